@@ -23,10 +23,12 @@
 #include "BlueCoveBlueZ.h"
 
 #include <dlfcn.h>
+#include <sys/time.h>
 
 #include <bluetooth/sdp_lib.h>
 
 int bluezVersionMajor = 0;
+void* bluezSdpExtractPdu = NULL;
 
 JNIEXPORT jboolean JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_isNativeCodeLoaded
   (JNIEnv *env, jobject peer) {
@@ -76,6 +78,29 @@ void* jlong2ptr(jlong l) {
     return ptr;
 }
 
+jlong bluecove_current_time_millis() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (jlong)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+}
+
+bool bluecove_socket_set_buffers(JNIEnv* env, int handle, jint sndbuf, jint rcvbuf) {
+    if ((sndbuf > 0) && (setsockopt(handle, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf)) < 0)) {
+        throwIOException(env, "Failed to set send buffer size. [%d] %s", errno, strerror(errno));
+        return false;
+    }
+    if ((rcvbuf > 0) && (setsockopt(handle, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf)) < 0)) {
+        throwIOException(env, "Failed to set receive buffer size. [%d] %s", errno, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionSetBuffersImpl
+  (JNIEnv* env, jobject peer, jlong handle, jint sndbuf, jint rcvbuf) {
+    bluecove_socket_set_buffers(env, handle, sndbuf, rcvbuf);
+}
+
 void reverseArray(jbyte* array, int length) {
     int i;
     jbyte temp;
@@ -98,22 +123,36 @@ void convertUUIDBytesToUUID(jbyte *bytes, uuid_t* uuid) {
     memcpy(&uuid->value, bytes, 128/8);
 }
 
-int getBlueZVersionMajor(JNIEnv* env) {
-    if(!bluezVersionMajor) {
-        char* libraryName = "libbluetooth.so";
-        char* functionName = "hci_local_name";
-        void* functionHandle;
-
-        void* libraryHandle = dlopen(libraryName, RTLD_LAZY);
-        if(!libraryHandle) {
-            throwBluetoothStateException(env, "can not load native library %s", libraryName);
-            return 0;
-        }
-        functionHandle = dlsym(libraryHandle, functionName);
+/*
+ * Detect BlueZ version and resolve sdp_extract_pdu which signature differs between BlueZ 3 and 4.
+ * Called once when library is loaded, the library handle is kept open while resolved functions are used.
+ */
+static void detectBlueZVersion() {
+    const char* libraryNames[] = { "libbluetooth.so", "libbluetooth.so.3", "libbluetooth.so.2" };
+    void* libraryHandle = NULL;
+    int i;
+    for (i = 0; (i < 3) && (libraryHandle == NULL); i++) {
+        libraryHandle = dlopen(libraryNames[i], RTLD_LAZY);
+    }
+    if (!libraryHandle) {
+        return;
+    }
+    bluezSdpExtractPdu = dlsym(libraryHandle, "sdp_extract_pdu");
+    if (bluezSdpExtractPdu == NULL) {
         dlclose(libraryHandle);
-        
-        bluezVersionMajor = functionHandle ? BLUEZ_VERSION_MAJOR_3 : BLUEZ_VERSION_MAJOR_4;
+        return;
     }
+    bluezVersionMajor = dlsym(libraryHandle, "hci_local_name") ? BLUEZ_VERSION_MAJOR_3 : BLUEZ_VERSION_MAJOR_4;
+}
 
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
+    detectBlueZVersion();
+    return JNI_VERSION_1_2;
+}
+
+int getBlueZVersionMajor(JNIEnv* env) {
+    if (!bluezVersionMajor) {
+        throwBluetoothStateException(env, "can not load native library %s", "libbluetooth.so");
+    }
     return bluezVersionMajor;
-}
\ No newline at end of file
+}
@@ -32,6 +32,7 @@
 
 #include <bluetooth/bluetooth.h>
 #include <bluetooth/sdp.h>
+#include <bluetooth/sdp_lib.h>
 #include <bluetooth/hci.h>
 #include <bluetooth/hci_lib.h>
 
@@ -46,6 +47,7 @@
 #define LOCALDEVICE_ACCESS_TIMEOUT 5000
 #define READ_REMOTE_NAME_TIMEOUT 5000
 #define DEVICE_NAME_MAX_SIZE 248
+#define ACL_CONNECTIONS_MAX 20
 
 int deviceClassBytesToInt(uint8_t* deviceClass);
 
@@ -62,6 +64,12 @@ void debugServiceRecord(JNIEnv *env, sdp_record_t* sdpRecord);
 jlong ptr2jlong(void * ptr);
 void* jlong2ptr(jlong l);
 
+// Used for read deadlines
+jlong bluecove_current_time_millis();
+
+// SO_SNDBUF and SO_RCVBUF in bytes, 0 keeps the kernel default. Returns false if exception thrown
+bool bluecove_socket_set_buffers(JNIEnv* env, int handle, jint sndbuf, jint rcvbuf);
+
 #define NOT_DISCOVERABLE com_intel_bluetooth_BluetoothStackBlueZConsts_NOT_DISCOVERABLE
 #define GIAC             com_intel_bluetooth_BluetoothStackBlueZConsts_GIAC
 #define LIAC             com_intel_bluetooth_BluetoothStackBlueZConsts_LIAC
@@ -109,9 +117,82 @@ void* jlong2ptr(jlong l);
 #define BLUEZ_VERSION_MAJOR_3 3
 #define BLUEZ_VERSION_MAJOR_4 4
 
+// Detected when library is loaded
+extern int bluezVersionMajor;
+extern void* bluezSdpExtractPdu;
+
 int getBlueZVersionMajor(JNIEnv* env);
 
 sdp_record_t* bluecove_sdp_extract_pdu(JNIEnv* env, const uint8_t *pdata, int bufsize, int *scanned);
 
+// --- SDP record parser, independent of BlueZ version
+
+sdp_record_t* bluecove_sdp_parse_pdu(const uint8_t* pdata, int bufsize, int* scanned);
+sdp_data_t* bluecove_sdp_parse_attr(const uint8_t* pdata, int bufsize, int* scanned, sdp_record_t* rec);
+int bluecove_sdp_element_header_length(uint8_t dtd);
+int bluecove_sdp_element_length(const uint8_t* pdata, int bufsize);
+
+// --- SDP server records registry
+
+// Attribute ID and position of its value in serialized record
+typedef struct {
+    uint16_t id;
+    int offset;
+    int length;
+} sdp_attr_span_t;
+
+int bluecove_sdp_attr_spans_max(int length);
+int bluecove_sdp_attr_spans(const uint8_t* pdu, int length, sdp_attr_span_t* spans, int max);
+int bluecove_sdp_record_diff(const uint8_t* oldPdu, int oldLength, const uint8_t* newPdu, int newLength,
+        sdp_attr_span_t* changed, int* changedCount, uint16_t* removed, int* removedCount);
+
+#define SDP_REGISTRY_UPDATED 0
+#define SDP_REGISTRY_UNCHANGED 1
+#define SDP_REGISTRY_NOT_FOUND 2
+#define SDP_REGISTRY_ERROR 3
+
+void bluecove_sdp_registry_put(JNIEnv* env, sdp_session_t* session, sdp_record_t* rec, const uint8_t* pdu, int length);
+int bluecove_sdp_registry_update(JNIEnv* env, sdp_session_t* session, bdaddr_t* localAddr, uint32_t handle, const uint8_t* pdu, int length);
+void bluecove_sdp_registry_remove(uint32_t handle);
+void bluecove_sdp_registry_remove_session(sdp_session_t* session);
+
+// --- SDP server calls
+
+typedef struct {
+    sdp_session_t* (*connect)(const bdaddr_t* src, const bdaddr_t* dst, uint32_t flags);
+    int (*close)(sdp_session_t* session);
+    int (*record_register)(sdp_session_t* session, bdaddr_t* device, sdp_record_t* rec, uint8_t flags);
+    int (*record_update)(sdp_session_t* session, bdaddr_t* device, const sdp_record_t* rec);
+    int (*record_unregister)(sdp_session_t* session, bdaddr_t* device, sdp_record_t* rec);
+} bluecove_sdp_server_t;
+
+// Used by native tests to register records in SDP server stand-in instead of sdpd, NULL restores libbluetooth
+void bluecove_sdp_server_hooks(const bluecove_sdp_server_t* server);
+
+int bluecove_sdp_record_update(sdp_session_t* session, bdaddr_t* device, const sdp_record_t* rec);
+
+// --- L2CAP channel options
+
+#ifndef L2CAP_FCS_NONE
+#define L2CAP_FCS_NONE  0x00
+#define L2CAP_FCS_CRC16 0x01
+#endif
+
+typedef int (*bluecove_getsockopt_t)(int handle, int level, int name, void* value, socklen_t* len);
+typedef int (*bluecove_setsockopt_t)(int handle, int level, int name, const void* value, socklen_t len);
+
+// Used by native tests on SEQPACKET socket pair that has no L2CAP_OPTIONS, NULL restores getsockopt and setsockopt
+void bluecove_l2cap_options_hooks(bluecove_getsockopt_t get, bluecove_setsockopt_t set);
+
+// mode is L2CAP_MODE_*, txWindow 0 keeps the kernel default, fcs is L2CAP_FCS_*. Returns false if exception thrown
+bool bluecove_l2cap_set_options(JNIEnv* env, int handle, jint receiveMTU, jint transmitMTU, jint flushTimeout, jint mode, jint txWindow, jint fcs);
+
+// --- Non-blocking client connect
+
+bool bluecove_connect_start(JNIEnv* env, int handle, struct sockaddr* addr, socklen_t addrLen);
+// timeout in milliseconds, 0 to wait for kernel page timeout
+bool bluecove_connect_wait(JNIEnv* env, jobject peer, int handle, jint timeout);
+bool bluecove_connect_finish(JNIEnv* env, int handle);
+
 #endif  /* _BLUECOVEBLUEZ_H */
 
@@ -0,0 +1,189 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2009 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+#define CPP__FILE "BlueCoveBlueZ_Connect.c"
+
+#include "BlueCoveBlueZ.h"
+
+#include <fcntl.h>
+#include <poll.h>
+
+/*
+ * Client connections are started with O_NONBLOCK and completed by poll, so connect is limited by the
+ * requested timeout and not by kernel page timeout, and one thread can wait for many connections.
+ */
+
+bool bluecove_connect_start(JNIEnv* env, int handle, struct sockaddr* addr, socklen_t addrLen) {
+    int flags = fcntl(handle, F_GETFL, 0);
+    if ((flags < 0) || (fcntl(handle, F_SETFL, flags | O_NONBLOCK) < 0)) {
+        throwIOException(env, "Failed to set non-blocking mode. [%d] %s", errno, strerror(errno));
+        return false;
+    }
+    if ((connect(handle, addr, addrLen) != 0) && (errno != EINPROGRESS)) {
+        throwIOException(env, "Failed to connect. [%d] %s", errno, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool bluecove_connect_finish(JNIEnv* env, int handle) {
+    int error = 0;
+    socklen_t len = sizeof(error);
+    if (getsockopt(handle, SOL_SOCKET, SO_ERROR, &error, &len) < 0) {
+        error = errno;
+    }
+    if (error == 0) {
+        // Read and write use blocking socket
+        int flags = fcntl(handle, F_GETFL, 0);
+        if ((flags < 0) || (fcntl(handle, F_SETFL, flags & ~O_NONBLOCK) < 0)) {
+            error = errno;
+        }
+    }
+    if (error == 0) {
+        return true;
+    }
+    if ((error == ETIMEDOUT) || (error == EHOSTDOWN)) {
+        throwBluetoothConnectionException(env, BT_CONNECTION_ERROR_TIMEOUT, "Failed to connect. [%d] %s", error, strerror(error));
+    } else {
+        throwIOException(env, "Failed to connect. [%d] %s", error, strerror(error));
+    }
+    return false;
+}
+
+bool bluecove_connect_wait(JNIEnv* env, jobject peer, int handle, jint timeout) {
+    jlong deadline = 0;
+    if (timeout > 0) {
+        deadline = bluecove_current_time_millis() + timeout;
+    }
+    while (true) {
+        int pollTimeout = 500; // milliseconds, check for thread interruption
+        if (timeout > 0) {
+            jlong remaining = deadline - bluecove_current_time_millis();
+            if (remaining <= 0) {
+                throwBluetoothConnectionException(env, BT_CONNECTION_ERROR_TIMEOUT, "Connection timeout");
+                return false;
+            }
+            if (remaining < pollTimeout) {
+                pollTimeout = (int)remaining;
+            }
+        }
+        struct pollfd fds;
+        memset(&fds, 0, sizeof(fds));
+        fds.fd = handle;
+        fds.events = POLLOUT;
+        int poll_rc = poll(&fds, 1, pollTimeout);
+        if (poll_rc > 0) {
+            // POLLERR and POLLHUP are reported by bluecove_connect_finish
+            return true;
+        } else if ((poll_rc < 0) && (errno != EINTR)) {
+            throwIOException(env, "Failed to poll. [%d] %s", errno, strerror(errno));
+            return false;
+        }
+        if (isCurrentThreadInterrupted(env, peer)) {
+            return false;
+        }
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionFinishImpl
+  (JNIEnv* env, jobject peer, jlong handle) {
+    bluecove_connect_finish(env, (int)handle);
+}
+
+/*
+ * Wait for any of the connections in progress, wakeupFd is read end of the pipe used to interrupt the wait.
+ */
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionWaitImpl
+  (JNIEnv* env, jobject peer, jlongArray handles, jint count, jbooleanArray ready, jint wakeupFd, jint timeout) {
+    struct pollfd* fds = (struct pollfd*)malloc(sizeof(struct pollfd) * (count + 1));
+    if (fds == NULL) {
+        throwRuntimeException(env, cOUT_OF_MEMORY);
+        return 0;
+    }
+    jlong* h = (*env)->GetLongArrayElements(env, handles, 0);
+    if (h == NULL) {
+        free(fds);
+        return 0;
+    }
+    memset(fds, 0, sizeof(struct pollfd) * (count + 1));
+    int i;
+    for (i = 0; i < count; i++) {
+        fds[i].fd = (int)h[i];
+        fds[i].events = POLLOUT;
+    }
+    (*env)->ReleaseLongArrayElements(env, handles, h, JNI_ABORT);
+    fds[count].fd = wakeupFd;
+    fds[count].events = POLLIN;
+
+    int done = 0;
+    int poll_rc = poll(fds, count + 1, timeout);
+    if (poll_rc < 0) {
+        if (errno != EINTR) {
+            throwIOException(env, "Failed to poll. [%d] %s", errno, strerror(errno));
+        }
+    } else if (poll_rc > 0) {
+        if (fds[count].revents & POLLIN) {
+            char buf[16];
+            while (read(wakeupFd, buf, sizeof(buf)) > 0) {
+            }
+        }
+        jboolean* r = (*env)->GetBooleanArrayElements(env, ready, 0);
+        if (r != NULL) {
+            for (i = 0; i < count; i++) {
+                r[i] = (fds[i].revents != 0);
+                if (r[i]) {
+                    done ++;
+                }
+            }
+            (*env)->ReleaseBooleanArrayElements(env, ready, r, 0);
+        }
+    }
+    free(fds);
+    return done;
+}
+
+/*
+ * Both ends are non-blocking, returns read end in the high 32 bits and write end in the low.
+ */
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionWakeupOpenImpl
+  (JNIEnv* env, jobject peer) {
+    int fds[2];
+    if (pipe(fds) < 0) {
+        throwIOException(env, "Failed to create pipe. [%d] %s", errno, strerror(errno));
+        return 0;
+    }
+    fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+    fcntl(fds[1], F_SETFL, fcntl(fds[1], F_GETFL, 0) | O_NONBLOCK);
+    return (((jlong)fds[0]) << 32) | (jlong)fds[1];
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionWakeupImpl
+  (JNIEnv* env, jobject peer, jlong wakeup) {
+    char c = 1;
+    // Pipe full means wakeup is already pending
+    if (write((int)(wakeup & 0xFFFFFFFF), &c, 1) < 0) {
+        Edebug("wakeup write. [%d] %s", errno, strerror(errno));
+    }
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionWakeupCloseImpl
+  (JNIEnv* env, jobject peer, jlong wakeup) {
+    close((int)(wakeup >> 32));
+    close((int)(wakeup & 0xFFFFFFFF));
+}
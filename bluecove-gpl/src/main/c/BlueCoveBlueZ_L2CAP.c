@@ -26,21 +26,86 @@
 #include <sys/poll.h>
 #include <bluetooth/l2cap.h>
 
+#ifndef L2CAP_MODE_BASIC
+#define L2CAP_MODE_BASIC 0x00
+#endif
+
 //#define BLUECOVE_L2CAP_USE_MSG
 // TODO Is this necessary to truncate data before calling socket functions? sockets preserve message boundaries.
 //#define BLUECOVE_L2CAP_MTU_TRUNCATE
 
 bool l2Get_options(JNIEnv* env, jlong handle, struct l2cap_options* opt);
 
-JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClientConnectionImpl
-  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint receiveMTU, jint transmitMTU, jint timeout) {
+static bluecove_getsockopt_t l2OptionsGet = getsockopt;
+static bluecove_setsockopt_t l2OptionsSet = setsockopt;
+
+void bluecove_l2cap_options_hooks(bluecove_getsockopt_t get, bluecove_setsockopt_t set) {
+    l2OptionsGet = (get != NULL)?get:getsockopt;
+    l2OptionsSet = (set != NULL)?set:setsockopt;
+}
+
+bool bluecove_l2cap_set_options(JNIEnv* env, int handle, jint receiveMTU, jint transmitMTU, jint flushTimeout, jint mode, jint txWindow, jint fcs) {
+    // Start from the kernel defaults for max_tx and txwin_size
+    struct l2cap_options opt;
+    socklen_t opt_len = sizeof(opt);
+    memset(&opt, 0, opt_len);
+    if (!l2Get_options(env, handle, &opt)) {
+        return false;
+    }
+    opt.imtu = receiveMTU;
+    opt.omtu = (transmitMTU > 0)?transmitMTU:L2CAP_DEFAULT_MTU;
+    opt.flush_to = (flushTimeout > 0)?flushTimeout:L2CAP_DEFAULT_FLUSH_TO;
+#ifdef L2CAP_MODE_ERTM
+    // Java L2CAPModeConnection.MODE_* are the same as L2CAP_MODE_*
+    opt.mode = mode;
+    opt.fcs = fcs;
+    if (txWindow > 0) {
+        opt.txwin_size = txWindow;
+    }
+    Edebug("L2CAP set imtu %i, omtu %i, flush_to %i, mode %i, txwin %i, fcs %i", opt.imtu, opt.omtu, opt.flush_to, opt.mode, opt.txwin_size, opt.fcs);
+#else
+    // BlueZ headers without channel mode in l2cap_options, only Basic mode is available
+    if (mode != L2CAP_MODE_BASIC) {
+        throwIOException(env, "L2CAP mode %i not supported", mode);
+        return false;
+    }
+    Edebug("L2CAP set imtu %i, omtu %i, flush_to %i", opt.imtu, opt.omtu, opt.flush_to);
+#endif //L2CAP_MODE_ERTM
+
+    if (l2OptionsSet(handle, SOL_L2CAP, L2CAP_OPTIONS, &opt, opt_len) < 0) {
+        if ((mode != L2CAP_MODE_BASIC) && (errno == EINVAL)) {
+            throwIOException(env, "L2CAP mode %i not supported. [%d] %s", mode, errno, strerror(errno));
+        } else {
+            throwIOException(env, "Failed to set L2CAP mtu options. [%d] %s", errno, strerror(errno));
+        }
+        return false;
+    }
+#ifdef BT_FLUSHABLE
+    // Since Linux 2.6.36 data is not flushable unless BT_FLUSHABLE is set, flush_to alone has no effect.
+    // Older kernels don't know the option and use flush_to for all data.
+    if (flushTimeout > 0) {
+        int flushable = BT_FLUSHABLE_ON;
+        if ((l2OptionsSet(handle, SOL_BLUETOOTH, BT_FLUSHABLE, &flushable, sizeof(flushable)) < 0) && (errno != ENOPROTOOPT)) {
+            throwIOException(env, "Failed to set L2CAP flushable. [%d] %s", errno, strerror(errno));
+            return false;
+        }
+    }
+#endif //BT_FLUSHABLE
+    return true;
+}
+
+/*
+ * Returns socket with connection in progress or -1.
+ */
+static int l2ConnectStart(JNIEnv* env, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint receiveMTU, jint transmitMTU,
+        jint sndbuf, jint rcvbuf, jint flushTimeout, jint mode, jint txWindow, jint fcs) {
     debug("CONNECT connect, psm %d", channel);
 
     // allocate socket
     int handle = socket(AF_BLUETOOTH, SOCK_SEQPACKET, BTPROTO_L2CAP);
     if (handle < 0) {
         throwIOException(env, "Failed to create socket. [%d] %s", errno, strerror(errno));
-        return 0;
+        return -1;
     }
 
     struct sockaddr_l2 localAddr;
@@ -55,22 +120,18 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClien
     if (bind(handle, (struct sockaddr *)&localAddr, sizeof(localAddr)) < 0) {
         throwIOException(env, "Failed to bind socket. [%d] %s", errno, strerror(errno));
         close(handle);
-        return 0;
+        return -1;
     }
 
-    // Set link mtu and security options
-    struct l2cap_options opt;
-    socklen_t opt_len = sizeof(opt);
-    memset(&opt, 0, opt_len);
-    opt.imtu = receiveMTU;
-    opt.omtu = (transmitMTU > 0)?transmitMTU:L2CAP_DEFAULT_MTU;
-    opt.flush_to = L2CAP_DEFAULT_FLUSH_TO;
-    Edebug("L2CAP set imtu %i, omtu %i", opt.imtu, opt.omtu);
+    // Set link mtu, channel mode and security options
+    if (!bluecove_l2cap_set_options(env, handle, receiveMTU, transmitMTU, flushTimeout, mode, txWindow, fcs)) {
+        close(handle);
+        return -1;
+    }
 
-    if (setsockopt(handle, SOL_L2CAP, L2CAP_OPTIONS, &opt, opt_len) < 0) {
-        throwIOException(env, "Failed to set L2CAP mtu options. [%d] %s", errno, strerror(errno));
+    if (!bluecove_socket_set_buffers(env, handle, sndbuf, rcvbuf)) {
         close(handle);
-        return 0;
+        return -1;
     }
 
     if (encrypt || authenticate) {
@@ -79,7 +140,7 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClien
         if (getsockopt(handle, SOL_L2CAP, L2CAP_LM, &socket_opt, &len) < 0) {
             throwIOException(env, "Failed to read L2CAP link mode. [%d] %s", errno, strerror(errno));
             close(handle);
-            return 0;
+            return -1;
         }
         //if (master) {
         //  socket_opt |= L2CAP_LM_MASTER;
@@ -95,7 +156,7 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClien
         if ((socket_opt != 0) && setsockopt(handle, SOL_L2CAP, L2CAP_LM, &socket_opt, sizeof(socket_opt)) < 0) {
             throwIOException(env, "Failed to set L2CAP link mode. [%d] %s", errno, strerror(errno));
             close(handle);
-            return 0;
+            return -1;
         }
     }
 
@@ -107,8 +168,20 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClien
     remoteAddr.l2_psm = channel;
 
     // connect to server
-    if (connect(handle, (struct sockaddr*)&remoteAddr, sizeof(remoteAddr)) != 0) {
-        throwIOException(env, "Failed to connect. [%d] %s", errno, strerror(errno));
+    if (!bluecove_connect_start(env, handle, (struct sockaddr*)&remoteAddr, sizeof(remoteAddr))) {
+        close(handle);
+        return -1;
+    }
+    return handle;
+}
+
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClientConnectionImpl
+  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint receiveMTU, jint transmitMTU, jint sndbuf, jint rcvbuf, jint flushTimeout, jint mode, jint txWindow, jint fcs, jint timeout) {
+    int handle = l2ConnectStart(env, localDeviceBTAddress, address, channel, authenticate, encrypt, receiveMTU, transmitMTU, sndbuf, rcvbuf, flushTimeout, mode, txWindow, fcs);
+    if (handle < 0) {
+        return 0;
+    }
+    if (!bluecove_connect_wait(env, peer, handle, timeout) || !bluecove_connect_finish(env, handle)) {
         close(handle);
         return 0;
     }
@@ -119,12 +192,27 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClien
         close(handle);
         return 0;
     }
+#ifdef L2CAP_MODE_ERTM
+    debug("L2CAP imtu %i, omtu %i, mode %i", copt.imtu, copt.omtu, copt.mode);
+#else
     debug("L2CAP imtu %i, omtu %i", copt.imtu, copt.omtu);
+#endif
     return handle;
 }
 
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2OpenClientConnectionStartImpl
+  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint receiveMTU, jint transmitMTU, jint sndbuf, jint rcvbuf, jint flushTimeout, jint mode, jint txWindow, jint fcs) {
+    int handle = l2ConnectStart(env, localDeviceBTAddress, address, channel, authenticate, encrypt, receiveMTU, transmitMTU, sndbuf, rcvbuf, flushTimeout, mode, txWindow, fcs);
+    if (handle < 0) {
+        return 0;
+    }
+    debug("L2CAP connect started, handle %li", handle);
+    return handle;
+}
+
+
 
-JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2CloseClientConnection
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2CloseClientConnectionImpl
   (JNIEnv* env, jobject peer, jlong handle) {
     debug("L2CAP disconnect, handle %li", handle);
     // Closing channel, further sends and receives will be disallowed.
@@ -138,7 +226,7 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2CloseClien
 
 bool l2Get_options(JNIEnv* env, jlong handle, struct l2cap_options* opt) {
     socklen_t opt_len = sizeof(*opt);
-    if (getsockopt(handle, SOL_L2CAP, L2CAP_OPTIONS, opt, &opt_len) < 0) {
+    if (l2OptionsGet(handle, SOL_L2CAP, L2CAP_OPTIONS, opt, &opt_len) < 0) {
         throwIOException(env, "Failed to get L2CAP link mtu. [%d] %s", errno, strerror(errno));
         return false;
     }
@@ -258,6 +346,128 @@ JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2Receive
     return count;
 }
 
+/*
+ * Packets up to this size are received to the stack and copied to the Java array, larger ones are received to pinned array.
+ */
+#define L2CAP_RECEIVE_STACK_BUFFER 4096
+
+/*
+ * Wait until the packet arrives, returns 1 when ready, 0 on timeout and -1 if exception thrown.
+ */
+static int l2WaitReceive(JNIEnv* env, jobject peer, jlong handle, jlong deadline) {
+    while (true) {
+        struct pollfd fds;
+        int pollTimeout = 500; // milliseconds, check for thread interruption
+        jlong remaining = deadline - bluecove_current_time_millis();
+        if (remaining <= 0) {
+            return 0;
+        }
+        if (remaining < pollTimeout) {
+            pollTimeout = (int)remaining;
+        }
+        memset(&fds, 0, sizeof(fds));
+        fds.fd = handle;
+        fds.events = POLLIN | POLLHUP | POLLERR;
+        fds.revents = 0;
+        int poll_rc = poll(&fds, 1, pollTimeout);
+        if (poll_rc > 0) {
+            if (fds.revents & POLLIN) {
+                // Packets queued before peer closed connection are still received
+                return 1;
+            } else if (fds.revents & (POLLHUP | POLLERR)) {
+                throwIOException(env, "Peer closed connection");
+                return -1;
+            } else if (fds.revents & POLLNVAL) {
+                throwIOException(env, "Connection closed");
+                return -1;
+            }
+        } else if ((poll_rc == -1) && (errno != EINTR)) {
+            throwIOException(env, "Failed to poll. [%d] %s", errno, strerror(errno));
+            return -1;
+        }
+        if (isCurrentThreadInterrupted(env, peer)) {
+            return -1;
+        }
+    }
+}
+
+#define L2CAP_RECEIVE_EMPTY -2
+
+/*
+ * Receive one packet without blocking. Returns packet size that may be bigger than the inBuf when it was truncated,
+ * L2CAP_RECEIVE_EMPTY when no packet is queued and -1 if exception thrown.
+ *
+ * MSG_TRUNC makes the kernel return real packet size, old kernels return the size of the copied data.
+ */
+static int l2ReceiveNow(JNIEnv* env, jlong handle, jbyteArray inBuf, int len) {
+    jbyte stackBuf[L2CAP_RECEIVE_STACK_BUFFER];
+    int count;
+    if (len <= L2CAP_RECEIVE_STACK_BUFFER) {
+        count = recv(handle, (char *)stackBuf, len, MSG_DONTWAIT | MSG_TRUNC);
+    } else {
+        // Only when Java buffer is larger than the stack buffer find out if the packet fits the stack
+        count = recv(handle, (char *)stackBuf, L2CAP_RECEIVE_STACK_BUFFER, MSG_DONTWAIT | MSG_PEEK | MSG_TRUNC);
+        if (count >= L2CAP_RECEIVE_STACK_BUFFER) {
+            jbyte *bytes = (*env)->GetByteArrayElements(env, inBuf, 0);
+            if (bytes == NULL) {
+                throwRuntimeException(env, "Invalid argument");
+                return -1;
+            }
+            count = recv(handle, (char *)bytes, len, MSG_DONTWAIT | MSG_TRUNC);
+            (*env)->ReleaseByteArrayElements(env, inBuf, bytes, (count > 0) ? 0 : JNI_ABORT);
+            goto receiveDone;
+        } else if (count >= 0) {
+            count = recv(handle, (char *)stackBuf, L2CAP_RECEIVE_STACK_BUFFER, MSG_DONTWAIT | MSG_TRUNC);
+        }
+    }
+    if (count > 0) {
+        (*env)->SetByteArrayRegion(env, inBuf, 0, (count < len) ? count : len, stackBuf);
+    }
+receiveDone:
+    if (count < 0) {
+        if ((errno == EAGAIN) || (errno == EWOULDBLOCK)) {
+            return L2CAP_RECEIVE_EMPTY;
+        }
+        throwIOException(env, "Failed to read. [%d] %s", errno, strerror(errno));
+        return -1;
+    }
+    return count;
+}
+
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2ReceiveTimeout
+  (JNIEnv* env, jobject peer, jlong handle, jbyteArray inBuf, jint timeout) {
+    if (inBuf == NULL) {
+        throwRuntimeException(env, "Invalid argument");
+        return 0;
+    }
+    int len = (*env)->GetArrayLength(env, inBuf);
+    jlong deadline = bluecove_current_time_millis() + timeout;
+    while (true) {
+        // Try to receive first, poll only when nothing is queued
+        int count = l2ReceiveNow(env, handle, inBuf, len);
+        if (count > 0) {
+            return count;
+        } else if (count == 0) {
+            // Empty packet (zero length SDU) is returned as 0, or the connection closed by peer
+            struct pollfd fds;
+            memset(&fds, 0, sizeof(fds));
+            fds.fd = handle;
+            fds.events = POLLIN | POLLHUP | POLLERR;
+            if ((poll(&fds, 1, 0) > 0) && (fds.revents & (POLLHUP | POLLERR))) {
+                throwIOException(env, "Peer closed connection");
+            }
+            return 0;
+        } else if (count != L2CAP_RECEIVE_EMPTY) {
+            return 0;
+        }
+        int ready = l2WaitReceive(env, peer, handle, deadline);
+        if (ready <= 0) {
+            // Timeout is -1 so it is not confused with the empty packet
+            return -1;
+        }
+    }
+}
+
 JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2Send
   (JNIEnv* env, jobject peer, jlong handle, jbyteArray data, jint transmitMTU) {
 #ifdef BLUECOVE_L2CAP_MTU_TRUNCATE
@@ -314,6 +524,49 @@ JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2GetTransmi
     }
 }
 
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2GetMode
+  (JNIEnv* env, jobject peer, jlong handle) {
+    struct l2cap_options opt;
+    if (l2Get_options(env, handle, &opt)) {
+#ifdef L2CAP_MODE_ERTM
+        return opt.mode;
+#else
+        return L2CAP_MODE_BASIC;
+#endif
+    } else {
+        return 0;
+    }
+}
+
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2GetTransmitWindow
+  (JNIEnv* env, jobject peer, jlong handle) {
+    struct l2cap_options opt;
+    if (l2Get_options(env, handle, &opt)) {
+#ifdef L2CAP_MODE_ERTM
+        return opt.txwin_size;
+#else
+        return 0;
+#endif
+    } else {
+        return 0;
+    }
+}
+
+JNIEXPORT jboolean JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2GetFCS
+  (JNIEnv* env, jobject peer, jlong handle) {
+    struct l2cap_options opt;
+    if (l2Get_options(env, handle, &opt)) {
+        // Basic mode frames have no FCS field
+#ifdef L2CAP_MODE_ERTM
+        return ((opt.mode != L2CAP_MODE_BASIC) && (opt.fcs != L2CAP_FCS_NONE))?JNI_TRUE:JNI_FALSE;
+#else
+        return JNI_FALSE;
+#endif
+    } else {
+        return JNI_FALSE;
+    }
+}
+
 JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2RemoteAddress
   (JNIEnv* env, jobject peer, jlong handle) {
     struct sockaddr_l2 remoteAddr;
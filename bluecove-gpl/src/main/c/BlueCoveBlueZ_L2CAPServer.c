@@ -25,7 +25,8 @@
 #include <fcntl.h>
 
 JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2ServerOpenImpl
-  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jboolean authorize, jboolean authenticate, jboolean encrypt, jboolean master, jboolean timeouts, jint backlog, jint receiveMTU, jint transmitMTU, jint assignPsm) {
+  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jboolean authorize, jboolean authenticate, jboolean encrypt, jboolean master, jboolean timeouts, jint backlog, jint receiveMTU, jint transmitMTU, jint assignPsm,
+   jint sndbuf, jint rcvbuf, jint flushTimeout, jint mode, jint txWindow, jint fcs) {
 
     // allocate socket
     int handle = socket(AF_BLUETOOTH, SOCK_SEQPACKET, BTPROTO_L2CAP);
@@ -53,17 +54,13 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2ServerOpe
         return 0;
     }
 
-    // Set link mtu and security options
-    struct l2cap_options opt;
-    socklen_t opt_len = sizeof(opt);
-    memset(&opt, 0, opt_len);
-    opt.imtu = receiveMTU;
-    opt.omtu = (transmitMTU > 0)?transmitMTU:L2CAP_DEFAULT_MTU;
-    opt.flush_to = L2CAP_DEFAULT_FLUSH_TO;
-    Edebug("L2CAP set imtu %i, omtu %i", opt.imtu, opt.omtu);
-
-    if (setsockopt(handle, SOL_L2CAP, L2CAP_OPTIONS, &opt, opt_len) < 0) {
-        throwIOException(env, "Failed to set L2CAP mtu options. [%d] %s", errno, strerror(errno));
+    // Set link mtu and channel mode, accepted connections inherit flush timeout and mode
+    if (!bluecove_l2cap_set_options(env, handle, receiveMTU, transmitMTU, flushTimeout, mode, txWindow, fcs)) {
+        close(handle);
+        return 0;
+    }
+
+    if (!bluecove_socket_set_buffers(env, handle, sndbuf, rcvbuf)) {
         close(handle);
         return 0;
     }
@@ -150,7 +147,7 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2ServerClos
     }
 }
 
-JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2ServerAcceptAndOpenServerConnection
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_l2ServerAcceptAndOpenServerConnectionImpl
   (JNIEnv* env, jobject peer, jlong handle) {
     struct sockaddr_l2 remoteAddr;
     memset(&remoteAddr, 0, sizeof(remoteAddr));
@@ -84,6 +84,54 @@ JNIEXPORT jintArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_getLoca
     return result;
 }
 
+// Remote addresses of ACL links, used by adapter pool to balance connections
+JNIEXPORT jlongArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_getACLConnectionsImpl
+(JNIEnv *env, jobject peer, jint deviceDescriptor, jint deviceID) {
+    struct hci_conn_list_req *cl;
+    struct hci_conn_info *ci;
+    cl = (struct hci_conn_list_req*)malloc(ACL_CONNECTIONS_MAX * sizeof(*ci) + sizeof(*cl));
+    if (!cl) {
+        throwRuntimeException(env, cOUT_OF_MEMORY);
+        return NULL;
+    }
+    cl->dev_id = deviceID;
+    cl->conn_num = ACL_CONNECTIONS_MAX;
+    if (ioctl(deviceDescriptor, HCIGETCONNLIST, (void*)cl) < 0) {
+        debug("HCIGETCONNLIST failed. [%d] %s", errno, strerror(errno));
+        free(cl);
+        return NULL;
+    }
+    int i;
+    int count = 0;
+    ci = cl->conn_info;
+    for (i = 0; i < cl->conn_num; i++, ci++) {
+        if (ci->type == ACL_LINK) {
+            count ++;
+        }
+    }
+    jlongArray result = (*env)->NewLongArray(env, count);
+    if (result == NULL) {
+        free(cl);
+        return NULL;
+    }
+    jlong *longs = (*env)->GetLongArrayElements(env, result, 0);
+    if (longs == NULL) {
+        free(cl);
+        return NULL;
+    }
+    int k = 0;
+    ci = cl->conn_info;
+    for (i = 0; i < cl->conn_num; i++, ci++) {
+        if (ci->type == ACL_LINK) {
+            longs[k] = deviceAddrToLong(&ci->bdaddr);
+            k ++;
+        }
+    }
+    (*env)->ReleaseLongArrayElements(env, result, longs, 0);
+    free(cl);
+    return result;
+}
+
 JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_nativeGetDeviceID
 (JNIEnv *env, jobject peer, jint findNumber, jint findBlueZDeviceID, jlong findLocalDeviceBTAddress) {
     bool findDevice = (findNumber >= 0) || (findLocalDeviceBTAddress > 0) || (findBlueZDeviceID >=0);
@@ -26,15 +26,17 @@
 #include <poll.h>
 #include <bluetooth/rfcomm.h>
 
-JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfOpenClientConnectionImpl
-  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint timeout) {
+/*
+ * Returns socket with connection in progress or -1.
+ */
+static int rfConnectStart(JNIEnv* env, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint sndbuf, jint rcvbuf) {
     debug("RFCOMM connect, channel %d", channel);
 
     // allocate socket
     int handle = socket(AF_BLUETOOTH, SOCK_STREAM, BTPROTO_RFCOMM);
     if (handle < 0) {
         throwIOException(env, "Failed to create socket. [%d] %s", errno, strerror(errno));
-        return 0;
+        return -1;
     }
 
     struct sockaddr_rc localAddr;
@@ -49,7 +51,12 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionR
     if (bind(handle, (struct sockaddr *)&localAddr, sizeof(localAddr)) < 0) {
         throwIOException(env, "Failed to  bind socket. [%d] %s", errno, strerror(errno));
         close(handle);
-        return 0;
+        return -1;
+    }
+
+    if (!bluecove_socket_set_buffers(env, handle, sndbuf, rcvbuf)) {
+        close(handle);
+        return -1;
     }
 
     // TODO verify how this works, I think device needs to paird before this can be setup.
@@ -60,7 +67,7 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionR
         if (getsockopt(handle, SOL_RFCOMM, RFCOMM_LM, &socket_opt, &len) < 0) {
             throwIOException(env, "Failed to read RFCOMM link mode. [%d] %s", errno, strerror(errno));
             close(handle);
-            return 0;
+            return -1;
         }
         //if (master) {
         //  socket_opt |= RFCOMM_LM_MASTER;
@@ -79,7 +86,7 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionR
         if ((socket_opt != 0) && setsockopt(handle, SOL_RFCOMM, RFCOMM_LM, &socket_opt, sizeof(socket_opt)) < 0) {
             throwIOException(env, "Failed to set RFCOMM link mode. [%d] %s", errno, strerror(errno));
             close(handle);
-            return 0;
+            return -1;
         }
     }
 
@@ -90,8 +97,20 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionR
     remoteAddr.rc_channel = channel;
 
     // connect to server
-    if (connect(handle, (struct sockaddr*)&remoteAddr, sizeof(remoteAddr)) != 0) {
-        throwIOException(env, "Failed to connect. [%d] %s", errno, strerror(errno));
+    if (!bluecove_connect_start(env, handle, (struct sockaddr*)&remoteAddr, sizeof(remoteAddr))) {
+        close(handle);
+        return -1;
+    }
+    return handle;
+}
+
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfOpenClientConnectionImpl
+  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint sndbuf, jint rcvbuf, jint timeout) {
+    int handle = rfConnectStart(env, localDeviceBTAddress, address, channel, authenticate, encrypt, sndbuf, rcvbuf);
+    if (handle < 0) {
+        return 0;
+    }
+    if (!bluecove_connect_wait(env, peer, handle, timeout) || !bluecove_connect_finish(env, handle)) {
         close(handle);
         return 0;
     }
@@ -99,7 +118,18 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionR
     return handle;
 }
 
-JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfCloseClientConnection
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfOpenClientConnectionStartImpl
+  (JNIEnv* env, jobject peer, jlong localDeviceBTAddress, jlong address, jint channel, jboolean authenticate, jboolean encrypt, jint sndbuf, jint rcvbuf) {
+    int handle = rfConnectStart(env, localDeviceBTAddress, address, channel, authenticate, encrypt, sndbuf, rcvbuf);
+    if (handle < 0) {
+        return 0;
+    }
+    debug("RFCOMM connect started, handle %li", handle);
+    return handle;
+}
+
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfCloseClientConnectionImpl
   (JNIEnv* env, jobject peer, jlong handle) {
     debug("RFCOMM disconnect, handle %li", handle);
     // Closing channel, further sends and receives will be disallowed.
@@ -131,8 +161,10 @@ JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_rfGetSecurit
     }
 }
 
-JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfRead
-  (JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len ) {
+/*
+ * timeout is in milliseconds, negative value to wait until data is available or connection closed.
+ */
+static jint rfRead(JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len, jint timeout) {
     if (b == NULL) {
         throwRuntimeException(env, "Invalid argument");
         return 0;
@@ -142,6 +174,10 @@ JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRf
         throwRuntimeException(env, "Invalid argument");
         return 0;
     }
+    jlong deadline = 0;
+    if (timeout >= 0) {
+        deadline = bluecove_current_time_millis() + timeout;
+    }
     int done = 0;
     while (done == 0) {
         int flags = MSG_DONTWAIT;
@@ -178,13 +214,24 @@ JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRf
             bool available = false;
             do {
                 struct pollfd fds;
-                int timeout = 500; // milliseconds
+                int pollTimeout = 500; // milliseconds, check for thread interruption
+                if (timeout >= 0) {
+                    jlong remaining = deadline - bluecove_current_time_millis();
+                    if (remaining <= 0) {
+                        throwInterruptedIOException(env, "RFCOMM read timeout");
+                        done = 0;
+                        goto rfReadEnd;
+                    }
+                    if (remaining < pollTimeout) {
+                        pollTimeout = (int)remaining;
+                    }
+                }
                 memset(&fds, 0, sizeof(fds));
                 fds.fd = handle;
                 fds.events = POLLIN | POLLHUP | POLLERR;// | POLLRDHUP;
                 fds.revents = 0;
                 //Edebug("poll: wait");
-                int poll_rc = poll(&fds, 1, timeout);
+                int poll_rc = poll(&fds, 1, pollTimeout);
                 if (poll_rc > 0) {
                     if (fds.revents & (POLLHUP | POLLERR /* | POLLRDHUP */)) {
                         debug("Stream socket peer closed connection");
@@ -220,6 +267,16 @@ rfReadEnd:
     return done;
 }
 
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfRead
+  (JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len ) {
+    return rfRead(env, peer, handle, b, off, len, -1);
+}
+
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfReadTimeout
+  (JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len, jint timeout) {
+    return rfRead(env, peer, handle, b, off, len, timeout);
+}
+
 JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfReadAvailable
   (JNIEnv* env, jobject peer, jlong handle) {
     struct pollfd fds;
@@ -251,8 +308,10 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRf
     }
 }
 
-JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfWrite__J_3BII
-  (JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len) {
+/*
+ * flags MSG_MORE tells the kernel more data follows and it can be sent in the same frame.
+ */
+static void rfWrite(JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len, int flags) {
     if (b == NULL) {
         throwRuntimeException(env, "Invalid argument");
         return;
@@ -264,7 +323,7 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRf
     }
     int done = 0;
     while(done < len) {
-        int count = send(handle, (char *)(bytes + off + done), len - done, 0);
+        int count = send(handle, (char *)(bytes + off + done), len - done, flags);
         if (count < 0) {
             throwIOException(env, "Failed to write. [%d] %s", errno, strerror(errno));
             break;
@@ -274,7 +333,17 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRf
         }
         done += count;
     }
-    (*env)->ReleaseByteArrayElements(env, b, bytes, 0);
+    (*env)->ReleaseByteArrayElements(env, b, bytes, JNI_ABORT);
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfWrite__J_3BII
+  (JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len) {
+    rfWrite(env, peer, handle, b, off, len, 0);
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfWriteMore
+  (JNIEnv* env, jobject peer, jlong handle, jbyteArray b, jint off, jint len, jboolean more) {
+    rfWrite(env, peer, handle, b, off, len, more ? MSG_MORE : 0);
 }
 
 JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfFlush
@@ -292,3 +361,23 @@ JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_getConnecti
     }
     return deviceAddrToLong(&remoteAddr.rc_bdaddr);
 }
+
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_connectionRfGetBufferSize
+  (JNIEnv* env, jobject peer, jlong handle) {
+    int sndbuf = 0;
+    int rcvbuf = 0;
+    socklen_t len = sizeof(sndbuf);
+    if (getsockopt(handle, SOL_SOCKET, SO_SNDBUF, &sndbuf, &len) < 0) {
+        throwIOException(env, "Failed to get SO_SNDBUF. [%d] %s", errno, strerror(errno));
+        return -1;
+    }
+    len = sizeof(rcvbuf);
+    if (getsockopt(handle, SOL_SOCKET, SO_RCVBUF, &rcvbuf, &len) < 0) {
+        throwIOException(env, "Failed to get SO_RCVBUF. [%d] %s", errno, strerror(errno));
+        return -1;
+    }
+    debug("RFCOMM sndbuf %i, rcvbuf %i", sndbuf, rcvbuf);
+    // Linux reports doubled value, half of it is bookkeeping overhead
+    int size = (sndbuf < rcvbuf) ? sndbuf : rcvbuf;
+    return size / 2;
+}
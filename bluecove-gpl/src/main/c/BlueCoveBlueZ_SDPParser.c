@@ -0,0 +1,258 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2008 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+#define CPP__FILE "BlueCoveBlueZ_SDPParser.c"
+
+#include "BlueCoveBlueZ.h"
+
+#include <bluetooth/sdp_lib.h>
+
+#include <endian.h>
+
+/*
+ * Serialized record parser. Builds sdp_record_t from the bytes created by Java SDPOutputStream
+ * using only the sdp_data_alloc API that is the same in BlueZ 3 and 4, so no version detection is required.
+ */
+
+int bluecove_sdp_element_header_length(uint8_t dtd) {
+    switch (dtd & 0x07) {
+    case 5:
+        return 2;
+    case 6:
+        return 3;
+    case 7:
+        return 5;
+    default:
+        return 1;
+    }
+}
+
+int bluecove_sdp_element_length(const uint8_t* pdata, int bufsize) {
+    if (bufsize < 1) {
+        return -1;
+    }
+    uint8_t dtd = pdata[0];
+    int header = 1;
+    uint32_t size = 0;
+    if ((dtd >> 3) != 0) {
+        switch (dtd & 0x07) {
+        case 0: case 1: case 2: case 3: case 4:
+            size = 1 << (dtd & 0x07);
+            break;
+        case 5:
+            if (bufsize < 2) {
+                return -1;
+            }
+            header = 2;
+            size = pdata[1];
+            break;
+        case 6:
+            if (bufsize < 3) {
+                return -1;
+            }
+            header = 3;
+            size = (pdata[1] << 8) | pdata[2];
+            break;
+        case 7:
+            if (bufsize < 5) {
+                return -1;
+            }
+            header = 5;
+            size = ((uint32_t)pdata[1] << 24) | (pdata[2] << 16) | (pdata[3] << 8) | pdata[4];
+            break;
+        }
+    }
+    if (size > (uint32_t)(bufsize - header)) {
+        return -1;
+    }
+    return header + size;
+}
+
+static uint16_t getBE16(const uint8_t* p) {
+    return (p[0] << 8) | p[1];
+}
+
+static uint32_t getBE32(const uint8_t* p) {
+    return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static uint64_t getBE64(const uint8_t* p) {
+    return ((uint64_t)getBE32(p) << 32) | getBE32(p + 4);
+}
+
+// BlueZ keeps 128-bit integers in host byte order and UUID128 in network byte order
+static void getBE128(const uint8_t* p, uint128_t* value) {
+#if __BYTE_ORDER == __LITTLE_ENDIAN
+    int i;
+    for (i = 0; i < 16; i++) {
+        value->data[i] = p[15 - i];
+    }
+#else
+    memcpy(value->data, p, 16);
+#endif
+}
+
+static sdp_data_t* parseElement(const uint8_t* pdata, int bufsize, int* scanned, sdp_record_t* rec) {
+    int length = bluecove_sdp_element_length(pdata, bufsize);
+    if (length < 0) {
+        return NULL;
+    }
+    uint8_t dtd = pdata[0];
+    const uint8_t* p = pdata + bluecove_sdp_element_header_length(dtd);
+    int valueLength = length - (p - pdata);
+    sdp_data_t* data = NULL;
+    union {
+        uint8_t uint8;
+        uint16_t uint16;
+        uint32_t uint32;
+        uint64_t uint64;
+        uint128_t uint128;
+    } value;
+
+    switch (dtd) {
+    case SDP_DATA_NIL:
+        data = sdp_data_alloc(dtd, NULL);
+        break;
+    case SDP_UINT8:
+    case SDP_INT8:
+    case SDP_BOOL:
+        value.uint8 = p[0];
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UINT16:
+    case SDP_INT16:
+        value.uint16 = getBE16(p);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UINT32:
+    case SDP_INT32:
+        value.uint32 = getBE32(p);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UINT64:
+    case SDP_INT64:
+        value.uint64 = getBE64(p);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UINT128:
+    case SDP_INT128:
+        getBE128(p, &value.uint128);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UUID16:
+        value.uint16 = getBE16(p);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UUID32:
+        value.uint32 = getBE32(p);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_UUID128:
+        memcpy(value.uint128.data, p, 16);
+        data = sdp_data_alloc(dtd, &value);
+        break;
+    case SDP_TEXT_STR8:
+    case SDP_TEXT_STR16:
+    case SDP_TEXT_STR32:
+    case SDP_URL_STR8:
+    case SDP_URL_STR16:
+    case SDP_URL_STR32:
+        data = sdp_data_alloc_with_length(dtd, p, valueLength);
+        break;
+    case SDP_SEQ8:
+    case SDP_SEQ16:
+    case SDP_SEQ32:
+    case SDP_ALT8:
+    case SDP_ALT16:
+    case SDP_ALT32: {
+        sdp_data_t* first = NULL;
+        sdp_data_t* last = NULL;
+        int offset = 0;
+        while (offset < valueLength) {
+            int elementScanned = 0;
+            sdp_data_t* element = parseElement(p + offset, valueLength - offset, &elementScanned, rec);
+            if (element == NULL) {
+                while (first != NULL) {
+                    sdp_data_t* next = first->next;
+                    sdp_data_free(first);
+                    first = next;
+                }
+                return NULL;
+            }
+            if (last == NULL) {
+                first = element;
+            } else {
+                last->next = element;
+            }
+            last = element;
+            offset += elementScanned;
+        }
+        data = sdp_data_alloc(dtd, first);
+        break;
+    }
+    default:
+        return NULL;
+    }
+    if (data == NULL) {
+        return NULL;
+    }
+    if ((dtd == SDP_UUID16) || (dtd == SDP_UUID32) || (dtd == SDP_UUID128)) {
+        sdp_pattern_add_uuid(rec, &data->val.uuid);
+    }
+    *scanned = length;
+    return data;
+}
+
+sdp_data_t* bluecove_sdp_parse_attr(const uint8_t* pdata, int bufsize, int* scanned, sdp_record_t* rec) {
+    return parseElement(pdata, bufsize, scanned, rec);
+}
+
+sdp_record_t* bluecove_sdp_parse_pdu(const uint8_t* pdata, int bufsize, int* scanned) {
+    int length = bluecove_sdp_element_length(pdata, bufsize);
+    if ((length < 0) || ((pdata[0] >> 3) != (SDP_SEQ8 >> 3))) {
+        return NULL;
+    }
+    sdp_record_t* rec = sdp_record_alloc();
+    if (rec == NULL) {
+        return NULL;
+    }
+    int offset = bluecove_sdp_element_header_length(pdata[0]);
+    while (offset < length) {
+        // Attribute ID is always UINT16
+        if ((length - offset < 4) || (pdata[offset] != SDP_UINT16)) {
+            sdp_record_free(rec);
+            return NULL;
+        }
+        uint16_t id = getBE16(pdata + offset + 1);
+        offset += 3;
+        int valueScanned = 0;
+        sdp_data_t* data = parseElement(pdata + offset, length - offset, &valueScanned, rec);
+        if (data == NULL) {
+            sdp_record_free(rec);
+            return NULL;
+        }
+        if ((id == SDP_ATTR_RECORD_HANDLE) && (data->dtd == SDP_UINT32)) {
+            rec->handle = data->val.uint32;
+        }
+        sdp_attr_replace(rec, id, data);
+        offset += valueScanned;
+    }
+    *scanned = length;
+    return rec;
+}
@@ -0,0 +1,326 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2008 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+#define CPP__FILE "BlueCoveBlueZ_SDPRegistry.c"
+
+#include "BlueCoveBlueZ.h"
+
+#include <bluetooth/sdp_lib.h>
+
+#include <pthread.h>
+
+// --- Attributes difference
+
+int bluecove_sdp_attr_spans_max(int length) {
+    // Each attribute takes at least 3 bytes for ID and 1 byte for value
+    return length / 4 + 1;
+}
+
+int bluecove_sdp_attr_spans(const uint8_t* pdu, int length, sdp_attr_span_t* spans, int max) {
+    int elementLength = bluecove_sdp_element_length(pdu, length);
+    if ((elementLength < 0) || ((pdu[0] >> 3) != (SDP_SEQ8 >> 3))) {
+        return -1;
+    }
+    int offset = bluecove_sdp_element_header_length(pdu[0]);
+    int count = 0;
+    while (offset < elementLength) {
+        // Attribute ID is always UINT16
+        if ((elementLength - offset < 4) || (pdu[offset] != SDP_UINT16)) {
+            return -1;
+        }
+        uint16_t id = (pdu[offset + 1] << 8) | pdu[offset + 2];
+        offset += 3;
+        int valueLength = bluecove_sdp_element_length(pdu + offset, elementLength - offset);
+        if ((valueLength < 0) || (count >= max)) {
+            return -1;
+        }
+        spans[count].id = id;
+        spans[count].offset = offset;
+        spans[count].length = valueLength;
+        count ++;
+        offset += valueLength;
+    }
+    return count;
+}
+
+static sdp_attr_span_t* findSpan(sdp_attr_span_t* spans, int count, uint16_t id) {
+    int i;
+    for (i = 0; i < count; i++) {
+        if (spans[i].id == id) {
+            return &spans[i];
+        }
+    }
+    return NULL;
+}
+
+int bluecove_sdp_record_diff(const uint8_t* oldPdu, int oldLength, const uint8_t* newPdu, int newLength,
+        sdp_attr_span_t* changed, int* changedCount, uint16_t* removed, int* removedCount) {
+    *changedCount = 0;
+    *removedCount = 0;
+    int oldMax = bluecove_sdp_attr_spans_max(oldLength);
+    int newMax = bluecove_sdp_attr_spans_max(newLength);
+    sdp_attr_span_t* oldSpans = (sdp_attr_span_t*)malloc(sizeof(sdp_attr_span_t) * oldMax);
+    sdp_attr_span_t* newSpans = (sdp_attr_span_t*)malloc(sizeof(sdp_attr_span_t) * newMax);
+    int rc = -1;
+    if ((oldSpans == NULL) || (newSpans == NULL)) {
+        goto diffDone;
+    }
+    int oldCount = bluecove_sdp_attr_spans(oldPdu, oldLength, oldSpans, oldMax);
+    int newCount = bluecove_sdp_attr_spans(newPdu, newLength, newSpans, newMax);
+    if ((oldCount < 0) || (newCount < 0)) {
+        goto diffDone;
+    }
+    int i;
+    for (i = 0; i < newCount; i++) {
+        sdp_attr_span_t* n = &newSpans[i];
+        // ServiceRecordHandle is assigned by SDP server
+        if (n->id == SDP_ATTR_RECORD_HANDLE) {
+            continue;
+        }
+        sdp_attr_span_t* o = findSpan(oldSpans, oldCount, n->id);
+        if ((o != NULL) && (o->length == n->length) && (memcmp(oldPdu + o->offset, newPdu + n->offset, n->length) == 0)) {
+            continue;
+        }
+        changed[(*changedCount)++] = *n;
+    }
+    for (i = 0; i < oldCount; i++) {
+        if ((oldSpans[i].id != SDP_ATTR_RECORD_HANDLE) && (findSpan(newSpans, newCount, oldSpans[i].id) == NULL)) {
+            removed[(*removedCount)++] = oldSpans[i].id;
+        }
+    }
+    rc = *changedCount + *removedCount;
+diffDone:
+    free(oldSpans);
+    free(newSpans);
+    return rc;
+}
+
+// --- Registered records
+
+/*
+ * Last registered record for each handle, updateRecord applies only changed attributes to it.
+ * The lock protects only the list and the busy/dropped flags. An entry marked busy is owned by one
+ * updating thread, it is not freed by remove but marked dropped and freed when the update ends.
+ */
+struct SDPRegistryEntry {
+    sdp_session_t* session;
+    sdp_record_t* record;
+    uint8_t* pdu;
+    int pduLength;
+    bool busy;
+    bool dropped;
+    struct SDPRegistryEntry* next;
+};
+
+static struct SDPRegistryEntry* sdpRegistry = NULL;
+static pthread_mutex_t sdpRegistryLock = PTHREAD_MUTEX_INITIALIZER;
+
+static struct SDPRegistryEntry** findEntry(uint32_t handle) {
+    struct SDPRegistryEntry** p = &sdpRegistry;
+    while ((*p != NULL) && ((*p)->record->handle != handle)) {
+        p = &((*p)->next);
+    }
+    return p;
+}
+
+static void freeEntry(struct SDPRegistryEntry* entry) {
+    sdp_record_free(entry->record);
+    free(entry->pdu);
+    free(entry);
+}
+
+// Called with lock held after entry is unlinked, returns entry to free after unlock or NULL
+static struct SDPRegistryEntry* dropEntry(struct SDPRegistryEntry* entry) {
+    entry->dropped = true;
+    return entry->busy ? NULL : entry;
+}
+
+static bool setEntryPdu(struct SDPRegistryEntry* entry, const uint8_t* pdu, int length) {
+    uint8_t* copy = (uint8_t*)malloc(length);
+    if (copy == NULL) {
+        return false;
+    }
+    memcpy(copy, pdu, length);
+    free(entry->pdu);
+    entry->pdu = copy;
+    entry->pduLength = length;
+    return true;
+}
+
+// Takes ownership of the entry for update, NULL when not registered or already updated by another thread
+static struct SDPRegistryEntry* acquireEntry(sdp_session_t* session, uint32_t handle) {
+    pthread_mutex_lock(&sdpRegistryLock);
+    struct SDPRegistryEntry* entry = *findEntry(handle);
+    if ((entry != NULL) && ((entry->session != session) || entry->busy)) {
+        entry = NULL;
+    }
+    if (entry != NULL) {
+        entry->busy = true;
+    }
+    pthread_mutex_unlock(&sdpRegistryLock);
+    return entry;
+}
+
+// Ends the update, entry is removed when not kept and freed if it was removed during update
+static void releaseEntry(struct SDPRegistryEntry* entry, bool keep) {
+    pthread_mutex_lock(&sdpRegistryLock);
+    entry->busy = false;
+    if ((!keep) && (!entry->dropped)) {
+        struct SDPRegistryEntry** p = &sdpRegistry;
+        while (*p != entry) {
+            p = &((*p)->next);
+        }
+        *p = entry->next;
+        entry->dropped = true;
+    }
+    bool dropped = entry->dropped;
+    pthread_mutex_unlock(&sdpRegistryLock);
+    if (dropped) {
+        freeEntry(entry);
+    }
+}
+
+void bluecove_sdp_registry_put(JNIEnv* env, sdp_session_t* session, sdp_record_t* rec, const uint8_t* pdu, int length) {
+    struct SDPRegistryEntry* entry = (struct SDPRegistryEntry*)malloc(sizeof(struct SDPRegistryEntry));
+    if (entry == NULL) {
+        sdp_record_free(rec);
+        return;
+    }
+    entry->session = session;
+    entry->record = rec;
+    entry->pdu = NULL;
+    entry->busy = false;
+    entry->dropped = false;
+    if (!setEntryPdu(entry, pdu, length)) {
+        freeEntry(entry);
+        return;
+    }
+    struct SDPRegistryEntry* old = NULL;
+    pthread_mutex_lock(&sdpRegistryLock);
+    struct SDPRegistryEntry** p = findEntry(rec->handle);
+    if (*p != NULL) {
+        old = *p;
+        *p = old->next;
+        old = dropEntry(old);
+    }
+    entry->next = sdpRegistry;
+    sdpRegistry = entry;
+    pthread_mutex_unlock(&sdpRegistryLock);
+    if (old != NULL) {
+        freeEntry(old);
+    }
+}
+
+int bluecove_sdp_registry_update(JNIEnv* env, sdp_session_t* session, bdaddr_t* localAddr, uint32_t handle, const uint8_t* pdu, int length) {
+    // sdpd round trip and debug are done without the lock, only this thread uses the acquired entry
+    struct SDPRegistryEntry* entry = acquireEntry(session, handle);
+    if (entry == NULL) {
+        return SDP_REGISTRY_NOT_FOUND;
+    }
+    int rc = SDP_REGISTRY_NOT_FOUND;
+    sdp_attr_span_t* changed = NULL;
+    uint16_t* removed = NULL;
+    if ((entry->pduLength == length) && (memcmp(entry->pdu, pdu, length) == 0)) {
+        debug("SDP record %x not changed", handle);
+        rc = SDP_REGISTRY_UNCHANGED;
+        goto updateDone;
+    }
+    changed = (sdp_attr_span_t*)malloc(sizeof(sdp_attr_span_t) * bluecove_sdp_attr_spans_max(length));
+    removed = (uint16_t*)malloc(sizeof(uint16_t) * bluecove_sdp_attr_spans_max(entry->pduLength));
+    if ((changed == NULL) || (removed == NULL)) {
+        goto updateDone;
+    }
+    int changedCount, removedCount;
+    int differences = bluecove_sdp_record_diff(entry->pdu, entry->pduLength, pdu, length, changed, &changedCount, removed, &removedCount);
+    if (differences < 0) {
+        goto updateDone;
+    }
+    if (differences == 0) {
+        debug("SDP record %x attributes not changed", handle);
+        setEntryPdu(entry, pdu, length);
+        rc = SDP_REGISTRY_UNCHANGED;
+        goto updateDone;
+    }
+    // Apply changed attributes to registered record, on error it is dropped and full update is done by caller.
+    int i;
+    for (i = 0; i < changedCount; i++) {
+        int scanned = changed[i].length;
+        sdp_data_t* data = bluecove_sdp_parse_attr(pdu + changed[i].offset, changed[i].length, &scanned, entry->record);
+        if (data == NULL) {
+            goto updateDone;
+        }
+        sdp_attr_replace(entry->record, changed[i].id, data);
+    }
+    for (i = 0; i < removedCount; i++) {
+        sdp_attr_remove(entry->record, removed[i]);
+    }
+    debug("SDP record %x update %i attributes, remove %i", handle, changedCount, removedCount);
+    if (bluecove_sdp_record_update(session, localAddr, entry->record) != 0) {
+        throwServiceRegistrationException(env, "Can not update SDP record. [%d] %s", errno, strerror(errno));
+        rc = SDP_REGISTRY_ERROR;
+        goto updateDone;
+    }
+    setEntryPdu(entry, pdu, length);
+    rc = SDP_REGISTRY_UPDATED;
+updateDone:
+    // Entry with partially applied attributes is not kept
+    releaseEntry(entry, (rc == SDP_REGISTRY_UPDATED) || (rc == SDP_REGISTRY_UNCHANGED));
+    free(changed);
+    free(removed);
+    return rc;
+}
+
+void bluecove_sdp_registry_remove(uint32_t handle) {
+    struct SDPRegistryEntry* entry = NULL;
+    pthread_mutex_lock(&sdpRegistryLock);
+    struct SDPRegistryEntry** p = findEntry(handle);
+    if (*p != NULL) {
+        entry = *p;
+        *p = entry->next;
+        entry = dropEntry(entry);
+    }
+    pthread_mutex_unlock(&sdpRegistryLock);
+    if (entry != NULL) {
+        freeEntry(entry);
+    }
+}
+
+void bluecove_sdp_registry_remove_session(sdp_session_t* session) {
+    struct SDPRegistryEntry* dropped = NULL;
+    pthread_mutex_lock(&sdpRegistryLock);
+    struct SDPRegistryEntry** p = &sdpRegistry;
+    while (*p != NULL) {
+        struct SDPRegistryEntry* entry = *p;
+        if (entry->session == session) {
+            *p = entry->next;
+            if (dropEntry(entry) != NULL) {
+                entry->next = dropped;
+                dropped = entry;
+            }
+        } else {
+            p = &(entry->next);
+        }
+    }
+    pthread_mutex_unlock(&sdpRegistryLock);
+    while (dropped != NULL) {
+        struct SDPRegistryEntry* entry = dropped;
+        dropped = entry->next;
+        freeEntry(entry);
+    }
+}
@@ -26,9 +26,27 @@
 
 #include <dlfcn.h>
 
+static const bluecove_sdp_server_t bluezSdpServer = {
+    sdp_connect,
+    sdp_close,
+    sdp_device_record_register,
+    sdp_device_record_update,
+    sdp_device_record_unregister
+};
+
+static const bluecove_sdp_server_t* sdpServer = &bluezSdpServer;
+
+void bluecove_sdp_server_hooks(const bluecove_sdp_server_t* server) {
+    sdpServer = (server != NULL)?server:&bluezSdpServer;
+}
+
+int bluecove_sdp_record_update(sdp_session_t* session, bdaddr_t* device, const sdp_record_t* rec) {
+    return sdpServer->record_update(session, device, rec);
+}
+
 JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_openSDPSessionImpl
   (JNIEnv* env, jobject peer) {
-    sdp_session_t* session = sdp_connect(BDADDR_ANY, BDADDR_LOCAL, SDP_RETRY_IF_BUSY);
+    sdp_session_t* session = sdpServer->connect(BDADDR_ANY, BDADDR_LOCAL, SDP_RETRY_IF_BUSY);
     if (!session) {
         throwServiceRegistrationException(env, "Can not open SDP session. [%d] %s", errno, strerror(errno));
         return 0;
@@ -41,7 +59,9 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_closeSDPSess
     if (sdpSessionHandle == 0) {
         return;
     }
-    if (sdp_close((sdp_session_t*)jlong2ptr(sdpSessionHandle)) < 0) {
+    sdp_session_t* session = (sdp_session_t*)jlong2ptr(sdpSessionHandle);
+    bluecove_sdp_registry_remove_session(session);
+    if (sdpServer->close(session) < 0) {
         if (quietly) {
             throwServiceRegistrationException(env, "Failed to close SDP session. [%d] %s", errno, strerror(errno));
         } else {
@@ -63,95 +83,170 @@ sdp_record_t* createNativeSDPrecord(JNIEnv* env, jbyteArray record) {
         return NULL;
     }
     int length_scanned = length;
-    sdp_record_t *rec = bluecove_sdp_extract_pdu(env, (uint8_t*) bytes, length, &length_scanned);
-    if (!rec) {
-        (*env)->ReleaseByteArrayElements(env, record, bytes, 0);
-        return NULL;
-    }
-
-    debug("pdu scanned %i -> %i", length, length_scanned);
+    sdp_record_t *rec = bluecove_sdp_parse_pdu((uint8_t*) bytes, length, &length_scanned);
+    (*env)->ReleaseByteArrayElements(env, record, bytes, JNI_ABORT);
     if (rec == NULL) {
-        throwServiceRegistrationException(env, "Can not convert SDP record. [%d] %s", errno, strerror(errno));
+        throwServiceRegistrationException(env, "Can not convert SDP record");
     }
-    (*env)->ReleaseByteArrayElements(env, record, bytes, 0);
     return rec;
 }
 
 sdp_record_t* bluecove_sdp_extract_pdu(JNIEnv* env, const uint8_t *pdata, int bufsize, int *scanned) {
-    sdp_record_t* rec = NULL;
-
     // we need to declare both to enable code to compile
     sdp_record_t* (*bluecove_sdp_extract_pdu_bluez_v3)(const uint8_t *pdata, int *scanned);
     sdp_record_t* (*bluecove_sdp_extract_pdu_bluez_v4)(const uint8_t *pdata, int bufsize, int *scanned);
 
-    char* functionName = "sdp_extract_pdu";
-
-    // detect bluez version
-    int bluezVersionMajor = getBlueZVersionMajor(env);
-    if(!bluezVersionMajor) {
-        return NULL;
-    }
-    debug("BlueZ major verion %d detected", bluezVersionMajor);
-
-    // call function with appropriate parameters according to bluez version
-    switch(bluezVersionMajor) {
+    // call function with appropriate parameters according to bluez version detected when library was loaded
+    switch(getBlueZVersionMajor(env)) {
         case BLUEZ_VERSION_MAJOR_3:
-            bluecove_sdp_extract_pdu_bluez_v3 = (typeof(bluecove_sdp_extract_pdu_bluez_v3))&sdp_extract_pdu;
-            rec = (*bluecove_sdp_extract_pdu_bluez_v3)(pdata, scanned);
-            debug("function %s of bluez major version %d is called", functionName, bluezVersionMajor);
-            break;
+            bluecove_sdp_extract_pdu_bluez_v3 = (typeof(bluecove_sdp_extract_pdu_bluez_v3))bluezSdpExtractPdu;
+            return (*bluecove_sdp_extract_pdu_bluez_v3)(pdata, scanned);
         case BLUEZ_VERSION_MAJOR_4:
-            bluecove_sdp_extract_pdu_bluez_v4 = (typeof(bluecove_sdp_extract_pdu_bluez_v4))&sdp_extract_pdu;
-            rec = (*bluecove_sdp_extract_pdu_bluez_v4)(pdata, bufsize, scanned);
-            debug("function %s of bluez major version %d is called", functionName, bluezVersionMajor);
-            break;
+            bluecove_sdp_extract_pdu_bluez_v4 = (typeof(bluecove_sdp_extract_pdu_bluez_v4))bluezSdpExtractPdu;
+            return (*bluecove_sdp_extract_pdu_bluez_v4)(pdata, bufsize, scanned);
     }
+    return NULL;
+}
 
-    return rec;
+/**
+ * Keep registered record in registry to apply only changed attributes on update.
+ */
+static void registryPutRecord(JNIEnv* env, sdp_session_t* session, sdp_record_t *rec, jbyteArray record) {
+    jbyte *bytes = (*env)->GetByteArrayElements(env, record, 0);
+    if (bytes == NULL) {
+        sdp_record_free(rec);
+        return;
+    }
+    bluecove_sdp_registry_put(env, session, rec, (uint8_t*)bytes, (*env)->GetArrayLength(env, record));
+    (*env)->ReleaseByteArrayElements(env, record, bytes, JNI_ABORT);
 }
 
-JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_registerSDPServiceImpl
-  (JNIEnv* env, jobject peer, jlong sdpSessionHandle, jlong localDeviceBTAddress, jbyteArray record) {
-    sdp_session_t* session = (sdp_session_t*)jlong2ptr(sdpSessionHandle);
+/**
+ * @return record handle or 0 and exception is thrown
+ */
+static uint32_t registerRecord(JNIEnv* env, sdp_session_t* session, bdaddr_t* localAddr, jbyteArray record) {
     sdp_record_t *rec = createNativeSDPrecord(env, record);
     if (rec == NULL) {
         return 0;
     }
-    bdaddr_t localAddr;
-    longToDeviceAddr(localDeviceBTAddress, &localAddr);
     // Remove ServiceRecordHandle
     sdp_attr_remove(rec, 0);
     rec->handle = 0;
     int flags = 0;
-    int err = sdp_device_record_register(session, &localAddr, rec, flags);
+    int err = sdpServer->record_register(session, localAddr, rec, flags);
     if (err != 0) {
         throwServiceRegistrationException(env, "Can not register SDP record. [%d] %s", errno, strerror(errno));
+        sdp_record_free(rec);
+        return 0;
     }
-    jlong handle = rec->handle;
-    sdp_record_free(rec);
+    uint32_t handle = rec->handle;
+    registryPutRecord(env, session, rec, record);
     return handle;
 }
 
+static void unregisterRecord(sdp_session_t* session, bdaddr_t* localAddr, uint32_t handle) {
+    bluecove_sdp_registry_remove(handle);
+    sdp_record_t *rec = sdp_record_alloc();
+    if (rec == NULL) {
+        return;
+    }
+    rec->handle = handle;
+    if (sdpServer->record_unregister(session, localAddr, rec) != 0) {
+        sdp_record_free(rec);
+    }
+}
+
+JNIEXPORT jlong JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_registerSDPServiceImpl
+  (JNIEnv* env, jobject peer, jlong sdpSessionHandle, jlong localDeviceBTAddress, jbyteArray record) {
+    sdp_session_t* session = (sdp_session_t*)jlong2ptr(sdpSessionHandle);
+    bdaddr_t localAddr;
+    longToDeviceAddr(localDeviceBTAddress, &localAddr);
+    return registerRecord(env, session, &localAddr, record);
+}
+
+/**
+ * sdpd takes one record per SDP_SVC_REGISTER_REQ and libbluetooth waits for each response, so records are still
+ * registered one after another. One call saves per record JNI and Java locking and makes the batch all or none.
+ */
+JNIEXPORT jlongArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_registerSDPServicesImpl
+  (JNIEnv* env, jobject peer, jlong sdpSessionHandle, jlong localDeviceBTAddress, jobjectArray records) {
+    sdp_session_t* session = (sdp_session_t*)jlong2ptr(sdpSessionHandle);
+    bdaddr_t localAddr;
+    longToDeviceAddr(localDeviceBTAddress, &localAddr);
+    int count = (*env)->GetArrayLength(env, records);
+    jlongArray result = (*env)->NewLongArray(env, count);
+    if (result == NULL) {
+        return NULL;
+    }
+    jlong* handles = (jlong*)malloc(sizeof(jlong) * (count + 1));
+    if (handles == NULL) {
+        throwRuntimeException(env, "Memory allocation error.");
+        return NULL;
+    }
+    int registered;
+    for (registered = 0; registered < count; registered++) {
+        jbyteArray record = (jbyteArray)(*env)->GetObjectArrayElement(env, records, registered);
+        uint32_t handle = 0;
+        if (record != NULL) {
+            handle = registerRecord(env, session, &localAddr, record);
+            (*env)->DeleteLocalRef(env, record);
+        } else {
+            throwServiceRegistrationException(env, "SDP record %i is null", registered);
+        }
+        if (handle == 0) {
+            break;
+        }
+        handles[registered] = handle;
+    }
+    if (registered < count) {
+        // Rollback, exception is already thrown
+        int i;
+        for (i = 0; i < registered; i++) {
+            unregisterRecord(session, &localAddr, (uint32_t)handles[i]);
+        }
+        free(handles);
+        return NULL;
+    }
+    (*env)->SetLongArrayRegion(env, result, 0, count, handles);
+    free(handles);
+    debug("registered %i SDP records", count);
+    return result;
+}
+
 JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_updateSDPServiceImpl
   (JNIEnv* env, jobject peer, jlong sdpSessionHandle, jlong localDeviceBTAddress, jlong handle, jbyteArray record) {
     sdp_session_t* session = (sdp_session_t*)jlong2ptr(sdpSessionHandle);
+    bdaddr_t localAddr;
+    longToDeviceAddr(localDeviceBTAddress, &localAddr);
+    // Apply only changed attributes to the record we registered
+    jbyte *bytes = (*env)->GetByteArrayElements(env, record, 0);
+    if (bytes == NULL) {
+        throwRuntimeException(env, "Memory allocation error.");
+        return;
+    }
+    int rc = bluecove_sdp_registry_update(env, session, &localAddr, (uint32_t)handle, (uint8_t*)bytes, (*env)->GetArrayLength(env, record));
+    (*env)->ReleaseByteArrayElements(env, record, bytes, JNI_ABORT);
+    if (rc != SDP_REGISTRY_NOT_FOUND) {
+        return;
+    }
     sdp_record_t *rec = createNativeSDPrecord(env, record);
     if (rec == NULL) {
         return;
     }
-    bdaddr_t localAddr;
-    longToDeviceAddr(localDeviceBTAddress, &localAddr);
     rec->handle = handle;
-    int err = sdp_device_record_update(session, &localAddr, rec);
+    int err = sdpServer->record_update(session, &localAddr, rec);
     if (err != 0) {
         throwServiceRegistrationException(env, "Can not update SDP record. [%d] %s", errno, strerror(errno));
+        sdp_record_free(rec);
+        return;
     }
-    sdp_record_free(rec);
+    registryPutRecord(env, session, rec, record);
 }
 
 JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_unregisterSDPServiceImpl
   (JNIEnv* env, jobject peer, jlong sdpSessionHandle, jlong localDeviceBTAddress, jlong handle, jbyteArray record) {
     sdp_session_t* session = (sdp_session_t*)jlong2ptr(sdpSessionHandle);
+    bluecove_sdp_registry_remove((uint32_t)handle);
     sdp_record_t *rec;
     // Use just handle to unredister record
     //rec = createNativeSDPrecord(env, record);
@@ -162,7 +257,7 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZ_unregisterSD
     rec->handle = handle;
     bdaddr_t localAddr;
     longToDeviceAddr(localDeviceBTAddress, &localAddr);
-    int err = sdp_device_record_unregister(session, &localAddr, rec);
+    int err = sdpServer->record_unregister(session, &localAddr, rec);
     if (err != 0) {
         throwServiceRegistrationException(env, "Can not unregister SDP record. [%d] %s", errno, strerror(errno));
         sdp_record_free(rec);
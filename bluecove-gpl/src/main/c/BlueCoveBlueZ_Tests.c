@@ -24,6 +24,7 @@
 #include "com_intel_bluetooth_BluetoothStackBlueZNativeTests.h"
 #include <dlfcn.h>
 #include <bluetooth/sdp_lib.h>
+#include <bluetooth/l2cap.h>
 
 JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testThrowException
 (JNIEnv *env, jclass peer, jint extype) {
@@ -61,27 +62,31 @@ JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_t
 	(*env)->ReleaseStringUTFChars(env, message, c);
 }
 
-JNIEXPORT jbyteArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testServiceRecordConvert
-(JNIEnv *env, jclass peer, jbyteArray record) {
+static jbyteArray serviceRecordConvert(JNIEnv *env, jbyteArray record, bool bluezParser) {
     int length = (*env)->GetArrayLength(env, record);
     jbyte *bytes = (*env)->GetByteArrayElements(env, record, 0);
     int length_scanned = length;
-    sdp_record_t *rec = bluecove_sdp_extract_pdu(env, (uint8_t*) bytes, length, &length_scanned);
-    if(!rec) {
-        return NULL;
+    sdp_record_t *rec;
+    if (bluezParser) {
+        rec = bluecove_sdp_extract_pdu(env, (uint8_t*) bytes, length, &length_scanned);
+    } else {
+        rec = bluecove_sdp_parse_pdu((uint8_t*) bytes, length, &length_scanned);
     }
-
-    debug("pdu scanned %i -> %i", length, length_scanned);
+    (*env)->ReleaseByteArrayElements(env, record, bytes, 0);
     if (rec == NULL) {
-        throwServiceRegistrationException(env, "Can not convert SDP record. [%d] %s", errno, strerror(errno));
-        (*env)->ReleaseByteArrayElements(env, record, bytes, 0);
+        if (!(*env)->ExceptionCheck(env)) {
+            throwServiceRegistrationException(env, "Can not convert SDP record. [%d] %s", errno, strerror(errno));
+        }
         return NULL;
     }
+
+    debug("pdu scanned %i -> %i", length, length_scanned);
     debugServiceRecord(env, rec);
 
     sdp_buf_t pdu;
     sdp_gen_record_pdu(rec, &pdu);
     debug("pdu.data_size %i -> %i", length, pdu.data_size);
+    sdp_record_free(rec);
 
     // construct byte array to hold pdu
     jbyteArray result = (*env)->NewByteArray(env, pdu.data_size);
@@ -90,7 +95,273 @@ JNIEXPORT jbyteArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeT
     (*env)->ReleaseByteArrayElements(env, result, result_bytes, 0);
 
     free(pdu.data);
+    return result;
+}
 
-    (*env)->ReleaseByteArrayElements(env, record, bytes, 0);
+JNIEXPORT jbyteArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testServiceRecordConvert
+(JNIEnv *env, jclass peer, jbyteArray record) {
+    return serviceRecordConvert(env, record, false);
+}
+
+JNIEXPORT jbyteArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testServiceRecordConvertBlueZ
+(JNIEnv *env, jclass peer, jbyteArray record) {
+    return serviceRecordConvert(env, record, true);
+}
+
+JNIEXPORT jintArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testServiceRecordDiff
+(JNIEnv *env, jclass peer, jbyteArray oldRecord, jbyteArray newRecord) {
+    int oldLength = (*env)->GetArrayLength(env, oldRecord);
+    int newLength = (*env)->GetArrayLength(env, newRecord);
+    sdp_attr_span_t* changed = (sdp_attr_span_t*)malloc(sizeof(sdp_attr_span_t) * bluecove_sdp_attr_spans_max(newLength));
+    uint16_t* removed = (uint16_t*)malloc(sizeof(uint16_t) * bluecove_sdp_attr_spans_max(oldLength));
+    jbyte *oldBytes = (*env)->GetByteArrayElements(env, oldRecord, 0);
+    jbyte *newBytes = (*env)->GetByteArrayElements(env, newRecord, 0);
+    int changedCount = 0;
+    int removedCount = 0;
+    int differences = bluecove_sdp_record_diff((uint8_t*)oldBytes, oldLength, (uint8_t*)newBytes, newLength, changed, &changedCount, removed, &removedCount);
+    (*env)->ReleaseByteArrayElements(env, oldRecord, oldBytes, JNI_ABORT);
+    (*env)->ReleaseByteArrayElements(env, newRecord, newBytes, JNI_ABORT);
+    jintArray result = NULL;
+    if (differences < 0) {
+        throwRuntimeException(env, "Can not parse SDP record");
+    } else {
+        result = (*env)->NewIntArray(env, differences);
+        if (result != NULL) {
+            jint *ints = (*env)->GetIntArrayElements(env, result, 0);
+            int i;
+            for (i = 0; i < changedCount; i++) {
+                ints[i] = changed[i].id;
+            }
+            for (i = 0; i < removedCount; i++) {
+                ints[changedCount + i] = 0x10000 | removed[i];
+            }
+            (*env)->ReleaseIntArrayElements(env, result, ints, 0);
+        }
+    }
+    free(changed);
+    free(removed);
     return result;
-}
\ No newline at end of file
+}
+
+// --- SDP server stand-in, keeps handles of registered records in memory
+
+#define SDP_MOCK_MAX_RECORDS 256
+// sdpd assigns handles of new records starting from 0x10000
+#define SDP_MOCK_FIRST_HANDLE 0x10000
+
+static uint32_t sdpMockHandles[SDP_MOCK_MAX_RECORDS];
+static int sdpMockCount;
+static uint32_t sdpMockNextHandle;
+static int sdpMockRoundTrip;
+static int sdpMockRegisterCalls;
+static int sdpMockFailAt;
+
+static void sdpMockRequest() {
+    if (sdpMockRoundTrip > 0) {
+        usleep(sdpMockRoundTrip);
+    }
+}
+
+static int sdpMockFind(uint32_t handle) {
+    int i;
+    for (i = 0; i < sdpMockCount; i++) {
+        if (sdpMockHandles[i] == handle) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+static sdp_session_t* sdpMockConnect(const bdaddr_t* src, const bdaddr_t* dst, uint32_t flags) {
+    return (sdp_session_t*)calloc(1, sizeof(sdp_session_t));
+}
+
+static int sdpMockClose(sdp_session_t* session) {
+    free(session);
+    return 0;
+}
+
+static int sdpMockRegister(sdp_session_t* session, bdaddr_t* device, sdp_record_t* rec, uint8_t flags) {
+    sdpMockRequest();
+    sdpMockRegisterCalls ++;
+    if ((sdpMockRegisterCalls == sdpMockFailAt) || (sdpMockCount >= SDP_MOCK_MAX_RECORDS)) {
+        errno = EIO;
+        return -1;
+    }
+    rec->handle = sdpMockNextHandle++;
+    sdpMockHandles[sdpMockCount++] = rec->handle;
+    return 0;
+}
+
+static int sdpMockUpdate(sdp_session_t* session, bdaddr_t* device, const sdp_record_t* rec) {
+    sdpMockRequest();
+    if (sdpMockFind(rec->handle) < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    return 0;
+}
+
+static int sdpMockUnregister(sdp_session_t* session, bdaddr_t* device, sdp_record_t* rec) {
+    sdpMockRequest();
+    int i = sdpMockFind(rec->handle);
+    if (i < 0) {
+        errno = EINVAL;
+        return -1;
+    }
+    sdpMockHandles[i] = sdpMockHandles[--sdpMockCount];
+    // Same as libbluetooth, record is freed on success
+    sdp_record_free(rec);
+    return 0;
+}
+
+static const bluecove_sdp_server_t sdpMockServer = {
+    sdpMockConnect,
+    sdpMockClose,
+    sdpMockRegister,
+    sdpMockUpdate,
+    sdpMockUnregister
+};
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testSDPMockOpen
+(JNIEnv *env, jclass peer, jint roundTrip, jint failAt) {
+    sdpMockCount = 0;
+    sdpMockNextHandle = SDP_MOCK_FIRST_HANDLE;
+    sdpMockRoundTrip = roundTrip;
+    sdpMockRegisterCalls = 0;
+    sdpMockFailAt = failAt;
+    bluecove_sdp_server_hooks(&sdpMockServer);
+}
+
+JNIEXPORT jint JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testSDPMockRecords
+(JNIEnv *env, jclass peer) {
+    return sdpMockCount;
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testSDPMockClose
+(JNIEnv *env, jclass peer) {
+    bluecove_sdp_server_hooks(NULL);
+}
+
+// --- L2CAP options on SEQPACKET socket pair
+
+// Linux L2CAP_DEFAULT_TX_WINDOW, L2CAP_DEFAULT_MAX_TX and L2CAP_DEFAULT_EXT_WINDOW
+#define L2CAP_MOCK_TX_WINDOW 63
+#define L2CAP_MOCK_MAX_TX 3
+#define L2CAP_MOCK_EXT_WINDOW 0x3FFF
+
+struct L2CAPMockSocket {
+    int handle;
+    struct l2cap_options opt;
+};
+
+static struct L2CAPMockSocket l2capMock[2];
+static bool l2capMockErtm;
+
+static struct l2cap_options* l2capMockOptions(int handle) {
+    int i;
+    for (i = 0; i < 2; i++) {
+        if (l2capMock[i].handle == handle) {
+            return &l2capMock[i].opt;
+        }
+    }
+    return NULL;
+}
+
+static int l2capMockGetsockopt(int handle, int level, int name, void* value, socklen_t* len) {
+    struct l2cap_options* opt = l2capMockOptions(handle);
+    if ((level != SOL_L2CAP) || (name != L2CAP_OPTIONS) || (opt == NULL)) {
+        errno = ENOPROTOOPT;
+        return -1;
+    }
+    if (*len > sizeof(struct l2cap_options)) {
+        *len = sizeof(struct l2cap_options);
+    }
+    memcpy(value, opt, *len);
+    return 0;
+}
+
+// Validates the options the same way as Linux kernel, ERTM and Streaming are rejected when disabled
+static int l2capMockSetsockopt(int handle, int level, int name, const void* value, socklen_t len) {
+    struct l2cap_options* opt = l2capMockOptions(handle);
+#ifdef BT_FLUSHABLE
+    if ((level == SOL_BLUETOOTH) && (name == BT_FLUSHABLE) && (opt != NULL)) {
+        return 0;
+    }
+#endif //BT_FLUSHABLE
+    if ((level != SOL_L2CAP) || (name != L2CAP_OPTIONS) || (opt == NULL)) {
+        errno = ENOPROTOOPT;
+        return -1;
+    }
+    struct l2cap_options requested = *opt;
+    memcpy(&requested, value, (len < sizeof(requested))?len:sizeof(requested));
+#ifdef L2CAP_MODE_ERTM
+    if (requested.txwin_size > L2CAP_MOCK_EXT_WINDOW) {
+        errno = EINVAL;
+        return -1;
+    }
+    switch (requested.mode) {
+    case L2CAP_MODE_BASIC:
+        break;
+    case L2CAP_MODE_ERTM:
+    case L2CAP_MODE_STREAMING:
+        if (l2capMockErtm) {
+            break;
+        }
+    default:
+        errno = EINVAL;
+        return -1;
+    }
+#endif //L2CAP_MODE_ERTM
+    *opt = requested;
+    return 0;
+}
+
+JNIEXPORT jlongArray JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testL2CAPMockOpen
+(JNIEnv *env, jclass peer, jboolean ertm) {
+    int sv[2];
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, sv) < 0) {
+        throwIOException(env, "Failed to create socket pair. [%d] %s", errno, strerror(errno));
+        return NULL;
+    }
+    int i;
+    for (i = 0; i < 2; i++) {
+        memset(&l2capMock[i], 0, sizeof(struct L2CAPMockSocket));
+        l2capMock[i].handle = sv[i];
+        l2capMock[i].opt.imtu = L2CAP_DEFAULT_MTU;
+        l2capMock[i].opt.omtu = L2CAP_DEFAULT_MTU;
+        l2capMock[i].opt.flush_to = L2CAP_DEFAULT_FLUSH_TO;
+#ifdef L2CAP_MODE_ERTM
+        l2capMock[i].opt.mode = L2CAP_MODE_BASIC;
+        l2capMock[i].opt.fcs = L2CAP_FCS_CRC16;
+        l2capMock[i].opt.max_tx = L2CAP_MOCK_MAX_TX;
+        l2capMock[i].opt.txwin_size = L2CAP_MOCK_TX_WINDOW;
+#endif
+    }
+    l2capMockErtm = ertm;
+    bluecove_l2cap_options_hooks(l2capMockGetsockopt, l2capMockSetsockopt);
+
+    jlongArray result = (*env)->NewLongArray(env, 2);
+    if (result != NULL) {
+        jlong handles[2] = {sv[0], sv[1]};
+        (*env)->SetLongArrayRegion(env, result, 0, 2, handles);
+    }
+    return result;
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testL2CAPSetOptions
+(JNIEnv *env, jclass peer, jlong handle, jint receiveMTU, jint transmitMTU, jint mode, jint txWindow, jint fcs) {
+    bluecove_l2cap_set_options(env, handle, receiveMTU, transmitMTU, 0, mode, txWindow, fcs);
+}
+
+JNIEXPORT void JNICALL Java_com_intel_bluetooth_BluetoothStackBlueZNativeTests_testL2CAPMockClose
+(JNIEnv *env, jclass peer) {
+    bluecove_l2cap_options_hooks(NULL, NULL);
+    int i;
+    for (i = 0; i < 2; i++) {
+        if (l2capMock[i].handle > 0) {
+            close(l2capMock[i].handle);
+        }
+        l2capMock[i].handle = -1;
+    }
+}
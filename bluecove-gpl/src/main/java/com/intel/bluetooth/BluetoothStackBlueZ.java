@@ -36,9 +36,14 @@ import javax.bluetooth.UUID;
 /**
  * Property "bluecove.deviceID" or "bluecove.deviceAddress" can be used to select Local
  * Bluetooth device.
+ * <p>
+ * With "bluecove.bluez.adapter_pool" client connections, service searches and Device Inquiry
+ * use all local adapters.
  * 
  */
-class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
+class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension, BluetoothStackBatchRegistration,
+        BluetoothStackReadTimeout, BluetoothStackConnectionBuffers, BluetoothStackWriteMore, BluetoothStackConnectAsync,
+        BluetoothStackL2CAPMode {
 
     public static final String NATIVE_BLUECOVE_LIB_BLUEZ = "bluecove";
 
@@ -61,6 +66,40 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
 
     private long localDeviceBTAddress;
 
+    /**
+     * Adapter pool, the first one is this stack device. null when pool is not enabled.
+     */
+    private BluetoothStackBlueZAdapter[] adapters;
+
+    private BluetoothStackBlueZAdapterPolicy adapterPolicy;
+
+    private BluetoothStackBlueZConnectScheduler connectScheduler;
+
+    /**
+     * Server handle to SO_SNDBUF and SO_RCVBUF for accepted connections
+     */
+    private final Hashtable serverBuffers = new Hashtable();
+
+    /**
+     * Adapter used by client connection, to release the link on close.
+     */
+    private final Hashtable/* <Long,BluetoothStackBlueZAdapter> */connectionAdapters = new Hashtable();
+
+    /**
+     * openAsync connections waiting in connect scheduler queue
+     */
+    private final Hashtable/* <BluetoothConnectionParams,AsyncConnect> */asyncQueued = new Hashtable();
+
+    /**
+     * Page slots of openAsync connections in progress, released by connectionFinish or close
+     */
+    private final Hashtable/* <Long,BluetoothStackBlueZConnectScheduler.Attempt> */asyncAttempts = new Hashtable();
+
+    /**
+     * Pipe used to interrupt connectionWait, 0 when not created.
+     */
+    private long connectionWakeup;
+
     private long sdpSesion;
 
     private int registeredServicesCount = 0;
@@ -172,8 +211,106 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
         propertiesMap.put(BlueCoveLocalDeviceProperties.LOCAL_DEVICE_PROPERTY_DEVICE_ID, String.valueOf(deviceID));
 
         devicesUsed.addElement(new Long(deviceID));
+
+        if (BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_BLUEZ_ADAPTER_POOL, false)) {
+            openAdapterPool();
+        }
+        int pagesMax = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_BLUEZ_CONNECT_SCHEDULER, 0);
+        if (pagesMax > 0) {
+            connectScheduler = new BluetoothStackBlueZConnectScheduler(pagesMax);
+        }
+    }
+
+    private void openAdapterPool() throws BluetoothStateException {
+        String policyClass = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_BLUEZ_ADAPTER_POLICY);
+        if (policyClass == null) {
+            adapterPolicy = new BluetoothStackBlueZLeastLinksPolicy();
+        } else {
+            try {
+                adapterPolicy = (BluetoothStackBlueZAdapterPolicy) Class.forName(policyClass).newInstance();
+            } catch (Throwable e) {
+                DebugLog.error("adapter policy " + policyClass, e);
+                throw new BluetoothStateException("Can't create adapter policy " + policyClass);
+            }
+        }
+        Vector pool = new Vector();
+        pool.addElement(new BluetoothStackBlueZAdapter(this, deviceID, deviceDescriptor, localDeviceBTAddress));
+        int[] ids = getLocalDevicesID();
+        if (ids != null) {
+            for (int i = 0; i < ids.length; i++) {
+                if (ids[i] == deviceID) {
+                    continue;
+                }
+                int dd = -1;
+                try {
+                    dd = nativeOpenDevice(ids[i]);
+                    long address = getLocalDeviceBluetoothAddressImpl(dd);
+                    pool.addElement(new BluetoothStackBlueZAdapter(this, ids[i], dd, address));
+                } catch (BluetoothStateException e) {
+                    DebugLog.error("adapter pool skip hci" + ids[i], e);
+                    if (dd >= 0) {
+                        nativeCloseDevice(dd);
+                    }
+                }
+            }
+        }
+        adapters = new BluetoothStackBlueZAdapter[pool.size()];
+        pool.copyInto(adapters);
+        DebugLog.debug("adapter pool size", adapters.length);
+    }
+
+    private void closeAdapterPool() {
+        BluetoothStackBlueZAdapter[] pool = adapters;
+        adapters = null;
+        if (pool == null) {
+            return;
+        }
+        // The first one is closed by destroy
+        for (int i = 1; i < pool.length; i++) {
+            nativeCloseDevice(pool[i].deviceDescriptor);
+        }
+        connectionAdapters.clear();
     }
 
+    private BluetoothStackBlueZAdapter selectAdapter(long remoteDeviceAddress) {
+        BluetoothStackBlueZAdapter[] pool = adapters;
+        if (pool == null) {
+            return null;
+        }
+        if (pool.length == 1) {
+            return pool[0];
+        }
+        int selected;
+        try {
+            selected = adapterPolicy.selectAdapter(pool, remoteDeviceAddress);
+        } catch (RuntimeException e) {
+            DebugLog.error("adapter policy", e);
+            selected = 0;
+        }
+        if ((selected < 0) || (selected >= pool.length)) {
+            selected = 0;
+        }
+        DebugLog.debug("selected adapter", pool[selected].toString());
+        return pool[selected];
+    }
+
+    private void adapterLinkOpened(long handle, BluetoothStackBlueZAdapter adapter) {
+        if (adapter != null) {
+            connectionAdapters.put(new Long(handle), adapter);
+        }
+    }
+
+    private void adapterLinkClosed(long handle) {
+        if (adapters != null) {
+            BluetoothStackBlueZAdapter adapter = (BluetoothStackBlueZAdapter) connectionAdapters.remove(new Long(handle));
+            if (adapter != null) {
+                adapter.linkClosed();
+            }
+        }
+    }
+
+    native long[] getACLConnectionsImpl(int deviceDescriptor, int deviceID);
+
     private native void nativeCloseDevice(int deviceDescriptor);
 
     public void destroy() {
@@ -185,6 +322,13 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
             } catch (ServiceRegistrationException ignore) {
             }
         }
+        closeAdapterPool();
+        synchronized (this) {
+            if (connectionWakeup != 0) {
+                connectionWakeupCloseImpl(connectionWakeup);
+                connectionWakeup = 0;
+            }
+        }
         nativeCloseDevice(deviceDescriptor);
         if (deviceID >= 0) {
             devicesUsed.removeElement(new Long(deviceID));
@@ -209,7 +353,8 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
      * @see com.intel.bluetooth.BluetoothStack#getFeatureSet()
      */
     public int getFeatureSet() {
-        return FEATURE_SERVICE_ATTRIBUTES | FEATURE_L2CAP | FEATURE_RSSI | FEATURE_ASSIGN_SERVER_PSM;
+        return FEATURE_SERVICE_ATTRIBUTES | FEATURE_L2CAP | FEATURE_RSSI | FEATURE_ASSIGN_SERVER_PSM | FEATURE_SOCKET_OPTIONS
+                | FEATURE_L2CAP_MODE;
     }
 
     // --- LocalDevice
@@ -260,6 +405,10 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
             }
             return b.toString();
         }
+        if (BlueCoveLocalDeviceProperties.LOCAL_DEVICE_PROPERTY_CONNECT_STATISTICS.equals(property)) {
+            BluetoothStackBlueZConnectScheduler scheduler = connectScheduler;
+            return (scheduler == null) ? null : scheduler.getStatistics();
+        }
         // Some Hack and testing functions, not documented
         if (property.startsWith("bluecove.nativeFunction:")) {
             String functionDescr = property.substring(property.indexOf(':') + 1, property.length());
@@ -389,39 +538,147 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
         DeviceInquiryRunnable inquiryRunnable = new DeviceInquiryRunnable() {
 
             public int runDeviceInquiry(DeviceInquiryThread startedNotify, int accessCode, DiscoveryListener listener) throws BluetoothStateException {
+                InquiryAdapterThread[] adapterThreads = startPoolInquiry(this, startedNotify, accessCode, listener);
+                int discType = DiscoveryListener.INQUIRY_ERROR;
+                boolean mainCompleted = false;
                 try {
-                    int discType = runDeviceInquiryImpl(this, startedNotify, deviceID, deviceDescriptor, accessCode, 8, 20, listener);
-                    if (deviceInquiryCanceled) {
-                        return DiscoveryListener.INQUIRY_TERMINATED;
-                    }
-                    return discType;
+                    discType = runDeviceInquiryImpl(this, startedNotify, deviceID, deviceDescriptor, accessCode, 8, 20, listener);
+                    mainCompleted = true;
                 } finally {
+                    if (adapterThreads != null) {
+                        // Don't leave other adapters running Inquiry after failure on main adapter
+                        if (!mainCompleted) {
+                            stopPoolInquiry(adapterThreads);
+                        }
+                        discType = joinPoolInquiry(adapterThreads, discType);
+                    }
                     discoveryListener = null;
                     discoveredDevices = null;
                 }
+                if (deviceInquiryCanceled) {
+                    return DiscoveryListener.INQUIRY_TERMINATED;
+                }
+                return discType;
             }
 
             public void deviceDiscoveredCallback(DiscoveryListener listener, long deviceAddr, int deviceClass, String deviceName, boolean paired) {
                 RemoteDevice remoteDevice = RemoteDeviceHelper.createRemoteDevice(BluetoothStackBlueZ.this, deviceAddr, deviceName, paired);
-                if (deviceInquiryCanceled || (discoveryListener == null) || (discoveredDevices == null) || (discoveredDevices.contains(remoteDevice))) {
+                Vector devices = discoveredDevices;
+                if (devices == null) {
                     return;
                 }
-                discoveredDevices.addElement(remoteDevice);
+                // Adapters of the pool report devices from different threads
+                synchronized (devices) {
+                    if (deviceInquiryCanceled || (discoveryListener == null) || (devices.contains(remoteDevice))) {
+                        return;
+                    }
+                    devices.addElement(remoteDevice);
+                }
+                // Application callback is called without lock so other adapters are not blocked
                 DeviceClass cod = new DeviceClass(deviceClass);
                 DebugLog.debug("deviceDiscoveredCallback address", remoteDevice.getBluetoothAddress());
                 DebugLog.debug("deviceDiscoveredCallback deviceClass", cod);
                 listener.deviceDiscovered(remoteDevice, cod);
-
             }
         };
         return DeviceInquiryThread.startInquiry(this, inquiryRunnable, accessCode, listener);
     }
 
+    /**
+     * Device Inquiry on other adapters of the pool.
+     */
+    private class InquiryAdapterThread extends Thread {
+
+        private final BluetoothStackBlueZAdapter adapter;
+
+        private final DeviceInquiryRunnable inquiryRunnable;
+
+        private final DeviceInquiryThread startedNotify;
+
+        private final int accessCode;
+
+        private final DiscoveryListener listener;
+
+        private int discType = DiscoveryListener.INQUIRY_ERROR;
+
+        private boolean stopped = false;
+
+        InquiryAdapterThread(BluetoothStackBlueZAdapter adapter, DeviceInquiryRunnable inquiryRunnable, DeviceInquiryThread startedNotify, int accessCode,
+                DiscoveryListener listener) {
+            super("DeviceInquiry-hci" + adapter.deviceID);
+            this.adapter = adapter;
+            this.inquiryRunnable = inquiryRunnable;
+            this.startedNotify = startedNotify;
+            this.accessCode = accessCode;
+            this.listener = listener;
+        }
+
+        public void run() {
+            try {
+                synchronized (this) {
+                    if (stopped) {
+                        return;
+                    }
+                }
+                discType = runDeviceInquiryImpl(inquiryRunnable, startedNotify, adapter.deviceID, adapter.deviceDescriptor, accessCode, 8, 20, listener);
+            } catch (Throwable e) {
+                DebugLog.error("DeviceInquiry on hci" + adapter.deviceID, e);
+            }
+        }
+    }
+
+    private InquiryAdapterThread[] startPoolInquiry(DeviceInquiryRunnable inquiryRunnable, DeviceInquiryThread startedNotify, int accessCode,
+            DiscoveryListener listener) {
+        BluetoothStackBlueZAdapter[] pool = adapters;
+        if ((pool == null) || (pool.length == 1)) {
+            return null;
+        }
+        InquiryAdapterThread[] threads = new InquiryAdapterThread[pool.length - 1];
+        for (int i = 0; i < threads.length; i++) {
+            threads[i] = new InquiryAdapterThread(pool[i + 1], inquiryRunnable, startedNotify, accessCode, listener);
+            UtilsJavaSE.threadSetDaemon(threads[i]);
+            threads[i].start();
+        }
+        return threads;
+    }
+
+    private void stopPoolInquiry(InquiryAdapterThread[] threads) {
+        for (int i = 0; i < threads.length; i++) {
+            synchronized (threads[i]) {
+                threads[i].stopped = true;
+            }
+            deviceInquiryCancelImpl(threads[i].adapter.deviceDescriptor);
+        }
+    }
+
+    /**
+     * Inquiry is completed when at least one adapter completed it.
+     */
+    private int joinPoolInquiry(InquiryAdapterThread[] threads, int discType) {
+        for (int i = 0; i < threads.length; i++) {
+            try {
+                threads[i].join();
+            } catch (InterruptedException e) {
+                break;
+            }
+            if (threads[i].discType == DiscoveryListener.INQUIRY_COMPLETED) {
+                discType = DiscoveryListener.INQUIRY_COMPLETED;
+            }
+        }
+        return discType;
+    }
+
     private native boolean deviceInquiryCancelImpl(int deviceDescriptor);
 
     public boolean cancelInquiry(DiscoveryListener listener) {
         if (discoveryListener != null && discoveryListener == listener) {
             deviceInquiryCanceled = true;
+            BluetoothStackBlueZAdapter[] pool = adapters;
+            if (pool != null) {
+                for (int i = 1; i < pool.length; i++) {
+                    deviceInquiryCancelImpl(pool[i].deviceDescriptor);
+                }
+            }
             return deviceInquiryCancelImpl(deviceDescriptor);
         }
         return false;
@@ -450,7 +707,19 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
                     for (int i = 0; i < uuidSet.length; i++) {
                         uuidValues[i] = Utils.UUIDToByteArray(uuidSet[i]);
                     }
-                    int respCode = runSearchServicesImpl(sst, localDeviceBTAddress, uuidValues, RemoteDeviceHelper.getAddress(device));
+                    long remoteAddress = RemoteDeviceHelper.getAddress(device);
+                    BluetoothStackBlueZAdapter adapter = selectAdapter(remoteAddress);
+                    int respCode;
+                    if (adapter == null) {
+                        respCode = runSearchServicesImpl(sst, localDeviceBTAddress, uuidValues, remoteAddress);
+                    } else {
+                        adapter.linkOpened();
+                        try {
+                            respCode = runSearchServicesImpl(sst, adapter.address, uuidValues, remoteAddress);
+                        } finally {
+                            adapter.linkClosed();
+                        }
+                    }
                     if ((respCode != DiscoveryListener.SERVICE_SEARCH_ERROR) && (sst.isTerminated())) {
                         return DiscoveryListener.SERVICE_SEARCH_TERMINATED;
                     } else if (respCode == DiscoveryListener.SERVICE_SEARCH_COMPLETED) {
@@ -525,6 +794,8 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
 
     private native long registerSDPServiceImpl(long sdpSesion, long localDeviceBTAddress, byte[] record) throws ServiceRegistrationException;
 
+    private native long[] registerSDPServicesImpl(long sdpSesion, long localDeviceBTAddress, byte[][] records) throws ServiceRegistrationException;
+
     private native void updateSDPServiceImpl(long sdpSesion, long localDeviceBTAddress, long handle, byte[] record) throws ServiceRegistrationException;
 
     private native void unregisterSDPServiceImpl(long sdpSesion, long localDeviceBTAddress, long handle, byte[] record) throws ServiceRegistrationException;
@@ -539,18 +810,50 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
         return blob;
     }
 
-    private synchronized void registerSDPRecord(ServiceRecordImpl serviceRecord) throws ServiceRegistrationException {
+    synchronized void registerSDPRecord(ServiceRecordImpl serviceRecord) throws ServiceRegistrationException {
+        if (ServiceRecordsRegistry.deferRegistration(this, serviceRecord)) {
+            return;
+        }
         long handle = registerSDPServiceImpl(getSDPSession(), this.localDeviceBTAddress, getSDPBinary(serviceRecord));
         serviceRecord.setHandle(handle);
         serviceRecord.populateAttributeValue(BluetoothConsts.ServiceRecordHandle, new DataElement(DataElement.U_INT_4, handle));
         registeredServicesCount++;
     }
 
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackBatchRegistration#registerServiceRecords(com.intel.bluetooth.ServiceRecordImpl[])
+     */
+    public synchronized void registerServiceRecords(ServiceRecordImpl[] serviceRecords) throws ServiceRegistrationException {
+        if (serviceRecords.length == 0) {
+            return;
+        }
+        byte[][] records = new byte[serviceRecords.length][];
+        for (int i = 0; i < serviceRecords.length; i++) {
+            records[i] = getSDPBinary(serviceRecords[i]);
+        }
+        long[] handles = registerSDPServicesImpl(getSDPSession(), this.localDeviceBTAddress, records);
+        for (int i = 0; i < serviceRecords.length; i++) {
+            serviceRecords[i].setHandle(handles[i]);
+            serviceRecords[i].populateAttributeValue(BluetoothConsts.ServiceRecordHandle, new DataElement(DataElement.U_INT_4, handles[i]));
+        }
+        registeredServicesCount += serviceRecords.length;
+    }
+
     private void updateSDPRecord(ServiceRecordImpl serviceRecord) throws ServiceRegistrationException {
+        if (serviceRecord.getHandle() == 0) {
+            // Registration deferred, record is serialized on commit
+            return;
+        }
         updateSDPServiceImpl(getSDPSession(), this.localDeviceBTAddress, serviceRecord.getHandle(), getSDPBinary(serviceRecord));
     }
 
-    private synchronized void unregisterSDPRecord(ServiceRecordImpl serviceRecord) throws ServiceRegistrationException {
+    synchronized void unregisterSDPRecord(ServiceRecordImpl serviceRecord) throws ServiceRegistrationException {
+        if (serviceRecord.getHandle() == 0) {
+            ServiceRecordsRegistry.cancelDeferredRegistration(this, serviceRecord);
+            return;
+        }
         try {
             unregisterSDPServiceImpl(getSDPSession(), this.localDeviceBTAddress, serviceRecord.getHandle(), getSDPBinary(serviceRecord));
         } finally {
@@ -565,17 +868,224 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
         }
     }
 
+    // --- Socket buffers
+
+    private native void connectionSetBuffersImpl(long handle, int sndbuf, int rcvbuf) throws IOException;
+
+    /**
+     * Accepted sockets do not inherit SO_SNDBUF and SO_RCVBUF from the server socket.
+     */
+    private void setServerBuffers(long serverHandle, BluetoothConnectionNotifierParams params) {
+        if ((params.sndbuf > 0) || (params.rcvbuf > 0)) {
+            serverBuffers.put(new Long(serverHandle), new int[] { params.sndbuf, params.rcvbuf });
+        }
+    }
+
+    private long acceptedConnectionBuffers(long serverHandle, long handle, boolean l2cap) throws IOException {
+        int[] buffers = (int[]) serverBuffers.get(new Long(serverHandle));
+        if ((buffers == null) || (handle == 0)) {
+            return handle;
+        }
+        boolean success = false;
+        try {
+            connectionSetBuffersImpl(handle, buffers[0], buffers[1]);
+            success = true;
+            return handle;
+        } finally {
+            if (!success) {
+                if (l2cap) {
+                    l2CloseClientConnectionImpl(handle);
+                } else {
+                    connectionRfCloseClientConnectionImpl(handle);
+                }
+            }
+        }
+    }
+
     // --- Client RFCOMM connections
 
+    private static class AsyncConnect {
+
+        final BluetoothStackBlueZAdapter adapter;
+
+        final BluetoothStackBlueZConnectScheduler.Attempt attempt;
+
+        AsyncConnect(BluetoothStackBlueZAdapter adapter, BluetoothStackBlueZConnectScheduler.Attempt attempt) {
+            this.adapter = adapter;
+            this.attempt = attempt;
+        }
+    }
+
+    /**
+     * Native start of RFCOMM or L2CAP connection.
+     */
+    private static abstract class ConnectStart {
+
+        abstract long start(long localAddress) throws IOException;
+    }
+
+    private BluetoothStackBlueZConnectScheduler.ACLCheck aclCheck(BluetoothStackBlueZAdapter adapter) {
+        final int id = (adapter == null) ? this.deviceID : adapter.deviceID;
+        final int dd = (adapter == null) ? this.deviceDescriptor : adapter.deviceDescriptor;
+        // Link may be created by other connection while this one waits in the queue
+        return new BluetoothStackBlueZConnectScheduler.ACLCheck() {
+            public boolean isConnected(long remoteAddress) {
+                long[] acl = getACLConnectionsImpl(dd, id);
+                if (acl != null) {
+                    for (int i = 0; i < acl.length; i++) {
+                        if (acl[i] == remoteAddress) {
+                            return true;
+                        }
+                    }
+                }
+                return false;
+            }
+        };
+    }
+
+    /**
+     * Wait for page slot of the adapter when connect scheduler is enabled.
+     * 
+     * @return null when scheduler is not used
+     */
+    private BluetoothStackBlueZConnectScheduler.Attempt scheduleConnect(BluetoothStackBlueZAdapter adapter, BluetoothConnectionParams params)
+            throws IOException {
+        if (connectScheduler == null) {
+            return null;
+        }
+        return connectScheduler.acquire((adapter == null) ? this.deviceID : adapter.deviceID, params.address, aclCheck(adapter), Thread
+                .currentThread().getPriority(), params.timeout);
+    }
+
+    private void releaseConnect(BluetoothStackBlueZConnectScheduler.Attempt attempt, boolean success) {
+        connectScheduler.release(attempt, success);
+        // Page slot may be free for queued openAsync connection
+        if (!asyncQueued.isEmpty()) {
+            connectionWakeup();
+        }
+    }
+
+    private void releaseAsyncConnect(long handle, boolean success) {
+        BluetoothStackBlueZConnectScheduler.Attempt attempt = (BluetoothStackBlueZConnectScheduler.Attempt) asyncAttempts.remove(new Long(handle));
+        if (attempt != null) {
+            releaseConnect(attempt, success);
+        }
+    }
+
+    /**
+     * Start openAsync connection when connect scheduler gives it page slot, the queued connection keeps its place
+     * until started or canceled.
+     * 
+     * @return connection handle, 0 when the connection waits in the scheduler queue
+     */
+    private long connectStart(BluetoothConnectionParams params, ConnectStart start) throws IOException {
+        BluetoothStackBlueZAdapter adapter;
+        BluetoothStackBlueZConnectScheduler.Attempt attempt = null;
+        if (connectScheduler == null) {
+            adapter = selectAdapter(params.address);
+        } else {
+            AsyncConnect queued = (AsyncConnect) asyncQueued.get(params);
+            if (queued == null) {
+                adapter = selectAdapter(params.address);
+                queued = new AsyncConnect(adapter, connectScheduler.enqueue((adapter == null) ? this.deviceID : adapter.deviceID, params.address,
+                        Thread.currentThread().getPriority(), params.timeout));
+                asyncQueued.put(params, queued);
+            }
+            if (!connectScheduler.tryAcquire(queued.attempt, aclCheck(queued.adapter))) {
+                return 0;
+            }
+            asyncQueued.remove(params);
+            adapter = queued.adapter;
+            attempt = queued.attempt;
+        }
+        long localAddress = (adapter == null) ? this.localDeviceBTAddress : adapter.address;
+        if (adapter != null) {
+            adapter.linkOpened();
+        }
+        boolean success = false;
+        try {
+            long handle = start.start(localAddress);
+            adapterLinkOpened(handle, adapter);
+            if (attempt != null) {
+                asyncAttempts.put(new Long(handle), attempt);
+            }
+            success = true;
+            return handle;
+        } finally {
+            if (!success) {
+                if (adapter != null) {
+                    adapter.linkClosed();
+                }
+                if (attempt != null) {
+                    releaseConnect(attempt, false);
+                }
+            }
+        }
+    }
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectAsync#connectionStartCancel(com.intel.bluetooth.BluetoothConnectionParams)
+     */
+    public void connectionStartCancel(BluetoothConnectionParams params) {
+        AsyncConnect queued = (AsyncConnect) asyncQueued.remove(params);
+        if (queued != null) {
+            connectScheduler.dequeue(queued.attempt);
+        }
+    }
+
     private native long connectionRfOpenClientConnectionImpl(long localDeviceBTAddress, long address, int channel, boolean authenticate, boolean encrypt,
-            int timeout) throws IOException;
+            int sndbuf, int rcvbuf, int timeout) throws IOException;
 
     public long connectionRfOpenClientConnection(BluetoothConnectionParams params) throws IOException {
-        return connectionRfOpenClientConnectionImpl(this.localDeviceBTAddress, params.address, params.channel, params.authenticate, params.encrypt,
-                params.timeout);
+        BluetoothStackBlueZAdapter adapter = selectAdapter(params.address);
+        BluetoothStackBlueZConnectScheduler.Attempt attempt = scheduleConnect(adapter, params);
+        long localAddress = (adapter == null) ? this.localDeviceBTAddress : adapter.address;
+        if (adapter != null) {
+            adapter.linkOpened();
+        }
+        boolean success = false;
+        try {
+            long handle = connectionRfOpenClientConnectionImpl(localAddress, params.address, params.channel, params.authenticate, params.encrypt,
+                    params.sndbuf, params.rcvbuf, (attempt == null) ? params.timeout : attempt.remainingTimeout());
+            adapterLinkOpened(handle, adapter);
+            success = true;
+            return handle;
+        } finally {
+            if ((!success) && (adapter != null)) {
+                adapter.linkClosed();
+            }
+            if (attempt != null) {
+                releaseConnect(attempt, success);
+            }
+        }
+    }
+
+    private native long connectionRfOpenClientConnectionStartImpl(long localDeviceBTAddress, long address, int channel, boolean authenticate,
+            boolean encrypt, int sndbuf, int rcvbuf) throws IOException;
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectAsync#connectionRfOpenClientConnectionStart(com.intel.bluetooth.BluetoothConnectionParams)
+     */
+    public long connectionRfOpenClientConnectionStart(final BluetoothConnectionParams params) throws IOException {
+        return connectStart(params, new ConnectStart() {
+            long start(long localAddress) throws IOException {
+                return connectionRfOpenClientConnectionStartImpl(localAddress, params.address, params.channel, params.authenticate, params.encrypt,
+                        params.sndbuf, params.rcvbuf);
+            }
+        });
     }
 
-    public native void connectionRfCloseClientConnection(long handle) throws IOException;
+    private native void connectionRfCloseClientConnectionImpl(long handle) throws IOException;
+
+    public void connectionRfCloseClientConnection(long handle) throws IOException {
+        releaseAsyncConnect(handle, false);
+        adapterLinkClosed(handle);
+        connectionRfCloseClientConnectionImpl(handle);
+    }
 
     public native int rfGetSecurityOptImpl(long handle) throws IOException;
 
@@ -593,18 +1103,19 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
     }
 
     private native long rfServerOpenImpl(long localDeviceBTAddress, boolean authorize, boolean authenticate, boolean encrypt, boolean master, boolean timeouts,
-            int backlog) throws IOException;
+            int backlog, int sndbuf, int rcvbuf) throws IOException;
 
     private native int rfServerGetChannelIDImpl(long handle) throws IOException;
 
     public long rfServerOpen(BluetoothConnectionNotifierParams params, ServiceRecordImpl serviceRecord) throws IOException {
         long socket = rfServerOpenImpl(this.localDeviceBTAddress, params.authorize, params.authenticate, params.encrypt, params.master, params.timeouts,
-                LISTEN_BACKLOG_RFCOMM);
+                LISTEN_BACKLOG_RFCOMM, params.sndbuf, params.rcvbuf);
         boolean success = false;
         try {
             int channel = rfServerGetChannelIDImpl(socket);
             serviceRecord.populateRFCOMMAttributes(0, channel, params.uuid, params.name, params.obex);
             registerSDPRecord(serviceRecord);
+            setServerBuffers(socket, params);
             success = true;
             return socket;
         } finally {
@@ -617,6 +1128,7 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
     private native void rfServerCloseImpl(long handle, boolean quietly) throws IOException;
 
     public void rfServerClose(long handle, ServiceRecordImpl serviceRecord) throws IOException {
+        serverBuffers.remove(new Long(handle));
         try {
             unregisterSDPRecord(serviceRecord);
         } finally {
@@ -628,7 +1140,11 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
         updateSDPRecord(serviceRecord);
     }
 
-    public native long rfServerAcceptAndOpenRfServerConnection(long handle) throws IOException;
+    private native long rfServerAcceptAndOpenRfServerConnectionImpl(long handle) throws IOException;
+
+    public long rfServerAcceptAndOpenRfServerConnection(long handle) throws IOException {
+        return acceptedConnectionBuffers(handle, rfServerAcceptAndOpenRfServerConnectionImpl(handle), false);
+    }
 
     public void connectionRfCloseServerConnection(long clientHandle) throws IOException {
         connectionRfCloseClientConnection(clientHandle);
@@ -647,16 +1163,93 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
 
     public native int connectionRfRead(long handle, byte[] b, int off, int len) throws IOException;
 
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackReadTimeout#connectionRfReadTimeout(long, byte[], int, int, int)
+     */
+    public native int connectionRfReadTimeout(long handle, byte[] b, int off, int len, int timeout) throws IOException;
+
     public native int connectionRfReadAvailable(long handle) throws IOException;
 
     public native void connectionRfWrite(long handle, int b) throws IOException;
 
     public native void connectionRfWrite(long handle, byte[] b, int off, int len) throws IOException;
 
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackWriteMore#connectionRfWriteMore(long, byte[], int, int, boolean)
+     */
+    public native void connectionRfWriteMore(long handle, byte[] b, int off, int len, boolean more) throws IOException;
+
     public native void connectionRfFlush(long handle) throws IOException;
 
     public native long getConnectionRfRemoteAddress(long handle) throws IOException;
 
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectionBuffers#connectionRfGetBufferSize(long)
+     */
+    public native int connectionRfGetBufferSize(long handle) throws IOException;
+
+    // --- Client connections in progress
+
+    private native long connectionWakeupOpenImpl() throws IOException;
+
+    private native void connectionWakeupImpl(long wakeup);
+
+    private native void connectionWakeupCloseImpl(long wakeup);
+
+    private native int connectionWaitImpl(long[] handles, int count, boolean[] ready, int wakeupFd, int timeout) throws IOException;
+
+    private native void connectionFinishImpl(long handle) throws IOException;
+
+    private synchronized long getConnectionWakeup() throws IOException {
+        if (connectionWakeup == 0) {
+            connectionWakeup = connectionWakeupOpenImpl();
+        }
+        return connectionWakeup;
+    }
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectAsync#connectionWait(long[], int, boolean[], int)
+     */
+    public int connectionWait(long[] handles, int count, boolean[] ready, int timeout) throws IOException {
+        return connectionWaitImpl(handles, count, ready, (int) (getConnectionWakeup() >> 32), timeout);
+    }
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectAsync#connectionWakeup()
+     */
+    public void connectionWakeup() {
+        try {
+            connectionWakeupImpl(getConnectionWakeup());
+        } catch (IOException e) {
+            DebugLog.error("connection wakeup", e);
+        }
+    }
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectAsync#connectionFinish(long)
+     */
+    public void connectionFinish(long handle) throws IOException {
+        boolean success = false;
+        try {
+            connectionFinishImpl(handle);
+            success = true;
+        } finally {
+            releaseAsyncConnect(handle, success);
+        }
+    }
+
     // --- Client and Server L2CAP connections
 
     private void validateMTU(int receiveMTU, int transmitMTU) {
@@ -666,7 +1259,7 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
     }
 
     private native long l2OpenClientConnectionImpl(long localDeviceBTAddress, long address, int channel, boolean authenticate, boolean encrypt, int receiveMTU,
-            int transmitMTU, int timeout) throws IOException;
+            int transmitMTU, int sndbuf, int rcvbuf, int flushTimeout, int mode, int txWindow, int fcs, int timeout) throws IOException;
 
     /*
      * (non-Javadoc)
@@ -676,19 +1269,64 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
      */
     public long l2OpenClientConnection(BluetoothConnectionParams params, int receiveMTU, int transmitMTU) throws IOException {
         validateMTU(receiveMTU, transmitMTU);
-        return l2OpenClientConnectionImpl(this.localDeviceBTAddress, params.address, params.channel, params.authenticate, params.encrypt, receiveMTU,
-                transmitMTU, params.timeout);
+        BluetoothStackBlueZAdapter adapter = selectAdapter(params.address);
+        BluetoothStackBlueZConnectScheduler.Attempt attempt = scheduleConnect(adapter, params);
+        long localAddress = (adapter == null) ? this.localDeviceBTAddress : adapter.address;
+        if (adapter != null) {
+            adapter.linkOpened();
+        }
+        boolean success = false;
+        try {
+            long handle = l2OpenClientConnectionImpl(localAddress, params.address, params.channel, params.authenticate, params.encrypt, receiveMTU,
+                    transmitMTU, params.sndbuf, params.rcvbuf, params.flushTimeout, params.l2capMode, params.txWindow, params.fcs,
+                    (attempt == null) ? params.timeout : attempt.remainingTimeout());
+            adapterLinkOpened(handle, adapter);
+            success = true;
+            return handle;
+        } finally {
+            if ((!success) && (adapter != null)) {
+                adapter.linkClosed();
+            }
+            if (attempt != null) {
+                releaseConnect(attempt, success);
+            }
+        }
+    }
+
+    private native long l2OpenClientConnectionStartImpl(long localDeviceBTAddress, long address, int channel, boolean authenticate, boolean encrypt,
+            int receiveMTU, int transmitMTU, int sndbuf, int rcvbuf, int flushTimeout, int mode, int txWindow, int fcs) throws IOException;
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackConnectAsync#l2OpenClientConnectionStart(com.intel.bluetooth.BluetoothConnectionParams, int, int)
+     */
+    public long l2OpenClientConnectionStart(final BluetoothConnectionParams params, final int receiveMTU, final int transmitMTU) throws IOException {
+        validateMTU(receiveMTU, transmitMTU);
+        return connectStart(params, new ConnectStart() {
+            long start(long localAddress) throws IOException {
+                return l2OpenClientConnectionStartImpl(localAddress, params.address, params.channel, params.authenticate, params.encrypt, receiveMTU,
+                        transmitMTU, params.sndbuf, params.rcvbuf, params.flushTimeout, params.l2capMode, params.txWindow, params.fcs);
+            }
+        });
     }
 
+    private native void l2CloseClientConnectionImpl(long handle) throws IOException;
+
     /*
      * (non-Javadoc)
      * 
      * @see com.intel.bluetooth.BluetoothStack#l2CloseClientConnection(long)
      */
-    public native void l2CloseClientConnection(long handle) throws IOException;
+    public void l2CloseClientConnection(long handle) throws IOException {
+        releaseAsyncConnect(handle, false);
+        adapterLinkClosed(handle);
+        l2CloseClientConnectionImpl(handle);
+    }
 
     private native long l2ServerOpenImpl(long localDeviceBTAddress, boolean authorize, boolean authenticate, boolean encrypt, boolean master, boolean timeouts,
-            int backlog, int receiveMTU, int transmitMTU, int assignPsm) throws IOException;
+            int backlog, int receiveMTU, int transmitMTU, int assignPsm, int sndbuf, int rcvbuf, int flushTimeout, int mode, int txWindow,
+            int fcs) throws IOException;
 
     public native int l2ServerGetPSMImpl(long handle) throws IOException;
 
@@ -701,12 +1339,14 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
     public long l2ServerOpen(BluetoothConnectionNotifierParams params, int receiveMTU, int transmitMTU, ServiceRecordImpl serviceRecord) throws IOException {
         validateMTU(receiveMTU, transmitMTU);
         long socket = l2ServerOpenImpl(this.localDeviceBTAddress, params.authorize, params.authenticate, params.encrypt, params.master, params.timeouts,
-                LISTEN_BACKLOG_L2CAP, receiveMTU, transmitMTU, params.bluecove_ext_psm);
+                LISTEN_BACKLOG_L2CAP, receiveMTU, transmitMTU, params.bluecove_ext_psm, params.sndbuf, params.rcvbuf, params.flushTimeout,
+                params.l2capMode, params.txWindow, params.fcs);
         boolean success = false;
         try {
             int channel = l2ServerGetPSMImpl(socket);
             serviceRecord.populateL2CAPAttributes(0, channel, params.uuid, params.name);
             registerSDPRecord(serviceRecord);
+            setServerBuffers(socket, params);
             success = true;
             return socket;
         } finally {
@@ -732,7 +1372,11 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
      * @see com.intel.bluetooth.BluetoothStack#l2ServerAcceptAndOpenServerConnection
      * (long)
      */
-    public native long l2ServerAcceptAndOpenServerConnection(long handle) throws IOException;
+    public long l2ServerAcceptAndOpenServerConnection(long handle) throws IOException {
+        return acceptedConnectionBuffers(handle, l2ServerAcceptAndOpenServerConnectionImpl(handle), true);
+    }
+
+    private native long l2ServerAcceptAndOpenServerConnectionImpl(long handle) throws IOException;
 
     /*
      * (non-Javadoc)
@@ -752,6 +1396,7 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
      * com.intel.bluetooth.ServiceRecordImpl)
      */
     public void l2ServerClose(long handle, ServiceRecordImpl serviceRecord) throws IOException {
+        serverBuffers.remove(new Long(handle));
         try {
             unregisterSDPRecord(serviceRecord);
         } finally {
@@ -773,6 +1418,13 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
      */
     public native int l2Receive(long handle, byte[] inBuf) throws IOException;
 
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackReadTimeout#l2ReceiveTimeout(long, byte[], int)
+     */
+    public native int l2ReceiveTimeout(long handle, byte[] inBuf, int timeout) throws IOException;
+
     /*
      * (non-Javadoc)
      * 
@@ -794,6 +1446,27 @@ class BluetoothStackBlueZ implements BluetoothStack, BluetoothStackExtension {
      */
     public native int l2GetTransmitMTU(long handle) throws IOException;
 
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackL2CAPMode#l2GetMode(long)
+     */
+    public native int l2GetMode(long handle) throws IOException;
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackL2CAPMode#l2GetTransmitWindow(long)
+     */
+    public native int l2GetTransmitWindow(long handle) throws IOException;
+
+    /*
+     * (non-Javadoc)
+     * 
+     * @see com.intel.bluetooth.BluetoothStackL2CAPMode#l2GetFCS(long)
+     */
+    public native boolean l2GetFCS(long handle) throws IOException;
+
     /*
      * (non-Javadoc)
      * 
@@ -0,0 +1,96 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2009 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+package com.intel.bluetooth;
+
+/**
+ * Local Bluetooth adapter in the pool used by BlueZ stack when
+ * "bluecove.bluez.adapter_pool" is enabled.
+ * 
+ * @see BluetoothStackBlueZAdapterPolicy
+ */
+public final class BluetoothStackBlueZAdapter {
+
+    final int deviceID;
+
+    final int deviceDescriptor;
+
+    final long address;
+
+    private final BluetoothStackBlueZ stack;
+
+    private int linkCount;
+
+    BluetoothStackBlueZAdapter(BluetoothStackBlueZ stack, int deviceID, int deviceDescriptor, long address) {
+        this.stack = stack;
+        this.deviceID = deviceID;
+        this.deviceDescriptor = deviceDescriptor;
+        this.address = address;
+    }
+
+    /**
+     * @return BlueZ device ID, N in "hciN"
+     */
+    public int getDeviceID() {
+        return deviceID;
+    }
+
+    /**
+     * @return Bluetooth address of the adapter
+     */
+    public long getAddress() {
+        return address;
+    }
+
+    /**
+     * @return number of RFCOMM and L2CAP client connections and service
+     *         searches BlueCove is running on this adapter
+     */
+    public synchronized int getLinkCount() {
+        return linkCount;
+    }
+
+    /**
+     * Ask the kernel for ACL links of the adapter, include links created by
+     * other applications.
+     * 
+     * @return addresses of remote devices connected to this adapter
+     */
+    public long[] getACLConnections() {
+        long[] connections = stack.getACLConnectionsImpl(deviceDescriptor, deviceID);
+        if (connections == null) {
+            return new long[0];
+        }
+        return connections;
+    }
+
+    synchronized void linkOpened() {
+        linkCount++;
+    }
+
+    synchronized void linkClosed() {
+        if (linkCount > 0) {
+            linkCount--;
+        }
+    }
+
+    public String toString() {
+        return "hci" + deviceID + " " + RemoteDeviceHelper.getBluetoothAddress(address) + " links " + getLinkCount();
+    }
+}
@@ -0,0 +1,41 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2009 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+package com.intel.bluetooth;
+
+/**
+ * Selects local adapter for client connection and service search when
+ * "bluecove.bluez.adapter_pool" is enabled. Implementation is created by name
+ * from "bluecove.bluez.adapter_policy" and should have public default
+ * constructor.
+ * <p>
+ * Called concurrently from threads opening connections.
+ */
+public interface BluetoothStackBlueZAdapterPolicy {
+
+    /**
+     * @param adapters
+     *            all adapters in the pool, the first one is the adapter the
+     *            stack was initialized with
+     * @param remoteDeviceAddress
+     *            device to connect to
+     * @return index of the adapter in <code>adapters</code>
+     */
+    public int selectAdapter(BluetoothStackBlueZAdapter[] adapters, long remoteDeviceAddress);
+}
@@ -0,0 +1,270 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2009 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.util.Vector;
+
+import javax.bluetooth.BluetoothConnectionException;
+
+/**
+ * Queue of client connections waiting for the adapter to page remote device. The controller pages one device at a
+ * time, connections above the limit wait here instead of in the kernel. Devices already connected with ACL link
+ * are not paged and do not wait.
+ * <p>
+ * Waiting connections are served by thread priority, then by deadline, then in order of arrival.
+ */
+class BluetoothStackBlueZConnectScheduler {
+
+    /**
+     * ACL link may be created by other connection while waiting, it is checked again at this interval.
+     */
+    private static final int ACL_CHECK_INTERVAL = 1000;
+
+    /**
+     * Ask the adapter if it has ACL link to the remote device.
+     */
+    interface ACLCheck {
+
+        boolean isConnected(long remoteAddress);
+    }
+
+    static class Attempt {
+
+        final int deviceID;
+
+        final long remoteAddress;
+
+        boolean paging;
+
+        final int priority;
+
+        final long deadline;
+
+        final long sequence;
+
+        final long queued;
+
+        long started;
+
+        Attempt(int deviceID, long remoteAddress, boolean paging, int priority, long deadline, long sequence) {
+            this.deviceID = deviceID;
+            this.remoteAddress = remoteAddress;
+            this.paging = paging;
+            this.priority = priority;
+            this.deadline = deadline;
+            this.sequence = sequence;
+            this.queued = System.currentTimeMillis();
+        }
+
+        /**
+         * @return connect timeout left after waiting in the queue, 0 if there is no deadline
+         */
+        int remainingTimeout() {
+            if (deadline == 0) {
+                return 0;
+            }
+            return (int) Math.max(1, deadline - System.currentTimeMillis());
+        }
+
+        boolean before(Attempt other) {
+            if (priority != other.priority) {
+                return priority > other.priority;
+            }
+            if (deadline != other.deadline) {
+                if (deadline == 0) {
+                    return false;
+                } else if (other.deadline == 0) {
+                    return true;
+                }
+                return deadline < other.deadline;
+            }
+            return sequence < other.sequence;
+        }
+    }
+
+    private final int pagesMax;
+
+    private final Vector/* <Attempt> */waiting = new Vector();
+
+    private final Vector/* <Attempt> */paging = new Vector();
+
+    private long sequence;
+
+    private int attempts;
+
+    private int failed;
+
+    /**
+     * Deadline expired while waiting in the queue
+     */
+    private int expired;
+
+    private long queueTimeTotal;
+
+    private long queueTimeMax;
+
+    private long connectTimeTotal;
+
+    private long connectTimeMax;
+
+    BluetoothStackBlueZConnectScheduler(int pagesMax) {
+        this.pagesMax = pagesMax;
+    }
+
+    private int pagingCount(int deviceID) {
+        int count = 0;
+        for (int i = 0; i < paging.size(); i++) {
+            if (((Attempt) paging.elementAt(i)).deviceID == deviceID) {
+                count++;
+            }
+        }
+        return count;
+    }
+
+    private boolean isFirst(Attempt attempt) {
+        for (int i = 0; i < waiting.size(); i++) {
+            Attempt other = (Attempt) waiting.elementAt(i);
+            if ((other != attempt) && (other.deviceID == attempt.deviceID) && other.before(attempt)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * Put the connection in the queue, it waits for page slot until tryAcquire returns true or dequeue is called.
+     * 
+     * @param timeout
+     *            connect timeout in milliseconds, 0 for no deadline
+     */
+    synchronized Attempt enqueue(int deviceID, long remoteAddress, int priority, int timeout) {
+        long deadline = (timeout > 0) ? (System.currentTimeMillis() + timeout) : 0;
+        Attempt attempt = new Attempt(deviceID, remoteAddress, true, priority, deadline, sequence++);
+        waiting.addElement(attempt);
+        return attempt;
+    }
+
+    /**
+     * Take page slot for queued connection without waiting. When adapter has ACL link to the device connection
+     * starts immediately.
+     * 
+     * @return true when the connection can start, it is removed from the queue and should be released
+     */
+    synchronized boolean tryAcquire(Attempt attempt, ACLCheck aclCheck) {
+        if (aclCheck.isConnected(attempt.remoteAddress)) {
+            attempt.paging = false;
+        } else if ((pagingCount(attempt.deviceID) >= pagesMax) || !isFirst(attempt)) {
+            return false;
+        }
+        waiting.removeElement(attempt);
+        // Next one may be allowed now
+        notifyAll();
+        if (attempt.paging) {
+            paging.addElement(attempt);
+        }
+        attempt.started = System.currentTimeMillis();
+        return true;
+    }
+
+    /**
+     * Remove connection that did not get page slot from the queue.
+     */
+    synchronized void dequeue(Attempt attempt) {
+        if (waiting.removeElement(attempt)) {
+            if ((attempt.deadline != 0) && (attempt.deadline <= System.currentTimeMillis())) {
+                expired++;
+            }
+            notifyAll();
+        }
+    }
+
+    /**
+     * Wait until the adapter can page the device.
+     * 
+     * @param aclCheck
+     *            called before each wait, when adapter has ACL link to the device connection starts immediately
+     * @param timeout
+     *            connect timeout in milliseconds, 0 for no deadline
+     */
+    synchronized Attempt acquire(int deviceID, long remoteAddress, ACLCheck aclCheck, int priority, int timeout) throws IOException {
+        Attempt attempt = enqueue(deviceID, remoteAddress, priority, timeout);
+        boolean acquired = false;
+        try {
+            while (!tryAcquire(attempt, aclCheck)) {
+                long wait = ACL_CHECK_INTERVAL;
+                if (attempt.deadline != 0) {
+                    wait = Math.min(wait, attempt.deadline - System.currentTimeMillis());
+                    if (wait <= 0) {
+                        throw new BluetoothConnectionException(BluetoothConnectionException.TIMEOUT, "Connection timeout, " + waiting.size()
+                                + " connections waiting for page");
+                    }
+                }
+                try {
+                    wait(wait);
+                } catch (InterruptedException e) {
+                    throw new InterruptedIOException();
+                }
+            }
+            acquired = true;
+        } finally {
+            if (!acquired) {
+                dequeue(attempt);
+            }
+        }
+        return attempt;
+    }
+
+    synchronized void release(Attempt attempt, boolean success) {
+        long now = System.currentTimeMillis();
+        long queueTime = attempt.started - attempt.queued;
+        long connectTime = now - attempt.started;
+        if (attempt.paging) {
+            paging.removeElement(attempt);
+            notifyAll();
+        }
+        attempts++;
+        if (!success) {
+            failed++;
+        }
+        queueTimeTotal += queueTime;
+        connectTimeTotal += connectTime;
+        queueTimeMax = Math.max(queueTimeMax, queueTime);
+        connectTimeMax = Math.max(connectTimeMax, connectTime);
+        DebugLog.debug("connect " + RemoteDeviceHelper.getBluetoothAddress(attempt.remoteAddress) + " hci" + attempt.deviceID
+                + (attempt.paging ? " page" : " acl") + (success ? " connected" : " failed") + " queue " + queueTime + " msec connect "
+                + connectTime + " msec");
+    }
+
+    synchronized String getStatistics() {
+        StringBuffer b = new StringBuffer();
+        b.append("attempts=").append(attempts);
+        b.append(",failed=").append(failed);
+        b.append(",expired=").append(expired);
+        b.append(",waiting=").append(waiting.size());
+        b.append(",paging=").append(paging.size());
+        b.append(",queue_avg=").append((attempts == 0) ? 0 : queueTimeTotal / attempts);
+        b.append(",queue_max=").append(queueTimeMax);
+        b.append(",connect_avg=").append((attempts == 0) ? 0 : connectTimeTotal / attempts);
+        b.append(",connect_max=").append(connectTimeMax);
+        return b.toString();
+    }
+}
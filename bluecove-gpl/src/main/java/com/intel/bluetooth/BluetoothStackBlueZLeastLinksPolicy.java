@@ -0,0 +1,49 @@
+/**
+ * BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2009 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * @version $Id$
+ */
+package com.intel.bluetooth;
+
+/**
+ * Default adapter pool policy. Reuse adapter already having ACL link to the
+ * remote device, no paging is needed for it. Otherwise select adapter with the
+ * least ACL links then the least BlueCove connections.
+ */
+class BluetoothStackBlueZLeastLinksPolicy implements BluetoothStackBlueZAdapterPolicy {
+
+    public int selectAdapter(BluetoothStackBlueZAdapter[] adapters, long remoteDeviceAddress) {
+        int selected = 0;
+        int selectedACL = Integer.MAX_VALUE;
+        int selectedLinks = Integer.MAX_VALUE;
+        for (int i = 0; i < adapters.length; i++) {
+            long[] acl = adapters[i].getACLConnections();
+            for (int k = 0; k < acl.length; k++) {
+                if (acl[k] == remoteDeviceAddress) {
+                    return i;
+                }
+            }
+            int links = adapters[i].getLinkCount();
+            if ((acl.length < selectedACL) || ((acl.length == selectedACL) && (links < selectedLinks))) {
+                selected = i;
+                selectedACL = acl.length;
+                selectedLinks = links;
+            }
+        }
+        return selected;
+    }
+}
@@ -1,35 +1,78 @@
-/**
- *  BlueCove BlueZ module - Java library for Bluetooth on Linux
- *  Copyright (C) 2008 Mina Shokry
- *  Copyright (C) 2007 Vlad Skarzhevskyy
- *
- * This program is free software: you can redistribute it and/or modify
- * it under the terms of the GNU General Public License as published by
- * the Free Software Foundation, either version 3 of the License, or
- * (at your option) any later version.
- *
- * This program is distributed in the hope that it will be useful,
- * but WITHOUT ANY WARRANTY; without even the implied warranty of
- * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
- * GNU General Public License for more details.
- *
- *  You should have received a copy of the GNU General Public License
- *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
- *
- *  @author vlads
- *  @version $Id: BluetoothStackBlueZ.java 1562 2008-01-16 18:31:25Z skarzhevskyy $
- */
-package com.intel.bluetooth;
-
-/**
- *
- *
- */
-public class BluetoothStackBlueZNativeTests {
-
-	static native void testThrowException(int type) throws Exception;
-
-	static native void testDebug(int argc, String message);
-
-	static native byte[] testServiceRecordConvert(byte[] record);
-}
+/**
+ *  BlueCove BlueZ module - Java library for Bluetooth on Linux
+ *  Copyright (C) 2008 Mina Shokry
+ *  Copyright (C) 2007 Vlad Skarzhevskyy
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  @author vlads
+ *  @version $Id: BluetoothStackBlueZ.java 1562 2008-01-16 18:31:25Z skarzhevskyy $
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ *
+ *
+ */
+public class BluetoothStackBlueZNativeTests {
+
+	static native void testThrowException(int type) throws Exception;
+
+	static native void testDebug(int argc, String message);
+
+	static native byte[] testServiceRecordConvert(byte[] record);
+
+	/**
+	 * Same as testServiceRecordConvert but uses sdp_extract_pdu from libbluetooth
+	 */
+	static native byte[] testServiceRecordConvertBlueZ(byte[] record);
+
+	/**
+	 * @return IDs of changed or added attributes followed by IDs of removed attributes with 0x10000 flag
+	 */
+	static native int[] testServiceRecordDiff(byte[] oldRecord, byte[] newRecord);
+
+	/**
+	 * Replaces local SDP server with in memory stand-in until testSDPMockClose.
+	 * 
+	 * @param roundTrip
+	 *            microseconds each request takes, like round trip to sdpd
+	 * @param failAt
+	 *            number of register request that fails, 0 for none
+	 */
+	static native void testSDPMockOpen(int roundTrip, int failAt);
+
+	/**
+	 * @return number of records registered in SDP server stand-in
+	 */
+	static native int testSDPMockRecords();
+
+	static native void testSDPMockClose();
+
+	/**
+	 * Creates SEQPACKET socket pair with mocked L2CAP_OPTIONS instead of L2CAP sockets, options of other sockets
+	 * are not accessible until testL2CAPMockClose.
+	 * 
+	 * @param ertm
+	 *            false to reject Enhanced Retransmission and Streaming modes like kernel with disable_ertm
+	 */
+	static native long[] testL2CAPMockOpen(boolean ertm) throws IOException;
+
+	static native void testL2CAPSetOptions(long handle, int receiveMTU, int transmitMTU, int mode, int txWindow, int fcs)
+			throws IOException;
+
+	static native void testL2CAPMockClose();
+}
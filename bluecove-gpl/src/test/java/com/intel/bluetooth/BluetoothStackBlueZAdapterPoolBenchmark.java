@@ -0,0 +1,118 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import junit.framework.TestCase;
+
+import com.intel.bluetooth.BluetoothStackBlueZLeastLinksPolicyTest.ACLStack;
+
+/**
+ * Simulated transfers from concurrent clients on adapter pool of 1, 2 and 4 dongles, prints aggregate throughput.
+ * 
+ * Each dongle radio serves one transfer chunk at a time, clients select the dongle using
+ * BluetoothStackBlueZLeastLinksPolicy the same way client connections do.
+ */
+public class BluetoothStackBlueZAdapterPoolBenchmark extends TestCase {
+
+	private static final int CLIENTS = 8;
+
+	private static final int TRANSFERS = 5;
+
+	private static final int CHUNKS = 10;
+
+	private static final int CHUNK_SIZE = 1000;
+
+	// 1000 bytes in 5 msec is close to EDR RFCOMM data rate
+	private static final int CHUNK_TIME = 5;
+
+	private static long runClients(int dongles) throws InterruptedException {
+		final ACLStack stack = new ACLStack();
+		final BluetoothStackBlueZAdapter[] adapters = BluetoothStackBlueZLeastLinksPolicyTest.createAdapters(stack,
+				dongles);
+		final BluetoothStackBlueZAdapterPolicy policy = new BluetoothStackBlueZLeastLinksPolicy();
+		final Object[] radios = new Object[dongles];
+		for (int i = 0; i < dongles; i++) {
+			radios[i] = new Object();
+		}
+		final Throwable[] failure = new Throwable[1];
+		Thread[] threads = new Thread[CLIENTS];
+		for (int i = 0; i < CLIENTS; i++) {
+			final long remote = 0x0019639C5C00L + i;
+			threads[i] = new Thread() {
+				public void run() {
+					try {
+						for (int t = 0; t < TRANSFERS; t++) {
+							int selected;
+							BluetoothStackBlueZAdapter adapter;
+							synchronized (policy) {
+								selected = policy.selectAdapter(adapters, remote);
+								adapter = adapters[selected];
+								adapter.linkOpened();
+								stack.connect(adapter.getDeviceID(), remote);
+							}
+							try {
+								for (int c = 0; c < CHUNKS; c++) {
+									synchronized (radios[selected]) {
+										Thread.sleep(CHUNK_TIME);
+									}
+								}
+							} finally {
+								synchronized (policy) {
+									stack.disconnect(adapter.getDeviceID(), remote);
+									adapter.linkClosed();
+								}
+							}
+						}
+					} catch (Throwable e) {
+						failure[0] = e;
+					}
+				}
+			};
+		}
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < CLIENTS; i++) {
+			threads[i].start();
+		}
+		for (int i = 0; i < CLIENTS; i++) {
+			threads[i].join();
+		}
+		long time = System.currentTimeMillis() - start;
+		if (failure[0] != null) {
+			fail("client failed " + failure[0]);
+		}
+		return time;
+	}
+
+	public void testAggregateThroughput() throws Exception {
+		int[] dongles = { 1, 2, 4 };
+		long bytes = (long) CLIENTS * TRANSFERS * CHUNKS * CHUNK_SIZE;
+		for (int i = 0; i < dongles.length; i++) {
+			long time = runClients(dongles[i]);
+			System.out.println("Adapter pool " + dongles[i] + " dongles, " + CLIENTS + " clients: " + time + " msec, "
+					+ ((time == 0) ? bytes : (bytes * 1000) / time) + " bytes/s");
+		}
+	}
+}
@@ -0,0 +1,264 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.util.Vector;
+
+import javax.bluetooth.BluetoothConnectionException;
+
+import junit.framework.TestCase;
+
+/**
+ * Page queue of BlueZ client connections, ACL links are reported by the test.
+ */
+public class BluetoothStackBlueZConnectSchedulerTest extends TestCase {
+
+	private static final long REMOTE = 0x0019639C5C41L;
+
+	private static final int PRIORITY = Thread.NORM_PRIORITY;
+
+	/**
+	 * Remote devices with ACL link, shared by all adapters.
+	 */
+	private static class TestACL implements BluetoothStackBlueZConnectScheduler.ACLCheck {
+
+		private final Vector/* <Long> */connected = new Vector();
+
+		void connect(long remoteAddress) {
+			connected.addElement(new Long(remoteAddress));
+		}
+
+		public boolean isConnected(long remoteAddress) {
+			return connected.contains(new Long(remoteAddress));
+		}
+	}
+
+	/**
+	 * Connection waiting in the queue on separate thread.
+	 */
+	private class Waiter extends Thread {
+
+		final int deviceID;
+
+		final long remoteAddress;
+
+		final int priority;
+
+		final int timeout;
+
+		BluetoothStackBlueZConnectScheduler.Attempt attempt;
+
+		IOException error;
+
+		boolean releaseOnAcquire = false;
+
+		Waiter(int deviceID, long remoteAddress, int priority, int timeout) {
+			this.deviceID = deviceID;
+			this.remoteAddress = remoteAddress;
+			this.priority = priority;
+			this.timeout = timeout;
+			setDaemon(true);
+		}
+
+		public void run() {
+			try {
+				BluetoothStackBlueZConnectScheduler.Attempt a = scheduler.acquire(deviceID, remoteAddress, acl,
+						priority, timeout);
+				synchronized (acquired) {
+					attempt = a;
+					acquired.addElement(this);
+				}
+				if (releaseOnAcquire) {
+					scheduler.release(a, true);
+				}
+			} catch (IOException e) {
+				error = e;
+			}
+		}
+
+		Waiter started() throws InterruptedException {
+			int queued = waitingCount();
+			start();
+			waitFor("waiting=" + (queued + 1));
+			return this;
+		}
+	}
+
+	private BluetoothStackBlueZConnectScheduler scheduler;
+
+	private TestACL acl;
+
+	private final Vector/* <Waiter> */acquired = new Vector();
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		scheduler = new BluetoothStackBlueZConnectScheduler(1);
+		acl = new TestACL();
+	}
+
+	private int waitingCount() {
+		String stat = scheduler.getStatistics();
+		int start = stat.indexOf("waiting=") + "waiting=".length();
+		return Integer.parseInt(stat.substring(start, stat.indexOf(',', start)));
+	}
+
+	private void waitFor(String statistics) throws InterruptedException {
+		long end = System.currentTimeMillis() + 5000;
+		while (scheduler.getStatistics().indexOf(statistics) == -1) {
+			if (System.currentTimeMillis() > end) {
+				fail("expected " + statistics + " in " + scheduler.getStatistics());
+			}
+			Thread.sleep(10);
+		}
+	}
+
+	public void testPageLimitPerAdapter() throws Exception {
+		BluetoothStackBlueZConnectScheduler.Attempt a1 = scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		assertTrue("paging", a1.paging);
+		BluetoothStackBlueZConnectScheduler.Attempt a2 = scheduler.acquire(1, REMOTE + 1, acl, PRIORITY, 0);
+		assertTrue("other adapter not limited", a2.paging);
+
+		Waiter w = new Waiter(0, REMOTE + 2, PRIORITY, 0).started();
+		Thread.sleep(100);
+		assertNull("waits for page slot", w.attempt);
+		scheduler.release(a2, true);
+		Thread.sleep(100);
+		assertNull("waits for page slot on its adapter", w.attempt);
+		scheduler.release(a1, true);
+		w.join(5000);
+		assertNotNull("acquired", w.attempt);
+		assertTrue("paging", w.attempt.paging);
+		assertTrue(scheduler.getStatistics().indexOf("waiting=0,paging=1") != -1);
+	}
+
+	public void testOrder() throws Exception {
+		BluetoothStackBlueZConnectScheduler.Attempt a = scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		Waiter fifo1 = new Waiter(0, REMOTE + 1, PRIORITY, 0);
+		Waiter late = new Waiter(0, REMOTE + 2, PRIORITY, 20000);
+		Waiter early = new Waiter(0, REMOTE + 3, PRIORITY, 10000);
+		Waiter high = new Waiter(0, REMOTE + 4, PRIORITY + 1, 0);
+		Waiter fifo2 = new Waiter(0, REMOTE + 5, PRIORITY, 0);
+		Waiter[] all = new Waiter[] { fifo1, late, early, high, fifo2 };
+		for (int i = 0; i < all.length; i++) {
+			all[i].releaseOnAcquire = true;
+			all[i].started();
+		}
+		scheduler.release(a, true);
+		for (int i = 0; i < all.length; i++) {
+			all[i].join(5000);
+		}
+		Waiter[] expected = new Waiter[] { high, early, late, fifo1, fifo2 };
+		assertEquals("acquired", expected.length, acquired.size());
+		for (int i = 0; i < expected.length; i++) {
+			assertSame("acquired " + i, expected[i], acquired.elementAt(i));
+		}
+	}
+
+	public void testExpiredInQueue() throws Exception {
+		scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		long start = System.currentTimeMillis();
+		try {
+			scheduler.acquire(0, REMOTE + 1, acl, PRIORITY, 200);
+			fail("page slot is not released");
+		} catch (BluetoothConnectionException e) {
+			assertEquals(BluetoothConnectionException.TIMEOUT, e.getStatus());
+		}
+		assertTrue("timeout applied", System.currentTimeMillis() - start >= 150);
+		assertTrue(scheduler.getStatistics().indexOf("expired=1,waiting=0,paging=1") != -1);
+	}
+
+	public void testInterrupted() throws Exception {
+		scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		Waiter w = new Waiter(0, REMOTE + 1, PRIORITY, 0).started();
+		w.interrupt();
+		w.join(5000);
+		assertTrue("interrupted", w.error instanceof InterruptedIOException);
+		assertNull(w.attempt);
+		assertTrue(scheduler.getStatistics().indexOf("waiting=0,paging=1") != -1);
+	}
+
+	public void testACLBypass() throws Exception {
+		scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		acl.connect(REMOTE + 1);
+		BluetoothStackBlueZConnectScheduler.Attempt a = scheduler.acquire(0, REMOTE + 1, acl, PRIORITY, 0);
+		assertFalse("not paging", a.paging);
+		assertTrue(scheduler.getStatistics().indexOf("waiting=0,paging=1") != -1);
+		scheduler.release(a, true);
+		assertTrue("page slot not released", scheduler.getStatistics().indexOf("paging=1") != -1);
+	}
+
+	public void testACLCreatedWhileWaiting() throws Exception {
+		scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		Waiter w = new Waiter(0, REMOTE + 1, PRIORITY, 0).started();
+		acl.connect(REMOTE + 1);
+		w.join(5000);
+		assertNotNull("acquired", w.attempt);
+		assertFalse("not paging", w.attempt.paging);
+		assertTrue(scheduler.getStatistics().indexOf("waiting=0,paging=1") != -1);
+	}
+
+	public void testAsyncQueued() throws Exception {
+		BluetoothStackBlueZConnectScheduler.Attempt a = scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		BluetoothStackBlueZConnectScheduler.Attempt queued = scheduler.enqueue(0, REMOTE + 1, PRIORITY, 0);
+		assertFalse("waits for page slot", scheduler.tryAcquire(queued, acl));
+		Waiter w = new Waiter(0, REMOTE + 2, PRIORITY, 0).started();
+		scheduler.release(a, true);
+		Thread.sleep(100);
+		assertNull("queued before", w.attempt);
+		assertTrue("acquired", scheduler.tryAcquire(queued, acl));
+		assertTrue("paging", queued.paging);
+		assertTrue(scheduler.getStatistics().indexOf("waiting=1,paging=1") != -1);
+		scheduler.release(queued, true);
+		w.join(5000);
+		assertNotNull("acquired after release", w.attempt);
+	}
+
+	public void testAsyncDequeue() throws Exception {
+		scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		BluetoothStackBlueZConnectScheduler.Attempt canceled = scheduler.enqueue(0, REMOTE + 1, PRIORITY, 0);
+		BluetoothStackBlueZConnectScheduler.Attempt expired = scheduler.enqueue(0, REMOTE + 2, PRIORITY, 100);
+		scheduler.dequeue(canceled);
+		Thread.sleep(150);
+		scheduler.dequeue(expired);
+		assertTrue(scheduler.getStatistics().indexOf("expired=1,waiting=0,paging=1") != -1);
+	}
+
+	public void testStatistics() throws Exception {
+		assertEquals("attempts=0,failed=0,expired=0,waiting=0,paging=0,queue_avg=0,queue_max=0,connect_avg=0,connect_max=0",
+				scheduler.getStatistics());
+		BluetoothStackBlueZConnectScheduler.Attempt a1 = scheduler.acquire(0, REMOTE, acl, PRIORITY, 0);
+		scheduler.release(a1, true);
+		BluetoothStackBlueZConnectScheduler.Attempt a2 = scheduler.acquire(0, REMOTE + 1, acl, PRIORITY, 0);
+		Thread.sleep(50);
+		scheduler.release(a2, false);
+		String stat = scheduler.getStatistics();
+		assertTrue(stat, stat.startsWith("attempts=2,failed=1,expired=0,waiting=0,paging=0,queue_avg="));
+		int start = stat.indexOf("connect_max=") + "connect_max=".length();
+		assertTrue(stat, Long.parseLong(stat.substring(start)) >= 40);
+	}
+}
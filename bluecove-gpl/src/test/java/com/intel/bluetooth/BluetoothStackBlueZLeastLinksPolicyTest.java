@@ -0,0 +1,148 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.util.Hashtable;
+import java.util.Vector;
+
+import junit.framework.TestCase;
+
+/**
+ * Adapter selection of the "bluecove.bluez.adapter_pool" default policy, ACL links are reported by test stack so
+ * no adapter is required.
+ */
+public class BluetoothStackBlueZLeastLinksPolicyTest extends TestCase {
+
+	private static final long REMOTE = 0x0019639C5C41L;
+
+	/**
+	 * Stack reporting ACL links registered by test.
+	 */
+	static class ACLStack extends BluetoothStackBlueZ {
+
+		private final Hashtable/* <Integer, Vector<Long>> */acl = new Hashtable();
+
+		synchronized void connect(int deviceID, long address) {
+			Integer key = new Integer(deviceID);
+			Vector links = (Vector) acl.get(key);
+			if (links == null) {
+				links = new Vector();
+				acl.put(key, links);
+			}
+			links.addElement(new Long(address));
+		}
+
+		synchronized void disconnect(int deviceID, long address) {
+			Vector links = (Vector) acl.get(new Integer(deviceID));
+			if (links != null) {
+				links.removeElement(new Long(address));
+			}
+		}
+
+		synchronized long[] getACLConnectionsImpl(int deviceDescriptor, int deviceID) {
+			Vector links = (Vector) acl.get(new Integer(deviceID));
+			if (links == null) {
+				return null;
+			}
+			long[] connections = new long[links.size()];
+			for (int i = 0; i < connections.length; i++) {
+				connections[i] = ((Long) links.elementAt(i)).longValue();
+			}
+			return connections;
+		}
+	}
+
+	static BluetoothStackBlueZAdapter[] createAdapters(ACLStack stack, int count) {
+		BluetoothStackBlueZAdapter[] adapters = new BluetoothStackBlueZAdapter[count];
+		for (int i = 0; i < count; i++) {
+			adapters[i] = new BluetoothStackBlueZAdapter(stack, i, 100 + i, 0x001122334400L + i);
+		}
+		return adapters;
+	}
+
+	private ACLStack stack;
+
+	private BluetoothStackBlueZAdapter[] adapters;
+
+	private BluetoothStackBlueZAdapterPolicy policy;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		stack = new ACLStack();
+		adapters = createAdapters(stack, 3);
+		policy = new BluetoothStackBlueZLeastLinksPolicy();
+	}
+
+	public void testNoLinks() {
+		assertEquals("first adapter", 0, policy.selectAdapter(adapters, REMOTE));
+	}
+
+	public void testExistingACLLink() {
+		stack.connect(2, REMOTE);
+		stack.connect(2, REMOTE + 1);
+		adapters[2].linkOpened();
+		assertEquals("adapter connected to remote device", 2, policy.selectAdapter(adapters, REMOTE));
+	}
+
+	public void testLeastACLLinks() {
+		stack.connect(0, REMOTE + 1);
+		stack.connect(0, REMOTE + 2);
+		stack.connect(2, REMOTE + 3);
+		adapters[1].linkOpened();
+		adapters[1].linkOpened();
+		assertEquals("adapter with least ACL links", 1, policy.selectAdapter(adapters, REMOTE));
+	}
+
+	public void testLeastLinkCountOnEqualACL() {
+		stack.connect(0, REMOTE + 1);
+		stack.connect(1, REMOTE + 2);
+		stack.connect(2, REMOTE + 3);
+		adapters[0].linkOpened();
+		adapters[0].linkOpened();
+		adapters[2].linkOpened();
+		assertEquals("adapter with least links", 1, policy.selectAdapter(adapters, REMOTE));
+		adapters[1].linkOpened();
+		adapters[1].linkOpened();
+		assertEquals("adapter with least links", 2, policy.selectAdapter(adapters, REMOTE));
+	}
+
+	public void testLinkClosed() {
+		adapters[0].linkOpened();
+		adapters[1].linkOpened();
+		assertEquals(2, policy.selectAdapter(adapters, REMOTE));
+		adapters[0].linkClosed();
+		assertEquals(0, policy.selectAdapter(adapters, REMOTE));
+		adapters[0].linkClosed();
+		assertEquals("link count is not negative", 0, adapters[0].getLinkCount());
+	}
+
+	public void testACLDisconnected() {
+		stack.connect(1, REMOTE);
+		assertEquals(1, policy.selectAdapter(adapters, REMOTE));
+		stack.disconnect(1, REMOTE);
+		assertEquals(0, policy.selectAdapter(adapters, REMOTE));
+	}
+}
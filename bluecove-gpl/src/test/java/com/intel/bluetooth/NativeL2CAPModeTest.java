@@ -0,0 +1,136 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * L2CAP channel mode options set by client and server connections, using SEQPACKET socket pair with mocked
+ * L2CAP_OPTIONS so no adapter is required.
+ */
+public class NativeL2CAPModeTest extends NativeTestCase {
+
+	private BluetoothStackBlueZ stack;
+
+	private long[] handles;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		stack = new BluetoothStackBlueZ();
+	}
+
+	protected void tearDown() throws Exception {
+		if (handles != null) {
+			BluetoothStackBlueZNativeTests.testL2CAPMockClose();
+			handles = null;
+		}
+		super.tearDown();
+	}
+
+	public void testBasicMode() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[0], 1024, 0, L2CAPModeConnection.MODE_BASIC, 0,
+				BluetoothConsts.L2CAP_FCS_CRC16);
+		assertEquals("mode", L2CAPModeConnection.MODE_BASIC, stack.l2GetMode(handles[0]));
+		assertFalse("fcs", stack.l2GetFCS(handles[0]));
+		assertEquals("receiveMTU", 1024, stack.l2GetReceiveMTU(handles[0]));
+		assertEquals("transmitMTU", 672, stack.l2GetTransmitMTU(handles[0]));
+	}
+
+	public void testEnhancedRetransmissionMode() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[0], 1024, 1024, L2CAPModeConnection.MODE_ERTM, 32,
+				BluetoothConsts.L2CAP_FCS_CRC16);
+		assertEquals("mode", L2CAPModeConnection.MODE_ERTM, stack.l2GetMode(handles[0]));
+		assertEquals("txWindow", 32, stack.l2GetTransmitWindow(handles[0]));
+		assertTrue("fcs", stack.l2GetFCS(handles[0]));
+	}
+
+	public void testEnhancedRetransmissionModeDefaultWindow() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[0], 1024, 1024, L2CAPModeConnection.MODE_ERTM, 0,
+				BluetoothConsts.L2CAP_FCS_CRC16);
+		assertEquals("txWindow", 63, stack.l2GetTransmitWindow(handles[0]));
+	}
+
+	public void testStreamingModeWithoutFCS() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[0], 1024, 1024, L2CAPModeConnection.MODE_STREAMING,
+				0, BluetoothConsts.L2CAP_FCS_NONE);
+		assertEquals("mode", L2CAPModeConnection.MODE_STREAMING, stack.l2GetMode(handles[0]));
+		assertFalse("fcs", stack.l2GetFCS(handles[0]));
+		assertEquals("other socket mode", L2CAPModeConnection.MODE_BASIC, stack.l2GetMode(handles[1]));
+	}
+
+	public void testModeNotSupported() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(false);
+		try {
+			BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[0], 1024, 1024, L2CAPModeConnection.MODE_ERTM,
+					0, BluetoothConsts.L2CAP_FCS_CRC16);
+			fail("ERTM accepted");
+		} catch (IOException e) {
+			assertTrue(e.getMessage(), e.getMessage().startsWith("L2CAP mode 3 not supported"));
+		}
+		assertEquals("mode", L2CAPModeConnection.MODE_BASIC, stack.l2GetMode(handles[0]));
+	}
+
+	public void testTransmitWindowTooLarge() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		try {
+			BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[0], 1024, 1024, L2CAPModeConnection.MODE_ERTM,
+					BluetoothConsts.L2CAP_TX_WINDOW_MAX + 1, BluetoothConsts.L2CAP_FCS_CRC16);
+			fail("txWindow accepted");
+		} catch (IOException e) {
+		}
+	}
+
+	public void testPacketsInStreamingMode() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		for (int i = 0; i < 2; i++) {
+			BluetoothStackBlueZNativeTests.testL2CAPSetOptions(handles[i], 1024, 1024,
+					L2CAPModeConnection.MODE_STREAMING, 0, BluetoothConsts.L2CAP_FCS_NONE);
+		}
+		byte[] first = new byte[] { 1, 2, 3 };
+		byte[] second = new byte[] { 4, 5, 6, 7, 8 };
+		stack.l2Send(handles[0], first, 1024);
+		stack.l2Send(handles[0], second, 1024);
+		byte[] inBuf = new byte[1024];
+		assertEquals("first packet", first.length, stack.l2Receive(handles[1], inBuf));
+		assertEquals("first data", 3, inBuf[2]);
+		assertEquals("second packet", second.length, stack.l2ReceiveTimeout(handles[1], inBuf, 1000));
+		assertEquals("second data", 8, inBuf[4]);
+		assertEquals("no packet", -1, stack.l2ReceiveTimeout(handles[1], inBuf, 0));
+	}
+
+	public void testEmptyPacket() throws IOException {
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(true);
+		byte[] inBuf = new byte[1024];
+		assertEquals("no packet", -1, stack.l2ReceiveTimeout(handles[1], inBuf, 100));
+		stack.l2Send(handles[0], new byte[0], 1024);
+		assertEquals("empty packet", 0, stack.l2ReceiveTimeout(handles[1], inBuf, 1000));
+		assertEquals("no packet", -1, stack.l2ReceiveTimeout(handles[1], inBuf, 0));
+	}
+}
@@ -0,0 +1,117 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * Prints packet rate of BlueZ native l2Ready() and l2Receive() loop and of l2ReceiveTimeout(), using SEQPACKET
+ * socket pair so no adapter is required.
+ */
+public class NativeL2CAPReceiveBenchmark extends NativeTestCase {
+
+	private static final int PACKETS = 20000;
+
+	private static final int PACKET_SIZE = 100;
+
+	private BluetoothStackBlueZ stack;
+
+	private long[] handles;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		stack = new BluetoothStackBlueZ();
+		handles = BluetoothStackBlueZNativeTests.testL2CAPMockOpen(false);
+	}
+
+	protected void tearDown() throws Exception {
+		if (handles != null) {
+			BluetoothStackBlueZNativeTests.testL2CAPMockClose();
+			handles = null;
+		}
+		super.tearDown();
+	}
+
+	/**
+	 * Sender thread blocks when socket buffer is full so receiver sees both queued and not yet sent packets.
+	 */
+	private Thread startSender() {
+		final long handle = handles[0];
+		Thread sender = new Thread() {
+			public void run() {
+				byte[] packet = new byte[PACKET_SIZE];
+				try {
+					for (int i = 0; i < PACKETS; i++) {
+						packet[0] = (byte) i;
+						packet[1] = (byte) (i >> 8);
+						stack.l2Send(handle, packet, PACKET_SIZE);
+					}
+				} catch (IOException e) {
+					e.printStackTrace();
+				}
+			}
+		};
+		sender.start();
+		return sender;
+	}
+
+	private long receivePackets(boolean withTimeout) throws Exception {
+		Thread sender = startSender();
+		long handle = handles[1];
+		byte[] inBuf = new byte[1024];
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < PACKETS; i++) {
+			int size;
+			if (withTimeout) {
+				size = stack.l2ReceiveTimeout(handle, inBuf, 5000);
+			} else {
+				while (!stack.l2Ready(handle)) {
+					Thread.yield();
+				}
+				size = stack.l2Receive(handle, inBuf);
+			}
+			assertEquals("size " + i, PACKET_SIZE, size);
+			assertEquals("packet " + i, (byte) i, inBuf[0]);
+		}
+		long time = System.currentTimeMillis() - start;
+		sender.join();
+		return time;
+	}
+
+	private static String rate(long time) {
+		return (PACKETS * 1000L / Math.max(time, 1)) + " packets/sec";
+	}
+
+	public void testReadyReceive() throws Exception {
+		long time = receivePackets(false);
+		System.out.println("BlueZ l2Ready() and l2Receive() " + PACKETS + " packets: " + time + " msec, " + rate(time));
+	}
+
+	public void testReceiveTimeout() throws Exception {
+		long time = receivePackets(true);
+		System.out.println("BlueZ l2ReceiveTimeout() " + PACKETS + " packets: " + time + " msec, " + rate(time));
+	}
+}
@@ -0,0 +1,160 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.util.Arrays;
+
+import javax.bluetooth.BluetoothStateException;
+import javax.bluetooth.L2CAPConnection;
+import javax.bluetooth.L2CAPConnectionNotifier;
+import javax.bluetooth.LocalDevice;
+import javax.bluetooth.ServiceRecord;
+import javax.microedition.io.Connector;
+
+/**
+ * Effect of sndbuf, rcvbuf and flushto connection parameters on L2CAP throughput and round trip time of small packets
+ * sent during bulk transfer.
+ * 
+ * Requires Bluetooth adapter that can connect to itself, skipped otherwise.
+ */
+public class NativeL2CAPSocketOptionsBenchmark extends NativeTestCase {
+
+	private static final String serverUUID = "11111111111111111111111111111128";
+
+	private static final int BULK_PACKETS = 2000;
+
+	private static final int PINGS = 100;
+
+	private static final byte PING = 1;
+
+	private static final byte END = 2;
+
+	private L2CAPConnectionNotifier notifier;
+
+	private Thread serverThread;
+
+	protected void tearDown() throws Exception {
+		stopServer();
+		super.tearDown();
+	}
+
+	private void stopServer() throws Exception {
+		if (notifier != null) {
+			notifier.close();
+			notifier = null;
+		}
+		if (serverThread != null) {
+			serverThread.join(5000);
+			serverThread = null;
+		}
+	}
+
+	private String startServer(String options) throws IOException {
+		notifier = (L2CAPConnectionNotifier) Connector.open("btl2cap://localhost:" + serverUUID + ";name=SocketOptionsTest"
+				+ options);
+		serverThread = new Thread() {
+			public void run() {
+				try {
+					L2CAPConnection conn = notifier.acceptAndOpen();
+					byte[] buf = new byte[conn.getReceiveMTU()];
+					while (true) {
+						conn.receive(buf);
+						if (buf[0] == PING) {
+							conn.send(new byte[] { PING });
+						} else if (buf[0] == END) {
+							conn.send(new byte[] { END });
+							break;
+						}
+					}
+					conn.close();
+				} catch (IOException e) {
+					e.printStackTrace();
+				}
+			}
+		};
+		serverThread.start();
+		ServiceRecord record = LocalDevice.getLocalDevice().getRecord(notifier);
+		return record.getConnectionURL(ServiceRecord.NOAUTHENTICATE_NOENCRYPT, false);
+	}
+
+	private void run(String name, String options) throws Exception {
+		String url;
+		final L2CAPConnection conn;
+		try {
+			url = startServer(options);
+			conn = (L2CAPConnection) Connector.open(url + options);
+		} catch (BluetoothStateException e) {
+			System.out.println("Bluetooth not available " + e.getMessage());
+			return;
+		} catch (IOException e) {
+			System.out.println("Can't connect to local device " + e.getMessage());
+			stopServer();
+			return;
+		}
+		// Bulk packets are filled with zeros
+		final byte[] packet = new byte[conn.getTransmitMTU()];
+		final long[] bulkTime = new long[1];
+		Thread bulk = new Thread() {
+			public void run() {
+				try {
+					long start = System.currentTimeMillis();
+					for (int i = 0; i < BULK_PACKETS; i++) {
+						conn.send(packet);
+					}
+					bulkTime[0] = System.currentTimeMillis() - start;
+				} catch (IOException e) {
+					e.printStackTrace();
+				}
+			}
+		};
+		bulk.start();
+		long[] rtt = new long[PINGS];
+		byte[] reply = new byte[conn.getReceiveMTU()];
+		for (int i = 0; i < PINGS; i++) {
+			long start = System.currentTimeMillis();
+			conn.send(new byte[] { PING });
+			conn.receive(reply);
+			rtt[i] = System.currentTimeMillis() - start;
+		}
+		bulk.join();
+		conn.send(new byte[] { END });
+		conn.receive(reply);
+		conn.close();
+
+		stopServer();
+
+		Arrays.sort(rtt);
+		long kbps = ((long) BULK_PACKETS * packet.length * 1000 / 1024) / Math.max(bulkTime[0], 1);
+		System.out.println("L2CAP " + name + ": " + kbps + " KB/s, rtt median " + rtt[PINGS / 2] + " msec, p99 "
+				+ rtt[PINGS * 99 / 100] + " msec");
+	}
+
+	public void testSocketOptions() throws Exception {
+		run("default", "");
+		run("large buffers", ";sndbuf=262144;rcvbuf=262144");
+		run("small buffers, flush timeout", ";sndbuf=4096;rcvbuf=4096;flushto=50");
+	}
+}
@@ -0,0 +1,73 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+/**
+ * Prints startup time of one by one and batch registration of many service records, using in memory SDP server
+ * stand-in with fixed request round trip instead of sdpd.
+ */
+public class NativeSDPRegistrationBenchmark extends NativeTestCase {
+
+	private static final int ROUND_TRIP = 1000;
+
+	private BluetoothStackBlueZ stack;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		stack = new BluetoothStackBlueZ();
+		BluetoothStackBlueZNativeTests.testSDPMockOpen(ROUND_TRIP, 0);
+	}
+
+	protected void tearDown() throws Exception {
+		BluetoothStackBlueZNativeTests.testSDPMockClose();
+		super.tearDown();
+	}
+
+	private void unregister(ServiceRecordImpl[] records) throws Exception {
+		for (int i = 0; i < records.length; i++) {
+			stack.unregisterSDPRecord(records[i]);
+		}
+	}
+
+	public void testRegisterServiceRecords() throws Exception {
+		int count = NativeSDPRegistrationTest.RECORDS;
+		ServiceRecordImpl[] records = NativeSDPRegistrationTest.createRecords(stack);
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < count; i++) {
+			stack.registerSDPRecord(records[i]);
+		}
+		long oneByOne = System.currentTimeMillis() - start;
+		unregister(records);
+
+		records = NativeSDPRegistrationTest.createRecords(stack);
+		start = System.currentTimeMillis();
+		stack.registerServiceRecords(records);
+		long batch = System.currentTimeMillis() - start;
+		unregister(records);
+
+		System.out.println("register " + count + " records with " + ROUND_TRIP + " usec round trip, one by one "
+				+ oneByOne + " msec, batch " + batch + " msec");
+	}
+}
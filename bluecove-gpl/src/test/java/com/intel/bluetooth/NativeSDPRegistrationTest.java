@@ -0,0 +1,136 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import javax.bluetooth.DataElement;
+import javax.bluetooth.ServiceRegistrationException;
+import javax.bluetooth.UUID;
+
+/**
+ * Batch registration of many service records and its rollback, using in memory SDP server stand-in instead of
+ * sdpd.
+ */
+public class NativeSDPRegistrationTest extends NativeTestCase {
+
+	static final int RECORDS = 60;
+
+	private BluetoothStackBlueZ stack;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		stack = new BluetoothStackBlueZ();
+	}
+
+	protected void tearDown() throws Exception {
+		BluetoothStackBlueZNativeTests.testSDPMockClose();
+		super.tearDown();
+	}
+
+	static ServiceRecordImpl[] createRecords(BluetoothStack stack) {
+		ServiceRecordImpl[] records = new ServiceRecordImpl[RECORDS];
+		for (int i = 0; i < RECORDS; i++) {
+			records[i] = new ServiceRecordImpl(stack, null, 0);
+			records[i].populateRFCOMMAttributes(0, 1 + (i % 30), new UUID(0x1000 + i), "Service" + i, false);
+		}
+		return records;
+	}
+
+	private void assertRegistered(ServiceRecordImpl[] records) {
+		assertEquals("registered", records.length, BluetoothStackBlueZNativeTests.testSDPMockRecords());
+		for (int i = 0; i < records.length; i++) {
+			long handle = records[i].getHandle();
+			assertTrue("handle " + i, handle >= 0x10000);
+			DataElement attr = records[i].getAttributeValue(BluetoothConsts.ServiceRecordHandle);
+			assertEquals("ServiceRecordHandle " + i, handle, attr.getLong());
+			for (int j = 0; j < i; j++) {
+				assertTrue("same handle " + j + " and " + i, handle != records[j].getHandle());
+			}
+		}
+	}
+
+	private void assertRolledBack(ServiceRecordImpl[] records) {
+		for (int i = 0; i < records.length; i++) {
+			assertEquals("handle " + i, 0, records[i].getHandle());
+		}
+		assertEquals("registered after rollback", 0, BluetoothStackBlueZNativeTests.testSDPMockRecords());
+	}
+
+	private void unregister(ServiceRecordImpl[] records) throws ServiceRegistrationException {
+		for (int i = 0; i < records.length; i++) {
+			stack.unregisterSDPRecord(records[i]);
+		}
+		assertEquals("unregistered", 0, BluetoothStackBlueZNativeTests.testSDPMockRecords());
+	}
+
+	public void testBatchRegistration() throws Exception {
+		BluetoothStackBlueZNativeTests.testSDPMockOpen(0, 0);
+		ServiceRecordImpl[] records = createRecords(stack);
+		stack.registerServiceRecords(records);
+		assertRegistered(records);
+		unregister(records);
+	}
+
+	public void testBatchRegistrationRollback() throws Exception {
+		BluetoothStackBlueZNativeTests.testSDPMockOpen(0, 0);
+		ServiceRecordImpl[] records = createRecords(stack);
+		// Not a DATSEQ, can't be parsed
+		records[RECORDS / 2] = new ServiceRecordImpl(stack, null, 0) {
+			byte[] toByteArray() {
+				return new byte[] { 0x08, 0x01 };
+			}
+		};
+		try {
+			stack.registerServiceRecords(records);
+			fail("ServiceRegistrationException expected");
+		} catch (ServiceRegistrationException e) {
+		}
+		assertRolledBack(records);
+	}
+
+	public void testBatchRegistrationServerRollback() throws Exception {
+		BluetoothStackBlueZNativeTests.testSDPMockOpen(0, RECORDS / 2 + 1);
+		ServiceRecordImpl[] records = createRecords(stack);
+		try {
+			stack.registerServiceRecords(records);
+			fail("ServiceRegistrationException expected");
+		} catch (ServiceRegistrationException e) {
+		}
+		assertRolledBack(records);
+	}
+
+	public void testDeferredRegistration() throws Exception {
+		BluetoothStackBlueZNativeTests.testSDPMockOpen(0, 0);
+		ServiceRecordImpl[] records = createRecords(stack);
+		ServiceRecordsRegistry.beginBatchRegistration();
+		for (int i = 0; i < RECORDS; i++) {
+			stack.registerSDPRecord(records[i]);
+			assertEquals("deferred", 0, records[i].getHandle());
+		}
+		assertEquals("registered before commit", 0, BluetoothStackBlueZNativeTests.testSDPMockRecords());
+		ServiceRecordsRegistry.commitBatchRegistration();
+		assertRegistered(records);
+		unregister(records);
+	}
+}
@@ -35,16 +35,21 @@ import javax.bluetooth.UUID;
  */
 public class NativeServiceRecordTest extends NativeTestCase {
 
+	private void assertRecordEquals(byte[] expected, byte[] actual) {
+		assertEquals("length", expected.length, actual.length);
+		for (int k = 0; k < expected.length; k++) {
+			assertEquals("byteAray[" + k + "]", expected[k], actual[k]);
+		}
+	}
+
 	public void validateServiceRecordConvert(ServiceRecordImpl serviceRecord) throws IOException {
 		byte[] inRecordData = serviceRecord.toByteArray();
 		DebugLog.debug("inRecordData", inRecordData);
 		byte[] nativeRecord = BluetoothStackBlueZNativeTests.testServiceRecordConvert(inRecordData);
 		DebugLog.debug("nativeRecord", nativeRecord);
-		assertEquals("length", inRecordData.length, nativeRecord.length);
-		for (int k = 0; k < inRecordData.length; k++) {
-			assertEquals("byteAray[" + k + "]", inRecordData[k], nativeRecord[k]);
-		}
-
+		assertRecordEquals(inRecordData, nativeRecord);
+		byte[] bluezRecord = BluetoothStackBlueZNativeTests.testServiceRecordConvertBlueZ(inRecordData);
+		assertRecordEquals(inRecordData, bluezRecord);
 	}
 
 	public void testServiceRecordConvert() throws IOException {
@@ -53,6 +58,59 @@ public class NativeServiceRecordTest extends NativeTestCase {
 		validateServiceRecordConvert(serviceRecord);
 	}
 
+	public void testServiceRecordConvertAllTypes() throws IOException {
+		ServiceRecordImpl serviceRecord = new ServiceRecordImpl(null, null, 0);
+		serviceRecord.populateL2CAPAttributes(1, 2, new UUID("B10C0BE1111111111111111111110001", false), "BBBB");
+		int id = 0x200;
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.NULL));
+		serviceRecord.setAttributeValue(id++, new DataElement(true));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.U_INT_1, 0xFE));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.U_INT_2, 0xFEDC));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.U_INT_4, 0xFEDCBA98L));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.U_INT_8, new byte[] { 1, 2, 3, 4, 5, 6, 7, 8 }));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.U_INT_16, new byte[] { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+				11, 12, 13, 14, 15, 16 }));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.INT_1, -2));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.INT_2, -0x1234));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.INT_4, -0x12345678L));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.INT_8, -0x123456789ABCDEFL));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.INT_16, new byte[] { -1, 2, 3, 4, 5, 6, 7, 8, 9, 10,
+				11, 12, 13, 14, 15, 16 }));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.UUID, new UUID(0x12345678L)));
+		serviceRecord.setAttributeValue(id++, new DataElement(DataElement.URL, "http://bluecove.org"));
+		DataElement alt = new DataElement(DataElement.DATALT);
+		alt.addElement(new DataElement(DataElement.STRING, "A"));
+		alt.addElement(new DataElement(DataElement.DATSEQ));
+		serviceRecord.setAttributeValue(id++, alt);
+		validateServiceRecordConvert(serviceRecord);
+	}
+
+	public void testServiceRecordDiff() throws IOException {
+		ServiceRecordImpl serviceRecord = new ServiceRecordImpl(null, null, 0);
+		serviceRecord.populateL2CAPAttributes(1, 2, new UUID(3), "BBBB");
+		final int statusID = 0x200;
+		final int extraID = 0x201;
+		serviceRecord.setAttributeValue(statusID, new DataElement(DataElement.STRING, "A"));
+		byte[] registered = serviceRecord.toByteArray();
+
+		assertEquals("unchanged", 0, BluetoothStackBlueZNativeTests.testServiceRecordDiff(registered, serviceRecord.toByteArray()).length);
+
+		serviceRecord.setAttributeValue(statusID, new DataElement(DataElement.STRING, "B"));
+		int[] diff = BluetoothStackBlueZNativeTests.testServiceRecordDiff(registered, serviceRecord.toByteArray());
+		assertEquals("changed", 1, diff.length);
+		assertEquals("changed ID", statusID, diff[0]);
+
+		serviceRecord.setAttributeValue(statusID, new DataElement(DataElement.STRING, "A"));
+		serviceRecord.setAttributeValue(extraID, new DataElement(DataElement.U_INT_1, 1));
+		diff = BluetoothStackBlueZNativeTests.testServiceRecordDiff(registered, serviceRecord.toByteArray());
+		assertEquals("added", 1, diff.length);
+		assertEquals("added ID", extraID, diff[0]);
+
+		diff = BluetoothStackBlueZNativeTests.testServiceRecordDiff(serviceRecord.toByteArray(), registered);
+		assertEquals("removed", 1, diff.length);
+		assertEquals("removed ID", 0x10000 | extraID, diff[0]);
+	}
+
 	public void xtestServiceRecordConvertLarge() throws IOException {
 		ServiceRecordImpl serviceRecord = new ServiceRecordImpl(null, null, 0);
 		serviceRecord.populateL2CAPAttributes(1, 2, new UUID(3), "BBBB");
@@ -0,0 +1,44 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.OutputStream;
+
+/**
+ * 
+ */
+public abstract class BlueCoveRFCommInternals {
+
+    /**
+     * @return number of write calls made to the stack by RFCOMM OutputStream
+     */
+    public static int getStackWriteCount(OutputStream os) {
+        if (os instanceof BluetoothRFCommOutputStream) {
+            return ((BluetoothRFCommOutputStream) os).stackWriteCount;
+        } else {
+            throw new IllegalArgumentException("Not a BlueCove RFCOMM OutputStream " + os.getClass().getName());
+        }
+    }
+}
@@ -0,0 +1,112 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import java.io.InputStream;
+
+import javax.microedition.io.Connector;
+import javax.microedition.io.StreamConnection;
+import javax.microedition.io.StreamConnectionNotifier;
+
+import com.intel.bluetooth.RemoteDeviceHelper;
+
+/**
+ * Open connections count after close, finalize and garbage collection of client connections.
+ */
+public class ConnectionsCountTest extends BaseEmulatorTestCase {
+
+	private static final String serverUUID = "11111111111111111111111111111128";
+
+	private static final int CONNECTIONS = 2;
+
+	@Override
+	protected Runnable createTestServer() {
+		return new TestCaseRunnable() {
+			public void execute() throws Exception {
+				StreamConnectionNotifier notifier = (StreamConnectionNotifier) Connector.open("btspp://localhost:"
+						+ serverUUID + ";name=ConnectionsCountTest");
+				StreamConnection[] connections = new StreamConnection[CONNECTIONS];
+				for (int i = 0; i < CONNECTIONS; i++) {
+					connections[i] = notifier.acceptAndOpen();
+				}
+				for (int i = 0; i < CONNECTIONS; i++) {
+					connections[i].close();
+				}
+				notifier.close();
+			}
+		};
+	}
+
+	private void assertConnections(String message, int connections, int devices) {
+		assertEquals(message + " connections", connections, RemoteDeviceHelper.openConnections());
+		assertEquals(message + " devices", devices, RemoteDeviceHelper.connectedDevices());
+	}
+
+	public void testClose() throws Exception {
+		String url = selectService(serverUUID);
+		StreamConnection conn = (StreamConnection) Connector.open(url);
+		InputStream is = conn.openInputStream();
+		assertConnections("open", 1, 1);
+		conn.close();
+		assertConnections("stream open", 1, 1);
+		is.close();
+		assertConnections("closed", 0, 0);
+
+		conn = (StreamConnection) Connector.open(url);
+		assertConnections("open", 1, 1);
+		conn.close();
+		conn = null;
+		// finalize() after close() is not counted again
+		for (int i = 0; i < 3; i++) {
+			System.gc();
+			System.runFinalization();
+		}
+		assertConnections("finalized", 0, 0);
+	}
+
+	private static void openAndDiscard(String url) throws Exception {
+		StreamConnection conn = (StreamConnection) Connector.open(url);
+		conn.openInputStream();
+	}
+
+	public void testGarbageCollected() throws Exception {
+		String url = selectService(serverUUID);
+		// Connection and its stream are not closed by application
+		openAndDiscard(url);
+		assertConnections("open", 1, 1);
+		long end = System.currentTimeMillis() + 10 * 1000;
+		while ((RemoteDeviceHelper.openConnections() != 0) && (System.currentTimeMillis() < end)) {
+			System.gc();
+			System.runFinalization();
+			Thread.sleep(100);
+		}
+		assertConnections("collected", 0, 0);
+
+		StreamConnection conn = (StreamConnection) Connector.open(url);
+		assertConnections("open after collected", 1, 1);
+		conn.close();
+		assertConnections("closed", 0, 0);
+	}
+}
@@ -0,0 +1,64 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import javax.microedition.io.Connector;
+
+/**
+ * L2CAP channel mode parameters are rejected by the emulator, it does not support FEATURE_L2CAP_MODE.
+ */
+public class L2CAPModeParamsTest extends BaseEmulatorTestCase {
+
+	private static final String serverUUID = "11111111111111111111111111111129";
+
+	private static final String clientURL = "btl2cap://0B1000000001:1001";
+
+	private void assertRejected(String url, String name) throws Exception {
+		try {
+			Connector.open(url).close();
+			fail(url + " accepted");
+		} catch (IllegalArgumentException e) {
+			assertEquals(name + " extension not supported on this stack", e.getMessage());
+		}
+	}
+
+	public void testClientModeRejected() throws Exception {
+		assertRejected(clientURL + ";l2mode=ertm", "l2mode");
+		assertRejected(clientURL + ";l2mode=basic", "l2mode");
+		assertRejected(clientURL + ";fcs=false", "fcs");
+	}
+
+	public void testClientTransmitWindowRejected() throws Exception {
+		assertRejected(clientURL + ";txwindow=32", "txwindow");
+		assertRejected(clientURL + ";l2mode=ertm;txwindow=32", "l2mode");
+	}
+
+	public void testServerModeRejected() throws Exception {
+		String url = "btl2cap://localhost:" + serverUUID;
+		assertRejected(url + ";l2mode=streaming", "l2mode");
+		assertRejected(url + ";txwindow=32", "txwindow");
+		assertRejected(url + ";fcs=true", "fcs");
+	}
+}
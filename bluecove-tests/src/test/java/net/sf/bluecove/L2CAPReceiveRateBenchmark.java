@@ -0,0 +1,55 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+/**
+ * Prints packet rate of L2CAP ready() and receive() loop and of receive(byte[], int) on emulator. BlueZ native
+ * receive is measured by NativeL2CAPReceiveBenchmark in bluecove-gpl.
+ */
+public class L2CAPReceiveRateBenchmark extends BaseEmulatorTestCase {
+
+	private static final int PACKETS = 2000;
+
+	@Override
+	protected Runnable createTestServer() {
+		return L2CAPReceiveTimeoutTest.createServer(PACKETS);
+	}
+
+	private static String rate(long time) {
+		return (PACKETS * 1000L / Math.max(time, 1)) + " packets/sec";
+	}
+
+	public void testReadyReceive() throws Exception {
+		long time = L2CAPReceiveTimeoutTest.receivePackets(selectService(L2CAPReceiveTimeoutTest.serverUUID), PACKETS,
+				false);
+		System.out.println("L2CAP ready() and receive() " + PACKETS + " packets: " + time + " msec, " + rate(time));
+	}
+
+	public void testReceiveTimeout() throws Exception {
+		long time = L2CAPReceiveTimeoutTest.receivePackets(selectService(L2CAPReceiveTimeoutTest.serverUUID), PACKETS,
+				true);
+		System.out.println("L2CAP receive(byte[], int) " + PACKETS + " packets: " + time + " msec, " + rate(time));
+	}
+}
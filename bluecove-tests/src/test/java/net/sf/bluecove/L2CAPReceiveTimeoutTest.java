@@ -0,0 +1,114 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import javax.bluetooth.L2CAPConnection;
+import javax.bluetooth.L2CAPConnectionNotifier;
+import javax.microedition.io.Connector;
+
+import com.intel.bluetooth.ReceiveTimeoutL2CAPConnection;
+
+/**
+ * L2CAP receive with timeout compared to ready() and receive() loop.
+ */
+public class L2CAPReceiveTimeoutTest extends BaseEmulatorTestCase {
+
+	static final String serverUUID = "11111111111111111111111111111127";
+
+	private static final int PACKETS = 100;
+
+	static final int PACKET_SIZE = 100;
+
+	@Override
+	protected Runnable createTestServer() {
+		return createServer(PACKETS);
+	}
+
+	/**
+	 * Sends numbered packets and waits for client to receive all of them.
+	 */
+	static Runnable createServer(final int packets) {
+		return new TestCaseRunnable() {
+			public void execute() throws Exception {
+				L2CAPConnectionNotifier notifier = (L2CAPConnectionNotifier) Connector.open("btl2cap://localhost:"
+						+ serverUUID + ";name=ReceiveTimeoutTest");
+				L2CAPConnection conn = notifier.acceptAndOpen();
+				byte[] packet = new byte[PACKET_SIZE];
+				for (int i = 0; i < packets; i++) {
+					packet[0] = (byte) i;
+					packet[1] = (byte) (i >> 8);
+					conn.send(packet);
+				}
+				// Wait for client to receive all packets
+				byte[] ack = new byte[conn.getReceiveMTU()];
+				conn.receive(ack);
+				conn.close();
+				notifier.close();
+			}
+		};
+	}
+
+	private static int packetNumber(byte[] packet) {
+		return (packet[0] & 0xFF) | ((packet[1] & 0xFF) << 8);
+	}
+
+	/**
+	 * Receive packets sent by the server.
+	 * 
+	 * @return time in milliseconds
+	 */
+	static long receivePackets(String url, int packets, boolean withTimeout) throws Exception {
+		L2CAPConnection conn = (L2CAPConnection) Connector.open(url);
+		byte[] inBuf = new byte[conn.getReceiveMTU()];
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < packets; i++) {
+			int size;
+			if (withTimeout) {
+				size = ((ReceiveTimeoutL2CAPConnection) conn).receive(inBuf, 5000);
+			} else {
+				while (!conn.ready()) {
+					Thread.yield();
+				}
+				size = conn.receive(inBuf);
+			}
+			assertEquals("size " + i, PACKET_SIZE, size);
+			assertEquals("packet", i & 0xFFFF, packetNumber(inBuf));
+		}
+		long time = System.currentTimeMillis() - start;
+		assertEquals("timeout", -1, ((ReceiveTimeoutL2CAPConnection) conn).receive(inBuf, 0));
+		assertEquals("timeout", -1, ((ReceiveTimeoutL2CAPConnection) conn).receive(inBuf, 50));
+		conn.send(new byte[] { 1 });
+		conn.close();
+		return time;
+	}
+
+	public void testReadyReceive() throws Exception {
+		receivePackets(selectService(serverUUID), PACKETS, false);
+	}
+
+	public void testReceiveTimeout() throws Exception {
+		receivePackets(selectService(serverUUID), PACKETS, true);
+	}
+}
@@ -0,0 +1,100 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import java.io.InputStream;
+import java.io.OutputStream;
+
+import javax.microedition.io.Connector;
+import javax.microedition.io.StreamConnection;
+import javax.microedition.io.StreamConnectionNotifier;
+
+import com.intel.bluetooth.BluetoothConnectionFuture;
+import com.intel.bluetooth.MicroeditionConnector;
+
+/**
+ * MicroeditionConnector.openAsync, several connections started before waiting for any of them.
+ */
+public class OpenAsyncTest extends BaseEmulatorTestCase {
+
+	private static final String serverUUID = "11111111111111111111111111111126";
+
+	private static final int CONNECTIONS = 3;
+
+	@Override
+	protected Runnable createTestServer() {
+		return new TestCaseRunnable() {
+			public void execute() throws Exception {
+				StreamConnectionNotifier notifier = (StreamConnectionNotifier) Connector.open("btspp://localhost:"
+						+ serverUUID + ";name=OpenAsyncTest");
+				// Client does not use any connection before all are started
+				StreamConnection[] connections = new StreamConnection[CONNECTIONS];
+				for (int i = 0; i < CONNECTIONS; i++) {
+					connections[i] = notifier.acceptAndOpen();
+				}
+				for (int i = 0; i < CONNECTIONS; i++) {
+					InputStream is = connections[i].openInputStream();
+					OutputStream os = connections[i].openOutputStream();
+					os.write(is.read() + 1);
+					os.flush();
+					os.close();
+					is.close();
+					connections[i].close();
+				}
+				notifier.close();
+			}
+		};
+	}
+
+	public void testOpenAsync() throws Exception {
+		String url = selectService(serverUUID);
+		BluetoothConnectionFuture[] futures = new BluetoothConnectionFuture[CONNECTIONS];
+		for (int i = 0; i < CONNECTIONS; i++) {
+			futures[i] = MicroeditionConnector.openAsync(url);
+		}
+		for (int i = 0; i < CONNECTIONS; i++) {
+			StreamConnection conn = (StreamConnection) futures[i].get(30 * 1000);
+			assertNotNull("connection " + i, conn);
+			assertTrue("done " + i, futures[i].isDone());
+			assertFalse("cancel completed " + i, futures[i].cancel());
+			OutputStream os = conn.openOutputStream();
+			InputStream is = conn.openInputStream();
+			os.write(i);
+			os.flush();
+			assertEquals("reply " + i, i + 1, is.read());
+			os.close();
+			is.close();
+			conn.close();
+		}
+	}
+
+	public void testOpenAsyncServerURL() throws Exception {
+		try {
+			MicroeditionConnector.openAsync("btspp://localhost:" + serverUUID);
+			fail("server URL accepted");
+		} catch (IllegalArgumentException e) {
+		}
+	}
+}
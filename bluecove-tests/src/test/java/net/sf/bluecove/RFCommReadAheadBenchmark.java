@@ -0,0 +1,57 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Prints RFCOMM InputStream per-byte read speed with and without read-ahead buffer.
+ */
+public class RFCommReadAheadBenchmark extends BaseEmulatorTestCase {
+
+	@Override
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD, null);
+		super.tearDown();
+	}
+
+	@Override
+	protected Runnable createTestServer() {
+		return RFCommReadAheadTest.createServer();
+	}
+
+	public void testReadAhead() throws Exception {
+		long time = RFCommReadAheadTest.readPerByte(selectService(RFCommReadAheadTest.serverUUID), "1024");
+		System.out.println("RFCOMM read() " + (RFCommReadAheadTest.DATA_SIZE / 1024) + " KB with read-ahead: " + time
+				+ " msec");
+	}
+
+	public void testDirectRead() throws Exception {
+		long time = RFCommReadAheadTest.readPerByte(selectService(RFCommReadAheadTest.serverUUID), "0");
+		System.out.println("RFCOMM read() " + (RFCommReadAheadTest.DATA_SIZE / 1024) + " KB without read-ahead: "
+				+ time + " msec");
+	}
+}
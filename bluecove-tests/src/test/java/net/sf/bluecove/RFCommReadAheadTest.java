@@ -0,0 +1,133 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import java.io.DataInputStream;
+import java.io.InputStream;
+import java.io.OutputStream;
+
+import javax.microedition.io.Connector;
+import javax.microedition.io.StreamConnection;
+import javax.microedition.io.StreamConnectionNotifier;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * RFCOMM InputStream read-ahead with mixed single byte and small reads.
+ */
+public class RFCommReadAheadTest extends BaseEmulatorTestCase {
+
+	static final String serverUUID = "11111111111111111111111111111124";
+
+	static final int DATA_SIZE = 64 * 1024;
+
+	private static byte[] makeTestData(int length) {
+		byte data[] = new byte[length];
+		for (int i = 0; i < length; i++) {
+			data[i] = (byte) (i & 0xFF);
+		}
+		return data;
+	}
+
+	@Override
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD, null);
+		super.tearDown();
+	}
+
+	@Override
+	protected Runnable createTestServer() {
+		return createServer();
+	}
+
+	/**
+	 * Sends DATA_SIZE bytes and waits for client to close the connection.
+	 */
+	static Runnable createServer() {
+		return new TestCaseRunnable() {
+			public void execute() throws Exception {
+				StreamConnectionNotifier notifier = (StreamConnectionNotifier) Connector.open("btspp://localhost:"
+						+ serverUUID + ";name=ReadAheadTest");
+				StreamConnection conn = notifier.acceptAndOpen();
+				OutputStream os = conn.openOutputStream();
+				os.write(makeTestData(DATA_SIZE));
+				os.flush();
+				// Wait for client to close the connection
+				InputStream is = conn.openInputStream();
+				while (is.read() != -1) {
+				}
+				os.close();
+				is.close();
+				conn.close();
+				notifier.close();
+			}
+		};
+	}
+
+	/**
+	 * Read data sent by the server from the connection opened with given read-ahead size.
+	 * 
+	 * @return time in milliseconds
+	 */
+	static long readPerByte(String url, String readAhead) throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD, readAhead);
+		StreamConnection conn = (StreamConnection) Connector.open(url);
+		DataInputStream is = conn.openDataInputStream();
+		byte[] expected = makeTestData(DATA_SIZE);
+		long start = System.currentTimeMillis();
+		// Mix single byte, small and large reads
+		for (int i = 0; i < DATA_SIZE / 2; i++) {
+			assertEquals("byte " + i, expected[i] & 0xFF, is.read());
+		}
+		byte[] small = new byte[7];
+		is.readFully(small);
+		assertEquals("small", copyOf(expected, DATA_SIZE / 2, 7), small);
+		int offset = DATA_SIZE / 2 + 7;
+		while (offset < DATA_SIZE) {
+			int b = is.read();
+			assertEquals("byte " + offset, expected[offset] & 0xFF, b);
+			offset++;
+		}
+		long time = System.currentTimeMillis() - start;
+		is.close();
+		conn.close();
+		return time;
+	}
+
+	private static byte[] copyOf(byte[] data, int off, int len) {
+		byte[] b = new byte[len];
+		System.arraycopy(data, off, b, 0, len);
+		return b;
+	}
+
+	public void testReadAhead() throws Exception {
+		readPerByte(selectService(serverUUID), "1024");
+	}
+
+	public void testDirectRead() throws Exception {
+		readPerByte(selectService(serverUUID), null);
+	}
+}
@@ -0,0 +1,91 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import java.io.DataOutputStream;
+import java.io.InputStream;
+
+import javax.microedition.io.Connector;
+import javax.microedition.io.StreamConnection;
+import javax.microedition.io.StreamConnectionNotifier;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+import com.intel.bluetooth.BlueCoveRFCommInternals;
+
+/**
+ * Prints RFCOMM stack writes and time per message written field by field, with and without write coalescing.
+ */
+public class RFCommWriteCoalescingBenchmark extends BaseEmulatorTestCase {
+
+	@Override
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_COALESCE, null);
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY, null);
+		super.tearDown();
+	}
+
+	@Override
+	protected Runnable createTestServer() {
+		return new TestCaseRunnable() {
+			public void execute() throws Exception {
+				StreamConnectionNotifier notifier = (StreamConnectionNotifier) Connector.open("btspp://localhost:"
+						+ RFCommWriteCoalescingTest.serverUUID + ";name=CoalescingBenchmark");
+				StreamConnection conn = notifier.acceptAndOpen();
+				InputStream is = conn.openInputStream();
+				byte[] b = new byte[0x100];
+				while (is.read(b) != -1) {
+				}
+				is.close();
+				conn.close();
+				notifier.close();
+			}
+		};
+	}
+
+	private void benchmark(String coalesce) throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_COALESCE, coalesce);
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY, "0");
+		StreamConnection conn = (StreamConnection) Connector.open(selectService(RFCommWriteCoalescingTest.serverUUID));
+		DataOutputStream os = conn.openDataOutputStream();
+		long start = System.currentTimeMillis();
+		RFCommWriteCoalescingTest.writeMessages(os);
+		long time = System.currentTimeMillis() - start;
+		int writes = BlueCoveRFCommInternals.getStackWriteCount(os);
+		int messages = RFCommWriteCoalescingTest.MESSAGES;
+		System.out.println("RFCOMM " + messages + " messages, write_coalesce " + coalesce + ": " + writes + " frames, "
+				+ ((float) writes / messages) + " frames per message, " + time + " msec");
+		os.close();
+		conn.close();
+	}
+
+	public void testNoCoalescing() throws Exception {
+		benchmark(null);
+	}
+
+	public void testCoalescing() throws Exception {
+		benchmark(String.valueOf(RFCommWriteCoalescingTest.FRAME_SIZE));
+	}
+}
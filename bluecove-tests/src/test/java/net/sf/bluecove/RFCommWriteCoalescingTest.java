@@ -0,0 +1,165 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import java.io.DataOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+
+import javax.microedition.io.Connector;
+import javax.microedition.io.StreamConnection;
+import javax.microedition.io.StreamConnectionNotifier;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+import com.intel.bluetooth.BlueCoveRFCommInternals;
+
+/**
+ * RFCOMM OutputStream write coalescing, stack writes per message written field by field.
+ */
+public class RFCommWriteCoalescingTest extends BaseEmulatorTestCase {
+
+	static final String serverUUID = "11111111111111111111111111111125";
+
+	static final int MESSAGES = 200;
+
+	static final int FRAME_SIZE = 127;
+
+	private final Object receivedLock = new Object();
+
+	private int receivedCount;
+
+	private byte[] received = new byte[MESSAGES * 64];
+
+	@Override
+	protected void setUp() throws Exception {
+		receivedCount = 0;
+		super.setUp();
+	}
+
+	@Override
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_COALESCE, null);
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY, null);
+		super.tearDown();
+	}
+
+	@Override
+	protected Runnable createTestServer() {
+		return new TestCaseRunnable() {
+			public void execute() throws Exception {
+				StreamConnectionNotifier notifier = (StreamConnectionNotifier) Connector.open("btspp://localhost:"
+						+ serverUUID + ";name=CoalescingTest");
+				StreamConnection conn = notifier.acceptAndOpen();
+				InputStream is = conn.openInputStream();
+				byte[] b = new byte[0x100];
+				int len;
+				while ((len = is.read(b)) != -1) {
+					synchronized (receivedLock) {
+						System.arraycopy(b, 0, received, receivedCount, len);
+						receivedCount += len;
+						receivedLock.notifyAll();
+					}
+				}
+				is.close();
+				conn.close();
+				notifier.close();
+			}
+		};
+	}
+
+	private void waitReceived(int count, int timeout) throws InterruptedException {
+		long end = System.currentTimeMillis() + timeout;
+		synchronized (receivedLock) {
+			while (receivedCount < count) {
+				long wait = end - System.currentTimeMillis();
+				if (wait <= 0) {
+					break;
+				}
+				receivedLock.wait(wait);
+			}
+			assertEquals("received", count, receivedCount);
+		}
+	}
+
+	/**
+	 * Each message is 16 bytes written in 10 calls.
+	 */
+	static void writeMessages(DataOutputStream os) throws IOException {
+		for (int i = 0; i < MESSAGES; i++) {
+			os.write(0x7E);
+			os.writeShort(i);
+			os.writeInt(i * 3);
+			os.write(new byte[] { 1, 2, 3, 4, 5, 6, 7 });
+			os.write(0x7F);
+			os.write(0x0D);
+		}
+		os.flush();
+	}
+
+	/**
+	 * Timer flush is disabled to get stable frame count.
+	 */
+	private int writeMessages(String coalesce) throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_COALESCE, coalesce);
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY, "0");
+		StreamConnection conn = (StreamConnection) Connector.open(selectService(serverUUID));
+		DataOutputStream os = conn.openDataOutputStream();
+		writeMessages(os);
+		waitReceived(MESSAGES * 16, 5000);
+		int writes = BlueCoveRFCommInternals.getStackWriteCount(os);
+		for (int i = 0; i < MESSAGES; i++) {
+			assertEquals("message start " + i, 0x7E, received[i * 16]);
+			assertEquals("message id " + i, (byte) i, received[i * 16 + 2]);
+			assertEquals("message end " + i, 0x0D, received[i * 16 + 15]);
+		}
+		os.close();
+		conn.close();
+		return writes;
+	}
+
+	public void testNoCoalescing() throws Exception {
+		assertEquals("writes", MESSAGES * 10, writeMessages(null));
+	}
+
+	public void testCoalescing() throws Exception {
+		int writes = writeMessages(String.valueOf(FRAME_SIZE));
+		assertTrue("writes " + writes, writes <= (MESSAGES * 16) / FRAME_SIZE + 1);
+	}
+
+	public void testDelayedFlush() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_COALESCE, String.valueOf(FRAME_SIZE));
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY, "5000");
+		StreamConnection conn = (StreamConnection) Connector.open(selectService(serverUUID));
+		DataOutputStream os = conn.openDataOutputStream();
+		os.writeInt(0x01020304);
+		// No flush, data is sent by the timer
+		waitReceived(4, 5000);
+		assertEquals("writes", 1, BlueCoveRFCommInternals.getStackWriteCount(os));
+		assertEquals("data", 0x04, received[3]);
+		os.close();
+		conn.close();
+	}
+}
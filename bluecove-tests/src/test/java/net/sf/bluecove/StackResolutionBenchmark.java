@@ -0,0 +1,46 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Resolves ThreadLocal BluetoothStack from many threads sharing one stack, prints calls per second.
+ */
+public class StackResolutionBenchmark extends BaseEmulatorTestCase {
+
+	private static final int ITERATIONS = 20000;
+
+	public void testResolution() throws Exception {
+		Object stackID = BlueCoveImpl.getThreadBluetoothStackID();
+		int[] threads = { 1, 4, 16 };
+		for (int i = 0; i < threads.length; i++) {
+			long time = StackResolutionTest.runThreads(stackID, threads[i], ITERATIONS);
+			long calls = (long) threads[i] * ITERATIONS;
+			System.out.println("Stack resolution " + threads[i] + " threads: " + time + " msec, "
+					+ ((time == 0) ? calls * 1000 : (calls * 1000) / time) + " iterations/s");
+		}
+	}
+}
@@ -0,0 +1,82 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2008-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package net.sf.bluecove;
+
+import javax.bluetooth.LocalDevice;
+
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Resolves ThreadLocal BluetoothStack from many threads sharing one stack.
+ */
+public class StackResolutionTest extends BaseEmulatorTestCase {
+
+	/**
+	 * @return time in milliseconds
+	 */
+	static long runThreads(final Object stackID, int threadsCount, final int iterations) throws Exception {
+		final Throwable[] failure = new Throwable[1];
+		Thread[] threads = new Thread[threadsCount];
+		for (int i = 0; i < threadsCount; i++) {
+			threads[i] = new Thread("StackResolution-" + i) {
+				public void run() {
+					try {
+						BlueCoveImpl.setThreadBluetoothStackID(stackID);
+						String expected = LocalDevice.getProperty("bluecove.stack");
+						for (int j = 0; j < iterations; j++) {
+							if (BlueCoveImpl.getCurrentThreadBluetoothStackID() != stackID) {
+								throw new Error("Wrong stackID");
+							}
+							if (BlueCoveImpl.getThreadBluetoothStackID() != stackID) {
+								throw new Error("Wrong thread stackID");
+							}
+							if (!expected.equals(LocalDevice.getProperty("bluecove.stack"))) {
+								throw new Error("Wrong stack");
+							}
+						}
+					} catch (Throwable e) {
+						failure[0] = e;
+					}
+				}
+			};
+		}
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < threadsCount; i++) {
+			threads[i].start();
+		}
+		for (int i = 0; i < threadsCount; i++) {
+			threads[i].join();
+		}
+		long time = System.currentTimeMillis() - start;
+		if (failure[0] != null) {
+			fail(failure[0].toString());
+		}
+		return time;
+	}
+
+	public void testResolution() throws Exception {
+		runThreads(BlueCoveImpl.getThreadBluetoothStackID(), 4, 1000);
+	}
+}
@@ -79,6 +79,10 @@ SOURCE=.\common.cpp
 # End Source File
 # Begin Source File
 
+SOURCE=.\commonObjects.cpp
+# End Source File
+# Begin Source File
+
 SOURCE=.\commonTest.cpp
 # End Source File
 # Begin Source File
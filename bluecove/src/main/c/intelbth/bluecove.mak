@@ -38,7 +38,9 @@ CLEAN :
 	-@erase "$(INTDIR)\BlueSoleilStack.obj"
 	-@erase "$(INTDIR)\BlueSoleilStack.sbr"
 	-@erase "$(INTDIR)\common.obj"
+	-@erase "$(INTDIR)\commonObjects.obj"
 	-@erase "$(INTDIR)\common.sbr"
+	-@erase "$(INTDIR)\commonObjects.sbr"
 	-@erase "$(INTDIR)\commonTest.obj"
 	-@erase "$(INTDIR)\commonTest.sbr"
 	-@erase "$(INTDIR)\ToshibaStack.obj"
@@ -100,6 +102,7 @@ BSC32_FLAGS=/nologo /o"$(OUTDIR)\bluecove.bsc"
 BSC32_SBRS= \
 	"$(INTDIR)\BlueSoleilStack.sbr" \
 	"$(INTDIR)\common.sbr" \
+	"$(INTDIR)\commonObjects.sbr" \
 	"$(INTDIR)\commonTest.sbr" \
 	"$(INTDIR)\WIDCOMMStack.sbr" \
 	"$(INTDIR)\WIDCOMMStackRFCOMM.sbr" \
@@ -116,6 +119,7 @@ LINK32_FLAGS=ws2_32.lib version.lib advapi32.lib user32.lib winspool.lib ole32.l
 LINK32_OBJS= \
 	"$(INTDIR)\BlueSoleilStack.obj" \
 	"$(INTDIR)\common.obj" \
+	"$(INTDIR)\commonObjects.obj" \
 	"$(INTDIR)\commonTest.obj" \
 	"$(INTDIR)\WIDCOMMStack.obj" \
 	"$(INTDIR)\WIDCOMMStackRFCOMM.obj" \
@@ -158,6 +162,11 @@ SOURCE=.\common.cpp
 "$(INTDIR)\common.obj"	"$(INTDIR)\common.sbr" : $(SOURCE) "$(INTDIR)"
 
 
+SOURCE=.\commonObjects.cpp
+
+"$(INTDIR)\commonObjects.obj"	"$(INTDIR)\commonObjects.sbr" : $(SOURCE) "$(INTDIR)"
+
+
 SOURCE=.\commonTest.cpp
 
 "$(INTDIR)\commonTest.obj"	"$(INTDIR)\commonTest.sbr" : $(SOURCE) "$(INTDIR)"
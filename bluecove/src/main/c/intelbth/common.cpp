@@ -430,517 +430,3 @@ jint getDeviceClassByOS(JNIEnv *env) {
     return MAJOR_COMPUTER;
 #endif
 }
-
-#ifndef WIN32
-void InitializeCriticalSection(CRITICAL_SECTION *criticalRegion) {
-    MPCreateCriticalRegion(criticalRegion);
-}
-void DeleteCriticalSection(CRITICAL_SECTION *criticalRegion) {
-    MPDeleteCriticalRegion(*criticalRegion);
-}
-void EnterCriticalSection(CRITICAL_SECTION *criticalRegion) {
-    MPEnterCriticalRegion(*criticalRegion, kDurationForever);
-}
-void LeaveCriticalSection(CRITICAL_SECTION *criticalRegion) {
-    MPExitCriticalRegion(*criticalRegion);
-}
-#endif
-
-ReceiveBuffer::ReceiveBuffer() {
-    safe = RECEIVE_BUFFER_SAFE;
-    if (safe) InitializeCriticalSection(&lock);
-    this->size = RECEIVE_BUFFER_MAX;
-    reset();
-}
-
-ReceiveBuffer::ReceiveBuffer(int size) {
-    safe = RECEIVE_BUFFER_SAFE;
-    if (safe) InitializeCriticalSection(&lock);
-    this->size = size;
-    if (this->size > RECEIVE_BUFFER_MAX) {
-        this->size = RECEIVE_BUFFER_MAX;
-    }
-    reset();
-}
-
-ReceiveBuffer::~ReceiveBuffer() {
-    if (safe) DeleteCriticalSection(&lock);
-    magic1b = 0;
-    magic2b = 0;
-    magic1e = 0;
-    magic2e = 0;
-}
-
-void ReceiveBuffer::reset() {
-    rcv_idx = 0;
-    read_idx = 0;
-    overflown = FALSE;
-    full = FALSE;
-    magic1b = MAGIC_1;
-    magic2b = MAGIC_2;
-    magic1e = MAGIC_1;
-    magic2e = MAGIC_2;
-}
-
-BOOL ReceiveBuffer::isCorrupted() {
-    return ((magic1b != MAGIC_1) || (magic2b != MAGIC_2) || (magic1e != MAGIC_1) || (magic2e != MAGIC_2));
-}
-
-BOOL ReceiveBuffer::isOverflown() {
-    return overflown && (available() == 0);
-}
-
-void ReceiveBuffer::setOverflown() {
-    overflown = TRUE;
-}
-
-int ReceiveBuffer::write_buffer(void *p_data, int len) {
-    if (overflown) {
-        return 0;
-    }
-    int accept;
-    int _read_idx = read_idx;
-
-    if ((_read_idx == rcv_idx) && full) {
-        accept = 0;
-    } else if (_read_idx <= rcv_idx) {
-        accept = size - rcv_idx + _read_idx;
-    } else {
-        accept = _read_idx - rcv_idx;
-    }
-
-    if (accept > len) {
-        accept = len;
-    } else if (accept < len) {
-        overflown = TRUE;
-    }
-
-    if (accept != 0) {
-        if (rcv_idx + accept <= size) {
-            memcpy((buffer + rcv_idx), p_data, accept);
-            int new_rcv_idx = rcv_idx + accept;
-            if (new_rcv_idx >= size) {
-                new_rcv_idx = 0;
-            }
-            rcv_idx = new_rcv_idx;
-        } else {
-            // Read first part till the end of the buffer.
-            int accept_fill_end_size = size - rcv_idx;
-            memcpy((buffer + rcv_idx), p_data, accept_fill_end_size);
-            // Read second part at the beginning of the buffer.
-            int accept_fill_begin_size = accept - accept_fill_end_size;
-            memcpy(buffer, ((jbyte*)p_data + accept_fill_end_size), accept_fill_begin_size);
-            rcv_idx = accept_fill_begin_size;
-        }
-
-        if (read_idx == rcv_idx) {
-            full = TRUE;
-        }
-    }
-    return accept;
-}
-
-int ReceiveBuffer::write(void *p_data, int len) {
-    if (overflown) {
-        return 0;
-    }
-    if (safe) EnterCriticalSection(&lock);
-    int accept = write_buffer(p_data, len);
-    if (safe) LeaveCriticalSection(&lock);
-    return accept;
-}
-
-int ReceiveBuffer::write_with_len(void *p_data, int len) {
-    if (overflown) {
-        return 0;
-    }
-    if (safe) EnterCriticalSection(&lock);
-    int accept = write_buffer(&len, sizeof(int));
-    accept += write_buffer(p_data, len);
-    if (safe) LeaveCriticalSection(&lock);
-    return accept;
-}
-
-
-void ReceiveBuffer::incReadIdx(int count) {
-    int next_read_idx = read_idx + count;
-    if (next_read_idx >= size) {
-        next_read_idx -= size;
-    }
-    read_idx = next_read_idx;
-    full = FALSE;
-}
-
-int ReceiveBuffer::readByte() {
-    if (available() == 0) {
-        return -1;
-    }
-    if (safe) EnterCriticalSection(&lock);
-    jint result = (unsigned char)buffer[read_idx];
-    incReadIdx(1);
-    if (safe) LeaveCriticalSection(&lock);
-    return result;
-}
-
-int ReceiveBuffer::sizeof_len() {
-    return sizeof(int);
-}
-
-int ReceiveBuffer::read_len(int* len) {
-    return read(len, sizeof(int));
-}
-
-int ReceiveBuffer::read(void *p_data, int len) {
-    int count = available();
-    if (count == 0) {
-        return 0;
-    }
-    if (safe) EnterCriticalSection(&lock);
-    if (count > len) {
-        count = len;
-    }
-    if (read_idx + count < size) {
-        if (p_data != NULL) {
-            memcpy(p_data, (buffer + read_idx), count);
-        }
-    } else {
-        // Read first part from the end of the buffer.
-        int accept_fill_end_size = size - read_idx;
-        if (p_data != NULL) {
-            memcpy(p_data, (buffer + read_idx), accept_fill_end_size);
-        }
-        // Read second part from the beginning of the buffer.
-        int accept_fill_begin_size = count - accept_fill_end_size;
-        if (p_data != NULL) {
-            memcpy((jbyte*)p_data + accept_fill_end_size, buffer, accept_fill_begin_size);
-        }
-    }
-    incReadIdx(count);
-    if (safe) LeaveCriticalSection(&lock);
-    return count;
-}
-
-int ReceiveBuffer::skip(int n) {
-    return read(NULL, n);
-}
-
-int ReceiveBuffer::available() {
-    if (safe) EnterCriticalSection(&lock);
-    int rc;
-    int _rcv_idx = rcv_idx;
-    int _read_idx = read_idx;
-    if ((_read_idx == _rcv_idx) && full) {
-        rc = size;
-    } else if (_read_idx <= _rcv_idx) {
-        rc = (_rcv_idx - _read_idx);
-    } else {
-        rc = (_rcv_idx + (size - _read_idx));
-    }
-    if (safe) LeaveCriticalSection(&lock);
-    return rc;
-}
-
-// --------- ObjectPool -------------
-
-PoolableObject::PoolableObject() {
-    magic1 = MAGIC_1;
-    magic2 = MAGIC_2;
-    internalHandle = -1;
-    usedCount = 0;
-    readyToFree = FALSE;
-}
-
-PoolableObject::~PoolableObject() {
-    magic1 = 0;
-    magic2 = 0;
-#ifdef SAFE_OBJECT_DESTRUCTION
-    // Do not allow to free the object until thre are no functions in wait using it. e.g. read and write
-    while (usedCount > 0) {
-        Sleep(50);
-    }
-#endif
-}
-
-void PoolableObject::tInc() {
-#ifdef SAFE_OBJECT_DESTRUCTION
-    InterlockedIncrement(&usedCount);
-#endif
-}
-
-void PoolableObject::tDec() {
-#ifdef SAFE_OBJECT_DESTRUCTION
-    InterlockedDecrement(&usedCount);
-#endif
-}
-
-BOOL PoolableObject::isValidObject() {
-    return ((magic1 == MAGIC_1) && (magic2 == MAGIC_2));
-}
-
-BOOL PoolableObject::isExternalHandle(jlong handle) {
-    return FALSE;
-}
-
-ObjectPool::ObjectPool(int size, int handleOffset, BOOL delayDelete) {
-    InitializeCriticalSection(&lock);
-    this->size = size;
-    this->handleOffset = handleOffset;
-    this->delayDelete = delayDelete;
-    this->handleReturned = 0;
-    this->handleBatch = 0;
-    handleMove = 0;
-    objs = new PoolableObject* [size];
-    for(int i = 0; i < size; i ++) {
-        objs[i] = NULL;
-    }
-}
-
-ObjectPool::~ObjectPool() {
-    EnterCriticalSection(&lock);
-    PoolableObject** __objs = objs;
-    objs = NULL;
-    for(int i = 0; i < size; i ++) {
-        if (__objs[i] != NULL) {
-            PoolableObject* o = __objs[i];
-            __objs[i] = NULL;
-            delete o;
-        }
-    }
-    delete __objs;
-    LeaveCriticalSection(&lock);
-    DeleteCriticalSection(&lock);
-}
-
-jlong ObjectPool::realIndex(jlong internalHandle) {
-    return (internalHandle - handleOffset) % size;
-}
-
-jlong ObjectPool::realIndex(PoolableObject* obj) {
-    return realIndex(obj->internalHandle);
-}
-
-BOOL ObjectPool::addObject(PoolableObject* obj) {
-    //ndebug(("new Object %p", obj));
-    EnterCriticalSection(&lock);
-    if (objs == NULL) {
-        LeaveCriticalSection(&lock);
-        return FALSE;
-    }
-    int freeIndex = -1;
-    for(int k = 0; k < size; k++) {
-        int i = k + handleMove;
-        if (i >= size) {
-            i -= size;
-        }
-
-        if (delayDelete && (objs[i] != NULL)) {
-            if (objs[i]->readyToFree) {
-                delete objs[i];
-                objs[i] = NULL;
-            }
-        }
-
-        if (objs[i] == NULL) {
-            freeIndex = i;
-            objs[freeIndex] = obj;
-            long newHandle = handleOffset + freeIndex + handleBatch * size;
-            while (newHandle <= handleReturned) {
-                newHandle += size;
-                handleBatch ++;
-            }
-            // Start all over from start
-            if (newHandle >= INT_MAX) {
-                newHandle = handleOffset + freeIndex;
-                handleBatch = 0;
-            }
-            handleReturned = (int)newHandle;
-            obj->internalHandle = (int)newHandle;
-
-            handleMove ++;
-            if (handleMove >= size) {
-                handleMove = 0;
-            }
-
-            LeaveCriticalSection(&lock);
-            return TRUE;
-        }
-    }
-    LeaveCriticalSection(&lock);
-    return FALSE;
-}
-
-BOOL ObjectPool::hasObject(PoolableObject* obj) {
-    for(int i = 0; (objs != NULL) && (i < size); i++) {
-        if ((void*)objs[i] == (void*)obj) {
-            return TRUE;
-        }
-    }
-    return FALSE;
-}
-
-BOOL ObjectPool::addObject(PoolableObject* obj, char poolableObjectType) {
-    obj->poolableObjectType = poolableObjectType;
-    return addObject(obj);
-}
-
-PoolableObject* ObjectPool::getObject(JNIEnv *env, jlong handle) {
-    if ((handle <= 0) || (objs == NULL)) {
-        throwIOException(env, "[EAO] Invalid handle %i", handle);
-        return NULL;
-    }
-    jlong idx = realIndex(handle);
-    if ((idx < 0) || (idx >= size)) {
-        throwIOException(env, "[EAO] Obsolete handle %i", handle);
-        return NULL;
-    }
-    PoolableObject* o = objs[idx];
-    if (o == NULL) {
-        throwIOException(env, "[EAO] Destroyed handle %i", handle);
-        return NULL;
-    }
-    if (o->readyToFree) {
-        throwIOException(env, "[EAO] Delay delete object access %i", handle);
-        return NULL;
-    }
-    if ((o->magic1 != MAGIC_1) || (o->magic2 != MAGIC_2)) {
-        throwIOException(env, "[EAO] Corrupted object %i", handle);
-        return NULL;
-    }
-    if ((o->internalHandle != handle) || (!o->isValidObject())) {
-        throwIOException(env, "[EAO] Corrupted handle %i", handle);
-        return NULL;
-    }
-    return o;
-}
-
-PoolableObject* ObjectPool::getObject(JNIEnv *env, jlong handle, char poolableObjectType) {
-    PoolableObject* o = getObject(env, handle);
-    if ((o != NULL) && (o->poolableObjectType != poolableObjectType)) {
-        throwIOException(env, "[EAO] Invalid handle type %i", handle);
-        return NULL;
-    }
-    return o;
-}
-
-PoolableObject* ObjectPool::getObjectByExternalHandle(jlong handle) {
-    for(int i = 0; (objs != NULL) && (i < size); i ++) {
-        if (objs[i] != NULL) {
-            PoolableObject* o = objs[i];
-            if (o->isExternalHandle(handle)) {
-                return o;
-            }
-        }
-    }
-    return NULL;
-}
-
-void ObjectPool::removeObject(PoolableObject* obj) {
-    jlong idx = realIndex(obj);
-    if ((idx >= 0) && (idx < size) && (objs != NULL)) {
-        objs[idx] = NULL;
-    }
-}
-
-DeviceInquiryCallback::DeviceInquiryCallback() {
-    this->inquiryRunnable = NULL;
-    this->deviceDiscoveredCallbackMethod = NULL;
-    this->startedNotify = NULL;
-    this->startedNotifyNotifyMethod = NULL;
-}
-
-BOOL DeviceInquiryCallback::builDeviceInquiryCallbacks(JNIEnv * env, jobject inquiryRunnable, jobject startedNotify) {
-    jclass inquiryRunnableClass = env->GetObjectClass(inquiryRunnable);
-
-    if (inquiryRunnableClass == NULL) {
-        throwRuntimeException(env, "Fail to get Object Class");
-        return FALSE;
-    }
-
-    jmethodID deviceDiscoveredCallbackMethod = env->GetMethodID(inquiryRunnableClass, "deviceDiscoveredCallback", "(Ljavax/bluetooth/DiscoveryListener;JILjava/lang/String;Z)V");
-    if (deviceDiscoveredCallbackMethod == NULL) {
-        throwRuntimeException(env, "Fail to get MethodID deviceDiscoveredCallback");
-        return FALSE;
-    }
-
-    jclass notifyClass = env->GetObjectClass(startedNotify);
-    if (notifyClass == NULL) {
-        throwRuntimeException(env, "Fail to get Object Class");
-        return FALSE;
-    }
-    jmethodID notifyMethod = env->GetMethodID(notifyClass, "deviceInquiryStartedCallback", "()V");
-    if (notifyMethod == NULL) {
-        throwRuntimeException(env, "Fail to get MethodID deviceInquiryStartedCallback");
-        return FALSE;
-    }
-
-    this->inquiryRunnable = inquiryRunnable;
-    this->deviceDiscoveredCallbackMethod = deviceDiscoveredCallbackMethod;
-    this->startedNotify = startedNotify;
-    this->startedNotifyNotifyMethod = notifyMethod;
-
-    return TRUE;
-}
-
-BOOL DeviceInquiryCallback::callDeviceInquiryStartedCallback(JNIEnv * env) {
-    if ((this->startedNotify == NULL) || (this->startedNotifyNotifyMethod == NULL)) {
-        throwRuntimeException(env, "DeviceInquiryCallback not initialized");
-        return FALSE;
-    }
-    env->CallVoidMethod(this->startedNotify, this->startedNotifyNotifyMethod);
-    if (ExceptionCheckCompatible(env)) {
-        return FALSE;
-    } else {
-        return TRUE;
-    }
-}
-
-BOOL DeviceInquiryCallback::callDeviceDiscovered(JNIEnv * env, jobject listener, jlong deviceAddr, jint deviceClass, jstring name, jboolean paired) {
-    if ((this->inquiryRunnable == NULL) || (this->deviceDiscoveredCallbackMethod == NULL)) {
-        throwRuntimeException(env, "DeviceInquiryCallback not initialized");
-        return FALSE;
-    }
-    env->CallVoidMethod(this->inquiryRunnable, this->deviceDiscoveredCallbackMethod, listener, deviceAddr, deviceClass, name, paired);
-    if (ExceptionCheckCompatible(env)) {
-        return FALSE;
-    } else {
-        return TRUE;
-    }
-}
-
-// --------------------
-
-RetrieveDevicesCallback::RetrieveDevicesCallback() {
-    this->listener = NULL;
-    this->deviceFoundCallbackMethod = NULL;
-}
-
-BOOL RetrieveDevicesCallback::builCallback(JNIEnv * env, jobject peer, jobject listener) {
-    jclass listenerClass = env->GetObjectClass(listener);
-
-    if (listenerClass == NULL) {
-        throwRuntimeException(env, "Fail to get Object Class");
-        return FALSE;
-    }
-
-    jmethodID callbackMethod = env->GetMethodID(listenerClass, "deviceFoundCallback", "(JILjava/lang/String;Z)V");
-    if (callbackMethod == NULL) {
-        throwRuntimeException(env, "Fail to get MethodID deviceFoundCallback");
-        return FALSE;
-    }
-    this->listener = listener;
-    this->deviceFoundCallbackMethod = callbackMethod;
-    return TRUE;
-}
-
-BOOL RetrieveDevicesCallback::callDeviceFoundCallback(JNIEnv * env, jlong deviceAddr, jint deviceClass, jstring name, jboolean paired) {
-    if ((this->listener == NULL) || (this->deviceFoundCallbackMethod == NULL)) {
-        throwRuntimeException(env, "deviceFoundCallback not initialized");
-        return FALSE;
-    }
-    env->CallVoidMethod(this->listener, this->deviceFoundCallbackMethod, deviceAddr, deviceClass, name, paired);
-    if (ExceptionCheckCompatible(env)) {
-        return FALSE;
-    } else {
-        return TRUE;
-    }
-}
@@ -114,22 +114,33 @@ typedef signed char jbyte;
 
 #else
 
-// OS X
+// OS X and other POSIX systems
 #include <unistd.h>
+#ifdef __APPLE__
 #include <CoreFoundation/CoreFoundation.h>
 #include <Carbon/Carbon.h>
+#endif
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <limits.h>
 
 #define BOOL bool
-//#define TRUE true
-//#define FALSE false
+#ifndef TRUE
+#define TRUE true
+#endif
+#ifndef FALSE
+#define FALSE false
+#endif
 #define DWORD unsigned int
 
 #include <wchar.h>
 #define WCHAR wchar_t
 
-#define CRITICAL_SECTION MPCriticalRegionID
+// CRITICAL_SECTION emulation
+#include "commonLock.h"
 
-#define swprintf_s snwprintf
+#define swprintf_s swprintf
 #define sprintf_s snprintf
 #define _vsnprintf_s vsnprintf
 
@@ -0,0 +1,98 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2008 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @version $Id$
+ */
+
+#pragma once
+
+/*
+* Win32 CRITICAL_SECTION and Interlocked API for non Windows platforms.
+*
+* pthread recursive mutex is used by default. Define BLUECOVE_STD_MUTEX to use C++11 std::recursive_mutex.
+* Both are reentrant the same way Win32 CRITICAL_SECTION is.
+*/
+
+#ifdef BLUECOVE_STD_MUTEX
+
+#include <mutex>
+#include <thread>
+#include <chrono>
+
+typedef std::recursive_mutex CRITICAL_SECTION;
+
+inline void InitializeCriticalSection(CRITICAL_SECTION *criticalSection) {
+}
+
+inline void DeleteCriticalSection(CRITICAL_SECTION *criticalSection) {
+}
+
+inline void EnterCriticalSection(CRITICAL_SECTION *criticalSection) {
+    criticalSection->lock();
+}
+
+inline void LeaveCriticalSection(CRITICAL_SECTION *criticalSection) {
+    criticalSection->unlock();
+}
+
+inline void Sleep(DWORD dwMilliseconds) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(dwMilliseconds));
+}
+
+#else // BLUECOVE_STD_MUTEX
+
+#include <pthread.h>
+
+typedef pthread_mutex_t CRITICAL_SECTION;
+
+inline void InitializeCriticalSection(CRITICAL_SECTION *criticalSection) {
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(criticalSection, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+inline void DeleteCriticalSection(CRITICAL_SECTION *criticalSection) {
+    pthread_mutex_destroy(criticalSection);
+}
+
+inline void EnterCriticalSection(CRITICAL_SECTION *criticalSection) {
+    pthread_mutex_lock(criticalSection);
+}
+
+inline void LeaveCriticalSection(CRITICAL_SECTION *criticalSection) {
+    pthread_mutex_unlock(criticalSection);
+}
+
+inline void Sleep(DWORD dwMilliseconds) {
+    usleep(dwMilliseconds * 1000);
+}
+
+#endif // BLUECOVE_STD_MUTEX
+
+inline long InterlockedIncrement(long volatile *addend) {
+    return __sync_add_and_fetch(addend, 1);
+}
+
+inline long InterlockedDecrement(long volatile *addend) {
+    return __sync_sub_and_fetch(addend, 1);
+}
@@ -99,6 +99,33 @@ public interface BlueCoveConfigProperties {
      */
     public static final String PROPERTY_LOCAL_DEVICE_ADDRESS = "bluecove.deviceAddress";
 
+    /**
+     * Linux BlueZ only. "true" to use all local adapters: client RFCOMM and
+     * L2CAP connections and service searches are distributed between them and
+     * Device Inquiry runs on all adapters in parallel. Adapter selected by
+     * "bluecove.deviceID" or "bluecove.deviceAddress" is used for everything
+     * else. Defaults to false. Initialization property.
+     */
+    public static final String PROPERTY_BLUEZ_ADAPTER_POOL = "bluecove.bluez.adapter_pool";
+
+    /**
+     * Class implementing com.intel.bluetooth.BluetoothStackBlueZAdapterPolicy
+     * used to select adapter from the pool. By default adapter already
+     * connected to the remote device is used, otherwise the one with the least
+     * ACL links. Initialization property.
+     */
+    public static final String PROPERTY_BLUEZ_ADAPTER_POLICY = "bluecove.bluez.adapter_policy";
+
+    /**
+     * Linux BlueZ only. Number of client connections each adapter may page at
+     * the same time, other RFCOMM and L2CAP connections wait in BlueCove queue
+     * by thread priority and "bluecove.connect.timeout" deadline. Connections
+     * to devices with existing ACL link are not queued. Use 1 as controller
+     * pages one device at a time. Defaults to 0, connections are not queued.
+     * Initialization property.
+     */
+    public static final String PROPERTY_BLUEZ_CONNECT_SCHEDULER = "bluecove.bluez.connect_scheduler";
+
     /**
      * JSR-82 simulator class. Initialization property.
      */
@@ -129,13 +156,14 @@ public interface BlueCoveConfigProperties {
      * initialized.
      */
     public static final String[] INITIALIZATION_PROPERTIES = new String[] { PROPERTY_STACK, PROPERTY_STACK_FIRST, PROPERTY_NATIVE_RESOURCE,
-            PROPERTY_NATIVE_RESOURCE, PROPERTY_BLUEZ_CLASS, PROPERTY_LOCAL_DEVICE_ID, PROPERTY_LOCAL_DEVICE_ADDRESS, PROPERTY_EMULATOR_CLASS, PROPERTY_EMULATOR_HOST, PROPERTY_EMULATOR_PORT };
+            PROPERTY_NATIVE_RESOURCE, PROPERTY_BLUEZ_CLASS, PROPERTY_LOCAL_DEVICE_ID, PROPERTY_LOCAL_DEVICE_ADDRESS, PROPERTY_BLUEZ_ADAPTER_POOL,
+            PROPERTY_BLUEZ_ADAPTER_POLICY, PROPERTY_BLUEZ_CONNECT_SCHEDULER, PROPERTY_EMULATOR_CLASS, PROPERTY_EMULATOR_HOST, PROPERTY_EMULATOR_PORT };
 
     /**
      * The amount of time in milliseconds for which the implementation will
      * attempt to establish connection RFCOMM or L2CAP before it throws
-     * BluetoothConnectionException. Defaults to 2 minutes. WIDCOMM and OS X
-     * only.
+     * BluetoothConnectionException. Defaults to 2 minutes. WIDCOMM, OS X and
+     * BlueZ only.
      */
     public static final String PROPERTY_CONNECT_TIMEOUT = "bluecove.connect.timeout";
 
@@ -147,6 +175,32 @@ public interface BlueCoveConfigProperties {
      */
     public static final String PROPERTY_CONNECT_UNREACHABLE_RETRY = "bluecove.connect.unreachable_retry";
 
+    /**
+     * Size in bytes of RFCOMM InputStream read-ahead buffer. read() and reads
+     * smaller than the buffer are served from data received by one bulk native
+     * read, e.g. 1024. Defaults to 0, read directly from the stack.
+     */
+    public static final String PROPERTY_RFCOMM_READ_AHEAD = "bluecove.rfcomm.read_ahead";
+
+    static final int PROPERTY_RFCOMM_READ_AHEAD_DEFAULT = 0;
+
+    /**
+     * Size in bytes of RFCOMM OutputStream coalescing buffer, use RFCOMM frame
+     * size of the connection. Small writes are sent together on flush(), when
+     * the buffer is full or after "bluecove.rfcomm.write_delay". Defaults to 0,
+     * every write is sent to the stack.
+     */
+    public static final String PROPERTY_RFCOMM_WRITE_COALESCE = "bluecove.rfcomm.write_coalesce";
+
+    /**
+     * Time in microseconds coalesced RFCOMM data waits for more writes before
+     * it is sent, rounded up to milliseconds. Set 0 to send only on flush()
+     * and full buffer. Defaults to 1000.
+     */
+    public static final String PROPERTY_RFCOMM_WRITE_DELAY = "bluecove.rfcomm.write_delay";
+
+    static final int PROPERTY_RFCOMM_WRITE_DELAY_DEFAULT = 1000;
+
     /**
      * Device Inquiry time in seconds defaults to 11 seconds. MS Stack and OS X
      * only.
@@ -167,6 +221,14 @@ public interface BlueCoveConfigProperties {
      */
     public static final String PROPERTY_OBEX_MTU = "bluecove.obex.mtu";
 
+    /**
+     * Propose the largest OBEX MTU the transport supports: 0xFFFF for tcpobex,
+     * RFCOMM socket buffer size when the stack can report it. The value of
+     * "bluecove.obex.mtu" is used when transport limit is not known.
+     * Defaults to false.
+     */
+    public static final String PROPERTY_OBEX_MTU_AUTO = "bluecove.obex.mtu_auto";
+
     /**
      * The amount of time in milliseconds for which the implementation will
      * attempt to successfully transmit a packet before it throws
@@ -174,6 +236,21 @@ public interface BlueCoveConfigProperties {
      */
     public static final String PROPERTY_OBEX_TIMEOUT = "bluecove.obex.timeout";
 
+    /**
+     * Use OBEX 1.5 Single Response Mode for PUT and GET when peer supports it.
+     * Body packets are sent without waiting for response to each one.
+     * Defaults to false.
+     */
+    public static final String PROPERTY_OBEX_SRM = "bluecove.obex.srm";
+
+    /**
+     * Maximum number of threads serving sessions accepted by one OBEX
+     * SessionNotifier. Sessions are queued when all threads are busy, idle
+     * session gives its thread to the waiting one. Defaults to 0, a new thread
+     * is created for each session.
+     */
+    public static final String PROPERTY_OBEX_SERVER_POOL = "bluecove.obex.server_pool";
+
     /**
      * Remove JSR-82 1.1 restriction for legal PSM values are in the range
      * (0x1001..0xFFFF).
@@ -161,18 +161,26 @@ public class BlueCoveImpl {
 
     private static ShutdownHookThread shutdownHookRegistered;
 
-    private static BlueCoveImpl instance;
+    /*
+     * Stack resolution reads these without lock, they are only changed under the class lock.
+     */
+    private static volatile BlueCoveImpl instance;
 
-    private static BluetoothStackHolder singleStack;
+    private static volatile BluetoothStackHolder singleStack;
 
-    private static ThreadLocalWrapper threadStack;
+    private static volatile ThreadLocalWrapper threadStack;
 
-    private static BluetoothStackHolder threadStackIDDefault;
+    private static volatile BluetoothStackHolder threadStackIDDefault;
 
     private static Hashtable resourceConfigProperties = new Hashtable();
 
     private static Hashtable/* <BluetoothStack, BluetoothStackHolder> */stacks = new Hashtable();
 
+    /**
+     * Immutable copy of stacks values, replaced on every change of stacks.
+     */
+    private static volatile BluetoothStackHolder[] stackHolders = new BluetoothStackHolder[0];
+
     private static Vector initializationProperties = new Vector();
 
     static {
@@ -187,7 +195,7 @@ public class BlueCoveImpl {
      */
     private static class BluetoothStackHolder {
 
-        private BluetoothStack bluetoothStack;
+        private volatile BluetoothStack bluetoothStack;
 
         Hashtable configProperties = new Hashtable();
 
@@ -241,6 +249,7 @@ public class BlueCoveImpl {
                     }
                 }
                 stacks.clear();
+                updateStackHolders();
                 System.out.println("BlueCove stack shutdown completed");
             }
             synchronized (monitor) {
@@ -292,13 +301,32 @@ public class BlueCoveImpl {
      *
      * @return Instance of the class, getBluetoothStack() can be called.
      */
-    public static synchronized BlueCoveImpl instance() {
+    public static BlueCoveImpl instance() {
+        BlueCoveImpl i = instance;
+        if (i != null) {
+            return i;
+        }
+        return createInstance();
+    }
+
+    private static synchronized BlueCoveImpl createInstance() {
         if (instance == null) {
             instance = new BlueCoveImpl();
         }
         return instance;
     }
 
+    private static void updateStackHolders() {
+        synchronized (stacks) {
+            BluetoothStackHolder[] holders = new BluetoothStackHolder[stacks.size()];
+            int i = 0;
+            for (Enumeration en = stacks.elements(); en.hasMoreElements();) {
+                holders[i++] = (BluetoothStackHolder) en.nextElement();
+            }
+            stackHolders = holders;
+        }
+    }
+
     private BlueCoveImpl() {
         try {
             accessControlContext = AccessController.getContext();
@@ -643,7 +671,18 @@ public class BlueCoveImpl {
      * @throws BluetoothStateException
      *             if the Bluetooth system could not be initialized
      */
-    public static synchronized Object getThreadBluetoothStackID() throws BluetoothStateException {
+    public static Object getThreadBluetoothStackID() throws BluetoothStateException {
+        ThreadLocalWrapper ts = threadStack;
+        if (ts != null) {
+            BluetoothStackHolder s = (BluetoothStackHolder) ts.get();
+            if ((s != null) && (s.bluetoothStack != null)) {
+                return s;
+            }
+        }
+        return initializeThreadBluetoothStackID();
+    }
+
+    private static synchronized Object initializeThreadBluetoothStackID() throws BluetoothStateException {
         useThreadLocalBluetoothStack();
         BluetoothStackHolder.getBluetoothStack();
         return threadStack.get();
@@ -656,11 +695,12 @@ public class BlueCoveImpl {
      *         call to <code>setThreadBluetoothStackID</code> or
      *         <code>null<code> if ThreadLocalBluetoothStack not used.
      */
-    public static synchronized Object getCurrentThreadBluetoothStackID() {
-        if (threadStack == null) {
+    public static Object getCurrentThreadBluetoothStackID() {
+        ThreadLocalWrapper ts = threadStack;
+        if (ts == null) {
             return null;
         }
-        return threadStack.get();
+        return ts.get();
     }
 
     /**
@@ -672,25 +712,27 @@ public class BlueCoveImpl {
      * @param stackID
      *            stackID to use or <code>null</code> to detach the current Thread
      */
-    public static synchronized void setThreadBluetoothStackID(Object stackID) {
+    public static void setThreadBluetoothStackID(Object stackID) {
         if ((stackID != null) && (!(stackID instanceof BluetoothStackHolder))) {
             throw new IllegalArgumentException("stackID is not valid");
         }
-        if (threadStack == null) {
+        ThreadLocalWrapper ts = threadStack;
+        if (ts == null) {
             throw new IllegalArgumentException("ThreadLocal configuration is not initialized");
         }
-        threadStack.set(stackID);
+        ts.set(stackID);
     }
 
     /**
      * Detach BluetoothStack from ThreadLocal. Used for removing itself from container
      * threads. Also can be use to initialize different stack in the same thread.
      */
-    public static synchronized void releaseThreadBluetoothStack() {
-        if (threadStack == null) {
+    public static void releaseThreadBluetoothStack() {
+        ThreadLocalWrapper ts = threadStack;
+        if (ts == null) {
             throw new IllegalArgumentException("ThreadLocal configuration is not initialized");
         }
-        threadStack.set(null);
+        ts.set(null);
     }
 
     /**
@@ -712,20 +754,23 @@ public class BlueCoveImpl {
         threadStackIDDefault = (BluetoothStackHolder) stackID;
     }
 
-    static synchronized void setThreadBluetoothStack(BluetoothStack bluetoothStack) {
-        if (threadStack == null) {
+    static void setThreadBluetoothStack(BluetoothStack bluetoothStack) {
+        ThreadLocalWrapper ts = threadStack;
+        if (ts == null) {
             return;
         }
-        BluetoothStackHolder s = ((BluetoothStackHolder) threadStack.get());
+        BluetoothStackHolder s = ((BluetoothStackHolder) ts.get());
         if ((s != null) && (s.bluetoothStack == bluetoothStack)) {
             return;
         }
-
-        BluetoothStackHolder sh = (BluetoothStackHolder) stacks.get(bluetoothStack);
-        if (sh == null) {
-            throw new RuntimeException("ThreadLocal not found for BluetoothStack");
+        BluetoothStackHolder[] holders = stackHolders;
+        for (int i = 0; i < holders.length; i++) {
+            if (holders[i].bluetoothStack == bluetoothStack) {
+                ts.set(holders[i]);
+                return;
+            }
         }
-        threadStack.set(sh);
+        throw new RuntimeException("ThreadLocal not found for BluetoothStack");
     }
 
     /**
@@ -748,8 +793,10 @@ public class BlueCoveImpl {
         if (s.bluetoothStack != null) {
             BluetoothConnectionNotifierBase.shutdownConnections(s.bluetoothStack);
             RemoteDeviceHelper.shutdownConnections(s.bluetoothStack);
+            BluetoothConnectDriver.shutdownConnections(s.bluetoothStack);
             s.bluetoothStack.destroy();
             stacks.remove(s.bluetoothStack);
+            updateStackHolders();
             s.bluetoothStack = null;
         }
     }
@@ -764,6 +811,7 @@ public class BlueCoveImpl {
             if (s.bluetoothStack != null) {
                 BluetoothConnectionNotifierBase.shutdownConnections(s.bluetoothStack);
                 RemoteDeviceHelper.shutdownConnections(s.bluetoothStack);
+                BluetoothConnectDriver.shutdownConnections(s.bluetoothStack);
                 try {
                     s.bluetoothStack.destroy();
                 } finally {
@@ -772,6 +820,7 @@ public class BlueCoveImpl {
             }
         }
         stacks.clear();
+        updateStackHolders();
         singleStack = null;
         threadStackIDDefault = null;
         if (shutdownHookRegistered != null) {
@@ -977,15 +1026,19 @@ public class BlueCoveImpl {
     private synchronized BluetoothStack setBluetoothStack(String stack, BluetoothStack detectorStack) throws BluetoothStateException {
         if (singleStack != null) {
             if (singleStack.bluetoothStack != null) {
+                BluetoothConnectDriver.shutdownConnections(singleStack.bluetoothStack);
                 singleStack.bluetoothStack.destroy();
                 stacks.remove(singleStack.bluetoothStack);
+                updateStackHolders();
                 singleStack.bluetoothStack = null;
             }
         } else if (threadStack != null) {
             BluetoothStackHolder s = ((BluetoothStackHolder) threadStack.get());
             if ((s != null) && (s.bluetoothStack != null)) {
+                BluetoothConnectDriver.shutdownConnections(s.bluetoothStack);
                 s.bluetoothStack.destroy();
                 stacks.remove(s.bluetoothStack);
+                updateStackHolders();
                 s.bluetoothStack = null;
             }
         }
@@ -1018,6 +1071,7 @@ public class BlueCoveImpl {
         BluetoothStackHolder sh = currentStackHolder(true);
         sh.bluetoothStack = newStack;
         stacks.put(newStack, sh);
+        updateStackHolders();
         if (threadStack != null) {
             threadStack.set(sh);
         }
@@ -1060,8 +1114,20 @@ public class BlueCoveImpl {
      * @exception Error
      *                if called from outside of BlueCove internal code.
      */
-    public synchronized BluetoothStack getBluetoothStack() throws BluetoothStateException {
+    public BluetoothStack getBluetoothStack() throws BluetoothStateException {
         Utils.isLegalAPICall(fqcnSet);
+        // Lock free for initialized stack
+        BluetoothStackHolder sh = currentStackHolder(false);
+        if (sh != null) {
+            BluetoothStack stack = sh.bluetoothStack;
+            if (stack != null) {
+                return stack;
+            }
+        }
+        return initializeBluetoothStack();
+    }
+
+    private synchronized BluetoothStack initializeBluetoothStack() throws BluetoothStateException {
         BluetoothStackHolder sh = currentStackHolder(false);
         if ((sh != null) && (sh.bluetoothStack != null)) {
             return sh.bluetoothStack;
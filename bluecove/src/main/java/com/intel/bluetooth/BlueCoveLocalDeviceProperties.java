@@ -73,6 +73,12 @@ public interface BlueCoveLocalDeviceProperties {
 	 */
 	public static final String LOCAL_DEVICE_PROPERTY_OPEN_CONNECTIONS = "bluecove.connections";
 
+	/**
+	 * <code>"bluecove.connect.statistics"</code> Client connection attempts, failures and time in milliseconds
+	 * spent waiting for page and connecting. Linux BlueZ with "bluecove.bluez.connect_scheduler" only.
+	 */
+	public static final String LOCAL_DEVICE_PROPERTY_CONNECT_STATISTICS = "bluecove.connect.statistics";
+
 	/**
 	 * If Stack support multiple bluetooth adapters return selected one ID. (Linux BlueZ and Emulator)
 	 * 
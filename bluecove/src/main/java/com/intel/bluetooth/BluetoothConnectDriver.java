@@ -0,0 +1,261 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.util.Hashtable;
+import java.util.Vector;
+
+import javax.microedition.io.Connection;
+
+/**
+ * Waits for client connections started by MicroeditionConnector.openAsync. One daemon thread per stack serves all
+ * connections in progress and ends when none is left.
+ */
+class BluetoothConnectDriver implements Runnable {
+
+	private static final int SHUTDOWN_TIMEOUT = 5 * 1000;
+
+	/**
+	 * Connections queued by the stack are started again at least at this interval.
+	 */
+	private static final int START_RETRY_INTERVAL = 1000;
+
+	static final Hashtable/* <BluetoothStack, BluetoothConnectDriver> */drivers = new Hashtable();
+
+	private final BluetoothStackConnectAsync stack;
+
+	private final Vector/* <BluetoothConnectionFuture> */pending = new Vector();
+
+	private Thread thread;
+
+	private boolean shutdown = false;
+
+	private BluetoothConnectDriver(BluetoothStackConnectAsync stack) {
+		this.stack = stack;
+	}
+
+	private static BluetoothConnectDriver getDriver(BluetoothStack bluetoothStack) {
+		synchronized (drivers) {
+			BluetoothConnectDriver driver = (BluetoothConnectDriver) drivers.get(bluetoothStack);
+			if (driver == null) {
+				driver = new BluetoothConnectDriver((BluetoothStackConnectAsync) bluetoothStack);
+				drivers.put(bluetoothStack, driver);
+			}
+			return driver;
+		}
+	}
+
+	static void add(BluetoothConnectionFuture future) {
+		if (future.getTimeout() > 0) {
+			future.deadline = System.currentTimeMillis() + future.getTimeout();
+		}
+		BluetoothConnectDriver driver = getDriver(future.getBluetoothStack());
+		boolean running;
+		synchronized (driver.pending) {
+			driver.pending.addElement(future);
+			running = (driver.thread != null);
+			if (!running) {
+				driver.thread = new Thread(driver, "BluetoothConnectDriver");
+				UtilsJavaSE.threadSetDaemon(driver.thread);
+				driver.thread.start();
+			}
+		}
+		if (running) {
+			driver.stack.connectionWakeup();
+		}
+	}
+
+	static void wakeup(BluetoothConnectionFuture future) {
+		BluetoothConnectDriver driver = (BluetoothConnectDriver) drivers.get(future.getBluetoothStack());
+		if (driver != null) {
+			driver.stack.connectionWakeup();
+		}
+	}
+
+	/**
+	 * Called before the stack is destroyed. Connections in progress fail and the driver thread ends.
+	 */
+	static void shutdownConnections(BluetoothStack bluetoothStack) {
+		BluetoothConnectDriver driver = (BluetoothConnectDriver) drivers.remove(bluetoothStack);
+		if (driver == null) {
+			return;
+		}
+		Thread running;
+		synchronized (driver.pending) {
+			driver.shutdown = true;
+			running = driver.thread;
+		}
+		if (running == null) {
+			return;
+		}
+		driver.stack.connectionWakeup();
+		try {
+			running.join(SHUTDOWN_TIMEOUT);
+		} catch (InterruptedException e) {
+		}
+	}
+
+	private void remove(BluetoothConnectionFuture future) {
+		synchronized (pending) {
+			pending.removeElement(future);
+		}
+	}
+
+	/**
+	 * @return <code>false</code> while the connection is queued by the stack or when starting it failed, the
+	 *         future is failed in that case
+	 */
+	private boolean startQueued(BluetoothConnectionFuture future) {
+		if (future.handle != 0) {
+			return true;
+		}
+		try {
+			return future.startConnection();
+		} catch (IOException e) {
+			remove(future);
+			future.failed(e);
+			return false;
+		}
+	}
+
+	private void finish(BluetoothConnectionFuture future) {
+		remove(future);
+		try {
+			stack.connectionFinish(future.handle);
+		} catch (IOException e) {
+			future.closeHandle();
+			future.failed(e);
+			return;
+		}
+		Connection connection;
+		try {
+			connection = future.createConnection(future.handle);
+		} catch (IOException e) {
+			future.failed(e);
+			return;
+		}
+		// cancel() may have returned true after the isCanceled() check, nobody else would close the connection
+		if (!future.completed(connection)) {
+			try {
+				connection.close();
+			} catch (IOException e) {
+				DebugLog.error("close canceled connection", e);
+			}
+			future.failed(new InterruptedIOException("Connection canceled"));
+		}
+	}
+
+	public void run() {
+		BluetoothConnectionFuture[] futures = new BluetoothConnectionFuture[0];
+		long[] handles = new long[0];
+		boolean[] ready = new boolean[0];
+		while (true) {
+			int count;
+			boolean stop;
+			synchronized (pending) {
+				count = pending.size();
+				if (count == 0) {
+					thread = null;
+					return;
+				}
+				if (futures.length < count) {
+					futures = new BluetoothConnectionFuture[count];
+					handles = new long[count];
+					ready = new boolean[count];
+				}
+				pending.copyInto(futures);
+				stop = shutdown;
+				if (stop) {
+					pending.removeAllElements();
+					thread = null;
+				}
+			}
+			if (stop) {
+				for (int i = 0; i < count; i++) {
+					futures[i].closeHandle();
+					futures[i].failed(new IOException("Bluetooth stack shutdown"));
+				}
+				return;
+			}
+			long now = System.currentTimeMillis();
+			int timeout = -1;
+			int waiting = 0;
+			boolean queued = false;
+			for (int i = 0; i < count; i++) {
+				BluetoothConnectionFuture future = futures[i];
+				if (future.isCanceled()) {
+					remove(future);
+					future.closeHandle();
+					future.failed(new InterruptedIOException("Connection canceled"));
+				} else if ((future.deadline != 0) && (future.deadline <= now)) {
+					remove(future);
+					future.closeHandle();
+					future.timeout();
+				} else if (startQueued(future) || !future.isDone()) {
+					if (future.deadline != 0) {
+						int remaining = (int) (future.deadline - now);
+						if ((timeout < 0) || (remaining < timeout)) {
+							timeout = remaining;
+						}
+					}
+					if (future.handle == 0) {
+						queued = true;
+					} else {
+						futures[waiting] = future;
+						handles[waiting] = future.handle;
+						ready[waiting] = false;
+						waiting++;
+					}
+				}
+			}
+			if (queued && ((timeout < 0) || (timeout > START_RETRY_INTERVAL))) {
+				timeout = START_RETRY_INTERVAL;
+			}
+			if ((waiting == 0) && (!queued)) {
+				continue;
+			}
+			try {
+				if (stack.connectionWait(handles, waiting, ready, timeout) == 0) {
+					continue;
+				}
+			} catch (IOException e) {
+				DebugLog.error("connection wait", e);
+				for (int i = 0; i < waiting; i++) {
+					remove(futures[i]);
+					futures[i].closeHandle();
+					futures[i].failed(e);
+				}
+				continue;
+			}
+			for (int i = 0; i < waiting; i++) {
+				if (ready[i]) {
+					finish(futures[i]);
+				}
+			}
+		}
+	}
+}
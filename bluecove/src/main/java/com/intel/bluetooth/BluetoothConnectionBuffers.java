@@ -0,0 +1,43 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * Connection that knows how much data the transport can buffer, used by OBEX to select MTU.
+ * 
+ * <p>
+ * <b><u>Your application should not use this class directly.</u></b>
+ * 
+ */
+public interface BluetoothConnectionBuffers {
+
+	/**
+	 * @return the smaller of send and receive buffer sizes in bytes or -1 if not known
+	 */
+	public int getTransportBufferSize() throws IOException;
+
+}
@@ -0,0 +1,263 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+
+import javax.bluetooth.BluetoothConnectionException;
+import javax.microedition.io.Connection;
+
+import com.intel.bluetooth.obex.OBEXClientSessionImpl;
+import com.intel.bluetooth.obex.OBEXConnectionParams;
+
+/**
+ * Result of {@link com.intel.bluetooth.MicroeditionConnector#openAsync(String)}.
+ * <p>
+ * When the stack supports it RFCOMM, L2CAP and OBEX client connections are established by one BlueCove thread,
+ * otherwise the connection is opened before openAsync returns.
+ */
+public class BluetoothConnectionFuture {
+
+	private static final int RFCOMM = 1;
+
+	private static final int L2CAP = 2;
+
+	private static final int OBEX = 3;
+
+	private int type;
+
+	private BluetoothStack bluetoothStack;
+
+	private BluetoothConnectionParams params;
+
+	private OBEXConnectionParams obexConnectionParams;
+
+	private int receiveMTU;
+
+	private int transmitMTU;
+
+	long handle;
+
+	long deadline;
+
+	private boolean done;
+
+	private boolean canceled;
+
+	private Connection connection;
+
+	private IOException exception;
+
+	BluetoothConnectionFuture() {
+	}
+
+	void startRFCOMM(BluetoothStack bluetoothStack, BluetoothConnectionParams params,
+			OBEXConnectionParams obexConnectionParams) throws IOException {
+		this.type = (obexConnectionParams == null) ? RFCOMM : OBEX;
+		this.bluetoothStack = bluetoothStack;
+		this.params = params;
+		this.obexConnectionParams = obexConnectionParams;
+		if (bluetoothStack instanceof BluetoothStackConnectAsync) {
+			startConnection();
+			BluetoothConnectDriver.add(this);
+		} else {
+			completed(createConnection(bluetoothStack.connectionRfOpenClientConnection(params)));
+		}
+	}
+
+	void startL2CAP(BluetoothStack bluetoothStack, BluetoothConnectionParams params, int receiveMTU, int transmitMTU)
+			throws IOException {
+		this.type = L2CAP;
+		this.bluetoothStack = bluetoothStack;
+		this.params = params;
+		this.receiveMTU = receiveMTU;
+		this.transmitMTU = transmitMTU;
+		if (bluetoothStack instanceof BluetoothStackConnectAsync) {
+			startConnection();
+			BluetoothConnectDriver.add(this);
+		} else {
+			completed(createConnection(bluetoothStack.l2OpenClientConnection(params, receiveMTU, transmitMTU)));
+		}
+	}
+
+	/**
+	 * Start the connection, or try again when the stack queued it.
+	 * 
+	 * @return <code>false</code> while the connection is queued by the stack
+	 */
+	boolean startConnection() throws IOException {
+		BluetoothStackConnectAsync stack = (BluetoothStackConnectAsync) bluetoothStack;
+		if (type == L2CAP) {
+			this.handle = stack.l2OpenClientConnectionStart(params, receiveMTU, transmitMTU);
+		} else {
+			this.handle = stack.connectionRfOpenClientConnectionStart(params);
+		}
+		return (this.handle != 0);
+	}
+
+	BluetoothStack getBluetoothStack() {
+		return bluetoothStack;
+	}
+
+	int getTimeout() {
+		return params.timeout;
+	}
+
+	/**
+	 * Create connection object for established connection, the handle is closed on error.
+	 */
+	Connection createConnection(long handle) throws IOException {
+		switch (type) {
+		case L2CAP:
+			return new BluetoothL2CAPClientConnection(bluetoothStack, handle, params, receiveMTU, transmitMTU);
+		case OBEX:
+			BluetoothRFCommClientConnection c = new BluetoothRFCommClientConnection(bluetoothStack, handle, params);
+			boolean initOK = false;
+			try {
+				Connection session = new OBEXClientSessionImpl(c, obexConnectionParams);
+				initOK = true;
+				return session;
+			} finally {
+				if (!initOK) {
+					c.close();
+				}
+			}
+		default:
+			return new BluetoothRFCommClientConnection(bluetoothStack, handle, params);
+		}
+	}
+
+	/**
+	 * Close connection in progress or remove it from the stack queue.
+	 */
+	void closeHandle() {
+		if (handle == 0) {
+			((BluetoothStackConnectAsync) bluetoothStack).connectionStartCancel(params);
+			return;
+		}
+		try {
+			if (type == L2CAP) {
+				bluetoothStack.l2CloseClientConnection(handle);
+			} else {
+				bluetoothStack.connectionRfCloseClientConnection(handle);
+			}
+		} catch (IOException e) {
+			DebugLog.error("close error", e);
+		}
+	}
+
+	/**
+	 * @return <code>false</code> if the attempt is canceled, the caller should close the connection and fail it
+	 */
+	synchronized boolean completed(Connection connection) {
+		if (canceled) {
+			return false;
+		}
+		this.connection = connection;
+		this.done = true;
+		notifyAll();
+		return true;
+	}
+
+	synchronized void failed(IOException exception) {
+		this.exception = exception;
+		this.done = true;
+		notifyAll();
+	}
+
+	void timeout() {
+		failed(new BluetoothConnectionException(BluetoothConnectionException.TIMEOUT, "Connection timeout"));
+	}
+
+	synchronized boolean isCanceled() {
+		return canceled;
+	}
+
+	/**
+	 * @return <code>true</code> when connection is established or failed
+	 */
+	public synchronized boolean isDone() {
+		return done;
+	}
+
+	/**
+	 * Stop connection attempt, get() will throw InterruptedIOException.
+	 * 
+	 * @return <code>false</code> if the connection attempt has already completed
+	 */
+	public boolean cancel() {
+		synchronized (this) {
+			if (done) {
+				return false;
+			}
+			canceled = true;
+		}
+		BluetoothConnectDriver.wakeup(this);
+		return true;
+	}
+
+	/**
+	 * Wait for connection.
+	 * 
+	 * @return the connection
+	 * @throws IOException
+	 *             the error that stopped the connection attempt
+	 */
+	public Connection get() throws IOException {
+		return get(0);
+	}
+
+	/**
+	 * Wait for connection.
+	 * 
+	 * @param timeout
+	 *            milliseconds, 0 to wait until the connection attempt is completed
+	 * @return the connection or <code>null</code> if it is not established before timeout
+	 * @throws IOException
+	 *             the error that stopped the connection attempt
+	 */
+	public synchronized Connection get(long timeout) throws IOException {
+		long end = System.currentTimeMillis() + timeout;
+		while (!done) {
+			long wait = 0;
+			if (timeout > 0) {
+				wait = end - System.currentTimeMillis();
+				if (wait <= 0) {
+					return null;
+				}
+			}
+			try {
+				wait(wait);
+			} catch (InterruptedException e) {
+				throw new InterruptedIOException();
+			}
+		}
+		if (exception != null) {
+			throw exception;
+		}
+		return connection;
+	}
+}
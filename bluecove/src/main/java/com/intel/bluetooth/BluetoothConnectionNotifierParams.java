@@ -55,6 +55,24 @@ class BluetoothConnectionNotifierParams {
 	 */
 	int bluecove_ext_psm = 0;
 
+	/**
+	 * Socket buffer sizes of accepted connections, see BluetoothConnectionParams.
+	 */
+	int sndbuf = 0;
+
+	int rcvbuf = 0;
+
+	int flushTimeout = 0;
+
+	/**
+	 * L2CAP channel mode of accepted connections, see BluetoothConnectionParams.
+	 */
+	int l2capMode = L2CAPModeConnection.MODE_BASIC;
+
+	int txWindow = 0;
+
+	int fcs = BluetoothConsts.L2CAP_FCS_CRC16;
+
 	public BluetoothConnectionNotifierParams(UUID uuid, boolean authenticate, boolean encrypt, boolean authorize,
 			String name, boolean master) {
 		super();
@@ -57,6 +57,32 @@ class BluetoothConnectionParams {
 	 */
 	public int timeout = DEFAULT_CONNECT_TIMEOUT;
 
+	/**
+	 * Socket send and receive buffer sizes in bytes. Usage:
+	 * btspp://0123456789AB:1;sndbuf=65536;rcvbuf=65536. 0 for stack default.
+	 */
+	int sndbuf = 0;
+
+	int rcvbuf = 0;
+
+	/**
+	 * L2CAP flush timeout in milliseconds, unsent data is discarded after it.
+	 * Usage: btl2cap://0123456789AB:1001;flushto=100. 0 for stack default,
+	 * never flushed.
+	 */
+	int flushTimeout = 0;
+
+	/**
+	 * L2CAP channel mode, transmit window and frame check sequence. Usage:
+	 * btl2cap://0123456789AB:1001;l2mode=ertm;txwindow=32;fcs=false. txwindow
+	 * 0 for stack default.
+	 */
+	int l2capMode = L2CAPModeConnection.MODE_BASIC;
+
+	int txWindow = 0;
+
+	int fcs = BluetoothConsts.L2CAP_FCS_CRC16;
+
 	public BluetoothConnectionParams(long address, int channel, boolean authenticate, boolean encrypt) {
 		super();
 		this.address = address;
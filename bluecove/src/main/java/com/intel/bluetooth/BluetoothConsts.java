@@ -63,6 +63,20 @@ public abstract class BluetoothConsts {
 
 	public static final int L2CAP_PSM_MAX = 0xFFFF;
 
+	/**
+	 * Flush timeout in milliseconds, 0xFFFF means data is never flushed.
+	 */
+	public static final int L2CAP_FLUSH_TIMEOUT_MAX = 0xFFFF;
+
+	/**
+	 * Enhanced Retransmission mode window, values above 63 require extended window size support.
+	 */
+	public static final int L2CAP_TX_WINDOW_MAX = 0x3FFF;
+
+	public static final int L2CAP_FCS_NONE = 0;
+
+	public static final int L2CAP_FCS_CRC16 = 1;
+
 	public static final int TCP_OBEX_DEFAULT_PORT = 650;
 
 	public static final String PROPERTY_BLUETOOTH_API_VERSION = "bluetooth.api.version";
@@ -32,7 +32,15 @@ import java.io.IOException;
 class BluetoothL2CAPClientConnection extends BluetoothL2CAPConnection {
 
     public BluetoothL2CAPClientConnection(BluetoothStack bluetoothStack, BluetoothConnectionParams params, int receiveMTU, int transmitMTU) throws IOException {
-        super(bluetoothStack, bluetoothStack.l2OpenClientConnection(params, receiveMTU, transmitMTU));
+        this(bluetoothStack, bluetoothStack.l2OpenClientConnection(params, receiveMTU, transmitMTU), params, receiveMTU, transmitMTU);
+    }
+
+    /**
+     * Connection established by BluetoothStackConnectAsync, the handle is closed on error.
+     */
+    BluetoothL2CAPClientConnection(BluetoothStack bluetoothStack, long handle, BluetoothConnectionParams params, int receiveMTU, int transmitMTU)
+            throws IOException {
+        super(bluetoothStack, handle);
         boolean initOK = false;
         try {
             this.securityOpt = bluetoothStack.l2GetSecurityOpt(this.handle, Utils.securityOpt(params.authenticate, params.encrypt));
@@ -25,6 +25,7 @@
 package com.intel.bluetooth;
 
 import java.io.IOException;
+import java.io.InterruptedIOException;
 
 import javax.bluetooth.L2CAPConnection;
 import javax.bluetooth.RemoteDevice;
@@ -34,7 +35,8 @@ import javax.bluetooth.ServiceRecord;
  *
  *
  */
-abstract class BluetoothL2CAPConnection implements L2CAPConnection, BluetoothConnectionAccess {
+abstract class BluetoothL2CAPConnection implements L2CAPConnection, ReceiveTimeoutL2CAPConnection, L2CAPModeConnection,
+		BluetoothConnectionAccess {
 
 	protected BluetoothStack bluetoothStack;
 
@@ -48,6 +50,11 @@ abstract class BluetoothL2CAPConnection implements L2CAPConnection, BluetoothCon
 
 	private boolean isClosed;
 
+	/**
+	 * ready() returned true and the packet is not received yet.
+	 */
+	private volatile boolean receiveReady;
+
 	protected BluetoothL2CAPConnection(BluetoothStack bluetoothStack, long handle) {
 		this.bluetoothStack = bluetoothStack;
 		this.handle = handle;
@@ -90,6 +97,51 @@ abstract class BluetoothL2CAPConnection implements L2CAPConnection, BluetoothCon
 		return bluetoothStack.l2GetTransmitMTU(handle);
 	}
 
+	/*
+	 * (non-Javadoc)
+	 *
+	 * @see com.intel.bluetooth.L2CAPModeConnection#getMode()
+	 */
+	public int getMode() throws IOException {
+		if (isClosed) {
+			throw new IOException("Connection closed");
+		}
+		if (bluetoothStack instanceof BluetoothStackL2CAPMode) {
+			return ((BluetoothStackL2CAPMode) bluetoothStack).l2GetMode(handle);
+		}
+		return MODE_BASIC;
+	}
+
+	/*
+	 * (non-Javadoc)
+	 *
+	 * @see com.intel.bluetooth.L2CAPModeConnection#getTransmitWindow()
+	 */
+	public int getTransmitWindow() throws IOException {
+		if (isClosed) {
+			throw new IOException("Connection closed");
+		}
+		if (bluetoothStack instanceof BluetoothStackL2CAPMode) {
+			return ((BluetoothStackL2CAPMode) bluetoothStack).l2GetTransmitWindow(handle);
+		}
+		return 0;
+	}
+
+	/*
+	 * (non-Javadoc)
+	 *
+	 * @see com.intel.bluetooth.L2CAPModeConnection#isFCSEnabled()
+	 */
+	public boolean isFCSEnabled() throws IOException {
+		if (isClosed) {
+			throw new IOException("Connection closed");
+		}
+		if (bluetoothStack instanceof BluetoothStackL2CAPMode) {
+			return ((BluetoothStackL2CAPMode) bluetoothStack).l2GetFCS(handle);
+		}
+		return false;
+	}
+
 	/*
 	 * (non-Javadoc)
 	 *
@@ -99,7 +151,11 @@ abstract class BluetoothL2CAPConnection implements L2CAPConnection, BluetoothCon
 		if (isClosed) {
 			throw new IOException("Connection closed");
 		}
-		return bluetoothStack.l2Ready(handle);
+		if (receiveReady) {
+			return true;
+		}
+		receiveReady = bluetoothStack.l2Ready(handle);
+		return receiveReady;
 	}
 
 	/*
@@ -114,9 +170,44 @@ abstract class BluetoothL2CAPConnection implements L2CAPConnection, BluetoothCon
 		if (inBuf == null) {
 			throw new NullPointerException("inBuf is null");
 		}
+		receiveReady = false;
 		return bluetoothStack.l2Receive(handle, inBuf);
 	}
 
+	/*
+	 * (non-Javadoc)
+	 *
+	 * @see com.intel.bluetooth.ReceiveTimeoutL2CAPConnection#receive(byte[], int)
+	 */
+	public int receive(byte[] inBuf, int timeout) throws IOException {
+		if (isClosed) {
+			throw new IOException("Connection closed");
+		}
+		if (inBuf == null) {
+			throw new NullPointerException("inBuf is null");
+		}
+		if (timeout < 0) {
+			throw new IllegalArgumentException("timeout is negative");
+		}
+		if (bluetoothStack instanceof BluetoothStackReadTimeout) {
+			receiveReady = false;
+			return ((BluetoothStackReadTimeout) bluetoothStack).l2ReceiveTimeout(handle, inBuf, timeout);
+		}
+		long deadline = System.currentTimeMillis() + timeout;
+		while (!ready()) {
+			long remaining = deadline - System.currentTimeMillis();
+			if (remaining <= 0) {
+				return -1;
+			}
+			try {
+				Thread.sleep(Math.min(remaining, 10));
+			} catch (InterruptedException e) {
+				throw new InterruptedIOException();
+			}
+		}
+		return receive(inBuf);
+	}
+
 	/*
 	 * (non-Javadoc)
 	 *
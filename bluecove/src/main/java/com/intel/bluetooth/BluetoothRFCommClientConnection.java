@@ -34,7 +34,15 @@ class BluetoothRFCommClientConnection extends BluetoothRFCommConnection {
 
 	public BluetoothRFCommClientConnection(BluetoothStack bluetoothStack, BluetoothConnectionParams params)
 			throws IOException {
-		super(bluetoothStack, bluetoothStack.connectionRfOpenClientConnection(params));
+		this(bluetoothStack, bluetoothStack.connectionRfOpenClientConnection(params), params);
+	}
+
+	/**
+	 * Connection established by BluetoothStackConnectAsync, the handle is closed on error.
+	 */
+	BluetoothRFCommClientConnection(BluetoothStack bluetoothStack, long handle, BluetoothConnectionParams params)
+			throws IOException {
+		super(bluetoothStack, handle);
 		boolean initOK = false;
 		try {
 			this.securityOpt = bluetoothStack.rfGetSecurityOpt(this.handle, Utils.securityOpt(params.authenticate,
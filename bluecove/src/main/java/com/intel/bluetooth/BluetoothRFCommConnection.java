@@ -46,7 +46,8 @@ import javax.microedition.io.StreamConnection;
  *
  *
  */
-abstract class BluetoothRFCommConnection implements StreamConnection, BluetoothConnectionAccess {
+abstract class BluetoothRFCommConnection implements StreamConnection, BluetoothConnectionAccess,
+		BluetoothConnectionBuffers {
 
 	protected BluetoothStack bluetoothStack;
 
@@ -307,6 +308,21 @@ abstract class BluetoothRFCommConnection implements StreamConnection, BluetoothC
 		return bluetoothStack.getConnectionRfRemoteAddress(handle);
 	}
 
+	/*
+	 * (non-Javadoc)
+	 *
+	 * @see com.intel.bluetooth.BluetoothConnectionBuffers#getTransportBufferSize()
+	 */
+	public int getTransportBufferSize() throws IOException {
+		if (isClosed) {
+			throw new IOException("Connection closed");
+		}
+		if (bluetoothStack instanceof BluetoothStackConnectionBuffers) {
+			return ((BluetoothStackConnectionBuffers) bluetoothStack).connectionRfGetBufferSize(handle);
+		}
+		return -1;
+	}
+
 	/*
 	 * (non-Javadoc)
 	 *
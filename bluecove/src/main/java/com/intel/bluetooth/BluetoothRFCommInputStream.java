@@ -25,13 +25,27 @@ package com.intel.bluetooth;
 
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InterruptedIOException;
 
-class BluetoothRFCommInputStream extends InputStream {
+class BluetoothRFCommInputStream extends InputStream implements ReadTimeoutInputStream {
 
 	volatile private BluetoothRFCommConnection conn;
 
+	private final int readAheadSize;
+
+	/**
+	 * Data received by one bulk native read, used by read() and small reads. Accessed only by the reading thread.
+	 */
+	private byte[] readAhead;
+
+	private int readAheadPos = 0;
+
+	private int readAheadLength = 0;
+
 	public BluetoothRFCommInputStream(BluetoothRFCommConnection conn) {
 		this.conn = conn;
+		this.readAheadSize = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD,
+				BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD_DEFAULT);
 	}
 
 	/*
@@ -43,10 +57,61 @@ class BluetoothRFCommInputStream extends InputStream {
 		if (conn == null) {
 			throw new IOException("Stream closed");
 		} else {
+			int buffered = readAheadLength - readAheadPos;
+			if (buffered > 0) {
+				return buffered;
+			}
 			return conn.bluetoothStack.connectionRfReadAvailable(conn.handle);
 		}
 	}
 
+	/**
+	 * Refill read-ahead buffer, timeout is in milliseconds, negative value to wait until data is available.
+	 * 
+	 * @return number of bytes received, -1 on end of stream
+	 * @throws InterruptedIOException
+	 *             if no data received, on timeout or when read is interrupted
+	 */
+	private int fillReadAhead(BluetoothRFCommConnection c, int timeout) throws IOException {
+		if (readAhead == null) {
+			readAhead = new byte[readAheadSize];
+		}
+		readAheadPos = 0;
+		readAheadLength = 0;
+		int count;
+		try {
+			if (timeout < 0) {
+				count = c.bluetoothStack.connectionRfRead(c.handle, readAhead, 0, readAhead.length);
+			} else {
+				count = ((BluetoothStackReadTimeout) c.bluetoothStack).connectionRfReadTimeout(c.handle, readAhead, 0,
+						readAhead.length, timeout);
+			}
+		} catch (IOException e) {
+			if (isClosed()) {
+				return -1;
+			} else {
+				throw e;
+			}
+		}
+		if (count == 0) {
+			throw new InterruptedIOException((timeout < 0) ? "RFCOMM read interrupted" : "RFCOMM read timeout");
+		}
+		if (count > 0) {
+			readAheadLength = count;
+		}
+		return count;
+	}
+
+	private int readBuffered(byte[] b, int off, int len) {
+		int buffered = readAheadLength - readAheadPos;
+		if (len > buffered) {
+			len = buffered;
+		}
+		System.arraycopy(readAhead, readAheadPos, b, off, len);
+		readAheadPos += len;
+		return len;
+	}
+
 	/*
 	 * Reads the next byte of data from the input stream. The value byte is
 	 * returned as an int in the range 0 to 255. If no byte is available because
@@ -60,8 +125,16 @@ class BluetoothRFCommInputStream extends InputStream {
 	 */
 
 	public int read() throws IOException {
-		if (conn == null) {
+		BluetoothRFCommConnection c = conn;
+		if (c == null) {
 			throw new IOException("Stream closed");
+		} else if (readAheadPos < readAheadLength) {
+			return readAhead[readAheadPos++] & 0xFF;
+		} else if (readAheadSize > 0) {
+			if (fillReadAhead(c, -1) < 0) {
+				return -1;
+			}
+			return readAhead[readAheadPos++] & 0xFF;
 		} else {
 			try {
                 return conn.bluetoothStack.connectionRfRead(conn.handle);
@@ -135,6 +208,17 @@ class BluetoothRFCommInputStream extends InputStream {
 				return 0;
 			}
 			// otherwise, there is an attempt to read at least one byte.
+			if (readAheadPos < readAheadLength) {
+				return readBuffered(b, off, len);
+			}
+			BluetoothRFCommConnection c = conn;
+			if ((len < readAheadSize) && (c != null)) {
+				int count = fillReadAhead(c, -1);
+				if (count < 0) {
+					return -1;
+				}
+				return readBuffered(b, off, len);
+			}
 			try {
 			    return conn.bluetoothStack.connectionRfRead(conn.handle, b, off, len);
 			} catch (IOException e) {
@@ -147,6 +231,59 @@ class BluetoothRFCommInputStream extends InputStream {
 		}
 	}
 
+	/**
+	 * Same as read(byte[], int, int) but throws InterruptedIOException when no data received in timeout
+	 * milliseconds. Only stacks implementing BluetoothStackReadTimeout wait with a deadline, others are polled using
+	 * available() every 10 milliseconds. Timeout 0 or negative does not wait.
+	 *
+	 * @see com.intel.bluetooth.ReadTimeoutInputStream#read(byte[], int, int, int)
+	 */
+	public int read(byte[] b, int off, int len, int timeout) throws IOException {
+		if (off < 0 || len < 0 || off + len > b.length) {
+			throw new IndexOutOfBoundsException();
+		}
+		BluetoothRFCommConnection c = conn;
+		if (c == null) {
+			throw new IOException("Stream closed");
+		}
+		if (len == 0) {
+			return 0;
+		}
+		if (readAheadPos < readAheadLength) {
+			return readBuffered(b, off, len);
+		}
+		if ((timeout <= 0) || !(c.bluetoothStack instanceof BluetoothStackReadTimeout)) {
+			long endOfDelay = System.currentTimeMillis() + timeout;
+			while (available() == 0) {
+				if (System.currentTimeMillis() >= endOfDelay) {
+					throw new InterruptedIOException("RFCOMM read timeout");
+				}
+				try {
+					Thread.sleep(10);
+				} catch (InterruptedException e) {
+					throw new InterruptedIOException();
+				}
+			}
+			return read(b, off, len);
+		}
+		if (len < readAheadSize) {
+			int count = fillReadAhead(c, timeout);
+			if (count < 0) {
+				return -1;
+			}
+			return readBuffered(b, off, len);
+		}
+		try {
+			return ((BluetoothStackReadTimeout) c.bluetoothStack).connectionRfReadTimeout(c.handle, b, off, len, timeout);
+		} catch (IOException e) {
+			if (isClosed()) {
+				return -1;
+			} else {
+				throw e;
+			}
+		}
+	}
+
 	/**
 	 * Closes this input stream and releases any system resources associated with the stream.
 	 * <p>
@@ -30,8 +30,41 @@ class BluetoothRFCommOutputStream extends OutputStream {
 
 	volatile private BluetoothRFCommConnection conn;
 
+	/**
+	 * Coalescing buffer size, 0 when data is written to the stack directly.
+	 */
+	private final int coalesceSize;
+
+	private final int coalesceDelayMillis;
+
+	private byte[] buffer;
+
+	private int count = 0;
+
+	private final Object lock = new Object();
+
+	/**
+	 * When the buffered data should be sent by BluetoothRFCommWriteFlusher, 0 if nothing scheduled.
+	 */
+	private volatile long flushDeadline = 0;
+
+	/**
+	 * Failure of delayed flush, thrown to the writer by next write() or flush(). The data stays in buffer.
+	 */
+	private IOException flushError;
+
+	/**
+	 * Number of write calls to the stack, used in tests.
+	 */
+	int stackWriteCount = 0;
+
 	public BluetoothRFCommOutputStream(BluetoothRFCommConnection conn) {
 		this.conn = conn;
+		this.coalesceSize = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_COALESCE, 0);
+		int delay = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY,
+				BlueCoveConfigProperties.PROPERTY_RFCOMM_WRITE_DELAY_DEFAULT);
+		// microseconds, rounded up to the timer resolution
+		this.coalesceDelayMillis = (delay + 999) / 1000;
 	}
 
 	/*
@@ -47,10 +80,23 @@ class BluetoothRFCommOutputStream extends OutputStream {
 	 */
 
 	public void write(int b) throws IOException {
-		if (conn == null) {
+		BluetoothRFCommConnection c = conn;
+		if (c == null) {
 			throw new IOException("Stream closed");
+		} else if (coalesceSize <= 0) {
+			stackWriteCount++;
+			c.bluetoothStack.connectionRfWrite(c.handle, b);
 		} else {
-			conn.bluetoothStack.connectionRfWrite(conn.handle, b);
+			synchronized (lock) {
+				throwFlushError();
+				if (buffer == null) {
+					buffer = new byte[coalesceSize];
+				} else if (count == buffer.length) {
+					writeBuffer(c, false);
+				}
+				buffer[count++] = (byte) b;
+				bufferUpdated(c);
+			}
 		}
 	}
 
@@ -78,19 +124,114 @@ class BluetoothRFCommOutputStream extends OutputStream {
 			throw new IndexOutOfBoundsException();
 		}
 
-		if (conn == null) {
+		BluetoothRFCommConnection c = conn;
+		if (c == null) {
 			throw new IOException("Stream closed");
+		} else if (coalesceSize <= 0) {
+			stackWriteCount++;
+			c.bluetoothStack.connectionRfWrite(c.handle, b, off, len);
 		} else {
-			conn.bluetoothStack.connectionRfWrite(conn.handle, b, off, len);
+			synchronized (lock) {
+				throwFlushError();
+				if (buffer == null) {
+					buffer = new byte[coalesceSize];
+				}
+				if (count + len <= buffer.length) {
+					System.arraycopy(b, off, buffer, count, len);
+					count += len;
+					bufferUpdated(c);
+					return;
+				}
+				if (count > 0) {
+					// Complete the frame, the rest of data follows immediately
+					int fill = buffer.length - count;
+					System.arraycopy(b, off, buffer, count, fill);
+					count += fill;
+					off += fill;
+					len -= fill;
+					writeBuffer(c, true);
+				}
+				if (len >= buffer.length) {
+					stackWriteCount++;
+					c.bluetoothStack.connectionRfWrite(c.handle, b, off, len);
+				} else if (len > 0) {
+					System.arraycopy(b, off, buffer, 0, len);
+					count = len;
+					bufferUpdated(c);
+				}
+			}
+		}
+	}
+
+	/**
+	 * Send full buffer or schedule delayed flush for the first byte buffered.
+	 */
+	private void bufferUpdated(BluetoothRFCommConnection c) throws IOException {
+		if (count == buffer.length) {
+			writeBuffer(c, false);
+		} else if ((flushDeadline == 0) && (coalesceDelayMillis > 0)) {
+			flushDeadline = System.currentTimeMillis() + coalesceDelayMillis;
+			BluetoothRFCommWriteFlusher.schedule(this);
+		}
+	}
+
+	private void writeBuffer(BluetoothRFCommConnection c, boolean more) throws IOException {
+		flushDeadline = 0;
+		if (count == 0) {
+			return;
+		}
+		stackWriteCount++;
+		if (more && (c.bluetoothStack instanceof BluetoothStackWriteMore)) {
+			((BluetoothStackWriteMore) c.bluetoothStack).connectionRfWriteMore(c.handle, buffer, 0, count, true);
+		} else {
+			c.bluetoothStack.connectionRfWrite(c.handle, buffer, 0, count);
+		}
+		// Data is kept in buffer when write failed
+		count = 0;
+	}
+
+	private void throwFlushError() throws IOException {
+		if (flushError != null) {
+			IOException e = flushError;
+			flushError = null;
+			throw e;
+		}
+	}
+
+	long getFlushDeadline() {
+		return flushDeadline;
+	}
+
+	/**
+	 * Called by BluetoothRFCommWriteFlusher when the flush delay expired.
+	 */
+	void flushDelayed() {
+		synchronized (lock) {
+			BluetoothRFCommConnection c = conn;
+			if (c != null) {
+				try {
+					writeBuffer(c, false);
+				} catch (IOException e) {
+					DebugLog.debug("RFCOMM delayed flush", e);
+					flushError = e;
+				}
+			}
 		}
 	}
 
 	public void flush() throws IOException {
-		if (conn == null) {
+		BluetoothRFCommConnection c = conn;
+		if (c == null) {
 			throw new IOException("Stream closed");
 		} else {
 			super.flush();
-			conn.bluetoothStack.connectionRfFlush(conn.handle);
+			if (coalesceSize > 0) {
+				synchronized (lock) {
+					throwFlushError();
+					writeBuffer(c, false);
+				}
+			}
+			c.bluetoothStack.connectionRfFlush(c.handle);
 		}
     }
 
@@ -108,8 +249,16 @@ class BluetoothRFCommOutputStream extends OutputStream {
 		// Function is not synchronized
 		BluetoothRFCommConnection c = conn;
 		if (c != null) {
-			conn = null;
-			c.streamClosed();
+			try {
+				if (coalesceSize > 0) {
+					synchronized (lock) {
+						writeBuffer(c, false);
+					}
+				}
+			} finally {
+				conn = null;
+				c.streamClosed();
+			}
 		}
 	}
 
@@ -0,0 +1,113 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.util.Vector;
+
+/**
+ * Sends data left in coalescing RFCOMM OutputStreams when their flush delay expires. One daemon thread serves all
+ * streams and ends when no stream has pending data.
+ */
+class BluetoothRFCommWriteFlusher implements Runnable {
+
+	private static final int IDLE_TIMEOUT = 10 * 1000;
+
+	private static final Vector streams = new Vector();
+
+	private static Thread thread;
+
+	private BluetoothRFCommWriteFlusher() {
+	}
+
+	static void schedule(BluetoothRFCommOutputStream stream) {
+		synchronized (streams) {
+			if (!streams.contains(stream)) {
+				streams.addElement(stream);
+			}
+			if (thread == null) {
+				thread = new Thread(new BluetoothRFCommWriteFlusher(), "BluetoothRFCommWriteFlusher");
+				UtilsJavaSE.threadSetDaemon(thread);
+				thread.start();
+			} else {
+				streams.notifyAll();
+			}
+		}
+	}
+
+	private static void flush(Vector due) {
+		for (int i = 0; i < due.size(); i++) {
+			((BluetoothRFCommOutputStream) due.elementAt(i)).flushDelayed();
+		}
+		due.removeAllElements();
+	}
+
+	public void run() {
+		Vector due = new Vector();
+		try {
+			while (true) {
+				synchronized (streams) {
+					while (true) {
+						long now = System.currentTimeMillis();
+						long next = Long.MAX_VALUE;
+						for (int i = streams.size() - 1; i >= 0; i--) {
+							BluetoothRFCommOutputStream stream = (BluetoothRFCommOutputStream) streams.elementAt(i);
+							long deadline = stream.getFlushDeadline();
+							if (deadline <= now) {
+								due.addElement(stream);
+								streams.removeElementAt(i);
+							} else if (deadline < next) {
+								next = deadline;
+							}
+						}
+						if (!due.isEmpty()) {
+							break;
+						}
+						if (streams.isEmpty()) {
+							streams.wait(IDLE_TIMEOUT);
+							if (streams.isEmpty()) {
+								thread = null;
+								return;
+							}
+						} else {
+							streams.wait(next - now);
+						}
+					}
+				}
+				// Streams are flushed without holding the queue lock, writer may schedule again meanwhile
+				flush(due);
+			}
+		} catch (InterruptedException e) {
+			// Send everything pending now, next write will start a new thread
+			synchronized (streams) {
+				thread = null;
+				for (int i = 0; i < streams.size(); i++) {
+					due.addElement(streams.elementAt(i));
+				}
+				streams.removeAllElements();
+			}
+			flush(due);
+		}
+	}
+}
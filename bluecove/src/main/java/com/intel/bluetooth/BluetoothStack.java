@@ -53,6 +53,16 @@ public interface BluetoothStack {
     
     public static final int FEATURE_ASSIGN_SERVER_PSM = 1 << 4;
 
+    /**
+     * Connection URL parameters sndbuf, rcvbuf and for L2CAP flushto.
+     */
+    public static final int FEATURE_SOCKET_OPTIONS = 1 << 5;
+
+    /**
+     * L2CAP connection URL parameters l2mode, txwindow and fcs, see L2CAPModeConnection.
+     */
+    public static final int FEATURE_L2CAP_MODE = 1 << 6;
+
     public static class LibraryInformation {
 
         public final String libraryName;
@@ -0,0 +1,49 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import javax.bluetooth.ServiceRegistrationException;
+
+/**
+ * Native stack support may implement this interface to register many service records in one call.
+ * 
+ * @see com.intel.bluetooth.ServiceRecordsRegistry#beginBatchRegistration()
+ * 
+ * <p>
+ * <b><u>Your application should not use this class directly.</u></b>
+ * 
+ */
+public interface BluetoothStackBatchRegistration {
+
+	/**
+	 * Register all service records or none of them. Handles are assigned to registered records.
+	 * 
+	 * @throws ServiceRegistrationException
+	 *             if any record can't be registered, records registered before the failure are
+	 *             unregistered
+	 */
+	public void registerServiceRecords(ServiceRecordImpl[] serviceRecords) throws ServiceRegistrationException;
+
+}
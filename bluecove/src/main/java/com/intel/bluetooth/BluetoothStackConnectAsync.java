@@ -0,0 +1,82 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * Native stack support may implement this interface to start client connections without blocking the calling
+ * thread. One thread waits for all connections in progress.
+ * 
+ * @see com.intel.bluetooth.MicroeditionConnector#openAsync(String)
+ * 
+ * <p>
+ * <b><u>Your application should not use this class directly.</u></b>
+ * 
+ */
+public interface BluetoothStackConnectAsync {
+
+	/**
+	 * @return handle of RFCOMM connection in progress, closed by connectionRfCloseClientConnection; 0 when the stack
+	 *         queued the connection, start is called again with the same params after connectionWait returns
+	 */
+	public long connectionRfOpenClientConnectionStart(BluetoothConnectionParams params) throws IOException;
+
+	/**
+	 * @return handle of L2CAP connection in progress, closed by l2CloseClientConnection; 0 when the stack queued the
+	 *         connection, start is called again with the same params after connectionWait returns
+	 */
+	public long l2OpenClientConnectionStart(BluetoothConnectionParams params, int receiveMTU, int transmitMTU)
+			throws IOException;
+
+	/**
+	 * Remove connection queued by start method that returned 0, called on cancel or timeout.
+	 */
+	public void connectionStartCancel(BluetoothConnectionParams params);
+
+	/**
+	 * Wait until any of connections is established or failed, the timeout expires or connectionWakeup() is called.
+	 * 
+	 * @param ready
+	 *            set to <code>true</code> for handles that should be passed to connectionFinish
+	 * @param timeout
+	 *            milliseconds, negative to wait without timeout
+	 * @return number of ready handles
+	 */
+	public int connectionWait(long[] handles, int count, boolean[] ready, int timeout) throws IOException;
+
+	/**
+	 * Make connectionWait() running in another thread return. Also called by the stack when queued connection may
+	 * start.
+	 */
+	public void connectionWakeup();
+
+	/**
+	 * @throws IOException
+	 *             if connection failed, the handle is not closed
+	 */
+	public void connectionFinish(long handle) throws IOException;
+
+}
@@ -0,0 +1,57 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * Native stack support may implement this interface to report L2CAP channel mode selected by l2mode, txwindow and fcs
+ * connection parameters. Stacks without it have only Basic mode.
+ * 
+ * @see com.intel.bluetooth.L2CAPModeConnection
+ * @see com.intel.bluetooth.BluetoothStack#FEATURE_L2CAP_MODE
+ * 
+ * <p>
+ * <b><u>Your application should not use this class directly.</u></b>
+ * 
+ */
+public interface BluetoothStackL2CAPMode {
+
+	/**
+	 * @see com.intel.bluetooth.L2CAPModeConnection#getMode()
+	 */
+	public int l2GetMode(long handle) throws IOException;
+
+	/**
+	 * @see com.intel.bluetooth.L2CAPModeConnection#getTransmitWindow()
+	 */
+	public int l2GetTransmitWindow(long handle) throws IOException;
+
+	/**
+	 * @see com.intel.bluetooth.L2CAPModeConnection#isFCSEnabled()
+	 */
+	public boolean l2GetFCS(long handle) throws IOException;
+
+}
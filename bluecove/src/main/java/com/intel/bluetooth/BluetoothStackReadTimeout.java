@@ -0,0 +1,57 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * Native stack support may implement this interface to wait for RFCOMM data or L2CAP packet with a deadline instead of
+ * polling available() or ready().
+ * 
+ * @see com.intel.bluetooth.BluetoothRFCommInputStream#read(byte[],int,int,int)
+ * @see com.intel.bluetooth.BluetoothL2CAPConnection#receive(byte[],int)
+ * 
+ * <p>
+ * <b><u>Your application should not use this class directly.</u></b>
+ * 
+ */
+public interface BluetoothStackReadTimeout {
+
+	/**
+	 * @see java.io.InputStream#read(byte[],int,int)
+	 * 
+	 * @param timeout
+	 *            milliseconds to wait for the first byte
+	 * @throws java.io.InterruptedIOException
+	 *             if no data received before timeout expired
+	 */
+	public int connectionRfReadTimeout(long handle, byte[] b, int off, int len, int timeout) throws IOException;
+
+	/**
+	 * @see com.intel.bluetooth.ReceiveTimeoutL2CAPConnection#receive(byte[],int)
+	 */
+	public int l2ReceiveTimeout(long handle, byte[] inBuf, int timeout) throws IOException;
+
+}
@@ -0,0 +1,65 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * L2CAP channel mode negotiated for the connection. Enhanced Retransmission mode is reliable with larger transmit
+ * window than Basic mode, Streaming mode has no retransmissions and lowest latency.
+ * 
+ * <p>
+ * The mode is selected by connection URL parameters
+ * <code>btl2cap://0123456789AB:1001;l2mode=streaming;fcs=false</code> or
+ * <code>btl2cap://localhost;name=test;l2mode=ertm;txwindow=32</code>
+ * 
+ * <p>
+ * <b>PUBLIC JSR-82 extension</b>
+ * 
+ */
+public interface L2CAPModeConnection {
+
+	public static final int MODE_BASIC = 0;
+
+	public static final int MODE_ERTM = 3;
+
+	public static final int MODE_STREAMING = 4;
+
+	/**
+	 * @return MODE_BASIC, MODE_ERTM or MODE_STREAMING
+	 */
+	public int getMode() throws IOException;
+
+	/**
+	 * @return Enhanced Retransmission mode transmit window size
+	 */
+	public int getTransmitWindow() throws IOException;
+
+	/**
+	 * @return true when frames are protected by the frame check sequence, always false in Basic mode
+	 */
+	public boolean isFCSEnabled() throws IOException;
+
+}
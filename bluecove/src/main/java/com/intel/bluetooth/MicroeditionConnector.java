@@ -86,6 +86,12 @@ public abstract class MicroeditionConnector {
 	private static final String RECEIVE_MTU = "receivemtu";
 	private static final String TRANSMIT_MTU = "transmitmtu";
 	private static final String EXT_BLUECOVE_L2CAP_PSM = "bluecovepsm";
+	private static final String EXT_BLUECOVE_SNDBUF = "sndbuf";
+	private static final String EXT_BLUECOVE_RCVBUF = "rcvbuf";
+	private static final String EXT_BLUECOVE_L2CAP_FLUSH_TIMEOUT = "flushto";
+	private static final String EXT_BLUECOVE_L2CAP_MODE = "l2mode";
+	private static final String EXT_BLUECOVE_L2CAP_TX_WINDOW = "txwindow";
+	private static final String EXT_BLUECOVE_L2CAP_FCS = "fcs";
 	private static final String ANDROID = "android";
 
 	static {
@@ -93,6 +99,8 @@ public abstract class MicroeditionConnector {
 		cliParams.put(AUTHENTICATE, AUTHENTICATE);
 		cliParams.put(ENCRYPT, ENCRYPT);
 		cliParams.put(MASTER, MASTER);
+		cliParams.put(EXT_BLUECOVE_SNDBUF, EXT_BLUECOVE_SNDBUF);
+		cliParams.put(EXT_BLUECOVE_RCVBUF, EXT_BLUECOVE_RCVBUF);
 
 		// srvParams ::== name | master | encrypt | authorize | authenticate
 		copyAll(srvParams, cliParams);
@@ -103,6 +111,10 @@ public abstract class MicroeditionConnector {
 
 		cliParamsL2CAP.put(RECEIVE_MTU, RECEIVE_MTU);
 		cliParamsL2CAP.put(TRANSMIT_MTU, TRANSMIT_MTU);
+		cliParamsL2CAP.put(EXT_BLUECOVE_L2CAP_FLUSH_TIMEOUT, EXT_BLUECOVE_L2CAP_FLUSH_TIMEOUT);
+		cliParamsL2CAP.put(EXT_BLUECOVE_L2CAP_MODE, EXT_BLUECOVE_L2CAP_MODE);
+		cliParamsL2CAP.put(EXT_BLUECOVE_L2CAP_TX_WINDOW, EXT_BLUECOVE_L2CAP_TX_WINDOW);
+		cliParamsL2CAP.put(EXT_BLUECOVE_L2CAP_FCS, EXT_BLUECOVE_L2CAP_FCS);
 
 		copyAll(srvParamsL2CAP, cliParamsL2CAP);
 		srvParamsL2CAP.put(AUTHORIZE, AUTHORIZE);
@@ -156,7 +168,37 @@ public abstract class MicroeditionConnector {
 		return openImpl(name, READ_WRITE, false, true);
 	}
 
+	/**
+	 * Start client connection and return without waiting for it to be established. btspp, btl2cap and btgoep
+	 * connections on stacks supporting it are established by one BlueCove thread, "bluecove.connect.timeout" is
+	 * applied to each. Other connections are opened before this method returns.
+	 * 
+	 * @param name
+	 *            The URL for the connection, server URLs are not accepted
+	 * @return the future to get the connection from
+	 * @throws IOException
+	 *             If the connection can't be started
+	 */
+	public static BluetoothConnectionFuture openAsync(String name) throws IOException {
+		BluetoothConnectionFuture future = new BluetoothConnectionFuture();
+		Connection connection = openImpl(name, READ_WRITE, false, false, future);
+		if (connection != null) {
+			future.completed(connection);
+		}
+		return future;
+	}
+
 	private static Connection openImpl(String name, int mode, boolean timeouts, boolean allowServer) throws IOException {
+		return openImpl(name, mode, timeouts, allowServer, null);
+	}
+
+	/**
+	 * @param future
+	 *            when not <code>null</code> Bluetooth client connection is started with it and <code>null</code>
+	 *            returned
+	 */
+	private static Connection openImpl(String name, int mode, boolean timeouts, boolean allowServer,
+			BluetoothConnectionFuture future) throws IOException {
 
 		DebugLog.debug("connecting", name);
 
@@ -292,6 +334,15 @@ public abstract class MicroeditionConnector {
 						values, AUTHENTICATE), paramBoolean(values, ENCRYPT), paramBoolean(values, AUTHORIZE),
 						(String) values.get(NAME), paramBoolean(values, MASTER));
 				notifierParams.timeouts = timeouts;
+				notifierParams.sndbuf = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_SNDBUF,
+						BluetoothStack.FEATURE_SOCKET_OPTIONS, Integer.MAX_VALUE);
+				notifierParams.rcvbuf = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_RCVBUF,
+						BluetoothStack.FEATURE_SOCKET_OPTIONS, Integer.MAX_VALUE);
+				notifierParams.flushTimeout = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_L2CAP_FLUSH_TIMEOUT,
+						BluetoothStack.FEATURE_SOCKET_OPTIONS, BluetoothConsts.L2CAP_FLUSH_TIMEOUT_MAX);
+				notifierParams.l2capMode = paramL2CAPMode(bluetoothStack, values);
+				notifierParams.txWindow = paramL2CAPTransmitWindow(bluetoothStack, values, notifierParams.l2capMode);
+				notifierParams.fcs = paramL2CAPFCS(bluetoothStack, values);
 				if (notifierParams.encrypt && (!notifierParams.authenticate)) {
 					if (values.get(AUTHENTICATE) == null) {
 						notifierParams.authenticate = true;
@@ -356,6 +407,15 @@ public abstract class MicroeditionConnector {
 				}
 				
 				connectionParams.timeouts = timeouts;
+				connectionParams.sndbuf = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_SNDBUF,
+						BluetoothStack.FEATURE_SOCKET_OPTIONS, Integer.MAX_VALUE);
+				connectionParams.rcvbuf = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_RCVBUF,
+						BluetoothStack.FEATURE_SOCKET_OPTIONS, Integer.MAX_VALUE);
+				connectionParams.flushTimeout = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_L2CAP_FLUSH_TIMEOUT,
+						BluetoothStack.FEATURE_SOCKET_OPTIONS, BluetoothConsts.L2CAP_FLUSH_TIMEOUT_MAX);
+				connectionParams.l2capMode = paramL2CAPMode(bluetoothStack, values);
+				connectionParams.txWindow = paramL2CAPTransmitWindow(bluetoothStack, values, connectionParams.l2capMode);
+				connectionParams.fcs = paramL2CAPFCS(bluetoothStack, values);
 				if (connectionParams.encrypt && (!connectionParams.authenticate)) {
 					if (values.get(AUTHENTICATE) == null) {
 						connectionParams.authenticate = true;
@@ -379,6 +439,12 @@ public abstract class MicroeditionConnector {
 					BlueCoveConfigProperties.PROPERTY_OBEX_TIMEOUT, OBEXConnectionParams.DEFAULT_TIMEOUT);
 			obexConnectionParams.mtu = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_MTU,
 					OBEXConnectionParams.OBEX_DEFAULT_MTU);
+			obexConnectionParams.mtuAuto = BlueCoveImpl.getConfigProperty(
+					BlueCoveConfigProperties.PROPERTY_OBEX_MTU_AUTO, false);
+			obexConnectionParams.srm = BlueCoveImpl.getConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SRM,
+					false);
+			obexConnectionParams.serverPoolSize = BlueCoveImpl.getConfigProperty(
+					BlueCoveConfigProperties.PROPERTY_OBEX_SERVER_POOL, 0);
 		}
 
 		/*
@@ -387,6 +453,9 @@ public abstract class MicroeditionConnector {
 		if (scheme.equals(BluetoothConsts.PROTOCOL_SCHEME_RFCOMM)) {
 			if (isServer) {
 				return new BluetoothRFCommConnectionNotifier(bluetoothStack, notifierParams);
+			} else if (future != null) {
+				future.startRFCOMM(bluetoothStack, connectionParams, null);
+				return null;
 			} else {
 				return new BluetoothRFCommClientConnection(bluetoothStack, connectionParams);
 			}
@@ -395,6 +464,9 @@ public abstract class MicroeditionConnector {
 				notifierParams.obex = true;
 				return new OBEXSessionNotifierImpl(
 						new BluetoothRFCommConnectionNotifier(bluetoothStack, notifierParams), obexConnectionParams);
+			} else if (future != null) {
+				future.startRFCOMM(bluetoothStack, connectionParams, obexConnectionParams);
+				return null;
 			} else {
 				return new OBEXClientSessionImpl(new BluetoothRFCommClientConnection(bluetoothStack, connectionParams),
 						obexConnectionParams);
@@ -403,6 +475,10 @@ public abstract class MicroeditionConnector {
 			if (isServer) {
 				return new BluetoothL2CAPConnectionNotifier(bluetoothStack, notifierParams, paramL2CAPMTU(values,
 						RECEIVE_MTU), paramL2CAPMTU(values, TRANSMIT_MTU));
+			} else if (future != null) {
+				future.startL2CAP(bluetoothStack, connectionParams, paramL2CAPMTU(values, RECEIVE_MTU), paramL2CAPMTU(
+						values, TRANSMIT_MTU));
+				return null;
 			} else {
 				return new BluetoothL2CAPClientConnection(bluetoothStack, connectionParams, paramL2CAPMTU(values,
 						RECEIVE_MTU), paramL2CAPMTU(values, TRANSMIT_MTU));
@@ -490,6 +566,67 @@ public abstract class MicroeditionConnector {
 		}
 	}
 
+	private static void validateFeature(BluetoothStack bluetoothStack, String name, int feature) {
+		if ((bluetoothStack.getFeatureSet() & feature) == 0) {
+			throw new IllegalArgumentException(name + " extension not supported on this stack");
+		}
+	}
+
+	/**
+	 * @return 0 when parameter is not present
+	 */
+	static int paramFeatureInt(BluetoothStack bluetoothStack, Hashtable values, String name, int feature, int max) {
+		String v = (String) values.get(name);
+		if (v == null) {
+			return 0;
+		}
+		validateFeature(bluetoothStack, name, feature);
+		try {
+			int value = Integer.parseInt(v);
+			if ((value > 0) && (value <= max)) {
+				return value;
+			}
+		} catch (NumberFormatException e) {
+		}
+		throw new IllegalArgumentException("invalid param value " + name + "=" + v);
+	}
+
+	static int paramL2CAPMode(BluetoothStack bluetoothStack, Hashtable values) {
+		String v = (String) values.get(EXT_BLUECOVE_L2CAP_MODE);
+		if (v == null) {
+			return L2CAPModeConnection.MODE_BASIC;
+		}
+		validateFeature(bluetoothStack, EXT_BLUECOVE_L2CAP_MODE, BluetoothStack.FEATURE_L2CAP_MODE);
+		if ("basic".equals(v)) {
+			return L2CAPModeConnection.MODE_BASIC;
+		} else if ("ertm".equals(v)) {
+			return L2CAPModeConnection.MODE_ERTM;
+		} else if ("streaming".equals(v)) {
+			return L2CAPModeConnection.MODE_STREAMING;
+		} else {
+			throw new IllegalArgumentException("invalid param value " + EXT_BLUECOVE_L2CAP_MODE + "=" + v);
+		}
+	}
+
+	static int paramL2CAPTransmitWindow(BluetoothStack bluetoothStack, Hashtable values, int mode) {
+		int txWindow = paramFeatureInt(bluetoothStack, values, EXT_BLUECOVE_L2CAP_TX_WINDOW,
+				BluetoothStack.FEATURE_L2CAP_MODE, BluetoothConsts.L2CAP_TX_WINDOW_MAX);
+		if ((txWindow != 0) && (mode != L2CAPModeConnection.MODE_ERTM)) {
+			throw new IllegalArgumentException(EXT_BLUECOVE_L2CAP_TX_WINDOW + " requires " + EXT_BLUECOVE_L2CAP_MODE
+					+ "=ertm");
+		}
+		return txWindow;
+	}
+
+	static int paramL2CAPFCS(BluetoothStack bluetoothStack, Hashtable values) {
+		if (values.get(EXT_BLUECOVE_L2CAP_FCS) == null) {
+			return BluetoothConsts.L2CAP_FCS_CRC16;
+		}
+		validateFeature(bluetoothStack, EXT_BLUECOVE_L2CAP_FCS, BluetoothStack.FEATURE_L2CAP_MODE);
+		return paramBoolean(values, EXT_BLUECOVE_L2CAP_FCS) ? BluetoothConsts.L2CAP_FCS_CRC16
+				: BluetoothConsts.L2CAP_FCS_NONE;
+	}
+
 	private static int paramL2CAPMTU(Hashtable values, String name) {
 		String v = (String) values.get(name);
 		if (v == null) {
@@ -0,0 +1,50 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * Connection input stream that can block until data arrives or deadline passes. Used by OBEX when timeouts are
+ * enabled.
+ * 
+ * <p>
+ * <b><u>Your application should not use this class directly.</u></b>
+ * 
+ */
+public interface ReadTimeoutInputStream {
+
+	/**
+	 * Reads up to len bytes like InputStream.read(byte[],int,int) but waits at most timeout milliseconds for the data.
+	 * 
+	 * @param timeout
+	 *            milliseconds, 0 or negative does not wait and reads only the data already received
+	 * @return the total number of bytes read into the buffer, or -1 if end of the stream has been reached
+	 * @throws java.io.InterruptedIOException
+	 *             if no data received before timeout expired
+	 */
+	public int read(byte[] b, int off, int len, int timeout) throws IOException;
+
+}
@@ -0,0 +1,50 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+/**
+ * L2CAP connection that can wait for the packet with a deadline. One call replaces ready() and receive() loop, on
+ * BlueZ it does not poll when the packet is already queued.
+ * 
+ * <p>
+ * <b>PUBLIC JSR-82 extension</b>
+ * 
+ */
+public interface ReceiveTimeoutL2CAPConnection {
+
+	/**
+	 * Reads a packet like L2CAPConnection.receive(byte[]) but waits at most timeout milliseconds for it. Stacks without
+	 * native receive timeout are polled using ready() every 10 milliseconds.
+	 * 
+	 * @param timeout
+	 *            milliseconds, 0 returns immediately when no packet is queued
+	 * @return the size of the packet, may be larger than inBuf when the packet was truncated; 0 for the packet of zero
+	 *         length; -1 if no packet arrived before timeout expired
+	 */
+	public int receive(byte[] inBuf, int timeout) throws IOException;
+
+}
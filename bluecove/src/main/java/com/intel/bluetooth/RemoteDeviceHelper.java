@@ -64,37 +64,66 @@ public abstract class RemoteDeviceHelper {
 
         private boolean paired;
 
+        private final RemoteDeviceRegistry registry;
+
         /**
-         * Connections can be discarded by the garbage collector.
+         * Connections can be discarded by the garbage collector. Guarded by
+         * this device.
          */
         private WeakVector connections;
 
-        private RemoteDeviceWithExtendedInfo(BluetoothStack bluetoothStack, long address, String name) {
+        /**
+         * Connections in the weak set plus connections discarded by the
+         * garbage collector that are not accounted yet. Updated by
+         * removeCollected().
+         */
+        private volatile int connectionsCount;
+
+        private RemoteDeviceWithExtendedInfo(BluetoothStack bluetoothStack, RemoteDeviceRegistry registry, long address, String name) {
             super(RemoteDeviceHelper.getBluetoothAddress(address));
             this.bluetoothStack = bluetoothStack;
+            this.registry = registry;
             this.name = name;
             this.addressLong = address;
         }
 
-        private void addConnection(Object connection) {
-            synchronized (this) {
-                if (connections == null) {
-                    connections = WeakVectorFactory.createWeakVector();
-                }
-            }
-            synchronized (connections) {
-                connections.addElement(connection);
-                DebugLog.debug("connection open, open now", connections.size());
+        private synchronized void addConnection(BluetoothConnectionAccess connection) {
+            if (connections == null) {
+                connections = WeakVectorFactory.createWeakVector();
             }
+            removeCollected();
+            connection.setRemoteDevice(this);
+            connections.addElement(connection);
+            connectionsCount++;
+            registry.connectionOpened(this, (connectionsCount == 1));
+            DebugLog.debug("connection open, open now", connectionsCount);
         }
 
-        private void removeConnection(Object connection) {
-            if (connections == null) {
+        private synchronized void removeConnection(BluetoothConnectionAccess connection) {
+            // Connection closed by application and finalize() reaches here twice
+            if (connection.getRemoteDevice() != this) {
                 return;
             }
-            synchronized (connections) {
-                connections.removeElement(connection);
-                DebugLog.debug("connection closed, open now", connections.size());
+            connection.setRemoteDevice(null);
+            // Already counted as closed by removeCollected() when finalize() reaches here
+            if (connections.removeElement(connection)) {
+                connectionsCount--;
+                registry.connectionClosed(this, (connectionsCount == 0));
+            }
+            DebugLog.debug("connection closed, open now", connectionsCount);
+        }
+
+        /**
+         * Connection discarded by the garbage collector without close() is
+         * removed from the weak set, finalize() may not release it when its
+         * streams are not closed. Count such connections as closed.
+         */
+        private synchronized void removeCollected() {
+            int alive = (connections == null) ? 0 : connections.size();
+            while (connectionsCount > alive) {
+                connectionsCount--;
+                registry.connectionClosed(this, (connectionsCount == 0));
+                DebugLog.debug("connection discarded, open now", connectionsCount);
             }
         }
 
@@ -102,8 +131,8 @@ public abstract class RemoteDeviceHelper {
             if (!hasConnections()) {
                 return;
             }
-            Vector c2shutdown = new Vector();
-            synchronized (connections) {
+            Vector c2shutdown;
+            synchronized (this) {
                 c2shutdown = Utils.clone(connections.elements());
             }
             for (Enumeration en = c2shutdown.elements(); en.hasMoreElements();) {
@@ -113,10 +142,9 @@ public abstract class RemoteDeviceHelper {
                 } catch (IOException e) {
                     DebugLog.debug("connection shutdown", e);
                 }
+                removeConnection(c);
             }
-            synchronized (connections) {
-                connections.removeAllElements();
-            }
+            removeCollected();
         }
 
         private void setStackAttributes(Object key, Object value) {
@@ -142,10 +170,10 @@ public abstract class RemoteDeviceHelper {
         }
 
         int connectionsCount() {
-            if (connections == null) {
-                return 0;
+            if (connectionsCount != 0) {
+                removeCollected();
             }
-            return connections.size();
+            return connectionsCount;
         }
 
         boolean hasConnections() {
@@ -189,15 +217,13 @@ public abstract class RemoteDeviceHelper {
             paired = false;
         }
 
-        private void updateConnectionMarkAuthenticated() {
+        private synchronized void updateConnectionMarkAuthenticated() {
             if (connections == null) {
                 return;
             }
-            synchronized (connections) {
-                for (Enumeration en = connections.elements(); en.hasMoreElements();) {
-                    BluetoothConnectionAccess c = (BluetoothConnectionAccess) en.nextElement();
-                    c.markAuthenticated();
-                }
+            for (Enumeration en = connections.elements(); en.hasMoreElements();) {
+                BluetoothConnectionAccess c = (BluetoothConnectionAccess) en.nextElement();
+                c.markAuthenticated();
             }
         }
 
@@ -270,7 +296,7 @@ public abstract class RemoteDeviceHelper {
             if (authenticated != null) {
                 return authenticated.booleanValue();
             }
-            synchronized (connections) {
+            synchronized (this) {
                 // Find first authenticated connection
                 for (Enumeration en = connections.elements(); en.hasMoreElements();) {
                     BluetoothConnectionAccess c = (BluetoothConnectionAccess) en.nextElement();
@@ -291,7 +317,7 @@ public abstract class RemoteDeviceHelper {
             if (!hasConnections()) {
                 return false;
             }
-            synchronized (connections) {
+            synchronized (this) {
                 // Find first encrypted connection
                 for (Enumeration en = connections.elements(); en.hasMoreElements();) {
                     BluetoothConnectionAccess c = (BluetoothConnectionAccess) en.nextElement();
@@ -318,24 +344,56 @@ public abstract class RemoteDeviceHelper {
         }
     }
 
-    private static Hashtable stackDevicesCashed = new Hashtable();
+    private static class StackDevices {
+
+        final BluetoothStack bluetoothStack;
+
+        final RemoteDeviceRegistry devices = new RemoteDeviceRegistry();
+
+        StackDevices(BluetoothStack bluetoothStack) {
+            this.bluetoothStack = bluetoothStack;
+        }
+    }
+
+    /**
+     * Copied on change, there are only few stacks.
+     */
+    private static volatile StackDevices[] stackDevicesCashed = new StackDevices[0];
 
     private RemoteDeviceHelper() {
 
     }
 
-    private static synchronized Hashtable devicesCashed(BluetoothStack bluetoothStack) {
-        Hashtable devicesCashed = (Hashtable) stackDevicesCashed.get(bluetoothStack);
-        if (devicesCashed == null) {
-            devicesCashed = new Hashtable();
-            stackDevicesCashed.put(bluetoothStack, devicesCashed);
+    private static RemoteDeviceRegistry findDevicesCashed(StackDevices[] stacks, BluetoothStack bluetoothStack) {
+        for (int i = 0; i < stacks.length; i++) {
+            if (stacks[i].bluetoothStack == bluetoothStack) {
+                return stacks[i].devices;
+            }
+        }
+        return null;
+    }
+
+    private static RemoteDeviceRegistry devicesCashed(BluetoothStack bluetoothStack) {
+        RemoteDeviceRegistry devicesCashed = findDevicesCashed(stackDevicesCashed, bluetoothStack);
+        if (devicesCashed != null) {
+            return devicesCashed;
+        }
+        synchronized (RemoteDeviceHelper.class) {
+            StackDevices[] stacks = stackDevicesCashed;
+            devicesCashed = findDevicesCashed(stacks, bluetoothStack);
+            if (devicesCashed == null) {
+                StackDevices[] newStacks = new StackDevices[stacks.length + 1];
+                System.arraycopy(stacks, 0, newStacks, 0, stacks.length);
+                newStacks[stacks.length] = new StackDevices(bluetoothStack);
+                devicesCashed = newStacks[stacks.length].devices;
+                stackDevicesCashed = newStacks;
+            }
+            return devicesCashed;
         }
-        return devicesCashed;
     }
 
     private static RemoteDeviceWithExtendedInfo getCashedDeviceWithExtendedInfo(BluetoothStack bluetoothStack, long address) {
-        Object key = new Long(address);
-        return (RemoteDeviceWithExtendedInfo) devicesCashed(bluetoothStack).get(key);
+        return (RemoteDeviceWithExtendedInfo) devicesCashed(bluetoothStack).get(address);
     }
 
     static RemoteDevice getCashedDevice(BluetoothStack bluetoothStack, long address) {
@@ -350,19 +408,23 @@ public abstract class RemoteDeviceHelper {
     }
     
     static RemoteDevice createRemoteDevice(BluetoothStack bluetoothStack, long address, String name, boolean paired) {
-        RemoteDeviceWithExtendedInfo dev = getCashedDeviceWithExtendedInfo(bluetoothStack, address);
+        RemoteDeviceRegistry devicesCashed = devicesCashed(bluetoothStack);
+        RemoteDeviceWithExtendedInfo dev = (RemoteDeviceWithExtendedInfo) devicesCashed.get(address);
         if (dev == null) {
+            RemoteDeviceWithExtendedInfo newDev;
             Object saveID = BlueCoveImpl.getCurrentThreadBluetoothStackID();
             try {
                 BlueCoveImpl.setThreadBluetoothStack(bluetoothStack);
-                dev = new RemoteDeviceWithExtendedInfo(bluetoothStack, address, name);
+                newDev = new RemoteDeviceWithExtendedInfo(bluetoothStack, devicesCashed, address, name);
             } finally {
                 if (saveID != null) {
                     BlueCoveImpl.setThreadBluetoothStackID(saveID);
                 }
             }
-            devicesCashed(bluetoothStack).put(new Long(address), dev);
-            DebugLog.debug0x("new devicesCashed", address);
+            dev = (RemoteDeviceWithExtendedInfo) devicesCashed.putIfAbsent(address, newDev);
+            if (dev == newDev) {
+                DebugLog.debug0x("new devicesCashed", address);
+            }
         } else if (!Utils.isStringSet(dev.name)) {
             // name found
             dev.name = name;
@@ -414,14 +476,7 @@ public abstract class RemoteDeviceHelper {
      * @return number of connections
      */
     public static int openConnections() {
-        int c = 0;
-        Hashtable devicesCashed = devicesCashed(getBluetoothStack());
-        synchronized (devicesCashed) {
-            for (Enumeration en = devicesCashed.elements(); en.hasMoreElements();) {
-                c += ((RemoteDeviceWithExtendedInfo) en.nextElement()).connectionsCount();
-            }
-        }
-        return c;
+        return removeCollected(getBluetoothStack()).openConnections();
     }
 
     /**
@@ -443,24 +498,28 @@ public abstract class RemoteDeviceHelper {
      * @return number of connections
      */
     public static int connectedDevices() {
-        int c = 0;
-        Hashtable devicesCashed = devicesCashed(getBluetoothStack());
-        synchronized (devicesCashed) {
-            for (Enumeration en = devicesCashed.elements(); en.hasMoreElements();) {
-                if (((RemoteDeviceWithExtendedInfo) en.nextElement()).hasConnections()) {
-                    c++;
-                }
+        return removeCollected(getBluetoothStack()).connectedDevicesCount();
+    }
+
+    /**
+     * Update connection counts of devices that had connections discarded by
+     * the garbage collector.
+     */
+    private static RemoteDeviceRegistry removeCollected(BluetoothStack bluetoothStack) {
+        RemoteDeviceRegistry devicesCashed = devicesCashed(bluetoothStack);
+        if (devicesCashed.connectedDevicesCount() != 0) {
+            Vector connected = devicesCashed.connectedDevices();
+            for (Enumeration en = connected.elements(); en.hasMoreElements();) {
+                ((RemoteDeviceWithExtendedInfo) en.nextElement()).removeCollected();
             }
         }
-        return c;
+        return devicesCashed;
     }
 
     static void shutdownConnections(BluetoothStack bluetoothStack) {
-        Hashtable devicesCashed = devicesCashed(bluetoothStack);
-        synchronized (devicesCashed) {
-            for (Enumeration en = devicesCashed.elements(); en.hasMoreElements();) {
-                ((RemoteDeviceWithExtendedInfo) en.nextElement()).shutdownConnections();
-            }
+        Vector connected = devicesCashed(bluetoothStack).connectedDevices();
+        for (Enumeration en = connected.elements(); en.hasMoreElements();) {
+            ((RemoteDeviceWithExtendedInfo) en.nextElement()).shutdownConnections();
         }
     }
 
@@ -526,7 +585,6 @@ public abstract class RemoteDeviceHelper {
 
     static void connected(BluetoothConnectionAccess connection) throws IOException {
         RemoteDeviceWithExtendedInfo device = (RemoteDeviceWithExtendedInfo) implGetRemoteDevice((Connection) connection);
-        connection.setRemoteDevice(device);
         device.addConnection(connection);
     }
 
@@ -534,7 +592,6 @@ public abstract class RemoteDeviceHelper {
         RemoteDevice d = connection.getRemoteDevice();
         if (d != null) {
             ((RemoteDeviceWithExtendedInfo) d).removeConnection(connection);
-            connection.setRemoteDevice(null);
         }
     }
 
@@ -690,7 +747,7 @@ public abstract class RemoteDeviceHelper {
             }
         }
 
-        Hashtable devicesCashed = devicesCashed(bluetoothStack);
+        RemoteDeviceRegistry devicesCashed = devicesCashed(bluetoothStack);
         switch (option) {
         case DiscoveryAgent.PREKNOWN:
             if (devicesCashed.size() == 0) {
@@ -698,7 +755,7 @@ public abstract class RemoteDeviceHelper {
                 return null;
             }
             Vector devicesPaired = new Vector();
-            for (Enumeration en = devicesCashed.elements(); en.hasMoreElements();) {
+            for (Enumeration en = devicesCashed.devices().elements(); en.hasMoreElements();) {
                 RemoteDeviceWithExtendedInfo d = (RemoteDeviceWithExtendedInfo) en.nextElement();
                 if (d.isTrustedDevice()) {
                     devicesPaired.addElement(d);
@@ -714,12 +771,7 @@ public abstract class RemoteDeviceHelper {
                 // Spec: null if no devices meet the criteria
                 return null;
             }
-            RemoteDevice[] devices = new RemoteDevice[devicesCashed.size()];
-            int k = 0;
-            for (Enumeration en = devicesCashed.elements(); en.hasMoreElements();) {
-                devices[k++] = (RemoteDevice) en.nextElement();
-            }
-            return devices;
+            return remoteDeviceListToArray(devicesCashed.devices());
         default:
             throw new IllegalArgumentException("invalid option");
         }
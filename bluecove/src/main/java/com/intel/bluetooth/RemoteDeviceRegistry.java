@@ -0,0 +1,180 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.util.Enumeration;
+import java.util.Hashtable;
+import java.util.Vector;
+
+/**
+ * Devices known to one BluetoothStack, keyed by Bluetooth address.
+ * <p>
+ * Lookups do not take the lock, entries are immutable and the table is replaced on resize. Devices with open
+ * connections are also kept in a separate set so connection count and shutdown do not visit every known device.
+ */
+class RemoteDeviceRegistry {
+
+	private static final int INITIAL_CAPACITY = 64;
+
+	private static class Entry {
+
+		final long address;
+
+		final Object device;
+
+		final Entry next;
+
+		Entry(long address, Object device, Entry next) {
+			this.address = address;
+			this.device = device;
+			this.next = next;
+		}
+	}
+
+	private volatile Entry[] table = new Entry[INITIAL_CAPACITY];
+
+	private volatile int size;
+
+	private final Hashtable/* <Object, Object> */connectedDevices = new Hashtable();
+
+	private volatile int connectedDevicesCount;
+
+	private volatile int openConnections;
+
+	private static int index(long address, int length) {
+		int h = (int) (address ^ (address >>> 32));
+		h ^= (h >>> 16);
+		return h & (length - 1);
+	}
+
+	private static Object find(Entry[] t, long address) {
+		for (Entry e = t[index(address, t.length)]; e != null; e = e.next) {
+			if (e.address == address) {
+				return e.device;
+			}
+		}
+		return null;
+	}
+
+	Object get(long address) {
+		Object device = find(table, address);
+		if (device != null) {
+			return device;
+		}
+		// Entry just added by other thread may not be visible yet
+		synchronized (this) {
+			return find(table, address);
+		}
+	}
+
+	/**
+	 * @return device already registered with this address or <code>device</code>
+	 */
+	synchronized Object putIfAbsent(long address, Object device) {
+		Entry[] t = table;
+		Object registered = find(t, address);
+		if (registered != null) {
+			return registered;
+		}
+		if (size >= (t.length - (t.length >> 2))) {
+			t = resize(t);
+		}
+		int i = index(address, t.length);
+		t[i] = new Entry(address, device, t[i]);
+		size++;
+		return device;
+	}
+
+	private Entry[] resize(Entry[] t) {
+		Entry[] n = new Entry[t.length * 2];
+		for (int i = 0; i < t.length; i++) {
+			for (Entry e = t[i]; e != null; e = e.next) {
+				int k = index(e.address, n.length);
+				n[k] = new Entry(e.address, e.device, n[k]);
+			}
+		}
+		table = n;
+		return n;
+	}
+
+	int size() {
+		return size;
+	}
+
+	Vector/* <Object> */devices() {
+		Entry[] t = table;
+		Vector v = new Vector(size);
+		for (int i = 0; i < t.length; i++) {
+			for (Entry e = t[i]; e != null; e = e.next) {
+				v.addElement(e.device);
+			}
+		}
+		return v;
+	}
+
+	/**
+	 * Called by device with its lock held.
+	 * 
+	 * @param first
+	 *            device had no open connections before
+	 */
+	synchronized void connectionOpened(Object device, boolean first) {
+		openConnections++;
+		if (first) {
+			connectedDevices.put(device, device);
+			connectedDevicesCount = connectedDevices.size();
+		}
+	}
+
+	/**
+	 * Called by device with its lock held.
+	 * 
+	 * @param last
+	 *            device has no open connections now
+	 */
+	synchronized void connectionClosed(Object device, boolean last) {
+		openConnections--;
+		if (last) {
+			connectedDevices.remove(device);
+			connectedDevicesCount = connectedDevices.size();
+		}
+	}
+
+	int openConnections() {
+		return openConnections;
+	}
+
+	int connectedDevicesCount() {
+		return connectedDevicesCount;
+	}
+
+	synchronized Vector/* <Object> */connectedDevices() {
+		Vector v = new Vector(connectedDevices.size());
+		for (Enumeration en = connectedDevices.elements(); en.hasMoreElements();) {
+			v.addElement(en.nextElement());
+		}
+		return v;
+	}
+}
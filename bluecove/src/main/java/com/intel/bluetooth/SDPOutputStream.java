@@ -119,20 +119,13 @@ class SDPOutputStream extends OutputStream {
 
 		case DataElement.DATSEQ:
 		case DataElement.DATALT: {
-			int result = 1;
+			int contentLength = 0;
 
 			for (Enumeration e = (Enumeration) d.getValue(); e.hasMoreElements();) {
-				result += getLength((DataElement) e.nextElement());
-			}
-			if (result < 0xff) {
-				result += 1;
-			} else if (result < 0xFFFF) {
-				result += 2;
-			} else {
-				result += 4;
+				contentLength += getLength((DataElement) e.nextElement());
 			}
 
-			return result;
+			return getSequenceLength(contentLength);
 		}
 
 		default:
@@ -140,6 +133,45 @@ class SDPOutputStream extends OutputStream {
 		}
 	}
 
+	/**
+	 * @return length of DATSEQ or DATALT with header for given length of encoded elements
+	 */
+	static int getSequenceLength(int contentLength) {
+		int result = 1 + contentLength;
+		if (result < 0xff) {
+			result += 1;
+		} else if (result < 0xFFFF) {
+			result += 2;
+		} else {
+			result += 4;
+		}
+		return result;
+	}
+
+	/**
+	 * Write DATSEQ header, elements are written by caller.
+	 * 
+	 * @param len
+	 *            sequence length as returned by getLength()
+	 */
+	void writeSequenceHeader(int len) throws IOException {
+		int sizeDescriptor;
+		int lenSize;
+		if (len < (0xff + 2)) {
+			sizeDescriptor = 5;
+			lenSize = 1;
+		} else if (len < (0xFFFF + 3)) {
+			sizeDescriptor = 6;
+			lenSize = 2;
+		} else {
+			sizeDescriptor = 7;
+			lenSize = 4;
+		}
+		len -= (1 + lenSize);
+		write(48 | sizeDescriptor);
+		writeLong(len, lenSize);
+	}
+
 	void writeElement(DataElement d) throws IOException {
 		switch (d.getDataType()) {
 		case DataElement.NULL:
@@ -231,22 +263,7 @@ class SDPOutputStream extends OutputStream {
 			break;
 
 		case DataElement.DATSEQ: {
-			int sizeDescriptor;
-			int len = getLength(d);
-			int lenSize;
-			if (len < (0xff + 2)) {
-				sizeDescriptor = 5;
-				lenSize = 1;
-			} else if (len < (0xFFFF + 3)) {
-				sizeDescriptor = 6;
-				lenSize = 2;
-			} else {
-				sizeDescriptor = 7;
-				lenSize = 4;
-			}
-			len -= (1 + lenSize);
-			write(48 | sizeDescriptor);
-			writeLong(len, lenSize);
+			writeSequenceHeader(getLength(d));
 
 			for (Enumeration e = (Enumeration) d.getValue(); e.hasMoreElements();) {
 				writeElement((DataElement) e.nextElement());
@@ -28,6 +28,7 @@ import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.util.Enumeration;
 import java.util.Hashtable;
+import java.util.Vector;
 
 import javax.bluetooth.BluetoothStateException;
 import javax.bluetooth.DataElement;
@@ -48,6 +49,16 @@ class ServiceRecordImpl implements ServiceRecord {
 
 	Hashtable attributes;
 
+	// <Integer, EncodedAttribute>
+	private Hashtable encodedAttributes = new Hashtable();
+
+	/**
+	 * Last result of toByteArray() and attributes it was made of, returned again while no attribute is changed.
+	 */
+	private byte[] encodedRecord;
+
+	private byte[][] encodedRecordParts;
+
 	protected boolean attributeUpdated;
 
 	int deviceServiceClasses;
@@ -68,44 +79,126 @@ class ServiceRecordImpl implements ServiceRecord {
 	}
 
 	byte[] toByteArray() throws IOException {
-	    DataElement rootSeq = new DataElement(DataElement.DATSEQ);
-		final boolean sort = true;
-		if (sort) {
-			int[] sortIDs = new int[attributes.size()];
-			int k = 0;
-			for (Enumeration e = attributes.keys(); e.hasMoreElements();) {
-				Integer key = (Integer) e.nextElement();
-				sortIDs[k] = key.intValue();
-				k++;
+		int[] sortIDs = new int[attributes.size()];
+		int k = 0;
+		for (Enumeration e = attributes.keys(); e.hasMoreElements();) {
+			Integer key = (Integer) e.nextElement();
+			sortIDs[k] = key.intValue();
+			k++;
+		}
+		// Sort
+		for (int i = 0; i < sortIDs.length; i++) {
+			for (int j = 0; j < sortIDs.length - i - 1; j++) {
+				if (sortIDs[j] > sortIDs[j + 1]) {
+					int temp = sortIDs[j];
+					sortIDs[j] = sortIDs[j + 1];
+					sortIDs[j + 1] = temp;
+				}
 			}
-			// DebugLog.debug("b4 sort", sortIDs);
-			// Sort
-			for (int i = 0; i < sortIDs.length; i++) {
-				for (int j = 0; j < sortIDs.length - i - 1; j++) {
-					if (sortIDs[j] > sortIDs[j + 1]) {
-						int temp = sortIDs[j];
-						sortIDs[j] = sortIDs[j + 1];
-						sortIDs[j + 1] = temp;
-					}
+		}
+		byte[][] encoded = new byte[sortIDs.length][];
+		boolean changed = (encodedRecordParts == null) || (encodedRecordParts.length != sortIDs.length);
+		int contentLength = 0;
+		for (int i = 0; i < sortIDs.length; i++) {
+			encoded[i] = getEncodedAttribute(sortIDs[i]);
+			contentLength += encoded[i].length;
+			if ((!changed) && (encodedRecordParts[i] != encoded[i])) {
+				changed = true;
+			}
+		}
+		if (!changed) {
+			return encodedRecord;
+		}
+		int length = SDPOutputStream.getSequenceLength(contentLength);
+		ByteArrayOutputStream header = new ByteArrayOutputStream(5);
+		(new SDPOutputStream(header)).writeSequenceHeader(length);
+		byte[] data = new byte[length];
+		int offset = header.size();
+		System.arraycopy(header.toByteArray(), 0, data, 0, offset);
+		for (int i = 0; i < encoded.length; i++) {
+			System.arraycopy(encoded[i], 0, data, offset, encoded[i].length);
+			offset += encoded[i].length;
+		}
+		encodedRecord = data;
+		encodedRecordParts = encoded;
+		return data;
+	}
+
+	/**
+	 * Encoded attribute ID and value, reused by toByteArray() until attribute is changed.
+	 */
+	private static class EncodedAttribute {
+
+		byte[] data;
+
+		/**
+		 * DATSEQ and DATALT can be modified after setAttributeValue(). Elements of value tree in pre-order,
+		 * each container followed by number of its elements.
+		 */
+		private Vector structure = new Vector();
+
+		EncodedAttribute(int attrID, DataElement value) throws IOException {
+			ByteArrayOutputStream out = new ByteArrayOutputStream();
+			SDPOutputStream sdpOut = new SDPOutputStream(out);
+			sdpOut.writeElement(new DataElement(DataElement.U_INT_2, attrID));
+			sdpOut.writeElement(value);
+			data = out.toByteArray();
+			snapshot(value);
+		}
+
+		private static boolean isContainer(DataElement d) {
+			return (d.getDataType() == DataElement.DATSEQ) || (d.getDataType() == DataElement.DATALT);
+		}
+
+		private void snapshot(DataElement d) {
+			structure.addElement(d);
+			if (isContainer(d)) {
+				int count = 0;
+				for (Enumeration e = (Enumeration) d.getValue(); e.hasMoreElements(); count++) {
+					snapshot((DataElement) e.nextElement());
 				}
+				structure.addElement(new Integer(count));
 			}
-			// DebugLog.debug("sorted", sortIDs);
-			for (int i = 0; i < sortIDs.length; i++) {
-			    int attrID  = sortIDs[i];
-			    rootSeq.addElement(new DataElement(DataElement.U_INT_2, attrID));
-			    rootSeq.addElement(getAttributeValue(attrID));
+		}
+
+		/**
+		 * @return position after the element in structure or -1 if element tree changed
+		 */
+		private int matches(DataElement d, int position) {
+			if ((position >= structure.size()) || (structure.elementAt(position) != d)) {
+				return -1;
 			}
-		} else {
-			for (Enumeration e = attributes.keys(); e.hasMoreElements();) {
-				Integer key = (Integer) e.nextElement();
-				rootSeq.addElement(new DataElement(DataElement.U_INT_2, key.intValue()));
-				rootSeq.addElement((DataElement) attributes.get(key));
+			position++;
+			if (isContainer(d)) {
+				int count = 0;
+				for (Enumeration e = (Enumeration) d.getValue(); e.hasMoreElements(); count++) {
+					position = matches((DataElement) e.nextElement(), position);
+					if (position == -1) {
+						return -1;
+					}
+				}
+				if ((position >= structure.size()) || (!new Integer(count).equals(structure.elementAt(position)))) {
+					return -1;
+				}
+				position++;
 			}
+			return position;
+		}
+
+		boolean isValid(DataElement value) {
+			return matches(value, 0) == structure.size();
+		}
+	}
+
+	private byte[] getEncodedAttribute(int attrID) throws IOException {
+		Integer key = new Integer(attrID);
+		DataElement value = (DataElement) attributes.get(key);
+		EncodedAttribute encoded = (EncodedAttribute) encodedAttributes.get(key);
+		if ((encoded == null) || (!encoded.isValid(value))) {
+			encoded = new EncodedAttribute(attrID, value);
+			encodedAttributes.put(key, encoded);
 		}
-        ByteArrayOutputStream out = new ByteArrayOutputStream();
-        SDPOutputStream sdpOut = new SDPOutputStream(out);
-        sdpOut.writeElement(rootSeq);
-		return out.toByteArray();
+		return encoded.data;
 	}
 
 	void loadByteArray(byte data[]) throws IOException {
@@ -605,6 +698,7 @@ class ServiceRecordImpl implements ServiceRecord {
 		 */
 
 		attributeUpdated = true;
+		encodedAttributes.remove(new Integer(attrID));
 		if (attrValue == null) {
 			return (attributes.remove(new Integer(attrID)) != null);
 		} else {
@@ -620,6 +714,7 @@ class ServiceRecordImpl implements ServiceRecord {
 		if (attrID < 0x0000 || attrID > 0xffff) {
 			throw new IllegalArgumentException();
 		}
+		encodedAttributes.remove(new Integer(attrID));
 		if (attrValue == null) {
 			attributes.remove(new Integer(attrID));
 		} else {
@@ -26,6 +26,7 @@ package com.intel.bluetooth;
 
 import java.util.Enumeration;
 import java.util.Hashtable;
+import java.util.Vector;
 
 import javax.bluetooth.ServiceRecord;
 import javax.bluetooth.ServiceRegistrationException;
@@ -48,6 +49,18 @@ public abstract class ServiceRecordsRegistry {
 	// <ServiceRecordImpl, BluetoothConnectionNotifierServiceRecordAccess>
 	private static Hashtable serviceRecordsMap = new Hashtable();
 
+	/**
+	 * Records waiting for commitBatchRegistration() in the current thread
+	 */
+	// <BluetoothStackBatchRegistration, Vector<ServiceRecordImpl>>
+	private static ThreadLocalWrapper batchRegistration = new ThreadLocalWrapper();
+
+	/**
+	 * Deferred records of all threads, notifier may be closed in other thread than one that opened it
+	 */
+	// <ServiceRecordImpl, Vector<ServiceRecordImpl>>
+	private static Hashtable deferredRecords = new Hashtable();
+
 	private ServiceRecordsRegistry() {
 
 	}
@@ -70,6 +83,80 @@ public abstract class ServiceRecordsRegistry {
 		return deviceServiceClasses;
 	}
 
+	/**
+	 * Defer SDP registration of service records created by Connector.open() in the current thread until
+	 * {@link #commitBatchRegistration()} is called. Stacks that can't register records in batch register them
+	 * immediately.
+	 * <p>
+	 * Records are not visible to remote devices before commit, acceptAndOpen() should be called after commit.
+	 */
+	public static void beginBatchRegistration() {
+		if (batchRegistration.get() == null) {
+			batchRegistration.set(new Hashtable());
+		}
+	}
+
+	/**
+	 * Register all records deferred since {@link #beginBatchRegistration()}. When registration fails on some
+	 * stack none of its records are registered and notifiers should be closed by application.
+	 * 
+	 * @throws ServiceRegistrationException
+	 *             if registration failed
+	 */
+	public static void commitBatchRegistration() throws ServiceRegistrationException {
+		Hashtable batch = (Hashtable) batchRegistration.get();
+		if (batch == null) {
+			return;
+		}
+		batchRegistration.set(null);
+		for (Enumeration en = batch.keys(); en.hasMoreElements();) {
+			BluetoothStackBatchRegistration stack = (BluetoothStackBatchRegistration) en.nextElement();
+			Vector records = (Vector) batch.get(stack);
+			ServiceRecordImpl[] serviceRecords;
+			synchronized (ServiceRecordsRegistry.class) {
+				serviceRecords = new ServiceRecordImpl[records.size()];
+				records.copyInto(serviceRecords);
+				for (int i = 0; i < serviceRecords.length; i++) {
+					deferredRecords.remove(serviceRecords[i]);
+				}
+			}
+			stack.registerServiceRecords(serviceRecords);
+		}
+	}
+
+	/**
+	 * Called by stack when record should be registered.
+	 * 
+	 * @return true if registration is deferred until commitBatchRegistration()
+	 */
+	static boolean deferRegistration(BluetoothStackBatchRegistration stack, ServiceRecordImpl serviceRecord) {
+		Hashtable batch = (Hashtable) batchRegistration.get();
+		if (batch == null) {
+			return false;
+		}
+		synchronized (ServiceRecordsRegistry.class) {
+			Vector records = (Vector) batch.get(stack);
+			if (records == null) {
+				records = new Vector();
+				batch.put(stack, records);
+			}
+			records.addElement(serviceRecord);
+			deferredRecords.put(serviceRecord, records);
+		}
+		return true;
+	}
+
+	/**
+	 * Called by stack when record that is not registered yet is closed, in any thread.
+	 */
+	static synchronized void cancelDeferredRegistration(BluetoothStackBatchRegistration stack,
+			ServiceRecordImpl serviceRecord) {
+		Vector records = (Vector) deferredRecords.remove(serviceRecord);
+		if (records != null) {
+			records.removeElement(serviceRecord);
+		}
+	}
+
 	public static void updateServiceRecord(ServiceRecord srvRecord) throws ServiceRegistrationException {
 		BluetoothConnectionNotifierServiceRecordAccess owner;
 		synchronized (ServiceRecordsRegistry.class) {
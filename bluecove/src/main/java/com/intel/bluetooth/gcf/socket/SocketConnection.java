@@ -31,7 +31,14 @@ import java.io.InputStream;
 import java.io.OutputStream;
 import java.net.Socket;
 
-public class SocketConnection implements javax.microedition.io.SocketConnection {
+import com.intel.bluetooth.BluetoothConnectionBuffers;
+
+public class SocketConnection implements javax.microedition.io.SocketConnection, BluetoothConnectionBuffers {
+
+	/**
+	 * TCP window grows with the transfer, the size reported to OBEX is the largest packet.
+	 */
+	private static final int TRANSPORT_BUFFER_SIZE = 0xFFFF;
 
 	protected Socket socket;
 
@@ -159,6 +166,15 @@ public class SocketConnection implements javax.microedition.io.SocketConnection
 		}
 	}
 
+	/*
+	 * (non-Javadoc)
+	 * 
+	 * @see com.intel.bluetooth.BluetoothConnectionBuffers#getTransportBufferSize()
+	 */
+	public int getTransportBufferSize() throws IOException {
+		return TRANSPORT_BUFFER_SIZE;
+	}
+
 	public void close() throws IOException {
 		// TODO fix differences between Java ME and Java SE
 
@@ -166,7 +182,7 @@ public class SocketConnection implements javax.microedition.io.SocketConnection
 	}
 
 	public InputStream openInputStream() throws IOException {
-		return socket.getInputStream();
+		return new SocketInputStream(socket);
 	}
 
 	public DataInputStream openDataInputStream() throws IOException {
@@ -0,0 +1,99 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.gcf.socket;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.InterruptedIOException;
+import java.net.Socket;
+
+import com.intel.bluetooth.ReadTimeoutInputStream;
+
+/**
+ * Socket InputStream that can wait for data with timeout using SO_TIMEOUT.
+ * 
+ * SO_TIMEOUT is changed only when the next read needs another value, so a sequence of timed reads does not call
+ * setSoTimeout each time.
+ */
+class SocketInputStream extends InputStream implements ReadTimeoutInputStream {
+
+	private final Socket socket;
+
+	private final InputStream in;
+
+	private final int defaultSoTimeout;
+
+	private int soTimeout;
+
+	SocketInputStream(Socket socket) throws IOException {
+		this.socket = socket;
+		this.in = socket.getInputStream();
+		this.defaultSoTimeout = socket.getSoTimeout();
+		this.soTimeout = this.defaultSoTimeout;
+	}
+
+	private synchronized void setSoTimeout(int timeout) throws IOException {
+		if (soTimeout != timeout) {
+			socket.setSoTimeout(timeout);
+			soTimeout = timeout;
+		}
+	}
+
+	public int read() throws IOException {
+		setSoTimeout(defaultSoTimeout);
+		return in.read();
+	}
+
+	public int read(byte[] b, int off, int len) throws IOException {
+		setSoTimeout(defaultSoTimeout);
+		return in.read(b, off, len);
+	}
+
+	/*
+	 * (non-Javadoc)
+	 * 
+	 * @see com.intel.bluetooth.ReadTimeoutInputStream#read(byte[], int, int, int)
+	 */
+	public synchronized int read(byte[] b, int off, int len, int timeout) throws IOException {
+		if (timeout <= 0) {
+			// SO_TIMEOUT zero is infinite, only check for data already received
+			if (in.available() == 0) {
+				throw new InterruptedIOException("Socket read timeout");
+			}
+			setSoTimeout(defaultSoTimeout);
+		} else {
+			setSoTimeout(timeout);
+		}
+		return in.read(b, off, len);
+	}
+
+	public int available() throws IOException {
+		return in.available();
+	}
+
+	public void close() throws IOException {
+		in.close();
+	}
+}
@@ -25,9 +25,12 @@
  */
 package com.intel.bluetooth.obex;
 
+import java.io.File;
 import java.io.IOException;
 
 import javax.microedition.io.Connection;
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
 
 /**
  * Allow access to BlueCove OBEX internals. Non JSR-82.
@@ -70,6 +73,48 @@ public abstract class BlueCoveOBEX {
         }
     }
 
+    /**
+     * PUT the file to the server. Faster than copying the file to Operation output stream, file data is read directly
+     * to OBEX packets. Length header is set to the file size if not present in headers. Requires Java 1.4 or later.
+     * 
+     * @param c
+     *            the connected OBEX client session
+     * @param headers
+     *            the headers to send in the initial PUT request, may be <code>null</code>
+     * @param file
+     *            the file to send
+     * @return the headers received from the server, use <code>getResponseCode()</code> to check the result
+     * @throws IOException
+     */
+    public static HeaderSet putFile(ClientSession c, HeaderSet headers, File file) throws IOException {
+        if (c instanceof OBEXClientSessionImpl) {
+            return ((OBEXClientSessionImpl) c).putFile(headers, file);
+        } else {
+            throw new IllegalArgumentException("Not a BlueCove OBEX Session " + c.getClass().getName());
+        }
+    }
+
+    /**
+     * PUT several objects in one connected session. Small object is sent with its headers in a single packet instead
+     * of separate headers and body packets, so pushing many small objects like vCards costs one round trip per object.
+     * 
+     * @param c
+     *            the connected OBEX client session
+     * @param headers
+     *            the headers for each object, element may be <code>null</code>
+     * @param objects
+     *            the objects data
+     * @return OBEX response code for each object
+     * @throws IOException
+     */
+    public static int[] putObjects(ClientSession c, HeaderSet[] headers, byte[][] objects) throws IOException {
+        if (c instanceof OBEXClientSessionImpl) {
+            return ((OBEXClientSessionImpl) c).putObjects(headers, objects);
+        } else {
+            throw new IllegalArgumentException("Not a BlueCove OBEX Session " + c.getClass().getName());
+        }
+    }
+
     /**
      * ConvertOBEX SUCCESS response code to human readable string, useful for debugging
      * applications.
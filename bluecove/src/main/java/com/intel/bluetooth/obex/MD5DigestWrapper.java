@@ -28,7 +28,7 @@ import java.security.MessageDigest;
 import java.security.NoSuchAlgorithmException;
 
 /**
- *
+ * MD5 used by OBEX authentication. The instance can be reused, digest() resets it for the next calculation.
  *
  */
 class MD5DigestWrapper {
@@ -47,6 +47,14 @@ class MD5DigestWrapper {
 		md5impl.update(input);
 	}
 
+	void update(byte[] input, int offset, int len) {
+		md5impl.update(input, offset, len);
+	}
+
+	void reset() {
+		md5impl.reset();
+	}
+
 	byte[] digest() {
 		return md5impl.digest();
 	}
@@ -24,7 +24,6 @@
  */
 package com.intel.bluetooth.obex;
 
-import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.UnsupportedEncodingException;
 import java.util.Enumeration;
@@ -44,6 +43,13 @@ class OBEXAuthentication {
 
 	private static final byte COLUMN[] = { ':' };
 
+	/**
+	 * Nonce generator state, guarded by class lock.
+	 */
+	private static MD5DigestWrapper nonceDigest;
+
+	private static final byte timestamp[] = new byte[8];
+
 	static class Challenge {
 
 		private String realm;
@@ -66,20 +72,9 @@ class OBEXAuthentication {
 		}
 
 		byte[] write() {
-			ByteArrayOutputStream buf = new ByteArrayOutputStream();
-
-			buf.write(0x00); // Tag
-			buf.write(0x10); // Len
-			buf.write(nonce, 0, 0x10);
-
-			byte options = (byte) ((isUserIdRequired ? 1 : 0) | ((!isFullAccess) ? 2 : 0));
-			buf.write(0x01); // Tag
-			buf.write(0x01); // Len
-			buf.write(options);
-
+			byte realmArray[] = null;
+			byte charSetCode = 0;
 			if (realm != null) {
-				byte realmArray[];
-				byte charSetCode;
 				try {
 					realmArray = OBEXUtils.getUTF16Bytes(realm);
 					charSetCode = -1; // 0xFF; Unicode
@@ -91,13 +86,26 @@ class OBEXAuthentication {
 					}
 					charSetCode = 1; // iso-8859-1
 				}
-				buf.write(0x02); // Tag
-				buf.write(realmArray.length + 1); // Len
-				buf.write(charSetCode);
-				buf.write(realmArray, 0, realmArray.length);
 			}
+			byte buf[] = new byte[2 + 0x10 + 3 + ((realmArray != null) ? (3 + realmArray.length) : 0)];
+			int i = 0;
+			buf[i++] = 0x00; // Tag
+			buf[i++] = 0x10; // Len
+			System.arraycopy(nonce, 0, buf, i, 0x10);
+			i += 0x10;
 
-			return buf.toByteArray();
+			byte options = (byte) ((isUserIdRequired ? 1 : 0) | ((!isFullAccess) ? 2 : 0));
+			buf[i++] = 0x01; // Tag
+			buf[i++] = 0x01; // Len
+			buf[i++] = options;
+
+			if (realmArray != null) {
+				buf[i++] = 0x02; // Tag
+				buf[i++] = (byte) (realmArray.length + 1); // Len
+				buf[i++] = charSetCode;
+				System.arraycopy(realmArray, 0, buf, i, realmArray.length);
+			}
+			return buf;
 		}
 
 		void read(byte data[]) throws IOException {
@@ -168,23 +176,24 @@ class OBEXAuthentication {
 		byte nonce[];
 
 		byte[] write() {
-			ByteArrayOutputStream buf = new ByteArrayOutputStream();
-
-			buf.write(0x00); // Tag
-			buf.write(0x10); // Len
-			buf.write(requestDigest, 0, 0x10);
+			byte buf[] = new byte[2 + 0x10 + ((userName != null) ? (2 + userName.length) : 0) + 2 + 0x10];
+			int i = 0;
+			buf[i++] = 0x00; // Tag
+			buf[i++] = 0x10; // Len
+			System.arraycopy(requestDigest, 0, buf, i, 0x10);
+			i += 0x10;
 
 			if (userName != null) {
-				buf.write(0x01); // Tag
-				buf.write(userName.length); // Len
-				buf.write(userName, 0, userName.length);
+				buf[i++] = 0x01; // Tag
+				buf[i++] = (byte) userName.length; // Len
+				System.arraycopy(userName, 0, buf, i, userName.length);
+				i += userName.length;
 			}
 
-			buf.write(0x02); // Tag
-			buf.write(0x10); // Len
-			buf.write(nonce, 0, 0x10);
-
-			return buf.toByteArray();
+			buf[i++] = 0x02; // Tag
+			buf[i++] = 0x10; // Len
+			System.arraycopy(nonce, 0, buf, i, 0x10);
+			return buf;
 		}
 
 		void read(byte data[]) throws IOException {
@@ -222,8 +231,19 @@ class OBEXAuthentication {
 		return challenge.write();
 	}
 
+	/**
+	 * request-digest is MD5(nonce ":" password). The session passes its own digest so no MessageDigest is created
+	 * per authentication.
+	 */
+	static byte[] requestDigest(MD5DigestWrapper md5, byte[] nonce, byte[] password) {
+		md5.update(nonce, 0, 0x10);
+		md5.update(COLUMN);
+		md5.update(password);
+		return md5.digest();
+	}
+
 	static boolean handleAuthenticationResponse(OBEXHeaderSetImpl incomingHeaders, Authenticator authenticator,
-			ServerRequestHandler serverHandler, Vector authChallengesSent) throws IOException {
+			ServerRequestHandler serverHandler, Vector authChallengesSent, MD5DigestWrapper md5) throws IOException {
 		if (!incomingHeaders.hasAuthenticationResponses()) {
 			return false;
 		}
@@ -252,11 +272,7 @@ class OBEXAuthentication {
 			}
 			// DebugLog.debug("authenticate using password", new String(password));
 			// DebugLog.debug("password used", password);
-			MD5DigestWrapper md5 = new MD5DigestWrapper();
-			md5.update(dr.nonce);
-			md5.update(COLUMN);
-			md5.update(password);
-			byte[] claulated = md5.digest();
+			byte[] claulated = requestDigest(md5, dr.nonce, password);
 			if (!equals(dr.requestDigest, claulated)) {
 				DebugLog.debug("got digest", dr.requestDigest);
 				DebugLog.debug("  expected", claulated);
@@ -273,7 +289,7 @@ class OBEXAuthentication {
 	}
 
 	static void handleAuthenticationChallenge(OBEXHeaderSetImpl incomingHeaders, OBEXHeaderSetImpl replyHeaders,
-			Authenticator authenticator) throws IOException {
+			Authenticator authenticator, MD5DigestWrapper md5) throws IOException {
 		if (!incomingHeaders.hasAuthenticationChallenge()) {
 			return;
 		}
@@ -288,11 +304,7 @@ class OBEXAuthentication {
 			if (challenge.isUserIdRequired()) {
 				dr.userName = pwd.getUserName();
 			}
-			MD5DigestWrapper md5 = new MD5DigestWrapper();
-			md5.update(dr.nonce);
-			md5.update(COLUMN);
-			md5.update(pwd.getPassword());
-			dr.requestDigest = md5.digest();
+			dr.requestDigest = requestDigest(md5, dr.nonce, pwd.getPassword());
 			// DebugLog.debug("password", new String(pwd.getPassword()));
 			// DebugLog.debug("password used", pwd.getPassword());
 			DebugLog.debug("send digest", dr.requestDigest);
@@ -301,11 +313,14 @@ class OBEXAuthentication {
 	}
 
 	private static synchronized byte[] createNonce() {
-		MD5DigestWrapper md5 = new MD5DigestWrapper();
-		md5.update(createTimestamp());
-		md5.update(COLUMN);
-		md5.update(getPrivateKey());
-		return md5.digest();
+		if (nonceDigest == null) {
+			nonceDigest = new MD5DigestWrapper();
+		}
+		byte[] key = getPrivateKey();
+		nonceDigest.update(createTimestamp());
+		nonceDigest.update(COLUMN);
+		nonceDigest.update(key);
+		return nonceDigest.digest();
 	}
 
 	static boolean equals(byte[] digest1, byte[] digest2) {
@@ -333,12 +348,11 @@ class OBEXAuthentication {
 			t = uniqueTimestamp + 1;
 		}
 		uniqueTimestamp = t;
-		byte[] buf = new byte[8];
-		for (int i = 0; i < buf.length; i++) {
-			buf[i] = (byte) (t >> (buf.length - 1 << 3));
+		for (int i = 0; i < timestamp.length; i++) {
+			timestamp[i] = (byte) (t >> (timestamp.length - 1 << 3));
 			t <<= 8;
 		}
-		return buf;
+		return timestamp;
 	}
 
 }
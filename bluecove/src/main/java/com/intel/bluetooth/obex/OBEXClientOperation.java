@@ -74,6 +74,18 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 
 	private boolean authenticationResponseCreated = false;
 
+	private boolean firstPacketSent = false;
+
+	/**
+	 * Single Response Mode requested in the first packet, server response will confirm it.
+	 */
+	private boolean srmRequested = false;
+
+	/**
+	 * Server asked with SRMP header to wait for response to the next packet.
+	 */
+	private boolean srmWait = false;
+
 	protected Object lock;
 
 	OBEXClientOperation(OBEXClientSessionImpl session, char operationId, OBEXHeaderSetImpl sendHeaders)
@@ -106,6 +118,12 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 	 * @see com.intel.bluetooth.obex.OBEXOperationReceive#receiveData(com.intel.bluetooth.obex.OBEXOperationInputStream)
 	 */
 	public void receiveData(OBEXOperationInputStream is) throws IOException {
+		if (session.isSingleResponseModeActive() && (!isGetOperation()) && (!requestEnded)) {
+			// In SRM server responds to PUT only after the final packet
+			closeOutputStream();
+			endRequestPhase();
+			return;
+		}
 		if (SHORT_REQUEST_PHASE) {
 			exchangePacket(this.startOperationHeaders);
 			this.startOperationHeaders = null;
@@ -117,26 +135,43 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 	/*
 	 * (non-Javadoc)
 	 * 
-	 * @see com.intel.bluetooth.obex.OBEXOperationDelivery#deliverPacket(boolean, byte[])
+	 * @see com.intel.bluetooth.obex.OBEXOperationDelivery#deliverPacket(boolean, byte[], int)
+	 */
+	public void deliverPacket(boolean finalPacket, byte[] buffer, int length) throws IOException {
+		if (requestEnded) {
+			return;
+		}
+		int dataHeaderID = startDataPacket(finalPacket);
+		OBEXHeaderSetImpl dataHeaders = OBEXSessionBase.createOBEXHeaderSetImpl();
+		dataHeaders.setBody(dataHeaderID, buffer, 0, length);
+		exchangePacket(dataHeaders);
+	}
+
+	/**
+	 * Same as deliverPacket but the Body is read from the file when the packet is written.
 	 */
-	public void deliverPacket(boolean finalPacket, byte[] buffer) throws IOException {
+	void deliverFilePacket(boolean finalPacket, OBEXFileSource source, long position, int length) throws IOException {
 		if (requestEnded) {
 			return;
 		}
+		int dataHeaderID = startDataPacket(finalPacket);
+		OBEXHeaderSetImpl dataHeaders = OBEXSessionBase.createOBEXHeaderSetImpl();
+		dataHeaders.setBody(dataHeaderID, source, position, length);
+		exchangePacket(dataHeaders);
+	}
+
+	private int startDataPacket(boolean finalPacket) throws IOException {
 		if (SHORT_REQUEST_PHASE && (this.startOperationHeaders != null)) {
 			exchangePacket(this.startOperationHeaders);
 			this.startOperationHeaders = null;
 		}
-		int dataHeaderID = OBEXHeaderSetImpl.OBEX_HDR_BODY;
 		if (finalPacket) {
 			this.operationId |= OBEXOperationCodes.FINAL_BIT;
-			dataHeaderID = OBEXHeaderSetImpl.OBEX_HDR_BODY_END;
 			DebugLog.debug("client Request Phase ended");
 			requestEnded = true;
+			return OBEXHeaderSetImpl.OBEX_HDR_BODY_END;
 		}
-		OBEXHeaderSetImpl dataHeaders = OBEXSessionBase.createOBEXHeaderSetImpl();
-		dataHeaders.setHeader(dataHeaderID, buffer);
-		exchangePacket(dataHeaders);
+		return OBEXHeaderSetImpl.OBEX_HDR_BODY;
 	}
 
 	protected void endRequestPhase() throws IOException {
@@ -155,15 +190,82 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 		}
 	}
 
+	private boolean isGetOperation() {
+		return ((this.operationId & ~OBEXOperationCodes.FINAL_BIT) == OBEXOperationCodes.GET);
+	}
+
+	/**
+	 * SRM is requested for PUT sent in more than one packet and for GET with single request packet, only response
+	 * phase of GET is streamed.
+	 */
+	private OBEXHeaderSetImpl requestSingleResponseMode(OBEXHeaderSetImpl headers) {
+		this.firstPacketSent = true;
+		if (!session.isSingleResponseModeEnabled()) {
+			return headers;
+		}
+		boolean finalPacket = ((this.operationId & OBEXOperationCodes.FINAL_BIT) != 0);
+		if (isGetOperation() != finalPacket) {
+			return headers;
+		}
+		if (headers == null) {
+			headers = OBEXSessionBase.createOBEXHeaderSetImpl();
+		}
+		headers.setSingleResponseMode(OBEXHeaderSetImpl.OBEX_SRM_ENABLE);
+		this.srmRequested = true;
+		return headers;
+	}
+
+	private void processSingleResponseMode(OBEXHeaderSetImpl dataHeaders, int responseCode) {
+		if (responseCode != OBEXOperationCodes.OBEX_RESPONSE_CONTINUE) {
+			this.srmRequested = false;
+			this.srmWait = false;
+			session.setSingleResponseModeActive(false);
+			return;
+		}
+		if (this.srmRequested) {
+			this.srmRequested = false;
+			if (dataHeaders.getSingleResponseMode() == OBEXHeaderSetImpl.OBEX_SRM_ENABLE) {
+				session.setSingleResponseModeActive(true);
+			} else {
+				DebugLog.debug("SRM not supported by server");
+			}
+		}
+		this.srmWait = session.isSingleResponseModeActive()
+				&& (dataHeaders.getSingleResponseModeParameters() == OBEXHeaderSetImpl.OBEX_SRMP_WAIT);
+	}
+
 	private void exchangePacket(OBEXHeaderSetImpl headers) throws IOException {
 		boolean success = false;
 		try {
-			session.writePacket(this.operationId, headers);
+			boolean srmActive = session.isSingleResponseModeActive();
+			if (srmActive && isGetOperation()) {
+				// Server sends response packets without waiting for GET requests
+				DebugLog.debug("client SRM receive");
+			} else {
+				boolean srmRequest = false;
+				if (!this.firstPacketSent) {
+					headers = requestSingleResponseMode(headers);
+					srmRequest = this.srmRequested;
+				}
+				try {
+					session.writePacket(this.operationId, headers);
+				} finally {
+					if (srmRequest) {
+						headers.clearSingleResponseMode();
+					}
+				}
+				if (srmActive && (!this.requestEnded) && (!this.srmWait)) {
+					// Server responds only to the final packet
+					success = true;
+					return;
+				}
+			}
 			byte[] b = session.readPacket();
-			OBEXHeaderSetImpl dataHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+			OBEXHeaderSetImpl dataHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 			session.handleAuthenticationResponse(dataHeaders, null);
 			int responseCode = dataHeaders.getResponseCode();
 			DebugLog.debug0x("client operation got reply", OBEXUtils.toStringObexResponseCodes(responseCode), responseCode);
+			processSingleResponseMode(dataHeaders, responseCode);
 			switch (responseCode) {
 			case ResponseCodes.OBEX_HTTP_UNAUTHORIZED:
                 if ((!authenticationResponseCreated) && (dataHeaders.hasAuthenticationChallenge())) {
@@ -217,6 +319,7 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 		} finally {
 			if (!success) {
 				errorReceived = true;
+				session.setSingleResponseModeActive(false);
 			}
 		}
 	}
@@ -231,18 +334,18 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 		this.replyHeaders = dataHeaders;
 	}
 
-	protected void processIncommingData(HeaderSet dataHeaders, boolean eof) throws IOException {
-		byte[] data = (byte[]) dataHeaders.getHeader(OBEXHeaderSetImpl.OBEX_HDR_BODY);
-		if (data == null) {
-			data = (byte[]) dataHeaders.getHeader(OBEXHeaderSetImpl.OBEX_HDR_BODY_END);
-			if (data != null) {
-				finalBodyReceived = true;
-				eof = true;
-			}
+	protected void processIncommingData(OBEXHeaderSetImpl dataHeaders, boolean eof) throws IOException {
+		if (dataHeaders.isEndOfBody()) {
+			finalBodyReceived = true;
+			eof = true;
 		}
-		if (data != null) {
-			DebugLog.debug("client received Data eof: " + eof + " len: ", data.length);
-			inputStream.appendData(data, eof);
+		if (dataHeaders.hasBody()) {
+			if (DebugLog.isDebugEnabled()) {
+				DebugLog.debug("client received Data eof: " + eof + " len: ", dataHeaders.getBodyLength());
+			}
+			// Copy from the packet buffer before the next packet is read
+			inputStream.appendData(dataHeaders.getBodyBuffer(), dataHeaders.getBodyOffset(), dataHeaders.getBodyLength(), eof);
+			dataHeaders.clearBody();
 		} else if (eof) {
 			inputStream.appendData(null, eof);
 		}
@@ -268,11 +371,22 @@ abstract class OBEXClientOperation implements Operation, OBEXOperation, OBEXOper
 	}
 
 	private void writeAbort() throws IOException {
+		if (session.isSingleResponseModeActive() && isGetOperation()) {
+			// Server does not read requests until SRM response phase ends, discard the rest of the object
+			try {
+				receiveOperationEnd();
+			} finally {
+				this.isClosed = true;
+				closeStream();
+			}
+			return;
+		}
 		try {
 			session.writePacket(OBEXOperationCodes.ABORT, null);
 			requestEnded = true;
 			byte[] b = session.readPacket();
-			HeaderSet dataHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+			session.setSingleResponseModeActive(false);
+			HeaderSet dataHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 			if (dataHeaders.getResponseCode() != OBEXOperationCodes.OBEX_RESPONSE_SUCCESS) {
 				throw new IOException("Fails to abort operation, received "
 						+ OBEXUtils.toStringObexResponseCodes(dataHeaders.getResponseCode()));
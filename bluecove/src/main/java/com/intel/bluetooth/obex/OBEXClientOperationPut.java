@@ -68,4 +68,25 @@ class OBEXClientOperationPut extends OBEXClientOperation {
 		return this.outputStream;
 	}
 
+	/**
+	 * Sends the file as the object body instead of output stream. Packets are filled to the MTU directly from the
+	 * file.
+	 */
+	void putFile(OBEXFileSource source) throws IOException {
+		validateOperationIsOpen();
+		if (outputStreamOpened) {
+			throw new IOException("output already open");
+		}
+		this.outputStreamOpened = true;
+		this.operationInProgress = true;
+		int packetLength = session.mtu - OBEXOperationCodes.OBEX_MTU_HEADER_RESERVE;
+		long length = source.length();
+		long position = 0;
+		do {
+			int len = (int) Math.min(packetLength, length - position);
+			deliverFilePacket((position + len == length), source, position, len);
+			position += len;
+		} while ((position < length) && (!isClosed()));
+	}
+
 }
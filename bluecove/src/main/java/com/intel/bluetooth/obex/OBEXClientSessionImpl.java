@@ -24,7 +24,9 @@
  */
 package com.intel.bluetooth.obex;
 
+import java.io.File;
 import java.io.IOException;
+import java.io.OutputStream;
 import java.util.Vector;
 
 import javax.microedition.io.StreamConnection;
@@ -98,8 +100,9 @@ public class OBEXClientSessionImpl extends OBEXSessionBase implements ClientSess
 		writePacketWithFlags(OBEXOperationCodes.CONNECT, connectRequest, (OBEXHeaderSetImpl) headers);
 
 		byte[] b = readPacket();
-		if (b.length < 6) {
-			if (b.length == 3) {
+		int len = OBEXUtils.packetLength(b);
+		if (len < 7) {
+			if (len == 3) {
 				throw new IOException("Invalid response from OBEX server " + OBEXUtils.toStringObexResponseCodes(b[0]));
 			}
 			throw new IOException("Invalid response from OBEX server");
@@ -113,7 +116,7 @@ public class OBEXClientSessionImpl extends OBEXSessionBase implements ClientSess
 		}
 		DebugLog.debug("mtu selected", this.mtu);
 
-		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 7);
+		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 7);
 
 		Object connID = responseHeaders.getHeader(OBEXHeaderSetImpl.OBEX_HDR_CONNECTION);
 		if (connID != null) {
@@ -142,12 +145,14 @@ public class OBEXClientSessionImpl extends OBEXSessionBase implements ClientSess
 		}
 		writePacket(OBEXOperationCodes.DISCONNECT, (OBEXHeaderSetImpl) headers);
 		byte[] b = readPacket();
+		// Parse before the packet buffer can be reused
+		HeaderSet responseHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 		this.isConnected = false;
 		if (this.operation != null) {
 			this.operation.close();
 			this.operation = null;
 		}
-		return OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+		return responseHeaders;
 	}
 
 	public void setConnectionID(long id) {
@@ -188,7 +193,7 @@ public class OBEXClientSessionImpl extends OBEXSessionBase implements ClientSess
 		writePacketWithFlags(OBEXOperationCodes.SETPATH_FINAL, request, (OBEXHeaderSetImpl) headers);
 
 		byte[] b = readPacket();
-		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 		validateAuthenticationResponse((OBEXHeaderSetImpl) headers, responseHeaders);
 		if (!authentRetry && (responseHeaders.getResponseCode() == ResponseCodes.OBEX_HTTP_UNAUTHORIZED)
 				&& (responseHeaders.hasAuthenticationChallenge())) {
@@ -214,6 +219,97 @@ public class OBEXClientSessionImpl extends OBEXSessionBase implements ClientSess
 		return this.operation;
 	}
 
+	/**
+	 * PUT the file content as the object body. Length header is added if not set in headers.
+	 * 
+	 * @return the headers received in response, response code of the operation is available from it
+	 */
+	HeaderSet putFile(HeaderSet headers, File file) throws IOException {
+		validateCreatedHeaderSet(headers);
+		canStartOperation();
+		OBEXFileSource source = new OBEXFileSource(file);
+		try {
+			if (headers == null) {
+				headers = createHeaderSet();
+			} else if ((headers.getHeader(HeaderSet.LENGTH) == null) && (source.length() <= 0xFFFFFFFFL)) {
+				// Don't change application HeaderSet
+				headers = OBEXHeaderSetImpl.cloneRequestHeaders(headers);
+			}
+			if ((headers.getHeader(HeaderSet.LENGTH) == null) && (source.length() <= 0xFFFFFFFFL)) {
+				headers.setHeader(HeaderSet.LENGTH, new Long(source.length()));
+			}
+			OBEXClientOperationPut putOperation = new OBEXClientOperationPut(this, (OBEXHeaderSetImpl) headers);
+			this.operation = putOperation;
+			try {
+				putOperation.putFile(source);
+				putOperation.getResponseCode();
+				return putOperation.getReceivedHeaders();
+			} finally {
+				putOperation.close();
+			}
+		} finally {
+			source.close();
+		}
+	}
+
+	/**
+	 * PUT objects one after another in this session. Object that fits the MTU together with its headers is sent as a
+	 * single PUT final packet, so it costs one request and one response. Larger objects are sent by the regular PUT
+	 * operation.
+	 * 
+	 * @return response code for each object
+	 */
+	int[] putObjects(HeaderSet[] headers, byte[][] objects) throws IOException {
+		if (headers.length != objects.length) {
+			throw new IllegalArgumentException("headers and objects length mismatch");
+		}
+		for (int i = 0; i < headers.length; i++) {
+			validateCreatedHeaderSet(headers[i]);
+		}
+		int[] responseCodes = new int[objects.length];
+		for (int i = 0; i < objects.length; i++) {
+			canStartOperation();
+			OBEXHeaderSetImpl hs = (OBEXHeaderSetImpl) headers[i];
+			if (hs == null) {
+				hs = (OBEXHeaderSetImpl) createHeaderSet();
+			}
+			byte[] data = objects[i];
+			if (OBEXHeaderSetImpl.toByteArray(hs).length + data.length + OBEXOperationCodes.OBEX_MTU_HEADER_RESERVE <= mtu) {
+				responseCodes[i] = putSinglePacket(hs, data, false);
+			} else {
+				Operation putOperation = put(hs);
+				try {
+					OutputStream os = putOperation.openOutputStream();
+					os.write(data);
+					os.close();
+					responseCodes[i] = putOperation.getResponseCode();
+				} finally {
+					putOperation.close();
+				}
+			}
+		}
+		return responseCodes;
+	}
+
+	private int putSinglePacket(OBEXHeaderSetImpl headers, byte[] data, boolean authentRetry) throws IOException {
+		headers.setBody(OBEXHeaderSetImpl.OBEX_HDR_BODY_END, data, 0, data.length);
+		try {
+			writePacket(OBEXOperationCodes.PUT_FINAL, headers);
+		} finally {
+			headers.clearBody();
+		}
+		byte[] b = readPacket();
+		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
+		validateAuthenticationResponse(headers, responseHeaders);
+		if (!authentRetry && (responseHeaders.getResponseCode() == ResponseCodes.OBEX_HTTP_UNAUTHORIZED)
+				&& (responseHeaders.hasAuthenticationChallenge())) {
+			OBEXHeaderSetImpl retryHeaders = OBEXHeaderSetImpl.cloneHeaders(headers);
+			handleAuthenticationChallenge(responseHeaders, retryHeaders);
+			return putSinglePacket(retryHeaders, data, true);
+		}
+		return responseHeaders.getResponseCode();
+	}
+
 	public HeaderSet delete(HeaderSet headers) throws IOException {
 		validateCreatedHeaderSet(headers);
 		canStartOperation();
@@ -223,7 +319,7 @@ public class OBEXClientSessionImpl extends OBEXSessionBase implements ClientSess
 	HeaderSet deleteImp(HeaderSet headers, boolean authentRetry) throws IOException {
 		writePacket(OBEXOperationCodes.PUT_FINAL, (OBEXHeaderSetImpl) headers);
 		byte[] b = readPacket();
-		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+		OBEXHeaderSetImpl responseHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 		validateAuthenticationResponse((OBEXHeaderSetImpl) headers, responseHeaders);
 		if (!authentRetry && (responseHeaders.getResponseCode() == ResponseCodes.OBEX_HTTP_UNAUTHORIZED)
 				&& (responseHeaders.hasAuthenticationChallenge())) {
@@ -54,4 +54,38 @@ public class OBEXConnectionParams {
 	 * Java System property "bluecove.obex.mtu" can be used to define the value.
 	 */
 	public int mtu = OBEX_DEFAULT_MTU;
+
+	/**
+	 * Each session proposes the largest MTU its transport supports, mtu is used when the limit is not known.
+	 * 
+	 * Java System property "bluecove.obex.mtu_auto" can be used to define the value.
+	 */
+	public boolean mtuAuto = false;
+
+	/**
+	 * Enables OBEX 1.5 Single Response Mode for PUT and GET. Client requests it in the first packet of an operation
+	 * and server accepts it only when enabled on its side, otherwise each packet is acknowledged by a response as
+	 * before.
+	 * 
+	 * Java System property "bluecove.obex.srm" can be used to define the value.
+	 */
+	public boolean srm = false;
+
+	/**
+	 * Maximum number of threads serving sessions of one SessionNotifier, 0 to create a thread for each session.
+	 * 
+	 * Java System property "bluecove.obex.server_pool" can be used to define the value.
+	 */
+	public int serverPoolSize = 0;
+
+	OBEXConnectionParams cloneParams() {
+		OBEXConnectionParams params = new OBEXConnectionParams();
+		params.timeouts = this.timeouts;
+		params.timeout = this.timeout;
+		params.mtu = this.mtu;
+		params.mtuAuto = this.mtuAuto;
+		params.srm = this.srm;
+		params.serverPoolSize = this.serverPoolSize;
+		return params;
+	}
 }
@@ -0,0 +1,114 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.File;
+import java.io.IOException;
+import java.io.RandomAccessFile;
+import java.nio.MappedByteBuffer;
+import java.nio.channels.FileChannel;
+
+import com.intel.bluetooth.DebugLog;
+
+/**
+ * File content for OBEX PUT body. Data is copied from memory mapped file window directly to the packet buffer.
+ * RandomAccessFile is used if the file can't be mapped.
+ * <p>
+ * Java 1.4+ only, the class is loaded only by the putFile call.
+ */
+class OBEXFileSource {
+
+	private static final int MAP_WINDOW = 16 * 1024 * 1024;
+
+	private RandomAccessFile file;
+
+	private final long length;
+
+	private FileChannel channel;
+
+	private MappedByteBuffer window;
+
+	private long windowPosition;
+
+	OBEXFileSource(File f) throws IOException {
+		this.file = new RandomAccessFile(f, "r");
+		this.length = this.file.length();
+		this.channel = this.file.getChannel();
+	}
+
+	long length() {
+		return this.length;
+	}
+
+	/**
+	 * Reads exactly len bytes of the file starting at position.
+	 */
+	void read(long position, byte[] b, int off, int len) throws IOException {
+		if ((position < 0) || (position + len > this.length)) {
+			throw new IOException("Read beyond end of file " + (position + len));
+		}
+		if (len == 0) {
+			return;
+		}
+		if (this.channel != null) {
+			if ((this.window == null) || (position < this.windowPosition)
+					|| (position + len > this.windowPosition + this.window.capacity())) {
+				mapWindow(position);
+			}
+			if (this.window != null) {
+				this.window.position((int) (position - this.windowPosition));
+				this.window.get(b, off, len);
+				return;
+			}
+		}
+		this.file.seek(position);
+		this.file.readFully(b, off, len);
+	}
+
+	private void mapWindow(long position) {
+		this.window = null;
+		long size = Math.max(this.length - position, 0);
+		if (size > MAP_WINDOW) {
+			size = MAP_WINDOW;
+		}
+		try {
+			this.window = this.channel.map(FileChannel.MapMode.READ_ONLY, position, size);
+			this.windowPosition = position;
+		} catch (IOException e) {
+			DebugLog.debug("can't map file, use read", e);
+			this.channel = null;
+		}
+	}
+
+	void close() throws IOException {
+		this.window = null;
+		this.channel = null;
+		RandomAccessFile f = this.file;
+		this.file = null;
+		if (f != null) {
+			f.close();
+		}
+	}
+}
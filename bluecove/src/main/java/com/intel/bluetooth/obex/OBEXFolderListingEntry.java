@@ -0,0 +1,197 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+/**
+ * Entry of OBEX <code>x-obex/folder-listing</code> object: file, folder or parent-folder element with its
+ * attributes. Attribute values are kept as they appear in the listing, e.g. modified="20090101T120000Z".
+ * <p>
+ * <b>PUBLIC JSR-82 extension</b>
+ */
+public class OBEXFolderListingEntry {
+
+	public static final int PARENT_FOLDER = 0;
+
+	public static final int FOLDER = 1;
+
+	public static final int FILE = 2;
+
+	private static final String ELEMENT_NAMES[] = { "parent-folder", "folder", "file" };
+
+	private final int kind;
+
+	private String attributeNames[];
+
+	private String attributeValues[];
+
+	private int attributeCount;
+
+	public OBEXFolderListingEntry(int kind) {
+		if ((kind < PARENT_FOLDER) || (kind > FILE)) {
+			throw new IllegalArgumentException("Invalid entry kind " + kind);
+		}
+		this.kind = kind;
+	}
+
+	public static OBEXFolderListingEntry createFolder(String name) {
+		OBEXFolderListingEntry entry = new OBEXFolderListingEntry(FOLDER);
+		entry.setAttribute("name", name);
+		return entry;
+	}
+
+	public static OBEXFolderListingEntry createFile(String name, long size) {
+		OBEXFolderListingEntry entry = new OBEXFolderListingEntry(FILE);
+		entry.setAttribute("name", name);
+		if (size >= 0) {
+			entry.setAttribute("size", String.valueOf(size));
+		}
+		return entry;
+	}
+
+	static int kindOf(String elementName) {
+		for (int i = 0; i < ELEMENT_NAMES.length; i++) {
+			if (ELEMENT_NAMES[i].equals(elementName)) {
+				return i;
+			}
+		}
+		return -1;
+	}
+
+	String getElementName() {
+		return ELEMENT_NAMES[kind];
+	}
+
+	public int getKind() {
+		return kind;
+	}
+
+	public boolean isParentFolder() {
+		return (kind == PARENT_FOLDER);
+	}
+
+	public boolean isFolder() {
+		return (kind == FOLDER);
+	}
+
+	public boolean isFile() {
+		return (kind == FILE);
+	}
+
+	public String getName() {
+		return getAttribute("name");
+	}
+
+	/**
+	 * @return file size in bytes or -1 if the size attribute is missing or invalid
+	 */
+	public long getSize() {
+		String size = getAttribute("size");
+		if (size == null) {
+			return -1;
+		}
+		try {
+			return Long.parseLong(size.trim());
+		} catch (NumberFormatException e) {
+			return -1;
+		}
+	}
+
+	public String getModified() {
+		return getAttribute("modified");
+	}
+
+	public String getAttribute(String name) {
+		for (int i = 0; i < attributeCount; i++) {
+			if (attributeNames[i].equals(name)) {
+				return attributeValues[i];
+			}
+		}
+		return null;
+	}
+
+	/**
+	 * Sets or replaces the attribute, <code>null</code> value removes it.
+	 */
+	public void setAttribute(String name, String value) {
+		for (int i = 0; i < attributeCount; i++) {
+			if (attributeNames[i].equals(name)) {
+				if (value != null) {
+					attributeValues[i] = value;
+				} else {
+					attributeCount--;
+					System.arraycopy(attributeNames, i + 1, attributeNames, i, attributeCount - i);
+					System.arraycopy(attributeValues, i + 1, attributeValues, i, attributeCount - i);
+					attributeNames[attributeCount] = null;
+					attributeValues[attributeCount] = null;
+				}
+				return;
+			}
+		}
+		if (value == null) {
+			return;
+		}
+		if (attributeNames == null) {
+			attributeNames = new String[4];
+			attributeValues = new String[4];
+		} else if (attributeCount == attributeNames.length) {
+			String names[] = new String[attributeCount * 2];
+			String values[] = new String[attributeCount * 2];
+			System.arraycopy(attributeNames, 0, names, 0, attributeCount);
+			System.arraycopy(attributeValues, 0, values, 0, attributeCount);
+			attributeNames = names;
+			attributeValues = values;
+		}
+		attributeNames[attributeCount] = name;
+		attributeValues[attributeCount] = value;
+		attributeCount++;
+	}
+
+	public int getAttributeCount() {
+		return attributeCount;
+	}
+
+	public String getAttributeName(int index) {
+		if (index >= attributeCount) {
+			throw new IndexOutOfBoundsException();
+		}
+		return attributeNames[index];
+	}
+
+	public String getAttributeValue(int index) {
+		if (index >= attributeCount) {
+			throw new IndexOutOfBoundsException();
+		}
+		return attributeValues[index];
+	}
+
+	public String toString() {
+		StringBuffer buf = new StringBuffer();
+		buf.append(getElementName());
+		for (int i = 0; i < attributeCount; i++) {
+			buf.append(' ').append(attributeNames[i]).append("=\"").append(attributeValues[i]).append('"');
+		}
+		return buf.toString();
+	}
+}
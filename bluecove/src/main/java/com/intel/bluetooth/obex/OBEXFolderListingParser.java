@@ -0,0 +1,307 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+import java.io.InputStream;
+
+/**
+ * Incremental parser for OBEX <code>x-obex/folder-listing</code> objects. Entries are parsed from the stream as
+ * the data arrives, e.g. from GET Operation input stream, the document is never kept in memory.
+ * <p>
+ * Only the folder-listing subset of XML is supported: declarations, comments and DOCTYPE are skipped, text content
+ * and unknown elements are ignored.
+ * <p>
+ * <b>PUBLIC JSR-82 extension</b>
+ */
+public class OBEXFolderListingParser {
+
+	private static final String LISTING_ELEMENT = "folder-listing";
+
+	private InputStream is;
+
+	private byte[] buffer = new byte[0x400];
+
+	private int bufferPos = 0;
+
+	private int bufferLength = 0;
+
+	private boolean eof = false;
+
+	private int unread = -1;
+
+	/**
+	 * Current name or attribute value, reused for all tokens.
+	 */
+	private byte[] token = new byte[0x80];
+
+	private int tokenLength;
+
+	private boolean listingStarted = false;
+
+	private boolean listingEnded = false;
+
+	public OBEXFolderListingParser(InputStream is) {
+		this.is = is;
+	}
+
+	/**
+	 * Reads the next entry from the listing.
+	 * 
+	 * @return the entry or <code>null</code> when the end of folder-listing is reached
+	 * @throws IOException
+	 *             on read error or malformed listing
+	 */
+	public OBEXFolderListingEntry next() throws IOException {
+		while (!listingEnded) {
+			int c = skipTo('<');
+			if (c == -1) {
+				throw new IOException("Unexpected end of folder-listing");
+			}
+			c = readByte();
+			if (c == '?') {
+				skipProcessingInstruction();
+			} else if (c == '!') {
+				skipDeclaration();
+			} else if (c == '/') {
+				String name = readName(readByte());
+				skipTo('>');
+				if (LISTING_ELEMENT.equals(name)) {
+					listingEnded = true;
+				}
+			} else {
+				String name = readName(c);
+				int kind = OBEXFolderListingEntry.kindOf(name);
+				if (kind == -1) {
+					readAttributes(null);
+					if (LISTING_ELEMENT.equals(name)) {
+						listingStarted = true;
+					}
+					continue;
+				}
+				if (!listingStarted) {
+					throw new IOException("Element " + name + " outside of folder-listing");
+				}
+				OBEXFolderListingEntry entry = new OBEXFolderListingEntry(kind);
+				readAttributes(entry);
+				return entry;
+			}
+		}
+		return null;
+	}
+
+	private int readByte() throws IOException {
+		if (unread != -1) {
+			int c = unread;
+			unread = -1;
+			return c;
+		}
+		if (bufferPos == bufferLength) {
+			if (eof) {
+				return -1;
+			}
+			bufferPos = 0;
+			bufferLength = is.read(buffer, 0, buffer.length);
+			if (bufferLength <= 0) {
+				bufferLength = 0;
+				eof = true;
+				return -1;
+			}
+		}
+		return buffer[bufferPos++] & 0xFF;
+	}
+
+	private int readRequired() throws IOException {
+		int c = readByte();
+		if (c == -1) {
+			throw new IOException("Unexpected end of folder-listing");
+		}
+		return c;
+	}
+
+	private static boolean isSpace(int c) {
+		return (c == ' ') || (c == '\t') || (c == '\r') || (c == '\n');
+	}
+
+	private int skipSpaces() throws IOException {
+		int c;
+		do {
+			c = readRequired();
+		} while (isSpace(c));
+		return c;
+	}
+
+	private int skipTo(int end) throws IOException {
+		int c;
+		do {
+			c = readByte();
+		} while ((c != end) && (c != -1));
+		return c;
+	}
+
+	/**
+	 * Skips processing instruction, '&lt;?' is already read.
+	 */
+	private void skipProcessingInstruction() throws IOException {
+		int last = 0;
+		int c;
+		while (((c = readRequired()) != '>') || (last != '?')) {
+			last = c;
+		}
+	}
+
+	/**
+	 * Skips comment or DOCTYPE with optional internal subset, '&lt;!' is already read.
+	 */
+	private void skipDeclaration() throws IOException {
+		int c = readRequired();
+		if (c == '-') {
+			readRequired();
+			int dashes = 0;
+			while (((c = readRequired()) != '>') || (dashes < 2)) {
+				dashes = (c == '-') ? dashes + 1 : 0;
+			}
+			return;
+		}
+		int depth = 0;
+		while (true) {
+			if (c == '[') {
+				depth++;
+			} else if (c == ']') {
+				depth--;
+			} else if ((c == '>') && (depth <= 0)) {
+				return;
+			}
+			c = readRequired();
+		}
+	}
+
+	private void appendToken(int b) {
+		if (tokenLength == token.length) {
+			byte[] newToken = new byte[token.length * 2];
+			System.arraycopy(token, 0, newToken, 0, tokenLength);
+			token = newToken;
+		}
+		token[tokenLength++] = (byte) b;
+	}
+
+	private void appendTokenChar(int ch) {
+		if (ch < 0x80) {
+			appendToken(ch);
+		} else if (ch < 0x800) {
+			appendToken(0xC0 | (ch >> 6));
+			appendToken(0x80 | (ch & 0x3F));
+		} else if (ch < 0x10000) {
+			appendToken(0xE0 | (ch >> 12));
+			appendToken(0x80 | ((ch >> 6) & 0x3F));
+			appendToken(0x80 | (ch & 0x3F));
+		} else {
+			appendToken(0xF0 | (ch >> 18));
+			appendToken(0x80 | ((ch >> 12) & 0x3F));
+			appendToken(0x80 | ((ch >> 6) & 0x3F));
+			appendToken(0x80 | (ch & 0x3F));
+		}
+	}
+
+	private String readName(int c) throws IOException {
+		tokenLength = 0;
+		while ((c != -1) && !isSpace(c) && (c != '/') && (c != '>') && (c != '=')) {
+			appendToken(c);
+			c = readByte();
+		}
+		unread = c;
+		return OBEXUtils.newStringASCII(token, 0, tokenLength);
+	}
+
+	/**
+	 * Reads attributes till the end of the start tag. Attributes are discarded when entry is <code>null</code>.
+	 */
+	private void readAttributes(OBEXFolderListingEntry entry) throws IOException {
+		while (true) {
+			int c = skipSpaces();
+			if (c == '>') {
+				return;
+			} else if (c == '/') {
+				if (readRequired() != '>') {
+					throw new IOException("Invalid folder-listing element");
+				}
+				return;
+			}
+			String name = readName(c);
+			c = skipSpaces();
+			if (c != '=') {
+				throw new IOException("Invalid folder-listing attribute " + name);
+			}
+			int quote = skipSpaces();
+			if ((quote != '"') && (quote != '\'')) {
+				throw new IOException("Invalid folder-listing attribute " + name);
+			}
+			tokenLength = 0;
+			while ((c = readRequired()) != quote) {
+				if (c == '&') {
+					appendTokenChar(readEntity());
+				} else {
+					appendToken(c);
+				}
+			}
+			if (entry != null) {
+				entry.setAttribute(name, new String(token, 0, tokenLength, "UTF-8"));
+			}
+		}
+	}
+
+	private int readEntity() throws IOException {
+		StringBuffer name = new StringBuffer();
+		int c;
+		while ((c = readRequired()) != ';') {
+			if (name.length() > 10) {
+				throw new IOException("Invalid entity in folder-listing");
+			}
+			name.append((char) c);
+		}
+		String entity = name.toString();
+		if (entity.equals("amp")) {
+			return '&';
+		} else if (entity.equals("lt")) {
+			return '<';
+		} else if (entity.equals("gt")) {
+			return '>';
+		} else if (entity.equals("quot")) {
+			return '"';
+		} else if (entity.equals("apos")) {
+			return '\'';
+		} else if (entity.startsWith("#")) {
+			try {
+				if (entity.startsWith("#x") || entity.startsWith("#X")) {
+					return Integer.parseInt(entity.substring(2), 16);
+				} else {
+					return Integer.parseInt(entity.substring(1));
+				}
+			} catch (NumberFormatException e) {
+			}
+		}
+		throw new IOException("Invalid entity &" + entity + "; in folder-listing");
+	}
+}
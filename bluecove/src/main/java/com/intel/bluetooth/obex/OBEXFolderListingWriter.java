@@ -0,0 +1,169 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+import java.io.OutputStream;
+
+/**
+ * Writes OBEX <code>x-obex/folder-listing</code> object entry by entry, e.g. to GET Operation output stream. Only
+ * a small encoding buffer is used, the document is never kept in memory.
+ * <p>
+ * <b>PUBLIC JSR-82 extension</b>
+ */
+public class OBEXFolderListingWriter {
+
+	private static final String LISTING_START = "<?xml version=\"1.0\"?>\n"
+			+ "<!DOCTYPE folder-listing SYSTEM \"obex-folder-listing.dtd\">\n" + "<folder-listing version=\"1.0\">\n";
+
+	private static final String LISTING_END = "</folder-listing>\n";
+
+	private OutputStream os;
+
+	private byte[] buffer = new byte[0x200];
+
+	private int bufferLength = 0;
+
+	private boolean started = false;
+
+	private boolean finished = false;
+
+	public OBEXFolderListingWriter(OutputStream os) {
+		this.os = os;
+	}
+
+	private void start() throws IOException {
+		if (finished) {
+			throw new IOException("folder-listing already finished");
+		}
+		if (!started) {
+			started = true;
+			append(LISTING_START, false);
+		}
+	}
+
+	public void write(OBEXFolderListingEntry entry) throws IOException {
+		start();
+		append('<');
+		append(entry.getElementName(), false);
+		for (int i = 0; i < entry.getAttributeCount(); i++) {
+			append(' ');
+			append(entry.getAttributeName(i), false);
+			append('=');
+			append('"');
+			append(entry.getAttributeValue(i), true);
+			append('"');
+		}
+		append('/');
+		append('>');
+		append('\n');
+	}
+
+	public void writeParentFolder() throws IOException {
+		write(new OBEXFolderListingEntry(OBEXFolderListingEntry.PARENT_FOLDER));
+	}
+
+	/**
+	 * Writes the end of folder-listing and the buffered data to the stream. The stream is not flushed or closed.
+	 */
+	public void finish() throws IOException {
+		start();
+		append(LISTING_END, false);
+		flushBuffer();
+		finished = true;
+	}
+
+	/**
+	 * Finishes the listing if required and closes the stream.
+	 */
+	public void close() throws IOException {
+		try {
+			if (!finished) {
+				finish();
+			}
+		} finally {
+			os.close();
+		}
+	}
+
+	private void flushBuffer() throws IOException {
+		if (bufferLength > 0) {
+			os.write(buffer, 0, bufferLength);
+			bufferLength = 0;
+		}
+	}
+
+	private void append(int b) throws IOException {
+		if (bufferLength == buffer.length) {
+			flushBuffer();
+		}
+		buffer[bufferLength++] = (byte) b;
+	}
+
+	private void append(String str, boolean escape) throws IOException {
+		int len = str.length();
+		for (int i = 0; i < len; i++) {
+			int ch = str.charAt(i);
+			if (escape) {
+				switch (ch) {
+				case '&':
+					append("&amp;", false);
+					continue;
+				case '<':
+					append("&lt;", false);
+					continue;
+				case '>':
+					append("&gt;", false);
+					continue;
+				case '"':
+					append("&quot;", false);
+					continue;
+				}
+			}
+			if ((ch >= 0xD800) && (ch <= 0xDBFF) && (i + 1 < len)) {
+				int low = str.charAt(i + 1);
+				if ((low >= 0xDC00) && (low <= 0xDFFF)) {
+					ch = 0x10000 + ((ch - 0xD800) << 10) + (low - 0xDC00);
+					i++;
+				}
+			}
+			if (ch < 0x80) {
+				append(ch);
+			} else if (ch < 0x800) {
+				append(0xC0 | (ch >> 6));
+				append(0x80 | (ch & 0x3F));
+			} else if (ch < 0x10000) {
+				append(0xE0 | (ch >> 12));
+				append(0x80 | ((ch >> 6) & 0x3F));
+				append(0x80 | (ch & 0x3F));
+			} else {
+				append(0xF0 | (ch >> 18));
+				append(0x80 | ((ch >> 12) & 0x3F));
+				append(0x80 | ((ch >> 6) & 0x3F));
+				append(0x80 | (ch & 0x3F));
+			}
+		}
+	}
+}
@@ -29,7 +29,6 @@ import java.io.OutputStream;
 import java.util.Calendar;
 import java.util.Date;
 import java.util.Enumeration;
-import java.util.Hashtable;
 import java.util.TimeZone;
 import java.util.Vector;
 
@@ -105,6 +104,20 @@ class OBEXHeaderSetImpl implements HeaderSet {
 	/** Sequence number used in each OBEX packet for reliability (0x93) */
 	static final int OBEX_HDR_SESSIONSEQ = 0x93;
 
+	/** Single Response Mode, OBEX 1.5 (0x97) */
+	static final int OBEX_HDR_SRM = 0x97;
+
+	/** Single Response Mode Parameters, OBEX 1.5 (0x98) */
+	static final int OBEX_HDR_SRMP = 0x98;
+
+	static final int OBEX_SRM_DISABLE = 0x00;
+
+	static final int OBEX_SRM_ENABLE = 0x01;
+
+	static final int OBEX_SRM_SUPPORTED = 0x02;
+
+	static final int OBEX_SRMP_WAIT = 0x01;
+
 	// 0x30 to 0x3F user defined - this range includes all combinations of the
 	// upper 2 bits
 	static final int OBEX_HDR_USER = 0x30;
@@ -131,23 +144,77 @@ class OBEXHeaderSetImpl implements HeaderSet {
 
 	private int responseCode;
 
-	private Hashtable headerValues;
+	/**
+	 * Headers with identifier below 0x10 are kept in arrays indexed by the identifier. User defined headers and header
+	 * with the same identifier but different encoding (Time) go to the overflow list.
+	 */
+	private static final int HEADER_SLOTS = 0x10;
+
+	private int[] headerIDs;
+
+	private Object[] headerValues;
+
+	private Vector overflowHeaders;
+
+	private int headerCount;
+
+	/**
+	 * Encoded Name and Type values, reused when the same HeaderSet is sent again.
+	 */
+	private byte[] encodedName;
+
+	private byte[] encodedType;
 
 	private Vector authResponses;
 
 	private Vector authChallenges;
 
+	/**
+	 * SRM and SRMP are session headers and are not visible to application.
+	 */
+	private int srm;
+
+	private int srmp;
+
+	/**
+	 * Body or End of Body header value is not copied from packet buffer. The view is valid until the buffer is
+	 * reused for the next packet.
+	 */
+	private int bodyHeaderID;
+
+	private byte[] bodyBuffer;
+
+	private int bodyOffset;
+
+	private int bodyLength;
+
+	/**
+	 * Body is read from the file when the packet is serialized.
+	 */
+	private OBEXFileSource bodySource;
+
+	private long bodySourcePosition;
+
 	private static final int NO_RESPONSE_CODE = Integer.MIN_VALUE;
 
+	private static final int NO_VALUE = -1;
+
 	OBEXHeaderSetImpl() {
 		this(NO_RESPONSE_CODE);
 	}
 
 	private OBEXHeaderSetImpl(int responseCode) {
-		this.headerValues = new Hashtable();
+		// Created on first setHeader, packets with only Body header don't need it
+		this.headerIDs = null;
+		this.headerValues = null;
+		this.overflowHeaders = null;
+		this.headerCount = 0;
 		this.responseCode = responseCode;
 		this.authResponses = null;
 		this.authChallenges = null;
+		this.srm = NO_VALUE;
+		this.srmp = NO_VALUE;
+		this.bodyHeaderID = NO_VALUE;
 	}
 
 	static void validateCreatedHeaderSet(HeaderSet headers) {
@@ -174,8 +241,16 @@ class OBEXHeaderSetImpl implements HeaderSet {
 
 	public void setHeader(int headerID, Object headerValue) {
 		validateHeaderID(headerID);
+		if (headerID == bodyHeaderID) {
+			clearBody();
+		}
+		if (headerID == OBEX_HDR_NAME) {
+			encodedName = null;
+		} else if (headerID == OBEX_HDR_TYPE) {
+			encodedType = null;
+		}
 		if (headerValue == null) {
-			headerValues.remove(new Integer(headerID));
+			removeHeader(headerID);
 		} else {
 			// Validate Java value Type
 			if ((headerID == OBEX_HDR_TIME) || (headerID == OBEX_HDR_TIME2)) {
@@ -216,13 +291,103 @@ class OBEXHeaderSetImpl implements HeaderSet {
 					throw new IllegalArgumentException("Unsupported encoding " + (headerID & OBEX_HDR_HI_MASK));
 				}
 			}
-			headerValues.put(new Integer(headerID), headerValue);
+			putHeader(headerID, headerValue);
+		}
+	}
+
+	private static class OverflowHeader {
+
+		int headerID;
+
+		Object value;
+
+		OverflowHeader(int headerID, Object value) {
+			this.headerID = headerID;
+			this.value = value;
+		}
+	}
+
+	private OverflowHeader findOverflowHeader(int headerID) {
+		if (overflowHeaders != null) {
+			for (int i = 0; i < overflowHeaders.size(); i++) {
+				OverflowHeader h = (OverflowHeader) overflowHeaders.elementAt(i);
+				if (h.headerID == headerID) {
+					return h;
+				}
+			}
+		}
+		return null;
+	}
+
+	private void putHeader(int headerID, Object value) {
+		int slot = headerID & OBEX_HDR_ID_MASK;
+		if ((slot < HEADER_SLOTS) && (headerIDs != null) && (headerIDs[slot] == headerID)) {
+			headerValues[slot] = value;
+			return;
+		}
+		OverflowHeader h = findOverflowHeader(headerID);
+		if (h != null) {
+			h.value = value;
+			return;
+		}
+		if (slot < HEADER_SLOTS) {
+			if (headerIDs == null) {
+				headerIDs = new int[HEADER_SLOTS];
+				headerValues = new Object[HEADER_SLOTS];
+				for (int i = 0; i < HEADER_SLOTS; i++) {
+					headerIDs[i] = NO_VALUE;
+				}
+			}
+			if (headerIDs[slot] == NO_VALUE) {
+				headerIDs[slot] = headerID;
+				headerValues[slot] = value;
+				headerCount++;
+				return;
+			}
+		}
+		if (overflowHeaders == null) {
+			overflowHeaders = new Vector();
+		}
+		overflowHeaders.addElement(new OverflowHeader(headerID, value));
+		headerCount++;
+	}
+
+	private Object findHeader(int headerID) {
+		int slot = headerID & OBEX_HDR_ID_MASK;
+		if ((slot < HEADER_SLOTS) && (headerIDs != null) && (headerIDs[slot] == headerID)) {
+			return headerValues[slot];
+		}
+		OverflowHeader h = findOverflowHeader(headerID);
+		return (h == null) ? null : h.value;
+	}
+
+	private void removeHeader(int headerID) {
+		int slot = headerID & OBEX_HDR_ID_MASK;
+		if ((slot < HEADER_SLOTS) && (headerIDs != null) && (headerIDs[slot] == headerID)) {
+			headerIDs[slot] = NO_VALUE;
+			headerValues[slot] = null;
+			headerCount--;
+			return;
+		}
+		OverflowHeader h = findOverflowHeader(headerID);
+		if (h != null) {
+			overflowHeaders.removeElement(h);
+			headerCount--;
 		}
 	}
 
 	public Object getHeader(int headerID) throws IOException {
 		validateHeaderID(headerID);
-		return headerValues.get(new Integer(headerID));
+		if (headerID == bodyHeaderID) {
+			byte[] data = new byte[bodyLength];
+			if (bodySource != null) {
+				bodySource.read(bodySourcePosition, data, 0, bodyLength);
+			} else {
+				System.arraycopy(bodyBuffer, bodyOffset, data, 0, bodyLength);
+			}
+			return data;
+		}
+		return findHeader(headerID);
 	}
 
 	/*
@@ -231,14 +396,30 @@ class OBEXHeaderSetImpl implements HeaderSet {
 	 * @see javax.obex.HeaderSet#getHeaderList()
 	 */
 	public int[] getHeaderList() throws IOException {
-		if (headerValues.size() == 0) {
+		int size = headerCount;
+		if (bodyHeaderID != NO_VALUE) {
+			size++;
+		}
+		if (size == 0) {
 			// Spec: null if no headers are available
 			return null;
 		}
-		int[] headerIDArray = new int[headerValues.size()];
+		int[] headerIDArray = new int[size];
 		int i = 0;
-		for (Enumeration e = headerValues.keys(); e.hasMoreElements();) {
-			headerIDArray[i++] = ((Integer) e.nextElement()).intValue();
+		if (headerIDs != null) {
+			for (int slot = 0; slot < HEADER_SLOTS; slot++) {
+				if (headerIDs[slot] != NO_VALUE) {
+					headerIDArray[i++] = headerIDs[slot];
+				}
+			}
+		}
+		if (overflowHeaders != null) {
+			for (int k = 0; k < overflowHeaders.size(); k++) {
+				headerIDArray[i++] = ((OverflowHeader) overflowHeaders.elementAt(k)).headerID;
+			}
+		}
+		if (bodyHeaderID != NO_VALUE) {
+			headerIDArray[i++] = bodyHeaderID;
 		}
 		return headerIDArray;
 	}
@@ -251,8 +432,57 @@ class OBEXHeaderSetImpl implements HeaderSet {
 	}
 
 	boolean hasIncommingData() {
-		return headerValues.contains(new Integer(OBEX_HDR_BODY))
-				|| headerValues.contains(new Integer(OBEX_HDR_BODY_END));
+		if (bodyHeaderID != NO_VALUE) {
+			return true;
+		}
+		return (findHeader(OBEX_HDR_BODY) != null) || (findHeader(OBEX_HDR_BODY_END) != null);
+	}
+
+	void setBody(int headerID, byte[] buffer, int off, int len) {
+		if (headerCount != 0) {
+			removeHeader(OBEX_HDR_BODY);
+			removeHeader(OBEX_HDR_BODY_END);
+		}
+		this.bodyHeaderID = headerID;
+		this.bodyBuffer = buffer;
+		this.bodyOffset = off;
+		this.bodyLength = len;
+		this.bodySource = null;
+	}
+
+	void setBody(int headerID, OBEXFileSource source, long position, int len) {
+		setBody(headerID, null, 0, len);
+		this.bodySource = source;
+		this.bodySourcePosition = position;
+	}
+
+	boolean hasBody() {
+		return (bodyHeaderID != NO_VALUE);
+	}
+
+	boolean isEndOfBody() {
+		return (bodyHeaderID == OBEX_HDR_BODY_END);
+	}
+
+	byte[] getBodyBuffer() {
+		return bodyBuffer;
+	}
+
+	int getBodyOffset() {
+		return bodyOffset;
+	}
+
+	int getBodyLength() {
+		return bodyLength;
+	}
+
+	/**
+	 * Called when the body is consumed, the packet buffer is going to be reused.
+	 */
+	void clearBody() {
+		this.bodyHeaderID = NO_VALUE;
+		this.bodyBuffer = null;
+		this.bodySource = null;
 	}
 
 	static OBEXHeaderSetImpl cloneHeaders(HeaderSet headers) throws IOException {
@@ -276,6 +506,22 @@ class OBEXHeaderSetImpl implements HeaderSet {
 		return hs;
 	}
 
+	/**
+	 * Copy of application request headers with authentication challenges, headers added by the implementation should
+	 * not change the application HeaderSet.
+	 */
+	static OBEXHeaderSetImpl cloneRequestHeaders(HeaderSet headers) throws IOException {
+		OBEXHeaderSetImpl hs = cloneHeaders(headers);
+		Vector challenges = ((OBEXHeaderSetImpl) headers).authChallenges;
+		if (challenges != null) {
+			hs.authChallenges = new Vector();
+			for (Enumeration e = challenges.elements(); e.hasMoreElements();) {
+				hs.authChallenges.addElement(e.nextElement());
+			}
+		}
+		return hs;
+	}
+
 	static HeaderSet appendHeaders(HeaderSet dst, HeaderSet src) throws IOException {
 		int[] headerIDArray = src.getHeaderList();
 		for (int i = 0; (headerIDArray != null) && (i < headerIDArray.length); i++) {
@@ -324,6 +570,23 @@ class OBEXHeaderSetImpl implements HeaderSet {
 		return authResponses.elements();
 	}
 
+	int getSingleResponseMode() {
+		return srm;
+	}
+
+	void setSingleResponseMode(int srm) {
+		this.srm = srm;
+	}
+
+	int getSingleResponseModeParameters() {
+		return srmp;
+	}
+
+	void clearSingleResponseMode() {
+		this.srm = NO_VALUE;
+		this.srmp = NO_VALUE;
+	}
+
 	static long readObexInt(byte[] data, int off) throws IOException {
 		long l = 0;
 		for (int i = 0; i < 4; i++) {
@@ -334,29 +597,29 @@ class OBEXHeaderSetImpl implements HeaderSet {
 	}
 
 	static void writeObexInt(OutputStream out, int headerID, long data) throws IOException {
-		byte[] b = new byte[5];
-		b[0] = (byte) headerID;
-		b[1] = (byte) ((data >>> 24) & 0xFF);
-		b[2] = (byte) ((data >>> 16) & 0xFF);
-		b[3] = (byte) ((data >>> 8) & 0xFF);
-		b[4] = (byte) ((data >>> 0) & 0xFF);
-		out.write(b);
+		out.write(headerID);
+		out.write((int) ((data >>> 24) & 0xFF));
+		out.write((int) ((data >>> 16) & 0xFF));
+		out.write((int) ((data >>> 8) & 0xFF));
+		out.write((int) ((data >>> 0) & 0xFF));
 	}
 
 	static void writeObexLen(OutputStream out, int headerID, int len) throws IOException {
-		byte[] b = new byte[3];
-		b[0] = (byte) headerID;
 		if ((len < 0) || len > 0xFFFF) {
 			throw new IOException("very large data" + len);
 		}
-		b[1] = OBEXUtils.hiByte(len);
-		b[2] = OBEXUtils.loByte(len);
-		out.write(b);
+		out.write(headerID);
+		out.write(OBEXUtils.hiByte(len));
+		out.write(OBEXUtils.loByte(len));
 	}
 
 	static void writeObexASCII(OutputStream out, int headerID, String value) throws IOException {
-		writeObexLen(out, headerID, 3 + value.length() + 1);
-		out.write(value.getBytes("iso-8859-1"));
+		writeObexASCII(out, headerID, OBEXUtils.getASCIIBytes(value));
+	}
+
+	private static void writeObexASCII(OutputStream out, int headerID, byte[] encoded) throws IOException {
+		writeObexLen(out, headerID, 3 + encoded.length + 1);
+		out.write(encoded);
 		out.write(0);
 	}
 
@@ -367,14 +630,18 @@ class OBEXHeaderSetImpl implements HeaderSet {
 		// terminator (0x00, 0x00). Therefore the length of the string `Jumar`
 		// would be 12 bytes; 5 visible
 		// characters plus the null terminator, each two bytes in length.
-		if (value.length() == 0) {
+		writeObexUnicode(out, headerID, OBEXUtils.getUTF16Bytes(value));
+	}
+
+	private static void writeObexUnicode(OutputStream out, int headerID, byte[] encoded) throws IOException {
+		if (encoded.length == 0) {
 			writeObexLen(out, headerID, 3);
 			return;
 		}
-		byte[] b = OBEXUtils.getUTF16Bytes(value);
-		writeObexLen(out, headerID, 3 + b.length + 2);
-		out.write(b);
-		out.write(new byte[] { 0, 0 });
+		writeObexLen(out, headerID, 3 + encoded.length + 2);
+		out.write(encoded);
+		out.write(0);
+		out.write(0);
 	}
 
 	static byte[] toByteArray(HeaderSet headers) throws IOException {
@@ -382,77 +649,134 @@ class OBEXHeaderSetImpl implements HeaderSet {
 			return new byte[0];
 		}
 		ByteArrayOutputStream buf = new ByteArrayOutputStream();
-		int[] headerIDArray = headers.getHeaderList();
-		for (int i = 0; (headerIDArray != null) && (i < headerIDArray.length); i++) {
-			int hi = headerIDArray[i];
-			if (hi == OBEX_HDR_TIME) {
-				Calendar c = (Calendar) headers.getHeader(hi);
-				writeObexLen(buf, hi, 19);
-				writeTimeISO8601(buf, c);
-			} else if (hi == OBEX_HDR_TIME2) {
-				Calendar c = (Calendar) headers.getHeader(hi);
-				writeObexInt(buf, hi, c.getTime().getTime() / 1000);
-			} else if (hi == OBEX_HDR_TYPE) {
-				// ASCII string
-				writeObexASCII(buf, hi, (String) headers.getHeader(hi));
-			} else {
-				switch (hi & OBEX_HDR_HI_MASK) {
-				case OBEX_STRING:
-					writeObexUnicode(buf, hi, (String) headers.getHeader(hi));
-					break;
-				case OBEX_BYTE_STREAM:
-					byte data[] = (byte[]) headers.getHeader(hi);
-					writeObexLen(buf, hi, 3 + data.length);
-					buf.write(data);
-					break;
-				case OBEX_BYTE:
-					buf.write(hi);
-					buf.write(((Byte) headers.getHeader(hi)).byteValue());
-					break;
-				case OBEX_INT:
-					writeObexInt(buf, hi, ((Long) headers.getHeader(hi)).longValue());
-					break;
-				default:
-					throw new IOException("Unsupported encoding " + (hi & OBEX_HDR_HI_MASK));
+		writeHeaders(buf, (OBEXHeaderSetImpl) headers);
+		return buf.toByteArray();
+	}
+
+	private static void writeHeader(OutputStream buf, OBEXHeaderSetImpl headers, int hi, Object value)
+			throws IOException {
+		if (hi == OBEX_HDR_NAME) {
+			if (headers.encodedName == null) {
+				headers.encodedName = OBEXUtils.getUTF16Bytes((String) value);
+			}
+			writeObexUnicode(buf, hi, headers.encodedName);
+		} else if (hi == OBEX_HDR_TYPE) {
+			// ASCII string
+			if (headers.encodedType == null) {
+				headers.encodedType = OBEXUtils.getASCIIBytes((String) value);
+			}
+			writeObexASCII(buf, hi, headers.encodedType);
+		} else if (hi == OBEX_HDR_TIME) {
+			writeObexLen(buf, hi, 19);
+			writeTimeISO8601(buf, (Calendar) value);
+		} else if (hi == OBEX_HDR_TIME2) {
+			writeObexInt(buf, hi, ((Calendar) value).getTime().getTime() / 1000);
+		} else {
+			switch (hi & OBEX_HDR_HI_MASK) {
+			case OBEX_STRING:
+				writeObexUnicode(buf, hi, (String) value);
+				break;
+			case OBEX_BYTE_STREAM:
+				byte data[] = (byte[]) value;
+				writeObexLen(buf, hi, 3 + data.length);
+				buf.write(data);
+				break;
+			case OBEX_BYTE:
+				buf.write(hi);
+				buf.write(((Byte) value).byteValue());
+				break;
+			case OBEX_INT:
+				writeObexInt(buf, hi, ((Long) value).longValue());
+				break;
+			default:
+				throw new IOException("Unsupported encoding " + (hi & OBEX_HDR_HI_MASK));
+			}
+		}
+	}
+
+	/**
+	 * Serialize headers directly to packet buffer, Body is written last.
+	 */
+	static void writeHeaders(OutputStream buf, OBEXHeaderSetImpl headers) throws IOException {
+		if (headers.headerIDs != null) {
+			for (int slot = 0; slot < HEADER_SLOTS; slot++) {
+				if (headers.headerIDs[slot] != NO_VALUE) {
+					writeHeader(buf, headers, headers.headerIDs[slot], headers.headerValues[slot]);
 				}
 			}
 		}
-		if ((headerIDArray != null) && (headerIDArray.length != 0)) {
-			DebugLog.debug("written headers", headerIDArray.length);
+		if (headers.overflowHeaders != null) {
+			for (int i = 0; i < headers.overflowHeaders.size(); i++) {
+				OverflowHeader h = (OverflowHeader) headers.overflowHeaders.elementAt(i);
+				writeHeader(buf, headers, h.headerID, h.value);
+			}
+		}
+		if (headers.headerCount != 0) {
+			DebugLog.debug("written headers", headers.headerCount);
+		}
+		OBEXHeaderSetImpl hs = headers;
+		if (hs.srm != NO_VALUE) {
+			buf.write(OBEX_HDR_SRM);
+			buf.write(hs.srm);
+		}
+		if (hs.srmp != NO_VALUE) {
+			buf.write(OBEX_HDR_SRMP);
+			buf.write(hs.srmp);
 		}
-		if (((OBEXHeaderSetImpl) headers).hasAuthenticationChallenge()) {
-			for (Enumeration iter = ((OBEXHeaderSetImpl) headers).authChallenges.elements(); iter.hasMoreElements();) {
+		if (hs.hasAuthenticationChallenge()) {
+			for (Enumeration iter = hs.authChallenges.elements(); iter.hasMoreElements();) {
 				byte[] authChallenge = (byte[]) iter.nextElement();
 				writeObexLen(buf, OBEX_HDR_AUTH_CHALLENGE, 3 + authChallenge.length);
 				buf.write(authChallenge);
 				DebugLog.debug("written AUTH_CHALLENGE");
 			}
 		}
-		if (((OBEXHeaderSetImpl) headers).hasAuthenticationResponses()) {
-			for (Enumeration iter = ((OBEXHeaderSetImpl) headers).authResponses.elements(); iter.hasMoreElements();) {
+		if (hs.hasAuthenticationResponses()) {
+			for (Enumeration iter = hs.authResponses.elements(); iter.hasMoreElements();) {
 				byte[] authResponse = (byte[]) iter.nextElement();
 				writeObexLen(buf, OBEX_HDR_AUTH_RESPONSE, 3 + authResponse.length);
 				buf.write(authResponse);
 				DebugLog.debug("written AUTH_RESPONSE");
 			}
 		}
-		return buf.toByteArray();
+		if (hs.bodyHeaderID != NO_VALUE) {
+			writeObexLen(buf, hs.bodyHeaderID, 3 + hs.bodyLength);
+			if (hs.bodySource == null) {
+				buf.write(hs.bodyBuffer, hs.bodyOffset, hs.bodyLength);
+			} else if (buf instanceof OBEXPacketBuffer) {
+				((OBEXPacketBuffer) buf).write(hs.bodySource, hs.bodySourcePosition, hs.bodyLength);
+			} else {
+				buf.write((byte[]) hs.getHeader(hs.bodyHeaderID));
+			}
+		}
 	}
 
 	/*
 	 * Read by server
 	 */
 	static OBEXHeaderSetImpl readHeaders(byte[] buf, int off) throws IOException {
-		return readHeaders(new OBEXHeaderSetImpl(NO_RESPONSE_CODE), buf, off);
+		return readHeaders(new OBEXHeaderSetImpl(NO_RESPONSE_CODE), buf, off, buf.length);
 	}
 
 	static OBEXHeaderSetImpl readHeaders(byte responseCode, byte[] buf, int off) throws IOException {
-		return readHeaders(new OBEXHeaderSetImpl(0xFF & responseCode), buf, off);
+		return readHeaders(new OBEXHeaderSetImpl(0xFF & responseCode), buf, off, buf.length);
 	}
 
-	private static OBEXHeaderSetImpl readHeaders(OBEXHeaderSetImpl hs, byte[] buf, int off) throws IOException {
+	/*
+	 * Read from session receive buffer, the buffer is longer than the packet
+	 */
+	static OBEXHeaderSetImpl readPacketHeaders(byte[] packet, int off) throws IOException {
+		return readHeaders(new OBEXHeaderSetImpl(NO_RESPONSE_CODE), packet, off, OBEXUtils.packetLength(packet));
+	}
+
+	static OBEXHeaderSetImpl readPacketHeaders(byte responseCode, byte[] packet, int off) throws IOException {
+		return readHeaders(new OBEXHeaderSetImpl(0xFF & responseCode), packet, off, OBEXUtils.packetLength(packet));
+	}
+
+	private static OBEXHeaderSetImpl readHeaders(OBEXHeaderSetImpl hs, byte[] buf, int off, int end)
+			throws IOException {
 		int count = 0;
-		while (off < buf.length) {
+		while (off < end) {
 			int hi = 0xFF & buf[off];
 			int len = 0;
 			switch (hi & OBEX_HDR_HI_MASK) {
@@ -461,22 +785,29 @@ class OBEXHeaderSetImpl implements HeaderSet {
 				if (len == 3) {
 					hs.setHeader(hi, "");
 				} else {
-					byte data[] = new byte[len - 5];
-					System.arraycopy(buf, off + 3, data, 0, data.length);
-					hs.setHeader(hi, OBEXUtils.newStringUTF16(data));
+					hs.setHeader(hi, OBEXUtils.newStringUTF16(buf, off + 3, len - 5));
 				}
 				break;
 			case OBEX_BYTE_STREAM:
 				len = OBEXUtils.bytesToShort(buf[off + 1], buf[off + 2]);
-				byte data[] = new byte[len - 3];
-				System.arraycopy(buf, off + 3, data, 0, data.length);
+				if ((hi == OBEX_HDR_BODY) || (hi == OBEX_HDR_BODY_END)) {
+					if ((len < 3) || (off + len > end)) {
+						throw new IOException("Invalid Body header length " + len);
+					}
+					hs.setBody(hi, buf, off + 3, len - 3);
+					break;
+				}
 				if (hi == OBEX_HDR_TYPE) {
-					if (data[data.length - 1] != 0) {
-						hs.setHeader(hi, new String(data, "iso-8859-1"));
-					} else {
-						hs.setHeader(hi, new String(data, 0, data.length - 1, "iso-8859-1"));
+					int typeLength = len - 3;
+					if ((typeLength > 0) && (buf[off + len - 1] == 0)) {
+						typeLength--;
 					}
-				} else if (hi == OBEX_HDR_TIME) {
+					hs.setHeader(hi, OBEXUtils.newStringASCII(buf, off + 3, typeLength));
+					break;
+				}
+				byte data[] = new byte[len - 3];
+				System.arraycopy(buf, off + 3, data, 0, data.length);
+				if (hi == OBEX_HDR_TIME) {
 					hs.setHeader(hi, readTimeISO8601(data));
 				} else if (hi == OBEX_HDR_AUTH_CHALLENGE) {
 					synchronized (hs) {
@@ -500,7 +831,15 @@ class OBEXHeaderSetImpl implements HeaderSet {
 				break;
 			case OBEX_BYTE:
 				len = 2;
-				hs.setHeader(hi, new Byte(buf[off + 1]));
+				if (hi == OBEX_HDR_SRM) {
+					hs.srm = 0xFF & buf[off + 1];
+					DebugLog.debug("received SRM", hs.srm);
+				} else if (hi == OBEX_HDR_SRMP) {
+					hs.srmp = 0xFF & buf[off + 1];
+					DebugLog.debug("received SRMP", hs.srmp);
+				} else {
+					hs.setHeader(hi, new Byte(buf[off + 1]));
+				}
 				break;
 			case OBEX_INT:
 				len = 5;
@@ -31,6 +31,9 @@ import java.io.IOException;
  */
 interface OBEXOperationDelivery extends OBEXOperation {
 
-	void deliverPacket(boolean finalPacket, byte buffer[]) throws IOException;
+	/**
+	 * The buffer is reused by the caller after the packet is sent.
+	 */
+	void deliverPacket(boolean finalPacket, byte buffer[], int length) throws IOException;
 
 }
@@ -70,6 +70,43 @@ class OBEXOperationInputStream extends InputStream {
 		}
 	}
 
+	/*
+	 * (non-Javadoc)
+	 *
+	 * @see java.io.InputStream#read(byte[], int, int)
+	 */
+	public int read(byte[] b, int off, int len) throws IOException {
+		if (b == null) {
+			throw new NullPointerException();
+		} else if ((off < 0) || (len < 0) || ((off + len) > b.length)) {
+			throw new IndexOutOfBoundsException();
+		} else if (len == 0) {
+			return 0;
+		}
+		if (isClosed) {
+			throw new IOException("Stream closed");
+		}
+		if (this.operation.isClosed() && (appendPos == readPos)) {
+			return -1;
+		}
+		synchronized (lock) {
+			while (!eofReceived && (this.operation instanceof OBEXOperationReceive) && !isClosed
+					&& (!this.operation.isClosed()) && (appendPos == readPos)) {
+				((OBEXOperationReceive) this.operation).receiveData(this);
+			}
+			int available = appendPos - readPos;
+			if (available == 0) {
+				return -1;
+			}
+			if (len > available) {
+				len = available;
+			}
+			System.arraycopy(buffer, readPos, b, off, len);
+			readPos += len;
+			return len;
+		}
+	}
+
 	/*
 	 * (non-Javadoc)
 	 *
@@ -94,6 +131,10 @@ class OBEXOperationInputStream extends InputStream {
 	}
 
 	void appendData(byte[] b, boolean eof) {
+		appendData(b, 0, (b == null) ? 0 : b.length, eof);
+	}
+
+	void appendData(byte[] b, int off, int len, boolean eof) {
 		if (isClosed || eofReceived) {
 			return;
 		}
@@ -101,20 +142,22 @@ class OBEXOperationInputStream extends InputStream {
 			if (eof) {
 				eofReceived = true;
 			}
-			if ((b != null) && (b.length != 0)) {
-				if (appendPos + b.length > buffer.length) {
-					int newSize = (b.length + (appendPos - readPos)) * 2;
-					if (newSize < buffer.length) {
-						newSize = buffer.length;
+			if ((b != null) && (len != 0)) {
+				if (appendPos + len > buffer.length) {
+					int unread = appendPos - readPos;
+					if (unread + len > buffer.length) {
+						byte[] newBuffer = new byte[(unread + len) * 2];
+						System.arraycopy(buffer, readPos, newBuffer, 0, unread);
+						buffer = newBuffer;
+					} else {
+						// Reuse the buffer when application reads as fast as packets arrive
+						System.arraycopy(buffer, readPos, buffer, 0, unread);
 					}
-					byte[] newBuffer = new byte[newSize];
-					System.arraycopy(buffer, readPos, newBuffer, 0, appendPos - readPos);
-					buffer = newBuffer;
-					appendPos -= readPos;
+					appendPos = unread;
 					readPos = 0;
 				}
-				System.arraycopy(b, 0, buffer, appendPos, b.length);
-				appendPos += b.length;
+				System.arraycopy(b, off, buffer, appendPos, len);
+				appendPos += len;
 			}
 			lock.notifyAll();
 		}
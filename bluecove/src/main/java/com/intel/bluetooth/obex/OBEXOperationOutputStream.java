@@ -45,7 +45,16 @@ class OBEXOperationOutputStream extends OutputStream {
 	}
 
 	public void write(int i) throws IOException {
-		write(new byte[] { (byte) i }, 0, 1);
+		if (this.operation.isClosed() || isClosed) {
+			throw new IOException("stream closed");
+		}
+		synchronized (lock) {
+			buffer[bufferLength++] = (byte) i;
+			if (bufferLength == buffer.length) {
+				this.operation.deliverPacket(false, buffer, bufferLength);
+				bufferLength = 0;
+			}
+		}
 	}
 
 	public void write(byte b[], int off, int len) throws IOException {
@@ -71,7 +80,7 @@ class OBEXOperationOutputStream extends OutputStream {
 				bufferLength += available;
 				written += available;
 				if (bufferLength == buffer.length) {
-					this.operation.deliverPacket(false, buffer);
+					this.operation.deliverPacket(false, buffer, bufferLength);
 					bufferLength = 0;
 				}
 			}
@@ -86,9 +95,7 @@ class OBEXOperationOutputStream extends OutputStream {
 
 	void deliverBuffer(boolean finalPacket) throws IOException {
 		synchronized (lock) {
-			byte[] b = new byte[bufferLength];
-			System.arraycopy(buffer, 0, b, 0, bufferLength);
-			this.operation.deliverPacket(finalPacket, b);
+			this.operation.deliverPacket(finalPacket, buffer, bufferLength);
 			bufferLength = 0;
 		}
 	}
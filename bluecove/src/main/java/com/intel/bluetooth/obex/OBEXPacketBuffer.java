@@ -0,0 +1,73 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.OutputStream;
+
+/**
+ * Session write buffer. OBEX packet is serialized directly to this buffer, the same array is reused for all packets.
+ * 
+ */
+class OBEXPacketBuffer extends ByteArrayOutputStream {
+
+	OBEXPacketBuffer(int size) {
+		super(size);
+	}
+
+	/**
+	 * Discards previous packet and writes opcode or response code followed by length placeholder.
+	 */
+	void startPacket(int commId) {
+		reset();
+		write(commId);
+		write(0);
+		write(0);
+	}
+
+	/**
+	 * Reads file data directly to the packet, the file is the only source of the copy.
+	 */
+	void write(OBEXFileSource source, long position, int len) throws IOException {
+		if (count + len > buf.length) {
+			byte[] newBuf = new byte[count + len];
+			System.arraycopy(buf, 0, newBuf, 0, count);
+			buf = newBuf;
+		}
+		source.read(position, buf, count, len);
+		count += len;
+	}
+
+	/**
+	 * Sets the packet length field and writes the packet to the stream.
+	 */
+	void writePacketTo(OutputStream out) throws IOException {
+		buf[1] = OBEXUtils.hiByte(count);
+		buf[2] = OBEXUtils.loByte(count);
+		writeTo(out);
+	}
+
+}
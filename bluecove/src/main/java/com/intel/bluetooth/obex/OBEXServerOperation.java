@@ -62,6 +62,16 @@ abstract class OBEXServerOperation implements Operation, OBEXOperation {
 
 	protected boolean inputStreamOpened = false;
 
+	/**
+	 * Single Response Mode requested by client and accepted, enabled by the next CONTINUE response.
+	 */
+	protected boolean srmAccepted = false;
+
+	/**
+	 * In Single Response Mode error is reported to client after the final packet.
+	 */
+	protected int srmErrorResponse = 0;
+
 	protected OBEXServerOperation(OBEXServerSessionImpl session, OBEXHeaderSetImpl receivedHeaders) throws IOException {
 		this.session = session;
 		this.receivedHeaders = receivedHeaders;
@@ -78,8 +88,47 @@ abstract class OBEXServerOperation implements Operation, OBEXOperation {
 
 	protected abstract boolean readRequestPacket() throws IOException;
 
+	protected void acceptSingleResponseMode(OBEXHeaderSetImpl requestHeaders) {
+		if ((requestHeaders.getSingleResponseMode() == OBEXHeaderSetImpl.OBEX_SRM_ENABLE)
+				&& session.isSingleResponseModeEnabled()) {
+			DebugLog.debug("server accepts SRM");
+			srmAccepted = true;
+		}
+	}
+
+	protected void writeContinueResponse(OBEXHeaderSetImpl headers) throws IOException {
+		if (!srmAccepted) {
+			session.writePacket(OBEXOperationCodes.OBEX_RESPONSE_CONTINUE, headers);
+			return;
+		}
+		srmAccepted = false;
+		if (headers == null) {
+			headers = OBEXSessionBase.createOBEXHeaderSetImpl();
+		}
+		headers.setSingleResponseMode(OBEXHeaderSetImpl.OBEX_SRM_ENABLE);
+		try {
+			session.writePacket(OBEXOperationCodes.OBEX_RESPONSE_CONTINUE, headers);
+		} finally {
+			headers.clearSingleResponseMode();
+		}
+		session.setSingleResponseModeActive(true);
+	}
+
+	protected void writeErrorResponse(int responseCode) throws IOException {
+		errorReceived = true;
+		if (session.isSingleResponseModeActive()) {
+			srmErrorResponse = responseCode;
+		} else {
+			session.writePacket(responseCode, null);
+		}
+	}
+
 	void writeResponse(int responseCode) throws IOException {
 		DebugLog.debug0x("server operation reply final", responseCode);
+		if (session.isSingleResponseModeActive()) {
+			writeSingleResponse(responseCode);
+			return;
+		}
 		session.writePacket(responseCode, sendHeaders);
 		sendHeaders = null;
 		if (responseCode == ResponseCodes.OBEX_HTTP_OK) {
@@ -95,22 +144,37 @@ abstract class OBEXServerOperation implements Operation, OBEXOperation {
 		}
 	}
 
-	protected void processIncommingData(HeaderSet dataHeaders, boolean eof) throws IOException {
+	private void writeSingleResponse(int responseCode) throws IOException {
+		// Client sends the rest of the request without waiting for response
+		while ((!finalPacketReceived) && (!session.isClosed())) {
+			DebugLog.debug("server waits to receive final packet");
+			readRequestPacket();
+		}
+		if (srmErrorResponse != 0) {
+			responseCode = srmErrorResponse;
+		}
+		session.writePacket(responseCode, sendHeaders);
+		sendHeaders = null;
+		session.setSingleResponseModeActive(false);
+	}
+
+	protected void processIncommingData(OBEXHeaderSetImpl dataHeaders, boolean eof) throws IOException {
 		// If this operation closing
 		if (this.inputStream == null) {
+			dataHeaders.clearBody();
 			return;
 		}
-		byte[] data = (byte[]) dataHeaders.getHeader(OBEXHeaderSetImpl.OBEX_HDR_BODY);
-		if (data == null) {
-			data = (byte[]) dataHeaders.getHeader(OBEXHeaderSetImpl.OBEX_HDR_BODY_END);
-			if (data != null) {
-				eof = true;
-			}
+		if (dataHeaders.isEndOfBody()) {
+			eof = true;
 		}
-		if (data != null) {
+		if (dataHeaders.hasBody()) {
 			incommingDataReceived = true;
-			DebugLog.debug("server received Data eof: " + eof + " len:", data.length);
-			inputStream.appendData(data, eof);
+			if (DebugLog.isDebugEnabled()) {
+				DebugLog.debug("server received Data eof: " + eof + " len:", dataHeaders.getBodyLength());
+			}
+			// Copy from the packet buffer before the next packet is read
+			inputStream.appendData(dataHeaders.getBodyBuffer(), dataHeaders.getBodyOffset(), dataHeaders.getBodyLength(), eof);
+			dataHeaders.clearBody();
 		} else if (eof) {
 			inputStream.appendData(null, eof);
 		}
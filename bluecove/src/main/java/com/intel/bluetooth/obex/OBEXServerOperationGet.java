@@ -28,7 +28,6 @@ import java.io.IOException;
 import java.io.InputStream;
 import java.io.OutputStream;
 
-import javax.obex.HeaderSet;
 import javax.obex.ResponseCodes;
 
 import com.intel.bluetooth.DebugLog;
@@ -41,6 +40,7 @@ class OBEXServerOperationGet extends OBEXServerOperation implements OBEXOperatio
 		if (finalPacket) {
 			requestEnded = true;
 			finalPacketReceived = true;
+			acceptSingleResponseMode(receivedHeaders);
 		}
 		this.inputStream = new OBEXOperationInputStream(this);
 		processIncommingData(receivedHeaders, finalPacket);
@@ -76,7 +76,7 @@ class OBEXServerOperationGet extends OBEXServerOperation implements OBEXOperatio
 		}
 		requestEnded = true;
 		outputStream = new OBEXOperationOutputStream(session.mtu, this);
-		session.writePacket(OBEXOperationCodes.OBEX_RESPONSE_CONTINUE, sendHeaders);
+		writeContinueResponse(sendHeaders);
 		sendHeaders = null;
 		return outputStream;
 	}
@@ -109,7 +109,7 @@ class OBEXServerOperationGet extends OBEXServerOperation implements OBEXOperatio
 			if (finalPacket) {
 				requestEnded = true;
 			}
-			HeaderSet requestHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+			OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 			OBEXHeaderSetImpl.appendHeaders(this.receivedHeaders, requestHeaders);
 			processIncommingData(requestHeaders, finalPacket);
 			break;
@@ -143,10 +143,11 @@ class OBEXServerOperationGet extends OBEXServerOperation implements OBEXOperatio
 	/*
 	 * (non-Javadoc)
 	 * 
-	 * @see com.intel.bluetooth.obex.OBEXOperationDelivery#deliverPacket(boolean, byte[])
+	 * @see com.intel.bluetooth.obex.OBEXOperationDelivery#deliverPacket(boolean, byte[], int)
 	 */
-	public void deliverPacket(boolean finalPacket, byte[] buffer) throws IOException {
-		if (session.requestSent) {
+	public void deliverPacket(boolean finalPacket, byte[] buffer, int length) throws IOException {
+		boolean srmActive = session.isSingleResponseModeActive();
+		if (session.requestSent && !srmActive) {
 			// TODO Consider moving readRequestPacket() to the begging of the function
 			readRequestPacket();
 			if (session.requestSent) {
@@ -160,13 +161,15 @@ class OBEXServerOperationGet extends OBEXServerOperation implements OBEXOperatio
 			// opcode = OBEXOperationCodes.OBEX_RESPONSE_SUCCESS;
 			dataHeaderID = OBEXHeaderSetImpl.OBEX_HDR_BODY_END;
 		}
-		dataHeaders.setHeader(dataHeaderID, buffer);
+		dataHeaders.setBody(dataHeaderID, buffer, 0, length);
 		if (sendHeaders != null) {
 			OBEXHeaderSetImpl.appendHeaders(dataHeaders, sendHeaders);
 			sendHeaders = null;
 		}
 		session.writePacket(opcode, dataHeaders);
-		readRequestPacket();
+		if (!srmActive) {
+			readRequestPacket();
+		}
 	}
 
 	private void processAbort() throws IOException {
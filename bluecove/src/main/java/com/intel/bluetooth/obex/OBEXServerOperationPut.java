@@ -37,6 +37,9 @@ class OBEXServerOperationPut extends OBEXServerOperation implements OBEXOperatio
 	protected OBEXServerOperationPut(OBEXServerSessionImpl session, OBEXHeaderSetImpl receivedHeaders,
 			boolean finalPacket) throws IOException {
 		super(session, receivedHeaders);
+		if (!finalPacket) {
+			acceptSingleResponseMode(receivedHeaders);
+		}
 		this.inputStream = new OBEXOperationInputStream(this);
 		processIncommingData(receivedHeaders, finalPacket);
 	}
@@ -103,10 +106,9 @@ class OBEXServerOperationPut extends OBEXServerOperation implements OBEXOperatio
 		switch (opcode) {
 		case OBEXOperationCodes.PUT_FINAL:
 		case OBEXOperationCodes.PUT:
-			OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readHeaders(b[0], b, 3);
+			OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b[0], b, 3);
 			if (!session.handleAuthenticationResponse(requestHeaders)) {
-				errorReceived = true;
-				session.writePacket(ResponseCodes.OBEX_HTTP_UNAUTHORIZED, null);
+				writeErrorResponse(ResponseCodes.OBEX_HTTP_UNAUTHORIZED);
 			} else {
 				OBEXHeaderSetImpl.appendHeaders(this.receivedHeaders, requestHeaders);
 				processIncommingData(requestHeaders, finalPacket);
@@ -116,9 +118,8 @@ class OBEXServerOperationPut extends OBEXServerOperation implements OBEXOperatio
 			processAbort();
 			break;
 		default:
-			errorReceived = true;
 			DebugLog.debug0x("server operation invalid request", OBEXUtils.toStringObexResponseCodes(opcode), opcode);
-			session.writePacket(ResponseCodes.OBEX_HTTP_BAD_REQUEST, null);
+			writeErrorResponse(ResponseCodes.OBEX_HTTP_BAD_REQUEST);
 		}
 		return finalPacket;
 	}
@@ -133,8 +134,12 @@ class OBEXServerOperationPut extends OBEXServerOperation implements OBEXOperatio
 			is.appendData(null, true);
 			return;
 		}
+		if (session.isSingleResponseModeActive()) {
+			readRequestPacket();
+			return;
+		}
 		DebugLog.debug("server operation reply continue");
-		session.writePacket(OBEXOperationCodes.OBEX_RESPONSE_CONTINUE, sendHeaders);
+		writeContinueResponse(sendHeaders);
 		sendHeaders = null;
 		readRequestPacket();
 	}
@@ -142,9 +147,9 @@ class OBEXServerOperationPut extends OBEXServerOperation implements OBEXOperatio
 	/*
 	 * (non-Javadoc)
 	 * 
-	 * @see com.intel.bluetooth.obex.OBEXOperationDelivery#deliverPacket(boolean, byte[])
+	 * @see com.intel.bluetooth.obex.OBEXOperationDelivery#deliverPacket(boolean, byte[], int)
 	 */
-	public void deliverPacket(boolean finalPacket, byte[] buffer) throws IOException {
+	public void deliverPacket(boolean finalPacket, byte[] buffer, int length) throws IOException {
 		if (session.requestSent) {
 			// TODO Consider moving readRequestPacket() to the begging of the function
 			readRequestPacket();
@@ -159,7 +164,7 @@ class OBEXServerOperationPut extends OBEXServerOperation implements OBEXOperatio
 			// opcode = OBEXOperationCodes.OBEX_RESPONSE_SUCCESS;
 			dataHeaderID = OBEXHeaderSetImpl.OBEX_HDR_BODY_END;
 		}
-		dataHeaders.setHeader(dataHeaderID, buffer);
+		dataHeaders.setBody(dataHeaderID, buffer, 0, length);
 		if (sendHeaders != null) {
 			OBEXHeaderSetImpl.appendHeaders(dataHeaders, sendHeaders);
 			sendHeaders = null;
@@ -61,6 +61,11 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 
 	static int errorCount = 0;
 
+	/**
+	 * Pool thread checks for waiting sessions with this interval while the session is idle.
+	 */
+	private static final int POOL_WAIT_TIMEOUT = 100;
+
 	OBEXServerSessionImpl(StreamConnection connection, ServerRequestHandler handler, Authenticator authenticator,
 			OBEXConnectionParams obexConnectionParams) throws IOException {
 		super(connection, obexConnectionParams);
@@ -68,26 +73,49 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		this.handler = handler;
 		this.authenticator = authenticator;
 		stackID = BlueCoveImpl.getCurrentThreadBluetoothStackID();
-		handlerThread = new Thread(this, "OBEXServerSessionThread-" + nextThreadNum());
-		UtilsJavaSE.threadSetDaemon(handlerThread);
 	}
 
 	void startSessionHandlerThread() {
+		handlerThread = new Thread(this, "OBEXServerSessionThread-" + nextThreadNum());
+		UtilsJavaSE.threadSetDaemon(handlerThread);
 		handlerThread.start();
 	}
 
 	public void run() {
 		// Let the acceptAndOpen return to the caller.
 		Thread.yield();
+		serveRequests(null);
+	}
+
+	/**
+	 * Handles requests until the session ends. When served by the pool the session is given back between operations
+	 * if the next request is not received and other sessions are waiting for a thread.
+	 * 
+	 * @return true if the session is still open and should be returned to the pool
+	 */
+	boolean serveRequests(OBEXServerSessionPool pool) {
+		boolean parked = false;
 		try {
 			if (stackID != null) {
 				BlueCoveImpl.setThreadBluetoothStackID(stackID);
 			}
 			while (!isClosed() && !closeRequested) {
+				if (pool != null) {
+					while (!waitForIncomingPacket(POOL_WAIT_TIMEOUT)) {
+						if (pool.hasWaitingSessions()) {
+							parked = true;
+							return true;
+						}
+					}
+					if (isClosed() || closeRequested) {
+						return false;
+					}
+				}
 				if (!handleRequest()) {
-					return;
+					return false;
 				}
 			}
+			return false;
 		} catch (Throwable e) {
 			synchronized (OBEXServerSessionImpl.class) {
 				errorCount++;
@@ -97,12 +125,15 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 			} else {
 				DebugLog.debug("OBEXServerSession error", e);
 			}
+			return false;
 		} finally {
-			DebugLog.debug("OBEXServerSession ends");
-			try {
-				super.close();
-			} catch (IOException e) {
-				DebugLog.debug("OBEXServerSession close error", e);
+			if (!parked) {
+				DebugLog.debug("OBEXServerSession ends");
+				try {
+					super.close();
+				} catch (IOException e) {
+					DebugLog.debug("OBEXServerSession close error", e);
+				}
 			}
 		}
 	}
@@ -191,7 +222,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		if (b[3] != OBEXOperationCodes.OBEX_VERSION) {
 			throw new IOException("Unsupported client OBEX version " + b[3]);
 		}
-		if (b.length < 7) {
+		if (OBEXUtils.packetLength(b) < 7) {
 			throw new IOException("Corrupted OBEX data");
 		}
 		int requestedMTU = OBEXUtils.bytesToShort(b[5], b[6]);
@@ -203,7 +234,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 
 		int rc;
 		OBEXHeaderSetImpl replyHeaders = createOBEXHeaderSetImpl();
-		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readHeaders(b, 7);
+		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b, 7);
 		if (!handleAuthenticationResponse(requestHeaders)) {
 			rc = ResponseCodes.OBEX_HTTP_UNAUTHORIZED;
 		} else {
@@ -243,7 +274,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		if (!validateConnection()) {
 			return;
 		}
-		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readHeaders(b, 3);
+		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b, 3);
 		OBEXHeaderSetImpl replyHeaders = createOBEXHeaderSetImpl();
 		int rc = ResponseCodes.OBEX_HTTP_OK;
 		try {
@@ -275,7 +306,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		if (!validateConnection()) {
 			return;
 		}
-		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readHeaders(b, 3);
+		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b, 3);
 		// OFF; Not tested in TCK.
 		// while ((!finalPacket) && (!operation.isIncommingDataReceived())) {
 		// finalPacket = operation.exchangeRequestPhasePackets();
@@ -311,6 +342,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		} finally {
 			operation.close();
 			operation = null;
+			setSingleResponseModeActive(false);
 		}
 	}
 
@@ -319,7 +351,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		if (!validateConnection()) {
 			return;
 		}
-		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readHeaders(b, 3);
+		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b, 3);
 		// If Client re-send the command packet with an Authenticate Response
 		if (!handleAuthenticationResponse(requestHeaders, handler)) {
 			writePacket(ResponseCodes.OBEX_HTTP_UNAUTHORIZED, null);
@@ -349,6 +381,7 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		} finally {
 			operation.close();
 			operation = null;
+			setSingleResponseModeActive(false);
 		}
 	}
 
@@ -372,10 +405,10 @@ class OBEXServerSessionImpl extends OBEXSessionBase implements Runnable, Bluetoo
 		if (!validateConnection()) {
 			return;
 		}
-		if (b.length < 5) {
+		if (OBEXUtils.packetLength(b) < 5) {
 			throw new IOException("Corrupted OBEX data");
 		}
-		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readHeaders(b, 5);
+		OBEXHeaderSetImpl requestHeaders = OBEXHeaderSetImpl.readPacketHeaders(b, 5);
 		// DebugLog.debug("setPath b[3]", b[3]);
 		// b[4] = (byte) ((backup?1:0) | (create?0:2));
 		boolean backup = ((b[3] & 1) != 0);
@@ -0,0 +1,148 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.util.Vector;
+
+import com.intel.bluetooth.DebugLog;
+import com.intel.bluetooth.UtilsJavaSE;
+
+/**
+ * Bounded set of threads serving server sessions of one SessionNotifier.
+ * <p>
+ * Connection streams can't notify about incoming data. Between operations a thread waits for the next request with
+ * the timed read of the transport and returns the session to the queue when other sessions are waiting, queued session
+ * that already received data is served first. Transports without timed read keep the thread until the session ends.
+ * Threads are created on demand and end after being idle for IDLE_THREAD_TIMEOUT or when the pool is shut down.
+ */
+class OBEXServerSessionPool {
+
+	private static final int IDLE_THREAD_TIMEOUT = 60 * 1000;
+
+	private final int maxThreads;
+
+	private final Vector sessions = new Vector();
+
+	private int threads = 0;
+
+	private int idleThreads = 0;
+
+	private boolean shutdown = false;
+
+	private static int threadNumber;
+
+	private static synchronized int nextThreadNum() {
+		return threadNumber++;
+	}
+
+	private class Worker implements Runnable {
+
+		public void run() {
+			OBEXServerSessionImpl session;
+			while ((session = nextSession()) != null) {
+				if (session.serveRequests(OBEXServerSessionPool.this)) {
+					park(session);
+				}
+			}
+		}
+	}
+
+	OBEXServerSessionPool(int maxThreads) {
+		this.maxThreads = maxThreads;
+	}
+
+	synchronized void execute(OBEXServerSessionImpl session) {
+		sessions.addElement(session);
+		if (idleThreads > 0) {
+			notify();
+		} else if (threads < maxThreads) {
+			threads++;
+			Thread t = new Thread(new Worker(), "OBEXServerSessionPoolThread-" + nextThreadNum());
+			UtilsJavaSE.threadSetDaemon(t);
+			t.start();
+		} else {
+			DebugLog.debug("OBEXServerSession queued", sessions.size());
+		}
+	}
+
+	/**
+	 * Called when SessionNotifier is closed. Idle threads end now, sessions already accepted are served until they end
+	 * and then their threads end too.
+	 */
+	synchronized void shutdown() {
+		shutdown = true;
+		notifyAll();
+	}
+
+	synchronized int getThreadCount() {
+		return threads;
+	}
+
+	/**
+	 * Called by serving thread to decide if idle session should be returned to the queue.
+	 */
+	synchronized boolean hasWaitingSessions() {
+		return !sessions.isEmpty();
+	}
+
+	private synchronized void park(OBEXServerSessionImpl session) {
+		sessions.addElement(session);
+		if (idleThreads > 0) {
+			notify();
+		}
+	}
+
+	private synchronized OBEXServerSessionImpl nextSession() {
+		long idleEnd = System.currentTimeMillis() + IDLE_THREAD_TIMEOUT;
+		while (sessions.isEmpty()) {
+			long wait = idleEnd - System.currentTimeMillis();
+			if ((wait <= 0) || shutdown) {
+				// Decrement under the same lock so execute() will start a new thread
+				threads--;
+				return null;
+			}
+			idleThreads++;
+			try {
+				wait(wait);
+			} catch (InterruptedException e) {
+				threads--;
+				return null;
+			} finally {
+				idleThreads--;
+			}
+		}
+		// Prefer the session that already received the next request
+		for (int i = 0; i < sessions.size(); i++) {
+			OBEXServerSessionImpl session = (OBEXServerSessionImpl) sessions.elementAt(i);
+			if (session.hasIncomingPacket()) {
+				sessions.removeElementAt(i);
+				return session;
+			}
+		}
+		OBEXServerSessionImpl session = (OBEXServerSessionImpl) sessions.firstElement();
+		sessions.removeElementAt(0);
+		return session;
+	}
+}
@@ -24,9 +24,9 @@
  */
 package com.intel.bluetooth.obex;
 
-import java.io.ByteArrayOutputStream;
 import java.io.IOException;
 import java.io.InputStream;
+import java.io.InterruptedIOException;
 import java.io.OutputStream;
 import java.util.Enumeration;
 import java.util.Vector;
@@ -40,8 +40,10 @@ import javax.obex.HeaderSet;
 import javax.obex.ServerRequestHandler;
 
 import com.intel.bluetooth.BluetoothConnectionAccess;
+import com.intel.bluetooth.BluetoothConnectionBuffers;
 import com.intel.bluetooth.BluetoothStack;
 import com.intel.bluetooth.DebugLog;
+import com.intel.bluetooth.ReadTimeoutInputStream;
 import com.intel.bluetooth.obex.OBEXAuthentication.Challenge;
 
 /**
@@ -74,15 +76,41 @@ abstract class OBEXSessionBase implements Connection, BluetoothConnectionAccess
 
     private Vector authChallengesSent;
 
+    /**
+     * Created on first authentication and reused for all digests calculated in this session.
+     */
+    private MD5DigestWrapper authDigest;
+
+    /**
+     * Packets are read to and written from the same buffers, no allocation per packet.
+     */
+    private byte[] receiveBuffer;
+
+    private OBEXPacketBuffer sendBuffer;
+
+    /**
+     * Number of bytes of the next packet already read to receiveBuffer by waitForIncomingPacket.
+     */
+    private int receivedPrefixLength = 0;
+
     /**
      * Each request packet flowed by response. This flag is from Client point of view
      */
     protected boolean requestSent;
 
+    /**
+     * OBEX 1.5 Single Response Mode is enabled for current PUT or GET operation. Packets flow in one direction and
+     * the ordering of request and response packets is not enforced.
+     */
+    protected boolean srmActive;
+
     public OBEXSessionBase(StreamConnection conn, OBEXConnectionParams obexConnectionParams) throws IOException {
         if (obexConnectionParams == null) {
             throw new NullPointerException("obexConnectionParams is null");
         }
+        if (obexConnectionParams.mtuAuto) {
+            obexConnectionParams = selectTransportMTU(conn, obexConnectionParams);
+        }
         this.isConnected = false;
         this.conn = conn;
         this.obexConnectionParams = obexConnectionParams;
@@ -131,6 +159,32 @@ abstract class OBEXSessionBase implements Connection, BluetoothConnectionAccess
 
     }
 
+    /**
+     * Largest packet the transport handles without blocking on a full socket buffer. Notifier params are shared by
+     * sessions, the copy is changed.
+     */
+    private static OBEXConnectionParams selectTransportMTU(StreamConnection conn, OBEXConnectionParams obexConnectionParams) {
+        int transportMTU = -1;
+        if (conn instanceof BluetoothConnectionBuffers) {
+            try {
+                transportMTU = ((BluetoothConnectionBuffers) conn).getTransportBufferSize();
+            } catch (IOException e) {
+                DebugLog.debug("can't get transport buffer size", e);
+            }
+        }
+        if (transportMTU > OBEXOperationCodes.OBEX_MAX_PACKET_LEN) {
+            transportMTU = OBEXOperationCodes.OBEX_MAX_PACKET_LEN;
+        }
+        if (transportMTU < OBEXOperationCodes.OBEX_MINIMUM_MTU) {
+            DebugLog.debug("transport mtu not known, use", obexConnectionParams.mtu);
+            return obexConnectionParams;
+        }
+        DebugLog.debug("transport mtu", transportMTU);
+        OBEXConnectionParams params = obexConnectionParams.cloneParams();
+        params.mtu = transportMTU;
+        return params;
+    }
+
     static OBEXHeaderSetImpl createOBEXHeaderSetImpl() {
         return new OBEXHeaderSetImpl();
     }
@@ -148,41 +202,37 @@ abstract class OBEXSessionBase implements Connection, BluetoothConnectionAccess
     }
 
     protected synchronized void writePacketWithFlags(int commId, byte[] headerFlagsData, OBEXHeaderSetImpl headers) throws IOException {
-        if (this.requestSent) {
+        if (this.requestSent && !this.srmActive) {
             throw new IOException("Write packet out of order");
         }
         this.requestSent = true;
-        int len = 3;
-        if (this.connectionID != -1) {
-            len += 5;
+        if (sendBuffer == null) {
+            sendBuffer = new OBEXPacketBuffer(Math.max(mtu, obexConnectionParams.mtu));
         }
+        OBEXPacketBuffer buf = sendBuffer;
+        buf.startPacket(commId);
         if (headerFlagsData != null) {
-            len += headerFlagsData.length;
+            buf.write(headerFlagsData);
+        }
+        if (this.connectionID != -1) {
+            OBEXHeaderSetImpl.writeObexInt(buf, OBEXHeaderSetImpl.OBEX_HDR_CONNECTION, this.connectionID);
         }
-        byte[] data = null;
         if (headers != null) {
-            data = OBEXHeaderSetImpl.toByteArray(headers);
-            len += data.length;
+            OBEXHeaderSetImpl.writeHeaders(buf, headers);
         }
+        int len = buf.size();
         if (len > mtu) {
             throw new IOException("Can't sent more data than in MTU, len=" + len + ", mtu=" + mtu);
         }
         this.packetsCountWrite++;
-        ByteArrayOutputStream buf = new ByteArrayOutputStream();
-        OBEXHeaderSetImpl.writeObexLen(buf, commId, len);
-        if (headerFlagsData != null) {
-            buf.write(headerFlagsData);
-        }
-        if (this.connectionID != -1) {
-            OBEXHeaderSetImpl.writeObexInt(buf, OBEXHeaderSetImpl.OBEX_HDR_CONNECTION, this.connectionID);
+        if (DebugLog.isDebugEnabled()) {
+            DebugLog.debug0x("obex send (" + this.packetsCountWrite + ")", OBEXUtils.toStringObexResponseCodes(commId), commId);
         }
-        if (data != null) {
-            buf.write(data);
-        }
-        DebugLog.debug0x("obex send (" + this.packetsCountWrite + ")", OBEXUtils.toStringObexResponseCodes(commId), commId);
-        os.write(buf.toByteArray());
+        buf.writePacketTo(os);
         os.flush();
-        DebugLog.debug("obex sent (" + this.packetsCountWrite + ") len", len);
+        if (DebugLog.isDebugEnabled()) {
+            DebugLog.debug("obex sent (" + this.packetsCountWrite + ") len", len);
+        }
 
         if ((headers != null) && (headers.hasAuthenticationChallenge())) {
             if (authChallengesSent == null) {
@@ -196,29 +246,99 @@ abstract class OBEXSessionBase implements Connection, BluetoothConnectionAccess
         }
     }
 
+    /**
+     * Reads the packet to session receive buffer. The buffer is longer than the packet, use
+     * OBEXUtils.packetLength(). Content is valid until the next packet is read.
+     */
     protected synchronized byte[] readPacket() throws IOException {
-        if (!this.requestSent) {
+        if (!this.requestSent && !this.srmActive) {
             throw new IOException("Read packet out of order");
         }
         this.requestSent = false;
-        byte[] header = new byte[3];
-        OBEXUtils.readFully(is, obexConnectionParams, header);
+        if (receiveBuffer == null) {
+            receiveBuffer = new byte[obexConnectionParams.mtu];
+        }
+        OBEXUtils.readFully(is, obexConnectionParams, receiveBuffer, receivedPrefixLength, 3 - receivedPrefixLength);
+        receivedPrefixLength = 0;
         this.packetsCountRead++;
-        DebugLog.debug0x("obex received (" + this.packetsCountRead + ")", OBEXUtils.toStringObexResponseCodes(header[0]), header[0] & 0xFF);
-        int lenght = OBEXUtils.bytesToShort(header[1], header[2]);
+        if (DebugLog.isDebugEnabled()) {
+            DebugLog.debug0x("obex received (" + this.packetsCountRead + ")", OBEXUtils.toStringObexResponseCodes(receiveBuffer[0]), receiveBuffer[0] & 0xFF);
+        }
+        int lenght = OBEXUtils.packetLength(receiveBuffer);
         if (lenght == 3) {
-            return header;
+            return receiveBuffer;
         }
         if ((lenght < 3) || (lenght > OBEXOperationCodes.OBEX_MAX_PACKET_LEN)) {
             throw new IOException("Invalid packet length " + lenght);
         }
-        byte[] data = new byte[lenght];
-        System.arraycopy(header, 0, data, 0, header.length);
-        OBEXUtils.readFully(is, obexConnectionParams, data, header.length, lenght - header.length);
-        if (is.available() > 0) {
+        if (lenght > receiveBuffer.length) {
+            // Peer ignores negotiated MTU
+            byte[] data = new byte[lenght];
+            System.arraycopy(receiveBuffer, 0, data, 0, 3);
+            receiveBuffer = data;
+        }
+        OBEXUtils.readFully(is, obexConnectionParams, receiveBuffer, 3, lenght - 3);
+        if (DebugLog.isDebugEnabled() && (is.available() > 0)) {
             DebugLog.debug("has more data after read", is.available());
         }
-        return data;
+        return receiveBuffer;
+    }
+
+    /**
+     * Next packet is already received by transport, also true for closed session so it can be cleaned up.
+     */
+    boolean hasIncomingPacket() {
+        InputStream in = this.is;
+        if ((in == null) || isClosed() || (receivedPrefixLength > 0)) {
+            return true;
+        }
+        try {
+            return (in.available() > 0);
+        } catch (IOException e) {
+            return true;
+        }
+    }
+
+    /**
+     * Blocks until the first byte of the next packet is received or timeout expires.
+     * 
+     * @return false on timeout, true when data or end of stream is received or the transport can't wait with timeout
+     */
+    synchronized boolean waitForIncomingPacket(int timeout) throws IOException {
+        if (hasIncomingPacket()) {
+            return true;
+        }
+        if (!(is instanceof ReadTimeoutInputStream)) {
+            return true;
+        }
+        if (receiveBuffer == null) {
+            receiveBuffer = new byte[obexConnectionParams.mtu];
+        }
+        try {
+            int rc = ((ReadTimeoutInputStream) is).read(receiveBuffer, 0, 1, timeout);
+            if (rc > 0) {
+                receivedPrefixLength = rc;
+            }
+            // End of stream is reported by readPacket
+            return (rc != 0);
+        } catch (InterruptedIOException e) {
+            return false;
+        }
+    }
+
+    boolean isSingleResponseModeEnabled() {
+        return obexConnectionParams.srm;
+    }
+
+    boolean isSingleResponseModeActive() {
+        return this.srmActive;
+    }
+
+    void setSingleResponseModeActive(boolean active) {
+        if (this.srmActive != active) {
+            DebugLog.debug("obex SRM", active);
+        }
+        this.srmActive = active;
     }
 
     private void validateBluetoothConnection() {
@@ -245,7 +365,8 @@ abstract class OBEXSessionBase implements Connection, BluetoothConnectionAccess
             }
             boolean authenticated = false;
             try {
-                authenticated = OBEXAuthentication.handleAuthenticationResponse(incomingHeaders, authenticator, serverHandler, authChallengesSent);
+                authenticated = OBEXAuthentication.handleAuthenticationResponse(incomingHeaders, authenticator, serverHandler, authChallengesSent,
+                        getAuthDigest());
             } finally {
                 if ((authenticated) && (authChallengesSent != null)) {
                     authChallengesSent.removeAllElements();
@@ -260,12 +381,19 @@ abstract class OBEXSessionBase implements Connection, BluetoothConnectionAccess
         }
     }
 
+    private MD5DigestWrapper getAuthDigest() {
+        if (authDigest == null) {
+            authDigest = new MD5DigestWrapper();
+        }
+        return authDigest;
+    }
+
     void handleAuthenticationChallenge(OBEXHeaderSetImpl incomingHeaders, OBEXHeaderSetImpl replyHeaders) throws IOException {
         if (incomingHeaders.hasAuthenticationChallenge()) {
             if (authenticator == null) {
                 throw new IOException("Authenticator required for authentication");
             }
-            OBEXAuthentication.handleAuthenticationChallenge(incomingHeaders, replyHeaders, authenticator);
+            OBEXAuthentication.handleAuthenticationChallenge(incomingHeaders, replyHeaders, authenticator, getAuthDigest());
         }
     }
 
@@ -54,6 +54,8 @@ public class OBEXSessionNotifierImpl implements SessionNotifier, BluetoothConnec
 
 	private OBEXConnectionParams obexConnectionParams;
 
+	private OBEXServerSessionPool sessionPool;
+
 	private static final String FQCN = OBEXSessionNotifierImpl.class.getName();
 
 	private static final Vector fqcnSet = new Vector();
@@ -73,6 +75,9 @@ public class OBEXSessionNotifierImpl implements SessionNotifier, BluetoothConnec
 		Utils.isLegalAPICall(fqcnSet);
 		this.notifier = notifier;
 		this.obexConnectionParams = obexConnectionParams;
+		if (obexConnectionParams.serverPoolSize > 0) {
+			this.sessionPool = new OBEXServerSessionPool(obexConnectionParams.serverPoolSize);
+		}
 	}
 
 	public Connection acceptAndOpen(ServerRequestHandler handler) throws IOException {
@@ -88,18 +93,29 @@ public class OBEXSessionNotifierImpl implements SessionNotifier, BluetoothConnec
 		}
 		OBEXServerSessionImpl sessionImpl = new OBEXServerSessionImpl(notifier.acceptAndOpen(), handler, auth,
 				obexConnectionParams);
-		sessionImpl.startSessionHandlerThread();
+		if (sessionPool != null) {
+			sessionPool.execute(sessionImpl);
+		} else {
+			sessionImpl.startSessionHandlerThread();
+		}
 		return sessionImpl;
 	}
 
 	public void close() throws IOException {
 		StreamConnectionNotifier n = this.notifier;
 		this.notifier = null;
+		if (sessionPool != null) {
+			sessionPool.shutdown();
+		}
 		if (n != null) {
 			n.close();
 		}
 	}
 
+	OBEXServerSessionPool getSessionPool() {
+		return sessionPool;
+	}
+
 	/*
 	 * (non-Javadoc)
 	 * 
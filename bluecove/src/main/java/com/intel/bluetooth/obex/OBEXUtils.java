@@ -24,7 +24,6 @@
  */
 package com.intel.bluetooth.obex;
 
-import java.io.ByteArrayOutputStream;
 import java.io.EOFException;
 import java.io.IOException;
 import java.io.InputStream;
@@ -33,6 +32,8 @@ import java.io.UnsupportedEncodingException;
 
 import javax.obex.ResponseCodes;
 
+import com.intel.bluetooth.ReadTimeoutInputStream;
+
 /**
  * OBEX IO Utils
  *
@@ -51,24 +52,38 @@ abstract class OBEXUtils {
 		}
 		int got = 0;
 		while (got < len) {
+			int rc;
 			if (obexConnectionParams.timeouts) {
+				// Timeout is restarted after each chunk received
 				long endOfDellay = System.currentTimeMillis() + obexConnectionParams.timeout;
-				int available = 0;
-				do {
-					available = is.available();
-					if (available == 0) {
-						if (System.currentTimeMillis() > endOfDellay) {
-							throw new InterruptedIOException("OBEX read timeout; received " + got + " form " +  len + " expected");
-						}
-						try {
-							Thread.sleep(100);
-						} catch (InterruptedException e) {
-							throw new InterruptedIOException();
-						}
+				if (is instanceof ReadTimeoutInputStream) {
+					// Block in the stream until data arrives, no polling
+					try {
+						rc = ((ReadTimeoutInputStream) is).read(b, off + got, len - got, obexConnectionParams.timeout);
+					} catch (InterruptedIOException e) {
+						throw new InterruptedIOException("OBEX read timeout; received " + got + " form " + len + " expected");
 					}
-				} while (available == 0);
+				} else {
+					int available = 0;
+					do {
+						available = is.available();
+						if (available == 0) {
+							if (System.currentTimeMillis() > endOfDellay) {
+								throw new InterruptedIOException("OBEX read timeout; received " + got + " form " + len
+										+ " expected");
+							}
+							try {
+								Thread.sleep(100);
+							} catch (InterruptedException e) {
+								throw new InterruptedIOException();
+							}
+						}
+					} while (available == 0);
+					rc = is.read(b, off + got, len - got);
+				}
+			} else {
+				rc = is.read(b, off + got, len - got);
 			}
-			int rc = is.read(b, off + got, len - got);
 			if (rc < 0) {
 				throw new EOFException("EOF while reading OBEX packet; received " + got + " form " +  len + " expected");
 			}
@@ -77,46 +92,65 @@ abstract class OBEXUtils {
 	}
 
 	static String newStringUTF16Simple(byte bytes[]) throws UnsupportedEncodingException {
-		StringBuffer buf = new StringBuffer();
-		for (int i = 0; i < bytes.length; i += 2) {
-			buf.append((char) bytesToShort(bytes[i], bytes[i + 1]));
-		}
-		return buf.toString();
+		return newStringUTF16(bytes, 0, bytes.length);
 	}
 
 	static String newStringUTF16(byte bytes[]) throws UnsupportedEncodingException {
-		try {
-			return new String(bytes, "UTF-16BE");
-		} catch (IllegalArgumentException e) {
-			// Java 1.1
-			return newStringUTF16Simple(bytes);
-		} catch (UnsupportedEncodingException e) {
-			// IBM J9
-			return newStringUTF16Simple(bytes);
+		return newStringUTF16(bytes, 0, bytes.length);
+	}
+
+	/**
+	 * UTF-16BE decoder without charset lookup, OBEX Unicode text is the same as Java char sequence. Trailing odd byte
+	 * is ignored.
+	 */
+	static String newStringUTF16(byte bytes[], int off, int len) {
+		char[] chars = new char[len / 2];
+		for (int i = 0; i < chars.length; i++, off += 2) {
+			chars[i] = (char) (((bytes[off] & 0xFF) << 8) | (bytes[off + 1] & 0xFF));
 		}
+		return new String(chars);
 	}
 
 	static byte[] getUTF16BytesSimple(String str) throws UnsupportedEncodingException {
-		ByteArrayOutputStream buf = new ByteArrayOutputStream();
+		return getUTF16Bytes(str);
+	}
+
+	/**
+	 * UTF-16BE encoder without charset lookup.
+	 */
+	static byte[] getUTF16Bytes(String str) throws UnsupportedEncodingException {
 		int len = str.length();
-		for (int i = 0; i < len; i++) {
+		byte[] b = new byte[len * 2];
+		for (int i = 0, j = 0; i < len; i++) {
 			char c = str.charAt(i);
-			buf.write(hiByte(c));
-			buf.write(loByte(c));
+			b[j++] = (byte) (c >> 8);
+			b[j++] = (byte) c;
 		}
-		return buf.toByteArray();
+		return b;
 	}
 
-	static byte[] getUTF16Bytes(String str) throws UnsupportedEncodingException {
-		try {
-			return str.getBytes("UTF-16BE");
-		} catch (IllegalArgumentException e) {
-			// Java 1.1
-			return getUTF16BytesSimple(str);
-		} catch (UnsupportedEncodingException e) {
-			// IBM J9
-			return getUTF16BytesSimple(str);
+	/**
+	 * ISO-8859-1 decoder for Type header without charset lookup.
+	 */
+	static String newStringASCII(byte bytes[], int off, int len) {
+		char[] chars = new char[len];
+		for (int i = 0; i < len; i++) {
+			chars[i] = (char) (bytes[off + i] & 0xFF);
+		}
+		return new String(chars);
+	}
+
+	/**
+	 * ISO-8859-1 encoder, characters outside of the charset are replaced by '?' like String.getBytes does.
+	 */
+	static byte[] getASCIIBytes(String str) {
+		int len = str.length();
+		byte[] b = new byte[len];
+		for (int i = 0; i < len; i++) {
+			char c = str.charAt(i);
+			b[i] = (c > 0xFF) ? (byte) '?' : (byte) c;
 		}
+		return b;
 	}
 
 	static byte hiByte(int value) {
@@ -131,6 +165,13 @@ abstract class OBEXUtils {
 		return ((((int) valueHi << 8) & 0xFF00) + (valueLo & 0xFF));
 	}
 
+	/**
+	 * Length of OBEX packet from the packet header, the buffer can be longer.
+	 */
+	static int packetLength(byte[] packet) {
+		return bytesToShort(packet[1], packet[2]);
+	}
+
 	public static String toStringObexResponseCodes(byte code) {
 		return toStringObexResponseCodes(code & 0xFF);
 	}
@@ -0,0 +1,156 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2008 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @version $Id$
+ */
+
+#include "nativeTestEnv.h"
+
+/*
+* ReceiveBuffer and ObjectPool throughput.
+*
+* Usage: commonObjectsBench [megabytes]
+*/
+
+static int benchMegabytes = 64;
+
+static void benchReceiveBufferSingleThread(int chunk) {
+    ReceiveBuffer* b = new ReceiveBuffer();
+    jbyte data[RECEIVE_BUFFER_MAX];
+    memset(data, 0x5A, sizeof(data));
+    long long total = (long long)benchMegabytes * 1024 * 1024;
+    long long transferred = 0;
+    double start = nativeTestTimeSeconds();
+    while (transferred < total) {
+        b->write(data, chunk);
+        if (chunk == 1) {
+            b->readByte();
+        } else {
+            b->read(data, chunk);
+        }
+        transferred += chunk;
+    }
+    double time = nativeTestTimeSeconds() - start;
+    fprintf(stdout, "ReceiveBuffer chunk %6i: %10.1f MB/s %12.0f ops/s\n", chunk, (transferred / (1024.0 * 1024.0)) / time, (transferred / chunk) / time);
+    delete b;
+}
+
+struct ProducerArgs {
+    ReceiveBuffer* buffer;
+    int chunk;
+    long long total;
+};
+
+static void* benchProducer(void* arg) {
+    ProducerArgs* a = (ProducerArgs*)arg;
+    jbyte data[RECEIVE_BUFFER_MAX];
+    memset(data, 0x5A, sizeof(data));
+    long long written = 0;
+    while (written < a->total) {
+        int accepted = 0;
+        if (RECEIVE_BUFFER_MAX - a->buffer->available() > a->chunk) {
+            accepted = a->buffer->write(data, a->chunk);
+        }
+        if (accepted == 0) {
+            sched_yield();
+        }
+        written += accepted;
+    }
+    return NULL;
+}
+
+static void benchReceiveBufferProducerConsumer(int chunk) {
+    ProducerArgs a;
+    a.buffer = new ReceiveBuffer();
+    a.chunk = chunk;
+    a.total = (long long)benchMegabytes * 1024 * 1024;
+    jbyte data[RECEIVE_BUFFER_MAX];
+    double start = nativeTestTimeSeconds();
+    pthread_t producer;
+    pthread_create(&producer, NULL, benchProducer, &a);
+    long long received = 0;
+    while (received < a.total) {
+        int count = a.buffer->read(data, chunk);
+        if (count == 0) {
+            sched_yield();
+        }
+        received += count;
+    }
+    pthread_join(producer, NULL);
+    double time = nativeTestTimeSeconds() - start;
+    fprintf(stdout, "ReceiveBuffer 2 threads chunk %6i: %10.1f MB/s\n", chunk, (received / (1024.0 * 1024.0)) / time);
+    if (a.buffer->isOverflown() || a.buffer->isCorrupted()) {
+        fprintf(stdout, "ReceiveBuffer failed\n");
+    }
+    delete a.buffer;
+}
+
+static void benchObjectPool(int poolSize, int liveObjects) {
+    NativeTestEnv t;
+    JNIEnv *env = &t.env;
+    ObjectPool* pool = new ObjectPool(poolSize, 1, FALSE);
+    PoolableObject** live = new PoolableObject*[liveObjects];
+    for (int i = 0; i < liveObjects; i++) {
+        live[i] = new PoolableObject();
+        pool->addObject(live[i], 'b');
+    }
+    int iterations = benchMegabytes * 16 * 1024;
+    double start = nativeTestTimeSeconds();
+    for (int i = 0; i < iterations; i++) {
+        PoolableObject* o = new PoolableObject();
+        pool->addObject(o, 'b');
+        pool->getObject(env, o->internalHandle, 'b');
+        pool->removeObject(o);
+        delete o;
+    }
+    double addRemoveTime = nativeTestTimeSeconds() - start;
+    start = nativeTestTimeSeconds();
+    for (int i = 0; i < iterations; i++) {
+        pool->getObject(env, live[i % liveObjects]->internalHandle, 'b');
+    }
+    double getTime = nativeTestTimeSeconds() - start;
+    fprintf(stdout, "ObjectPool size %5i live %5i: add/get/remove %12.0f ops/s, get %12.0f ops/s\n", poolSize, liveObjects, iterations / addRemoveTime, iterations / getTime);
+    if (t.exceptionPending) {
+        fprintf(stdout, "ObjectPool failed %s\n", t.exceptionMessage);
+    }
+    delete pool;
+    delete [] live;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 1) {
+        benchMegabytes = atoi(argv[1]);
+        if (benchMegabytes <= 0) {
+            benchMegabytes = 1;
+        }
+    }
+    int chunks[] = {1, 16, 128, 1024, 0x4000};
+    for (int i = 0; i < 5; i++) {
+        benchReceiveBufferSingleThread(chunks[i]);
+    }
+    for (int i = 1; i < 5; i++) {
+        benchReceiveBufferProducerConsumer(chunks[i]);
+    }
+    benchObjectPool(10, 1);
+    benchObjectPool(1000, 100);
+    benchObjectPool(1000, 999);
+    return 0;
+}
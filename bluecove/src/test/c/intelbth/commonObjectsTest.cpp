@@ -0,0 +1,341 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2008 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @version $Id$
+ */
+
+#include "nativeTestEnv.h"
+
+/*
+* Native unit tests for ReceiveBuffer, ObjectPool and error handling. Same cases as NativeReceiveBufferTest.java
+*/
+
+#define TEST_BUFFER_SIZE (4 * 2 * 10)
+
+static void createData(jbyte* data, int size, int off) {
+    for (int i = 0; i < size; i++) {
+        data[i] = (jbyte)((off + i) % 0xFF);
+    }
+}
+
+static void testReceiveBufferWriteReadSimple() {
+    ReceiveBuffer b(TEST_BUFFER_SIZE);
+    jbyte data[7];
+    jbyte rcv[7];
+    createData(data, 7, 3);
+    TEST_ASSERT_EQUALS(7, b.write(data, 7));
+    TEST_ASSERT_EQUALS(7, b.available());
+    TEST_ASSERT_EQUALS(7, b.read(rcv, 7));
+    TEST_ASSERT(memcmp(data, rcv, 7) == 0);
+    TEST_ASSERT_EQUALS(0, b.available());
+    TEST_ASSERT_EQUALS(-1, b.readByte());
+    TEST_ASSERT(!b.isCorrupted());
+}
+
+static void testReceiveBufferOverflow() {
+    ReceiveBuffer b(TEST_BUFFER_SIZE);
+    jbyte data[TEST_BUFFER_SIZE * 2];
+    jbyte rcv[TEST_BUFFER_SIZE * 2];
+    createData(data, TEST_BUFFER_SIZE * 2, 0);
+    TEST_ASSERT_EQUALS(TEST_BUFFER_SIZE, b.write(data, TEST_BUFFER_SIZE * 2));
+    TEST_ASSERT_EQUALS(TEST_BUFFER_SIZE, b.available());
+    TEST_ASSERT(!b.isOverflown());
+    TEST_ASSERT_EQUALS(0, b.write(data, 1));
+    TEST_ASSERT_EQUALS(TEST_BUFFER_SIZE, b.read(rcv, TEST_BUFFER_SIZE * 2));
+    TEST_ASSERT(memcmp(data, rcv, TEST_BUFFER_SIZE) == 0);
+    TEST_ASSERT(b.isOverflown());
+    b.reset();
+    TEST_ASSERT(!b.isOverflown());
+    TEST_ASSERT(!b.isCorrupted());
+}
+
+static void testReceiveBufferWrapAround() {
+    ReceiveBuffer b(TEST_BUFFER_SIZE);
+    int size = TEST_BUFFER_SIZE - (TEST_BUFFER_SIZE / 4);
+    jbyte data[TEST_BUFFER_SIZE];
+    jbyte rcv[TEST_BUFFER_SIZE];
+    for (int i = 0; i < 7; i++) {
+        createData(data, size, i);
+        TEST_ASSERT_EQUALS(size, b.write(data, size));
+        TEST_ASSERT_EQUALS(size, b.available());
+        TEST_ASSERT_EQUALS(size, b.read(rcv, size));
+        TEST_ASSERT(memcmp(data, rcv, size) == 0);
+    }
+    TEST_ASSERT(!b.isCorrupted());
+}
+
+static void testReceiveBufferAllBytesBorderConditions() {
+    int shifts[] = {TEST_BUFFER_SIZE / 2, TEST_BUFFER_SIZE / 4, 3 * TEST_BUFFER_SIZE / 4, TEST_BUFFER_SIZE};
+    for (int s = 0; s < 4; s++) {
+        ReceiveBuffer b(TEST_BUFFER_SIZE);
+        int shift = shifts[s];
+        const int size = TEST_BUFFER_SIZE * 3;
+        jbyte data[size];
+        createData(data, size, s);
+        int w;
+        for (w = 0; w < shift; w++) {
+            TEST_ASSERT_EQUALS(1, b.write(&data[w], 1));
+            TEST_ASSERT_EQUALS(w + 1, b.available());
+        }
+        int r;
+        for (r = 0; r < size - shift; r++) {
+            TEST_ASSERT_EQUALS((unsigned char)data[r], b.readByte());
+            TEST_ASSERT_EQUALS(shift - 1, b.available());
+            w = r + shift;
+            TEST_ASSERT_EQUALS(1, b.write(&data[w], 1));
+            TEST_ASSERT_EQUALS(shift, b.available());
+        }
+        for (; r < size; r++) {
+            TEST_ASSERT_EQUALS((unsigned char)data[r], b.readByte());
+            TEST_ASSERT_EQUALS(size - r - 1, b.available());
+        }
+        TEST_ASSERT(!b.isCorrupted());
+    }
+}
+
+static void testReceiveBufferSkip() {
+    ReceiveBuffer b(TEST_BUFFER_SIZE);
+    jbyte data[TEST_BUFFER_SIZE];
+    jbyte rcv[20];
+    createData(data, TEST_BUFFER_SIZE, 0);
+    TEST_ASSERT_EQUALS(TEST_BUFFER_SIZE, b.write(data, TEST_BUFFER_SIZE));
+    TEST_ASSERT_EQUALS(10, b.read(rcv, 10));
+    TEST_ASSERT_EQUALS(5, b.skip(5));
+    TEST_ASSERT_EQUALS(20, b.read(rcv, 20));
+    TEST_ASSERT(memcmp(data + 15, rcv, 20) == 0);
+}
+
+static void testReceiveBufferWithLen() {
+    ReceiveBuffer b(TEST_BUFFER_SIZE);
+    jbyte data[10];
+    jbyte rcv[10];
+    createData(data, 10, 0);
+    for (int i = 0; i < 10; i++) {
+        TEST_ASSERT_EQUALS(b.sizeof_len() + 10, b.write_with_len(data, 10));
+        int len = 0;
+        TEST_ASSERT_EQUALS(b.sizeof_len(), b.read_len(&len));
+        TEST_ASSERT_EQUALS(10, len);
+        TEST_ASSERT_EQUALS(10, b.read(rcv, len));
+        TEST_ASSERT(memcmp(data, rcv, 10) == 0);
+    }
+}
+
+#define THREAD_TEST_SIZE (TEST_BUFFER_SIZE * 1000)
+
+static void* receiveBufferWriter(void* arg) {
+    ReceiveBuffer* b = (ReceiveBuffer*)arg;
+    jbyte data[THREAD_TEST_SIZE];
+    createData(data, THREAD_TEST_SIZE, 0);
+    int i = 0;
+    while (i < THREAD_TEST_SIZE) {
+        if (b->available() > TEST_BUFFER_SIZE / 2) {
+            usleep(10);
+            continue;
+        }
+        int len = 7;
+        if (i + len > THREAD_TEST_SIZE) {
+            len = THREAD_TEST_SIZE - i;
+        }
+        i += b->write(data + i, len);
+    }
+    return NULL;
+}
+
+static void testReceiveBufferThread() {
+    ReceiveBuffer b(TEST_BUFFER_SIZE);
+    pthread_t writer;
+    pthread_create(&writer, NULL, receiveBufferWriter, &b);
+    jbyte data[THREAD_TEST_SIZE];
+    createData(data, THREAD_TEST_SIZE, 0);
+    int i = 0;
+    BOOL same = TRUE;
+    while (i < THREAD_TEST_SIZE) {
+        int c = b.readByte();
+        if (c == -1) {
+            usleep(10);
+            continue;
+        }
+        if ((jbyte)c != data[i]) {
+            same = FALSE;
+        }
+        i ++;
+    }
+    pthread_join(writer, NULL);
+    TEST_ASSERT(same);
+    TEST_ASSERT(!b.isOverflown());
+    TEST_ASSERT(!b.isCorrupted());
+}
+
+class TestPoolableObject : public PoolableObject {
+public:
+    jlong externalHandle;
+    static int destroyed;
+
+    TestPoolableObject(jlong externalHandle) {
+        this->externalHandle = externalHandle;
+    }
+
+    virtual ~TestPoolableObject() {
+        destroyed ++;
+    }
+
+    virtual BOOL isExternalHandle(jlong handle) {
+        return (externalHandle == handle);
+    }
+};
+
+int TestPoolableObject::destroyed = 0;
+
+static void testObjectPoolAddGet() {
+    NativeTestEnv t;
+    JNIEnv *env = &t.env;
+    ObjectPool pool(10, 1, FALSE);
+    TestPoolableObject* o1 = new TestPoolableObject(100);
+    TestPoolableObject* o2 = new TestPoolableObject(200);
+    TEST_ASSERT(pool.addObject(o1, 'r'));
+    TEST_ASSERT(pool.addObject(o2, 'l'));
+    TEST_ASSERT(o1->internalHandle != o2->internalHandle);
+    TEST_ASSERT(pool.hasObject(o1));
+    TEST_ASSERT(pool.getObject(env, o1->internalHandle) == o1);
+    TEST_ASSERT(pool.getObject(env, o2->internalHandle, 'l') == o2);
+    TEST_ASSERT(pool.getObjectByExternalHandle(200) == o2);
+    TEST_ASSERT(pool.getObjectByExternalHandle(300) == NULL);
+    TEST_ASSERT(!t.exceptionPending);
+
+    TEST_ASSERT(pool.getObject(env, o1->internalHandle, 'l') == NULL);
+    TEST_ASSERT_STRING_EQUALS("java/io/IOException", t.exceptionClass);
+    TEST_ASSERT(strstr(t.exceptionMessage, "Invalid handle type") != NULL);
+}
+
+static void testObjectPoolRemove() {
+    NativeTestEnv t;
+    JNIEnv *env = &t.env;
+    ObjectPool pool(10, 1, FALSE);
+    TestPoolableObject* o = new TestPoolableObject(0);
+    TEST_ASSERT(pool.addObject(o));
+    int handle = o->internalHandle;
+    pool.removeObject(o);
+    TEST_ASSERT(!pool.hasObject(o));
+    TEST_ASSERT(pool.getObject(env, handle) == NULL);
+    TEST_ASSERT_STRING_EQUALS("java/io/IOException", t.exceptionClass);
+    TEST_ASSERT(strstr(t.exceptionMessage, "Destroyed handle") != NULL);
+    delete o;
+
+    t.clearException();
+    TEST_ASSERT(pool.getObject(env, 0) == NULL);
+    TEST_ASSERT(strstr(t.exceptionMessage, "Invalid handle") != NULL);
+}
+
+static void testObjectPoolHandlesNotReused() {
+    NativeTestEnv t;
+    JNIEnv *env = &t.env;
+    ObjectPool pool(3, 1, FALSE);
+    int lastHandle = 0;
+    for (int i = 0; i < 20; i++) {
+        TestPoolableObject* o = new TestPoolableObject(i);
+        TEST_ASSERT(pool.addObject(o));
+        TEST_ASSERT(o->internalHandle > lastHandle);
+        lastHandle = o->internalHandle;
+        TEST_ASSERT(pool.getObject(env, o->internalHandle) == o);
+        pool.removeObject(o);
+        delete o;
+    }
+    TEST_ASSERT(!t.exceptionPending);
+}
+
+static void testObjectPoolFull() {
+    ObjectPool pool(3, 1, FALSE);
+    for (int i = 0; i < 3; i++) {
+        TEST_ASSERT(pool.addObject(new TestPoolableObject(i)));
+    }
+    TestPoolableObject* o = new TestPoolableObject(4);
+    TEST_ASSERT(!pool.addObject(o));
+    delete o;
+}
+
+static void testObjectPoolDelayDelete() {
+    TestPoolableObject::destroyed = 0;
+    ObjectPool pool(2, 1, TRUE);
+    TestPoolableObject* o1 = new TestPoolableObject(1);
+    TEST_ASSERT(pool.addObject(o1));
+    TEST_ASSERT(pool.addObject(new TestPoolableObject(2)));
+    o1->readyToFree = TRUE;
+    TEST_ASSERT(pool.addObject(new TestPoolableObject(3)));
+    TEST_ASSERT_EQUALS(1, TestPoolableObject::destroyed);
+}
+
+static void testThrowException() {
+    NativeTestEnv t;
+    JNIEnv *env = &t.env;
+    throwIOException(env, "3[%s]", "str");
+    TEST_ASSERT_STRING_EQUALS("java/io/IOException", t.exceptionClass);
+    TEST_ASSERT_STRING_EQUALS("3[str]", t.exceptionMessage);
+
+    // Throw Exception two times in a row. Second Exception ignored
+    throwRuntimeException(env, "22.2");
+    TEST_ASSERT_STRING_EQUALS("java/io/IOException", t.exceptionClass);
+    TEST_ASSERT_EQUALS(1, t.exceptionCount);
+
+    t.clearException();
+    throwBluetoothConnectionException(env, BT_CONNECTION_ERROR_TIMEOUT, "8[%s]", "str");
+    TEST_ASSERT_STRING_EQUALS("javax/bluetooth/BluetoothConnectionException", t.exceptionClass);
+    TEST_ASSERT_STRING_EQUALS("8[str]", t.exceptionMessage);
+    TEST_ASSERT_EQUALS(BT_CONNECTION_ERROR_TIMEOUT, t.exceptionError);
+    TEST_ASSERT_EQUALS(0, t.fatalErrorCount);
+}
+
+static void testDeviceInquiryCallback() {
+    NativeTestEnv t;
+    JNIEnv *env = &t.env;
+    DeviceInquiryCallback callback;
+    TEST_ASSERT(!callback.callDeviceInquiryStartedCallback(env));
+    TEST_ASSERT_STRING_EQUALS("java/lang/RuntimeException", t.exceptionClass);
+
+    t.clearException();
+    TEST_ASSERT(callback.builDeviceInquiryCallbacks(env, nativeTestObject(), nativeTestObject()));
+    TEST_ASSERT(callback.callDeviceInquiryStartedCallback(env));
+    TEST_ASSERT(callback.callDeviceDiscovered(env, NULL, 0x0123456789ABLL, 0x5a020c, NULL, JNI_TRUE));
+    TEST_ASSERT_EQUALS(2, t.callVoidMethodCount);
+    TEST_ASSERT_EQUALS(0x0123456789ABLL, t.callDeviceAddr);
+    TEST_ASSERT_EQUALS(0x5a020c, t.callDeviceClass);
+}
+
+static const NativeTestCase tests[] = {
+    {"testReceiveBufferWriteReadSimple", testReceiveBufferWriteReadSimple},
+    {"testReceiveBufferOverflow", testReceiveBufferOverflow},
+    {"testReceiveBufferWrapAround", testReceiveBufferWrapAround},
+    {"testReceiveBufferAllBytesBorderConditions", testReceiveBufferAllBytesBorderConditions},
+    {"testReceiveBufferSkip", testReceiveBufferSkip},
+    {"testReceiveBufferWithLen", testReceiveBufferWithLen},
+    {"testReceiveBufferThread", testReceiveBufferThread},
+    {"testObjectPoolAddGet", testObjectPoolAddGet},
+    {"testObjectPoolRemove", testObjectPoolRemove},
+    {"testObjectPoolHandlesNotReused", testObjectPoolHandlesNotReused},
+    {"testObjectPoolFull", testObjectPoolFull},
+    {"testObjectPoolDelayDelete", testObjectPoolDelayDelete},
+    {"testThrowException", testThrowException},
+    {"testDeviceInquiryCallback", testDeviceInquiryCallback},
+    {NULL, NULL}
+};
+
+int main(int argc, char* argv[]) {
+    return runNativeTests(tests);
+}
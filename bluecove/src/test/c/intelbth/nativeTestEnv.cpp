@@ -0,0 +1,194 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2008 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @version $Id$
+ */
+
+#include "nativeTestEnv.h"
+
+#include <sys/time.h>
+
+int nativeTestFailures = 0;
+
+// Distinct non NULL values returned as JNI references.
+static _jclass testClass;
+static _jstring testString;
+static _jthrowable testThrowable;
+static _jobject testObject;
+static int testMethodIDs[2];
+
+static void copyString(char* dst, const char* src) {
+    strncpy(dst, src, DEBUG_MESSAGE_MAX);
+    dst[DEBUG_MESSAGE_MAX] = 0;
+}
+
+static jint JNICALL testGetVersion(JNIEnv *env) {
+    return JNI_VERSION_1_4;
+}
+
+static jclass JNICALL testFindClass(JNIEnv *env, const char *name) {
+    copyString(NativeTestEnv::of(env)->lastClassName, name);
+    return &testClass;
+}
+
+static jint JNICALL testThrow(JNIEnv *env, jthrowable obj) {
+    NativeTestEnv* t = NativeTestEnv::of(env);
+    t->exceptionPending = TRUE;
+    t->exceptionCount ++;
+    copyString(t->exceptionClass, t->lastClassName);
+    copyString(t->exceptionMessage, t->lastStringUTF);
+    return JNI_OK;
+}
+
+static jint JNICALL testThrowNew(JNIEnv *env, jclass clazz, const char *msg) {
+    NativeTestEnv* t = NativeTestEnv::of(env);
+    t->exceptionPending = TRUE;
+    t->exceptionCount ++;
+    t->exceptionError = 0;
+    copyString(t->exceptionClass, t->lastClassName);
+    copyString(t->exceptionMessage, msg);
+    return JNI_OK;
+}
+
+static jthrowable JNICALL testExceptionOccurred(JNIEnv *env) {
+    return NativeTestEnv::of(env)->exceptionPending ? &testThrowable : NULL;
+}
+
+static void JNICALL testFatalError(JNIEnv *env, const char *msg) {
+    NativeTestEnv::of(env)->fatalErrorCount ++;
+}
+
+static jboolean JNICALL testExceptionCheck(JNIEnv *env) {
+    return NativeTestEnv::of(env)->exceptionPending ? JNI_TRUE : JNI_FALSE;
+}
+
+static jobject JNICALL testNewGlobalRef(JNIEnv *env, jobject lobj) {
+    return lobj;
+}
+
+static void JNICALL testDeleteLocalRef(JNIEnv *env, jobject obj) {
+}
+
+static jobject JNICALL testNewObjectV(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args) {
+    // Only BluetoothConnectionException(int, String) is created by native code
+    NativeTestEnv::of(env)->exceptionError = va_arg(args, jint);
+    return &testThrowable;
+}
+
+static jclass JNICALL testGetObjectClass(JNIEnv *env, jobject obj) {
+    return &testClass;
+}
+
+static jmethodID JNICALL testGetMethodID(JNIEnv *env, jclass clazz, const char *name, const char *sig) {
+    return (jmethodID)&testMethodIDs[0];
+}
+
+static jboolean JNICALL testCallBooleanMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
+    return JNI_FALSE;
+}
+
+static void JNICALL testCallVoidMethodV(JNIEnv *env, jobject obj, jmethodID methodID, va_list args) {
+    NativeTestEnv* t = NativeTestEnv::of(env);
+    t->callVoidMethodCount ++;
+    if (obj == &testObject) {
+        // deviceDiscoveredCallback(DiscoveryListener, long, int, String, boolean)
+        va_arg(args, jobject);
+        t->callDeviceAddr = va_arg(args, jlong);
+        t->callDeviceClass = va_arg(args, jint);
+    }
+}
+
+static jmethodID JNICALL testGetStaticMethodID(JNIEnv *env, jclass clazz, const char *name, const char *sig) {
+    return (jmethodID)&testMethodIDs[1];
+}
+
+static void JNICALL testCallStaticVoidMethodV(JNIEnv *env, jclass cls, jmethodID methodID, va_list args) {
+}
+
+static jstring JNICALL testNewStringUTF(JNIEnv *env, const char *utf) {
+    copyString(NativeTestEnv::of(env)->lastStringUTF, utf);
+    return &testString;
+}
+
+NativeTestEnv::NativeTestEnv() {
+    memset(&functions, 0, sizeof(functions));
+    functions.GetVersion = testGetVersion;
+    functions.FindClass = testFindClass;
+    functions.Throw = testThrow;
+    functions.ThrowNew = testThrowNew;
+    functions.ExceptionOccurred = testExceptionOccurred;
+    functions.FatalError = testFatalError;
+    functions.ExceptionCheck = testExceptionCheck;
+    functions.NewGlobalRef = testNewGlobalRef;
+    functions.DeleteLocalRef = testDeleteLocalRef;
+    functions.NewObjectV = testNewObjectV;
+    functions.GetObjectClass = testGetObjectClass;
+    functions.GetMethodID = testGetMethodID;
+    functions.CallBooleanMethodV = testCallBooleanMethodV;
+    functions.CallVoidMethodV = testCallVoidMethodV;
+    functions.GetStaticMethodID = testGetStaticMethodID;
+    functions.CallStaticVoidMethodV = testCallStaticVoidMethodV;
+    functions.NewStringUTF = testNewStringUTF;
+    env.functions = &functions;
+
+    lastClassName[0] = 0;
+    lastStringUTF[0] = 0;
+    fatalErrorCount = 0;
+    callVoidMethodCount = 0;
+    callDeviceAddr = 0;
+    callDeviceClass = 0;
+    exceptionCount = 0;
+    clearException();
+}
+
+void NativeTestEnv::clearException() {
+    exceptionPending = FALSE;
+    exceptionClass[0] = 0;
+    exceptionMessage[0] = 0;
+    exceptionError = 0;
+}
+
+NativeTestEnv* NativeTestEnv::of(JNIEnv *env) {
+    return (NativeTestEnv*)((char*)env - offsetof(NativeTestEnv, env));
+}
+
+jobject nativeTestObject() {
+    return &testObject;
+}
+
+int runNativeTests(const NativeTestCase* tests) {
+    int count = 0;
+    for(const NativeTestCase* t = tests; t->name != NULL; t++) {
+        int failuresBefore = nativeTestFailures;
+        t->function();
+        fprintf(stdout, "%s %s\n", t->name, (failuresBefore == nativeTestFailures) ? "OK" : "FAILED");
+        count ++;
+    }
+    fprintf(stdout, "Tests run: %i, Failures: %i\n", count, nativeTestFailures);
+    fflush(stdout);
+    return (nativeTestFailures == 0) ? 0 : 1;
+}
+
+double nativeTestTimeSeconds() {
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return tv.tv_sec + tv.tv_usec / 1000000.0;
+}
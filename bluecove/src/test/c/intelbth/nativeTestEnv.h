@@ -0,0 +1,101 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2008 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @version $Id$
+ */
+
+#pragma once
+
+#include "common.h"
+#include "commonObjects.h"
+
+#include <stddef.h>
+
+/*
+* JNIEnv that records thrown exceptions and Java callbacks, so native core can be tested without JVM.
+* Not thread safe, create one per test thread.
+*/
+class NativeTestEnv {
+public:
+    JNIEnv env;
+    JNINativeInterface_ functions;
+
+    BOOL exceptionPending;
+    int exceptionCount;
+    char exceptionClass[DEBUG_MESSAGE_MAX+1];
+    char exceptionMessage[DEBUG_MESSAGE_MAX+1];
+    int exceptionError;
+
+    char lastClassName[DEBUG_MESSAGE_MAX+1];
+    char lastStringUTF[DEBUG_MESSAGE_MAX+1];
+    int fatalErrorCount;
+
+    int callVoidMethodCount;
+    jlong callDeviceAddr;
+    jint callDeviceClass;
+
+    NativeTestEnv();
+
+    void clearException();
+
+    static NativeTestEnv* of(JNIEnv *env);
+};
+
+// Java object that accepts callbacks
+jobject nativeTestObject();
+
+// --- Minimal test runner
+
+extern int nativeTestFailures;
+
+#define TEST_ASSERT(condition) \
+    if (!(condition)) { \
+        fprintf(stderr, "%s(%i): assertion failed: %s\n", __FILE__, __LINE__, #condition); \
+        nativeTestFailures ++; \
+        return; \
+    }
+
+#define TEST_ASSERT_EQUALS(expected, actual) \
+    if ((long long)(expected) != (long long)(actual)) { \
+        fprintf(stderr, "%s(%i): %s expected <%lli> but was <%lli>\n", __FILE__, __LINE__, #actual, (long long)(expected), (long long)(actual)); \
+        nativeTestFailures ++; \
+        return; \
+    }
+
+#define TEST_ASSERT_STRING_EQUALS(expected, actual) \
+    if (strcmp((expected), (actual)) != 0) { \
+        fprintf(stderr, "%s(%i): %s expected <%s> but was <%s>\n", __FILE__, __LINE__, #actual, (expected), (actual)); \
+        nativeTestFailures ++; \
+        return; \
+    }
+
+typedef void (*NativeTestFunction)();
+
+struct NativeTestCase {
+    const char* name;
+    NativeTestFunction function;
+};
+
+int runNativeTests(const NativeTestCase* tests);
+
+// --- Benchmark timing
+
+double nativeTestTimeSeconds();
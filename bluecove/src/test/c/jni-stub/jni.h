@@ -0,0 +1,181 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2008 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @version $Id$
+ */
+
+/*
+* Minimal jni.h stand-in used to build and test native code on machines without JDK.
+*
+* Only the JNI functions used by the portable native core are declared.
+* Names and signatures follow the JDK jni.h so the same test code compiles against both.
+*/
+
+#ifndef _JAVASOFT_JNI_H_
+#define _JAVASOFT_JNI_H_
+
+#include <stdio.h>
+#include <stdarg.h>
+
+#define JNIEXPORT
+#define JNIIMPORT
+#define JNICALL
+
+typedef int jint;
+typedef long long jlong;
+typedef signed char jbyte;
+typedef unsigned char jboolean;
+typedef unsigned short jchar;
+typedef short jshort;
+typedef float jfloat;
+typedef double jdouble;
+typedef jint jsize;
+
+class _jobject {};
+class _jclass : public _jobject {};
+class _jthrowable : public _jobject {};
+class _jstring : public _jobject {};
+class _jarray : public _jobject {};
+class _jbyteArray : public _jarray {};
+
+typedef _jobject *jobject;
+typedef _jclass *jclass;
+typedef _jthrowable *jthrowable;
+typedef _jstring *jstring;
+typedef _jarray *jarray;
+typedef _jbyteArray *jbyteArray;
+
+struct _jmethodID;
+typedef struct _jmethodID *jmethodID;
+
+#define JNI_FALSE 0
+#define JNI_TRUE 1
+
+#define JNI_OK 0
+#define JNI_ERR (-1)
+
+#define JNI_VERSION_1_1 0x00010001
+#define JNI_VERSION_1_2 0x00010002
+#define JNI_VERSION_1_4 0x00010004
+
+struct JNIEnv_;
+typedef JNIEnv_ JNIEnv;
+
+struct JNINativeInterface_ {
+    jint (JNICALL *GetVersion)(JNIEnv *env);
+
+    jclass (JNICALL *FindClass)(JNIEnv *env, const char *name);
+
+    jint (JNICALL *Throw)(JNIEnv *env, jthrowable obj);
+    jint (JNICALL *ThrowNew)(JNIEnv *env, jclass clazz, const char *msg);
+    jthrowable (JNICALL *ExceptionOccurred)(JNIEnv *env);
+    void (JNICALL *FatalError)(JNIEnv *env, const char *msg);
+    jboolean (JNICALL *ExceptionCheck)(JNIEnv *env);
+
+    jobject (JNICALL *NewGlobalRef)(JNIEnv *env, jobject lobj);
+    void (JNICALL *DeleteLocalRef)(JNIEnv *env, jobject obj);
+
+    jobject (JNICALL *NewObjectV)(JNIEnv *env, jclass clazz, jmethodID methodID, va_list args);
+    jclass (JNICALL *GetObjectClass)(JNIEnv *env, jobject obj);
+
+    jmethodID (JNICALL *GetMethodID)(JNIEnv *env, jclass clazz, const char *name, const char *sig);
+    jboolean (JNICALL *CallBooleanMethodV)(JNIEnv *env, jobject obj, jmethodID methodID, va_list args);
+    void (JNICALL *CallVoidMethodV)(JNIEnv *env, jobject obj, jmethodID methodID, va_list args);
+
+    jmethodID (JNICALL *GetStaticMethodID)(JNIEnv *env, jclass clazz, const char *name, const char *sig);
+    void (JNICALL *CallStaticVoidMethodV)(JNIEnv *env, jclass cls, jmethodID methodID, va_list args);
+
+    jstring (JNICALL *NewStringUTF)(JNIEnv *env, const char *utf);
+};
+
+struct JNIEnv_ {
+    const struct JNINativeInterface_ *functions;
+
+    jint GetVersion() {
+        return functions->GetVersion(this);
+    }
+    jclass FindClass(const char *name) {
+        return functions->FindClass(this, name);
+    }
+    jint Throw(jthrowable obj) {
+        return functions->Throw(this, obj);
+    }
+    jint ThrowNew(jclass clazz, const char *msg) {
+        return functions->ThrowNew(this, clazz, msg);
+    }
+    jthrowable ExceptionOccurred() {
+        return functions->ExceptionOccurred(this);
+    }
+    void FatalError(const char *msg) {
+        functions->FatalError(this, msg);
+    }
+    jboolean ExceptionCheck() {
+        return functions->ExceptionCheck(this);
+    }
+    jobject NewGlobalRef(jobject lobj) {
+        return functions->NewGlobalRef(this, lobj);
+    }
+    void DeleteLocalRef(jobject obj) {
+        functions->DeleteLocalRef(this, obj);
+    }
+    jobject NewObject(jclass clazz, jmethodID methodID, ...) {
+        va_list args;
+        jobject result;
+        va_start(args, methodID);
+        result = functions->NewObjectV(this, clazz, methodID, args);
+        va_end(args);
+        return result;
+    }
+    jclass GetObjectClass(jobject obj) {
+        return functions->GetObjectClass(this, obj);
+    }
+    jmethodID GetMethodID(jclass clazz, const char *name, const char *sig) {
+        return functions->GetMethodID(this, clazz, name, sig);
+    }
+    jboolean CallBooleanMethod(jobject obj, jmethodID methodID, ...) {
+        va_list args;
+        jboolean result;
+        va_start(args, methodID);
+        result = functions->CallBooleanMethodV(this, obj, methodID, args);
+        va_end(args);
+        return result;
+    }
+    void CallVoidMethod(jobject obj, jmethodID methodID, ...) {
+        va_list args;
+        va_start(args, methodID);
+        functions->CallVoidMethodV(this, obj, methodID, args);
+        va_end(args);
+    }
+    jmethodID GetStaticMethodID(jclass clazz, const char *name, const char *sig) {
+        return functions->GetStaticMethodID(this, clazz, name, sig);
+    }
+    void CallStaticVoidMethod(jclass cls, jmethodID methodID, ...) {
+        va_list args;
+        va_start(args, methodID);
+        functions->CallStaticVoidMethodV(this, cls, methodID, args);
+        va_end(args);
+    }
+    jstring NewStringUTF(const char *utf) {
+        return functions->NewStringUTF(this, utf);
+    }
+};
+
+#endif // _JAVASOFT_JNI_H_
@@ -0,0 +1,372 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.lang.reflect.InvocationHandler;
+import java.lang.reflect.Method;
+import java.lang.reflect.Proxy;
+import java.util.Hashtable;
+import java.util.Vector;
+
+import javax.bluetooth.BluetoothConnectionException;
+import javax.microedition.io.Connection;
+
+import junit.framework.TestCase;
+
+/**
+ * BluetoothConnectionFuture driven by BluetoothConnectDriver on a stack implementing BluetoothStackConnectAsync.
+ * Test stack connections complete when the test tells them to.
+ */
+public class BluetoothConnectionFutureTest extends TestCase {
+
+	private static final long REMOTE = 0x0019639C5C41L;
+
+	/**
+	 * BluetoothStack and BluetoothStackConnectAsync calls made by the driver.
+	 */
+	private static class AsyncStackHandler implements InvocationHandler {
+
+		private long nextHandle = 0;
+
+		/**
+		 * Handles ready for connectionFinish, value is IOException or Boolean.TRUE
+		 */
+		private final Hashtable/* <Long, Object> */results = new Hashtable();
+
+		private boolean wakeup = false;
+
+		/**
+		 * Start returns 0 like stack that queued the connection
+		 */
+		private boolean queued = false;
+
+		private int starts = 0;
+
+		final Vector/* <Long> */closed = new Vector();
+
+		final Vector/* <BluetoothConnectionParams> */startCanceled = new Vector();
+
+		synchronized void setQueued(boolean queued) {
+			this.queued = queued;
+			if (!queued) {
+				wakeup = true;
+				notifyAll();
+			}
+		}
+
+		synchronized int getStarts() {
+			return starts;
+		}
+
+		synchronized void complete(long handle, IOException error) {
+			results.put(new Long(handle), (error == null) ? (Object) Boolean.TRUE : error);
+			notifyAll();
+		}
+
+		synchronized int connectionWait(long[] handles, int count, boolean[] ready, int timeout)
+				throws InterruptedException {
+			long end = System.currentTimeMillis() + timeout;
+			while (true) {
+				int readyCount = 0;
+				for (int i = 0; i < count; i++) {
+					if (results.containsKey(new Long(handles[i]))) {
+						ready[i] = true;
+						readyCount++;
+					}
+				}
+				if (readyCount > 0) {
+					return readyCount;
+				}
+				if (wakeup) {
+					wakeup = false;
+					return 0;
+				}
+				long wait = 0;
+				if (timeout >= 0) {
+					wait = end - System.currentTimeMillis();
+					if (wait <= 0) {
+						return 0;
+					}
+				}
+				wait(wait);
+			}
+		}
+
+		public Object invoke(Object proxy, Method method, Object[] args) throws Throwable {
+			String name = method.getName();
+			if (name.equals("hashCode")) {
+				return new Integer(System.identityHashCode(proxy));
+			} else if (name.equals("equals")) {
+				return (proxy == args[0]) ? Boolean.TRUE : Boolean.FALSE;
+			} else if (name.equals("toString")) {
+				return "AsyncStack";
+			} else if (name.equals("connectionRfOpenClientConnectionStart")) {
+				synchronized (this) {
+					starts++;
+					return new Long(queued ? 0 : ++nextHandle);
+				}
+			} else if (name.equals("connectionWait")) {
+				return new Integer(connectionWait((long[]) args[0], ((Integer) args[1]).intValue(), (boolean[]) args[2],
+						((Integer) args[3]).intValue()));
+			} else if (name.equals("connectionWakeup")) {
+				synchronized (this) {
+					wakeup = true;
+					notifyAll();
+				}
+			} else if (name.equals("connectionFinish")) {
+				Object result;
+				synchronized (this) {
+					result = results.get(args[0]);
+				}
+				if (result instanceof IOException) {
+					throw (IOException) result;
+				}
+			} else if (name.equals("connectionRfCloseClientConnection")) {
+				closed.addElement(args[0]);
+			} else if (name.equals("connectionStartCancel")) {
+				startCanceled.addElement(args[0]);
+			}
+			return null;
+		}
+	}
+
+	/**
+	 * Established connection is not created on test stack. Creation can be held to cancel the attempt meanwhile.
+	 */
+	private static class TestFuture extends BluetoothConnectionFuture {
+
+		private final Object lock = new Object();
+
+		private boolean hold;
+
+		private boolean creating;
+
+		private boolean connectionClosed;
+
+		void hold() {
+			synchronized (lock) {
+				hold = true;
+			}
+		}
+
+		void release() {
+			synchronized (lock) {
+				hold = false;
+				lock.notifyAll();
+			}
+		}
+
+		boolean waitCreating(long timeout) throws InterruptedException {
+			long end = System.currentTimeMillis() + timeout;
+			synchronized (lock) {
+				while (!creating) {
+					long wait = end - System.currentTimeMillis();
+					if (wait <= 0) {
+						return false;
+					}
+					lock.wait(wait);
+				}
+				return true;
+			}
+		}
+
+		boolean isConnectionClosed() {
+			synchronized (lock) {
+				return connectionClosed;
+			}
+		}
+
+		Connection createConnection(long handle) throws IOException {
+			synchronized (lock) {
+				creating = true;
+				lock.notifyAll();
+				while (hold) {
+					try {
+						lock.wait();
+					} catch (InterruptedException e) {
+						throw new InterruptedIOException();
+					}
+				}
+			}
+			return new Connection() {
+				public void close() throws IOException {
+					synchronized (lock) {
+						connectionClosed = true;
+					}
+				}
+			};
+		}
+	}
+
+	private AsyncStackHandler handler;
+
+	private BluetoothStack stack;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		handler = new AsyncStackHandler();
+		stack = (BluetoothStack) Proxy.newProxyInstance(BluetoothStack.class.getClassLoader(), new Class[] {
+				BluetoothStack.class, BluetoothStackConnectAsync.class }, handler);
+	}
+
+	protected void tearDown() throws Exception {
+		BluetoothConnectDriver.shutdownConnections(stack);
+		super.tearDown();
+	}
+
+	private TestFuture start(int timeout) throws IOException {
+		BluetoothConnectionParams params = new BluetoothConnectionParams(REMOTE, 1, false, false);
+		params.timeout = timeout;
+		TestFuture future = new TestFuture();
+		future.startRFCOMM(stack, params, null);
+		return future;
+	}
+
+	public void testCompleted() throws IOException {
+		BluetoothConnectionFuture future = start(0);
+		assertNull("in progress", future.get(100));
+		assertFalse("in progress", future.isDone());
+		handler.complete(future.handle, null);
+		assertNotNull("connection", future.get(5000));
+		assertTrue("done", future.isDone());
+		assertFalse("cancel after done", future.cancel());
+		assertEquals("handle closed", 0, handler.closed.size());
+	}
+
+	public void testFailed() throws IOException {
+		BluetoothConnectionFuture future = start(0);
+		handler.complete(future.handle, new BluetoothConnectionException(BluetoothConnectionException.FAILED_NOINFO));
+		try {
+			future.get(5000);
+			fail("connection failed");
+		} catch (BluetoothConnectionException e) {
+			assertEquals(BluetoothConnectionException.FAILED_NOINFO, e.getStatus());
+		}
+		assertTrue("handle closed", handler.closed.contains(new Long(future.handle)));
+	}
+
+	public void testCancel() throws IOException {
+		BluetoothConnectionFuture future1 = start(0);
+		BluetoothConnectionFuture future2 = start(0);
+		assertTrue("cancel", future1.cancel());
+		try {
+			future1.get(5000);
+			fail("connection canceled");
+		} catch (InterruptedIOException e) {
+		}
+		assertTrue("handle closed", handler.closed.contains(new Long(future1.handle)));
+		assertFalse("cancel after done", future1.cancel());
+
+		assertFalse("other connection in progress", future2.isDone());
+		handler.complete(future2.handle, null);
+		assertNotNull("connection", future2.get(5000));
+	}
+
+	public void testCancelDuringCompletion() throws Exception {
+		TestFuture future = start(0);
+		future.hold();
+		handler.complete(future.handle, null);
+		assertTrue("connection created", future.waitCreating(5000));
+		assertTrue("cancel before completed", future.cancel());
+		future.release();
+		try {
+			future.get(5000);
+			fail("connection canceled");
+		} catch (InterruptedIOException e) {
+		}
+		assertTrue("done", future.isDone());
+		assertTrue("connection closed", future.isConnectionClosed());
+	}
+
+	public void testTimeout() throws IOException {
+		BluetoothConnectionFuture future1 = start(200);
+		BluetoothConnectionFuture future2 = start(0);
+		long start = System.currentTimeMillis();
+		try {
+			future1.get(5000);
+			fail("connection timeout");
+		} catch (BluetoothConnectionException e) {
+			assertEquals(BluetoothConnectionException.TIMEOUT, e.getStatus());
+		}
+		assertTrue("timeout applied", System.currentTimeMillis() - start >= 150);
+		assertTrue("handle closed", handler.closed.contains(new Long(future1.handle)));
+		assertFalse("no timeout", future2.isDone());
+	}
+
+	public void testQueuedStart() throws IOException {
+		handler.setQueued(true);
+		BluetoothConnectionFuture future = start(0);
+		assertEquals("queued", 0, future.handle);
+		assertNull("in progress", future.get(100));
+		handler.complete(1, null);
+		handler.setQueued(false);
+		assertNotNull("connection", future.get(5000));
+		assertEquals("handle", 1, future.handle);
+		assertTrue("started again", handler.getStarts() >= 2);
+		assertEquals("not canceled", 0, handler.startCanceled.size());
+	}
+
+	public void testQueuedCancel() throws IOException {
+		handler.setQueued(true);
+		BluetoothConnectionFuture future = start(0);
+		assertTrue("cancel", future.cancel());
+		try {
+			future.get(5000);
+			fail("connection canceled");
+		} catch (InterruptedIOException e) {
+		}
+		assertEquals("removed from queue", 1, handler.startCanceled.size());
+		assertEquals("no handle", 0, handler.closed.size());
+	}
+
+	public void testQueuedTimeout() throws IOException {
+		handler.setQueued(true);
+		BluetoothConnectionFuture future = start(200);
+		try {
+			future.get(5000);
+			fail("connection timeout");
+		} catch (BluetoothConnectionException e) {
+			assertEquals(BluetoothConnectionException.TIMEOUT, e.getStatus());
+		}
+		assertEquals("removed from queue", 1, handler.startCanceled.size());
+		assertEquals("no handle", 0, handler.closed.size());
+	}
+
+	public void testShutdown() throws IOException {
+		BluetoothConnectionFuture future = start(0);
+		assertTrue("driver registered", BluetoothConnectDriver.drivers.containsKey(stack));
+		BluetoothConnectDriver.shutdownConnections(stack);
+		assertFalse("driver removed", BluetoothConnectDriver.drivers.containsKey(stack));
+		try {
+			future.get(5000);
+			fail("stack shutdown");
+		} catch (IOException e) {
+		}
+		assertTrue("done", future.isDone());
+		assertTrue("handle closed", handler.closed.contains(new Long(future.handle)));
+	}
+}
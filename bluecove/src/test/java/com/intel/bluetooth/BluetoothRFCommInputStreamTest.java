@@ -0,0 +1,153 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+import java.io.InterruptedIOException;
+import java.lang.reflect.InvocationHandler;
+import java.lang.reflect.Method;
+import java.lang.reflect.Proxy;
+
+import junit.framework.TestCase;
+
+/**
+ * BluetoothRFCommInputStream read-ahead buffer.
+ */
+public class BluetoothRFCommInputStreamTest extends TestCase {
+
+	/**
+	 * Stack calls made by the stream, bulk read returns data or 0 as interrupted native read.
+	 */
+	private static class StackHandler implements InvocationHandler {
+
+		byte[] data;
+
+		int byteReads;
+
+		int bulkReads;
+
+		int timedReads;
+
+		public Object invoke(Object proxy, Method method, Object[] args) throws Throwable {
+			if (method.getName().equals("connectionRfReadAvailable")) {
+				return new Integer((data == null) ? 0 : data.length);
+			}
+			if (method.getName().equals("connectionRfReadTimeout")) {
+				timedReads++;
+				return new Integer(0);
+			}
+			if (method.getName().equals("connectionRfRead")) {
+				if (args.length == 1) {
+					byteReads++;
+					return new Integer(0x55);
+				}
+				bulkReads++;
+				if (data == null) {
+					return new Integer(0);
+				}
+				byte[] b = (byte[]) args[1];
+				int off = ((Integer) args[2]).intValue();
+				int len = Math.min(((Integer) args[3]).intValue(), data.length);
+				System.arraycopy(data, 0, b, off, len);
+				return new Integer(len);
+			}
+			return null;
+		}
+	}
+
+	private StackHandler stack;
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD, null);
+		super.tearDown();
+	}
+
+	private BluetoothRFCommInputStream createStream(String readAhead) {
+		return createStream(readAhead, new Class[] { BluetoothStack.class });
+	}
+
+	private BluetoothRFCommInputStream createStream(String readAhead, Class[] interfaces) {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_RFCOMM_READ_AHEAD, readAhead);
+		stack = new StackHandler();
+		BluetoothStack bluetoothStack = (BluetoothStack) Proxy.newProxyInstance(BluetoothStack.class.getClassLoader(),
+				interfaces, stack);
+		BluetoothRFCommConnection conn = new BluetoothRFCommConnection(bluetoothStack, 1) {
+			void closeConnectionHandle(long handle) throws IOException {
+			}
+		};
+		return new BluetoothRFCommInputStream(conn);
+	}
+
+	public void testDisabledByDefault() throws IOException {
+		BluetoothRFCommInputStream is = createStream(null);
+		assertEquals(0x55, is.read());
+		assertEquals(0x55, is.read());
+		assertEquals("byte reads", 2, stack.byteReads);
+		assertEquals("bulk reads", 0, stack.bulkReads);
+	}
+
+	public void testReadAhead() throws IOException {
+		BluetoothRFCommInputStream is = createStream("16");
+		stack.data = new byte[] { 1, 2, 3 };
+		assertEquals(1, is.read());
+		assertEquals("available", 2, is.available());
+		byte[] b = new byte[4];
+		assertEquals("buffered", 2, is.read(b, 0, b.length));
+		assertEquals(3, b[1]);
+		assertEquals("bulk reads", 1, stack.bulkReads);
+		assertEquals("byte reads", 0, stack.byteReads);
+	}
+
+	public void testInterruptedReadAhead() throws IOException {
+		BluetoothRFCommInputStream is = createStream("16");
+		try {
+			is.read();
+			fail("read() interrupted");
+		} catch (InterruptedIOException e) {
+		}
+		try {
+			is.read(new byte[4], 0, 4);
+			fail("read(byte[]) interrupted");
+		} catch (InterruptedIOException e) {
+		}
+		stack.data = new byte[] { 7 };
+		assertEquals("read after interrupt", 7, is.read());
+	}
+
+	public void testReadTimeoutZeroDoesNotWait() throws IOException {
+		BluetoothRFCommInputStream is = createStream(null, new Class[] { BluetoothStack.class,
+				BluetoothStackReadTimeout.class });
+		byte[] b = new byte[4];
+		try {
+			is.read(b, 0, b.length, 0);
+			fail("read without data");
+		} catch (InterruptedIOException e) {
+		}
+		stack.data = new byte[] { 9 };
+		assertEquals("received", 1, is.read(b, 0, b.length, 0));
+		assertEquals(9, b[0]);
+		assertEquals("timed reads", 0, stack.timedReads);
+	}
+}
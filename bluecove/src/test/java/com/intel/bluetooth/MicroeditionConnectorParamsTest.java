@@ -0,0 +1,194 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.lang.reflect.InvocationHandler;
+import java.lang.reflect.Method;
+import java.lang.reflect.Proxy;
+import java.util.Hashtable;
+
+import junit.framework.TestCase;
+
+/**
+ * Connection URL parameters that depend on stack features.
+ */
+public class MicroeditionConnectorParamsTest extends TestCase {
+
+	private static BluetoothStack createStack(final int features) {
+		return (BluetoothStack) Proxy.newProxyInstance(BluetoothStack.class.getClassLoader(),
+				new Class[] { BluetoothStack.class }, new InvocationHandler() {
+					public Object invoke(Object proxy, Method method, Object[] args) throws Throwable {
+						if (method.getName().equals("getFeatureSet")) {
+							return new Integer(features);
+						}
+						return null;
+					}
+				});
+	}
+
+	private static Hashtable params(String name, String value) {
+		Hashtable values = new Hashtable();
+		values.put(name, value);
+		return values;
+	}
+
+	private static int socketOption(BluetoothStack stack, String name, String value, int max) {
+		return MicroeditionConnector.paramFeatureInt(stack, params(name, value), name,
+				BluetoothStack.FEATURE_SOCKET_OPTIONS, max);
+	}
+
+	private static void assertRejected(BluetoothStack stack, String name, String value, int max) {
+		try {
+			socketOption(stack, name, value, max);
+			fail(name + "=" + value + " accepted");
+		} catch (IllegalArgumentException e) {
+		}
+	}
+
+	public void testSocketOptions() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_SOCKET_OPTIONS);
+		assertEquals("sndbuf", 65536, socketOption(stack, "sndbuf", "65536", Integer.MAX_VALUE));
+		assertEquals("rcvbuf", 4096, socketOption(stack, "rcvbuf", "4096", Integer.MAX_VALUE));
+		assertEquals("flushto", 50, socketOption(stack, "flushto", "50", BluetoothConsts.L2CAP_FLUSH_TIMEOUT_MAX));
+		assertEquals("not present", 0, MicroeditionConnector.paramFeatureInt(stack, new Hashtable(), "sndbuf",
+				BluetoothStack.FEATURE_SOCKET_OPTIONS, Integer.MAX_VALUE));
+	}
+
+	public void testSocketOptionsRange() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_SOCKET_OPTIONS);
+		assertRejected(stack, "sndbuf", "0", Integer.MAX_VALUE);
+		assertRejected(stack, "sndbuf", "-1", Integer.MAX_VALUE);
+		assertRejected(stack, "rcvbuf", "4k", Integer.MAX_VALUE);
+		assertRejected(stack, "rcvbuf", "", Integer.MAX_VALUE);
+		assertRejected(stack, "sndbuf", "2147483648", Integer.MAX_VALUE);
+		int max = BluetoothConsts.L2CAP_FLUSH_TIMEOUT_MAX;
+		assertEquals("flushto max", max, socketOption(stack, "flushto", String.valueOf(max), max));
+		assertRejected(stack, "flushto", String.valueOf(max + 1), max);
+	}
+
+	public void testSocketOptionsNotSupported() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_L2CAP | BluetoothStack.FEATURE_L2CAP_MODE);
+		String[] names = { "sndbuf", "rcvbuf", "flushto" };
+		for (int i = 0; i < names.length; i++) {
+			try {
+				socketOption(stack, names[i], "100", Integer.MAX_VALUE);
+				fail(names[i] + " accepted");
+			} catch (IllegalArgumentException e) {
+				assertEquals(names[i] + " extension not supported on this stack", e.getMessage());
+			}
+		}
+	}
+
+	private static int modeOption(BluetoothStack stack, String name, String value) {
+		if (name.equals("l2mode")) {
+			return MicroeditionConnector.paramL2CAPMode(stack, params(name, value));
+		} else if (name.equals("txwindow")) {
+			return MicroeditionConnector.paramL2CAPTransmitWindow(stack, params(name, value),
+					L2CAPModeConnection.MODE_ERTM);
+		} else {
+			return MicroeditionConnector.paramL2CAPFCS(stack, params(name, value));
+		}
+	}
+
+	private static void assertModeRejected(BluetoothStack stack, String name, String value) {
+		try {
+			modeOption(stack, name, value);
+			fail(name + "=" + value + " accepted");
+		} catch (IllegalArgumentException e) {
+		}
+	}
+
+	public void testL2CAPMode() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_L2CAP | BluetoothStack.FEATURE_L2CAP_MODE);
+		assertEquals("default", L2CAPModeConnection.MODE_BASIC, MicroeditionConnector.paramL2CAPMode(stack,
+				new Hashtable()));
+		assertEquals("basic", L2CAPModeConnection.MODE_BASIC, MicroeditionConnector.paramL2CAPMode(stack, params(
+				"l2mode", "basic")));
+		assertEquals("ertm", L2CAPModeConnection.MODE_ERTM, MicroeditionConnector.paramL2CAPMode(stack, params(
+				"l2mode", "ertm")));
+		assertEquals("streaming", L2CAPModeConnection.MODE_STREAMING, MicroeditionConnector.paramL2CAPMode(stack,
+				params("l2mode", "streaming")));
+		assertModeRejected(stack, "l2mode", "ERTM");
+		assertModeRejected(stack, "l2mode", "3");
+		assertModeRejected(stack, "l2mode", "");
+	}
+
+	public void testL2CAPTransmitWindow() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_L2CAP | BluetoothStack.FEATURE_L2CAP_MODE);
+		int max = BluetoothConsts.L2CAP_TX_WINDOW_MAX;
+		assertEquals("default", 0, MicroeditionConnector.paramL2CAPTransmitWindow(stack, new Hashtable(),
+				L2CAPModeConnection.MODE_BASIC));
+		assertEquals("txwindow", 32, MicroeditionConnector.paramL2CAPTransmitWindow(stack, params("txwindow", "32"),
+				L2CAPModeConnection.MODE_ERTM));
+		assertEquals("txwindow max", max, MicroeditionConnector.paramL2CAPTransmitWindow(stack, params("txwindow",
+				String.valueOf(max)), L2CAPModeConnection.MODE_ERTM));
+		assertModeRejected(stack, "txwindow", "0");
+		assertModeRejected(stack, "txwindow", "-1");
+		assertModeRejected(stack, "txwindow", String.valueOf(max + 1));
+	}
+
+	public void testL2CAPTransmitWindowRequiresERTM() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_L2CAP | BluetoothStack.FEATURE_L2CAP_MODE);
+		int[] modes = { L2CAPModeConnection.MODE_BASIC, L2CAPModeConnection.MODE_STREAMING };
+		for (int i = 0; i < modes.length; i++) {
+			try {
+				MicroeditionConnector.paramL2CAPTransmitWindow(stack, params("txwindow", "32"), modes[i]);
+				fail("txwindow accepted in mode " + modes[i]);
+			} catch (IllegalArgumentException e) {
+				assertEquals("txwindow requires l2mode=ertm", e.getMessage());
+			}
+		}
+	}
+
+	public void testL2CAPFCS() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_L2CAP | BluetoothStack.FEATURE_L2CAP_MODE);
+		assertEquals("default", BluetoothConsts.L2CAP_FCS_CRC16, MicroeditionConnector.paramL2CAPFCS(stack,
+				new Hashtable()));
+		assertEquals("true", BluetoothConsts.L2CAP_FCS_CRC16, MicroeditionConnector.paramL2CAPFCS(stack, params(
+				"fcs", "true")));
+		assertEquals("false", BluetoothConsts.L2CAP_FCS_NONE, MicroeditionConnector.paramL2CAPFCS(stack, params(
+				"fcs", "false")));
+		assertModeRejected(stack, "fcs", "none");
+		assertModeRejected(stack, "fcs", "0");
+	}
+
+	public void testL2CAPModeNotSupported() {
+		BluetoothStack stack = createStack(BluetoothStack.FEATURE_L2CAP | BluetoothStack.FEATURE_SOCKET_OPTIONS);
+		assertEquals("default mode", L2CAPModeConnection.MODE_BASIC, MicroeditionConnector.paramL2CAPMode(stack,
+				new Hashtable()));
+		assertEquals("default fcs", BluetoothConsts.L2CAP_FCS_CRC16, MicroeditionConnector.paramL2CAPFCS(stack,
+				new Hashtable()));
+		String[] names = { "l2mode", "txwindow", "fcs" };
+		String[] values = { "ertm", "32", "false" };
+		for (int i = 0; i < names.length; i++) {
+			try {
+				modeOption(stack, names[i], values[i]);
+				fail(names[i] + " accepted");
+			} catch (IllegalArgumentException e) {
+				assertEquals(names[i] + " extension not supported on this stack", e.getMessage());
+			}
+		}
+	}
+}
@@ -0,0 +1,81 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import junit.framework.TestCase;
+
+/**
+ *
+ */
+public class RemoteDeviceRegistryTest extends TestCase {
+
+	public void testPutGet() {
+		RemoteDeviceRegistry registry = new RemoteDeviceRegistry();
+		int count = 5000;
+		for (int i = 0; i < count; i++) {
+			long address = 0x0019630000L + i * 0x10001L;
+			Object device = new Long(address);
+			assertSame("put " + i, device, registry.putIfAbsent(address, device));
+		}
+		assertEquals("size", count, registry.size());
+		assertEquals("devices", count, registry.devices().size());
+		for (int i = 0; i < count; i++) {
+			long address = 0x0019630000L + i * 0x10001L;
+			assertEquals("get " + i, new Long(address), registry.get(address));
+		}
+		assertNull("unknown", registry.get(0x0019630000L + 1));
+	}
+
+	public void testPutIfAbsent() {
+		RemoteDeviceRegistry registry = new RemoteDeviceRegistry();
+		Object first = new Object();
+		assertSame(first, registry.putIfAbsent(0x0123456789ABL, first));
+		assertSame("registered", first, registry.putIfAbsent(0x0123456789ABL, new Object()));
+		assertEquals("size", 1, registry.size());
+	}
+
+	public void testConnectedDevices() {
+		RemoteDeviceRegistry registry = new RemoteDeviceRegistry();
+		Object d1 = new Object();
+		Object d2 = new Object();
+		registry.connectionOpened(d1, true);
+		registry.connectionOpened(d1, false);
+		registry.connectionOpened(d2, true);
+		assertEquals("connections", 3, registry.openConnections());
+		assertEquals("devices", 2, registry.connectedDevicesCount());
+		assertEquals("devices list", 2, registry.connectedDevices().size());
+
+		registry.connectionClosed(d1, false);
+		assertEquals("devices", 2, registry.connectedDevicesCount());
+		registry.connectionClosed(d1, true);
+		assertEquals("connections", 1, registry.openConnections());
+		assertEquals("devices", 1, registry.connectedDevicesCount());
+		assertSame(d2, registry.connectedDevices().firstElement());
+
+		registry.connectionClosed(d2, true);
+		assertEquals("connections", 0, registry.openConnections());
+		assertEquals("devices", 0, registry.connectedDevicesCount());
+	}
+}
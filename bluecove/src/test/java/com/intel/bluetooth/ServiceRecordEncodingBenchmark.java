@@ -0,0 +1,61 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.IOException;
+
+import javax.bluetooth.DataElement;
+
+import junit.framework.TestCase;
+
+/**
+ * Encode time for large record, changing one attribute between encodings. Run with "mvn test -P benchmark".
+ */
+public class ServiceRecordEncodingBenchmark extends TestCase {
+
+	public void testEncodingPerformance() throws IOException {
+		final int attributes = 200;
+		final int count = 200;
+		ServiceRecordImpl serviceRecord = ServiceRecordEncodingTest.createLargeRecord(attributes);
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < count; i++) {
+			ServiceRecordEncodingTest.encodeRecord(serviceRecord);
+		}
+		long full = System.currentTimeMillis() - start;
+		start = System.currentTimeMillis();
+		for (int i = 0; i < count; i++) {
+			serviceRecord.setAttributeValue(0x200 + (i % attributes), new DataElement(DataElement.U_INT_4, i));
+			serviceRecord.toByteArray();
+		}
+		long cached = System.currentTimeMillis() - start;
+		start = System.currentTimeMillis();
+		for (int i = 0; i < count; i++) {
+			serviceRecord.toByteArray();
+		}
+		long unchanged = System.currentTimeMillis() - start;
+		System.out.println("encode record with " + attributes + " attributes " + count + " times: full " + full + " ms, cached "
+				+ cached + " ms, unchanged " + unchanged + " ms");
+	}
+}
@@ -0,0 +1,130 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2007-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.util.Arrays;
+
+import javax.bluetooth.DataElement;
+import javax.bluetooth.UUID;
+
+import junit.framework.TestCase;
+
+/**
+ * ServiceRecordImpl.toByteArray() with cached attributes encoding.
+ */
+public class ServiceRecordEncodingTest extends TestCase {
+
+	/**
+	 * Encode whole record as one DataElement, the way it was done before encoding cache.
+	 */
+	static byte[] encodeRecord(ServiceRecordImpl serviceRecord) throws IOException {
+		DataElement rootSeq = new DataElement(DataElement.DATSEQ);
+		int[] ids = serviceRecord.getAttributeIDs();
+		Arrays.sort(ids);
+		for (int i = 0; i < ids.length; i++) {
+			rootSeq.addElement(new DataElement(DataElement.U_INT_2, ids[i]));
+			rootSeq.addElement(serviceRecord.getAttributeValue(ids[i]));
+		}
+		ByteArrayOutputStream out = new ByteArrayOutputStream();
+		(new SDPOutputStream(out)).writeElement(rootSeq);
+		return out.toByteArray();
+	}
+
+	private void assertEncoding(ServiceRecordImpl serviceRecord) throws IOException {
+		byte[] expected = encodeRecord(serviceRecord);
+		byte[] actual = serviceRecord.toByteArray();
+		assertEquals("length", expected.length, actual.length);
+		for (int k = 0; k < expected.length; k++) {
+			assertEquals("byteAray[" + k + "]", expected[k], actual[k]);
+		}
+	}
+
+	static ServiceRecordImpl createLargeRecord(int attributes) {
+		ServiceRecordImpl serviceRecord = new ServiceRecordImpl(null, null, 0);
+		serviceRecord.populateRFCOMMAttributes(0, 1, new UUID("B10C0BE1111111111111111111110001", false), "Service", true);
+		for (int i = 0; i < attributes; i++) {
+			DataElement seq = new DataElement(DataElement.DATSEQ);
+			seq.addElement(new DataElement(DataElement.STRING, "Attribute " + i));
+			seq.addElement(new DataElement(DataElement.UUID, new UUID(0x1100 + i)));
+			seq.addElement(new DataElement(DataElement.U_INT_4, i));
+			serviceRecord.setAttributeValue(0x200 + i, seq);
+		}
+		return serviceRecord;
+	}
+
+	public void testEncoding() throws IOException {
+		ServiceRecordImpl serviceRecord = createLargeRecord(10);
+		assertEncoding(serviceRecord);
+		// Cached
+		assertEncoding(serviceRecord);
+
+		serviceRecord.setAttributeValue(0x203, new DataElement(DataElement.STRING, "Changed"));
+		assertEncoding(serviceRecord);
+		serviceRecord.setAttributeValue(0x204, null);
+		assertEncoding(serviceRecord);
+	}
+
+	public void testEncodingModifiedSequence() throws IOException {
+		ServiceRecordImpl serviceRecord = createLargeRecord(3);
+		assertEncoding(serviceRecord);
+
+		DataElement seq = serviceRecord.getAttributeValue(0x201);
+		seq.addElement(new DataElement(DataElement.BOOL, true));
+		assertEncoding(serviceRecord);
+
+		DataElement nested = new DataElement(DataElement.DATSEQ);
+		seq.insertElementAt(nested, 0);
+		assertEncoding(serviceRecord);
+
+		nested.addElement(new DataElement(DataElement.NULL));
+		assertEncoding(serviceRecord);
+
+		seq.removeElement(nested);
+		assertEncoding(serviceRecord);
+	}
+
+	public void testEncodingLargeRecord() throws IOException {
+		// Sequence length over 0xFF and 0xFFFF
+		assertEncoding(createLargeRecord(20));
+		assertEncoding(createLargeRecord(3000));
+	}
+
+	public void testEncodingReused() throws IOException {
+		ServiceRecordImpl serviceRecord = createLargeRecord(5);
+		byte[] data = serviceRecord.toByteArray();
+		assertSame("not changed", data, serviceRecord.toByteArray());
+
+		serviceRecord.setAttributeValue(0x202, new DataElement(DataElement.U_INT_4, 1));
+		byte[] changed = serviceRecord.toByteArray();
+		assertNotSame("attribute changed", data, changed);
+		assertEncoding(serviceRecord);
+
+		serviceRecord.getAttributeValue(0x201).addElement(new DataElement(DataElement.NULL));
+		assertNotSame("sequence modified", changed, serviceRecord.toByteArray());
+		assertEncoding(serviceRecord);
+	}
+}
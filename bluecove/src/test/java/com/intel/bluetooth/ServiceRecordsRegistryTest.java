@@ -0,0 +1,77 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth;
+
+import javax.bluetooth.ServiceRegistrationException;
+
+import junit.framework.TestCase;
+
+/**
+ * Deferred service records registration.
+ */
+public class ServiceRecordsRegistryTest extends TestCase {
+
+	private static class BatchStack implements BluetoothStackBatchRegistration {
+
+		ServiceRecordImpl[] registered;
+
+		public void registerServiceRecords(ServiceRecordImpl[] serviceRecords) throws ServiceRegistrationException {
+			registered = serviceRecords;
+		}
+	}
+
+	public void testCommit() throws Exception {
+		BatchStack stack = new BatchStack();
+		ServiceRecordImpl first = new ServiceRecordImpl(null, null, 0);
+		ServiceRecordImpl second = new ServiceRecordImpl(null, null, 0);
+		assertFalse("not in batch", ServiceRecordsRegistry.deferRegistration(stack, first));
+		ServiceRecordsRegistry.beginBatchRegistration();
+		assertTrue("deferred", ServiceRecordsRegistry.deferRegistration(stack, first));
+		assertTrue("deferred", ServiceRecordsRegistry.deferRegistration(stack, second));
+		ServiceRecordsRegistry.commitBatchRegistration();
+		assertEquals("registered", 2, stack.registered.length);
+		assertSame(first, stack.registered[0]);
+		assertSame(second, stack.registered[1]);
+	}
+
+	public void testCancelInOtherThread() throws Exception {
+		final BatchStack stack = new BatchStack();
+		final ServiceRecordImpl cancelled = new ServiceRecordImpl(null, null, 0);
+		ServiceRecordImpl kept = new ServiceRecordImpl(null, null, 0);
+		ServiceRecordsRegistry.beginBatchRegistration();
+		ServiceRecordsRegistry.deferRegistration(stack, cancelled);
+		ServiceRecordsRegistry.deferRegistration(stack, kept);
+		Thread closer = new Thread() {
+			public void run() {
+				ServiceRecordsRegistry.cancelDeferredRegistration(stack, cancelled);
+			}
+		};
+		closer.start();
+		closer.join();
+		ServiceRecordsRegistry.commitBatchRegistration();
+		assertEquals("registered", 1, stack.registered.length);
+		assertSame(kept, stack.registered[0]);
+	}
+}
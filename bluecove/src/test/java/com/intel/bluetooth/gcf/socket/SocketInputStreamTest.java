@@ -0,0 +1,97 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.gcf.socket;
+
+import java.io.InterruptedIOException;
+import java.net.ServerSocket;
+import java.net.Socket;
+
+import junit.framework.TestCase;
+
+/**
+ * SocketInputStream timed reads on loopback socket.
+ */
+public class SocketInputStreamTest extends TestCase {
+
+	private ServerSocket server;
+
+	private Socket client;
+
+	private Socket accepted;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		server = new ServerSocket(0);
+		client = new Socket("127.0.0.1", server.getLocalPort());
+		accepted = server.accept();
+	}
+
+	protected void tearDown() throws Exception {
+		accepted.close();
+		client.close();
+		server.close();
+		super.tearDown();
+	}
+
+	private void waitAvailable(SocketInputStream is) throws Exception {
+		long endOfDelay = System.currentTimeMillis() + 5000;
+		while (is.available() == 0) {
+			assertTrue("data not received", System.currentTimeMillis() < endOfDelay);
+			Thread.sleep(10);
+		}
+	}
+
+	public void testReadTimeout() throws Exception {
+		SocketInputStream is = new SocketInputStream(client);
+		byte[] b = new byte[4];
+		try {
+			is.read(b, 0, b.length, 100);
+			fail("read without data");
+		} catch (InterruptedIOException e) {
+		}
+		accepted.getOutputStream().write(5);
+		assertEquals("received", 1, is.read(b, 0, b.length, 1000));
+		assertEquals(5, b[0]);
+		assertEquals("SO_TIMEOUT", 1000, client.getSoTimeout());
+		accepted.getOutputStream().write(6);
+		assertEquals(6, is.read());
+		assertEquals("SO_TIMEOUT restored", 0, client.getSoTimeout());
+	}
+
+	public void testReadTimeoutZeroDoesNotWait() throws Exception {
+		SocketInputStream is = new SocketInputStream(client);
+		byte[] b = new byte[4];
+		try {
+			is.read(b, 0, b.length, 0);
+			fail("read without data");
+		} catch (InterruptedIOException e) {
+		}
+		assertEquals("SO_TIMEOUT", 0, client.getSoTimeout());
+		accepted.getOutputStream().write(7);
+		waitAvailable(is);
+		assertEquals("received", 1, is.read(b, 0, b.length, 0));
+		assertEquals(7, b[0]);
+	}
+}
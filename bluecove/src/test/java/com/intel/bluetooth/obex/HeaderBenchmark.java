@@ -0,0 +1,56 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+
+import javax.obex.HeaderSet;
+
+import junit.framework.TestCase;
+
+/**
+ * Prints the rate of header encoding and decoding for a typical folder listing GET request.
+ */
+public class HeaderBenchmark extends TestCase {
+
+	public void testHeaderReadWriteSpeed() throws IOException {
+		int count = 100000;
+		long start = System.currentTimeMillis();
+		byte[] b = null;
+		for (int i = 0; i < count; i++) {
+			HeaderSet hs = new OBEXHeaderSetImpl();
+			hs.setHeader(HeaderSet.NAME, "Documents");
+			hs.setHeader(HeaderSet.TYPE, "x-obex/folder-listing");
+			b = OBEXHeaderSetImpl.toByteArray(hs);
+		}
+		long write = System.currentTimeMillis() - start;
+		start = System.currentTimeMillis();
+		for (int i = 0; i < count; i++) {
+			OBEXHeaderSetImpl.readHeaders((byte) 0, b, 0).getHeader(HeaderSet.NAME);
+		}
+		long read = System.currentTimeMillis() - start;
+		System.out.println("OBEX headers " + count + " Name and Type: write " + write + " msec, read " + read + " msec");
+	}
+}
@@ -216,4 +216,65 @@ public class HeaderTest extends TestCase {
 		validateReadWrite(hs);
 	}
 
+	public void testHeaderSingleResponseModeReadWrite() throws IOException {
+		OBEXHeaderSetImpl hs = new OBEXHeaderSetImpl();
+		hs.setHeader(HeaderSet.NAME, "test.txt");
+		hs.setSingleResponseMode(OBEXHeaderSetImpl.OBEX_SRM_ENABLE);
+		byte b[] = OBEXHeaderSetImpl.toByteArray(hs);
+		assertEquals("length", 3 + 18 + 2, b.length);
+		OBEXHeaderSetImpl r = OBEXHeaderSetImpl.readHeaders((byte) 0, b, 0);
+		assertEquals("SRM", OBEXHeaderSetImpl.OBEX_SRM_ENABLE, r.getSingleResponseMode());
+		assertEquals("HeaderList.length", 1, r.getHeaderList().length);
+
+		byte srmp[] = new byte[] { (byte) OBEXHeaderSetImpl.OBEX_HDR_SRMP, OBEXHeaderSetImpl.OBEX_SRMP_WAIT };
+		r = OBEXHeaderSetImpl.readHeaders((byte) 0, srmp, 0);
+		assertEquals("SRMP", OBEXHeaderSetImpl.OBEX_SRMP_WAIT, r.getSingleResponseModeParameters());
+		assertNull("HeaderList", r.getHeaderList());
+
+		hs.clearSingleResponseMode();
+		assertEquals("length", 3 + 18, OBEXHeaderSetImpl.toByteArray(hs).length);
+	}
+
+
+	public void testHeaderSameIdentifierReadWrite() throws IOException, ParseException {
+		HeaderSet hs = new OBEXHeaderSetImpl();
+		Calendar c = Calendar.getInstance(TimeZone.getTimeZone("UTC"));
+		c.setTime(detectDateformat("2006-07-02 18:30:21"));
+		hs.setHeader(HeaderSet.TIME_ISO_8601, c);
+		hs.setHeader(HeaderSet.TIME_4_BYTE, c);
+		hs.setHeader(OBEXHeaderSetImpl.OBEX_HDR_USER | OBEXHeaderSetImpl.OBEX_STRING, "user");
+		hs.setHeader(OBEXHeaderSetImpl.OBEX_HDR_USER | OBEXHeaderSetImpl.OBEX_BYTE_STREAM, new byte[] { 1 });
+		hs.setHeader(OBEXHeaderSetImpl.OBEX_HDR_USER | OBEXHeaderSetImpl.OBEX_BYTE, new Byte((byte) 2));
+		hs.setHeader(OBEXHeaderSetImpl.OBEX_HDR_USER | OBEXHeaderSetImpl.OBEX_INT, new Long(3));
+		assertEquals("HeaderList.length", 6, hs.getHeaderList().length);
+		validateReadWrite(hs);
+
+		hs.setHeader(HeaderSet.TIME_ISO_8601, null);
+		hs.setHeader(OBEXHeaderSetImpl.OBEX_HDR_USER | OBEXHeaderSetImpl.OBEX_BYTE_STREAM, null);
+		assertEquals("HeaderList.length", 4, hs.getHeaderList().length);
+		assertNull("removed", hs.getHeader(HeaderSet.TIME_ISO_8601));
+		assertNotNull("TIME_4_BYTE", hs.getHeader(HeaderSet.TIME_4_BYTE));
+		assertEquals("user string", "user", hs.getHeader(OBEXHeaderSetImpl.OBEX_HDR_USER | OBEXHeaderSetImpl.OBEX_STRING));
+		validateReadWrite(hs);
+
+		// Time 4 byte stays in overflow list when Time slot is free
+		hs.setHeader(HeaderSet.TIME_4_BYTE, c);
+		assertEquals("HeaderList.length", 4, hs.getHeaderList().length);
+	}
+
+	public void testHeaderEncodedNameChanged() throws IOException {
+		HeaderSet hs = new OBEXHeaderSetImpl();
+		hs.setHeader(HeaderSet.NAME, "first.txt");
+		hs.setHeader(HeaderSet.TYPE, "text/plain");
+		OBEXHeaderSetImpl.toByteArray(hs);
+		hs.setHeader(HeaderSet.NAME, "second.txt");
+		hs.setHeader(HeaderSet.TYPE, "x-obex/folder-listing");
+		HeaderSet r = OBEXHeaderSetImpl.readHeaders((byte) 0, OBEXHeaderSetImpl.toByteArray(hs), 0);
+		assertEquals("Name", "second.txt", r.getHeader(HeaderSet.NAME));
+		assertEquals("Type", "x-obex/folder-listing", r.getHeader(HeaderSet.TYPE));
+		hs.setHeader(HeaderSet.NAME, "");
+		r = OBEXHeaderSetImpl.readHeaders((byte) 0, OBEXHeaderSetImpl.toByteArray(hs), 0);
+		assertEquals("empty Name", "", r.getHeader(HeaderSet.NAME));
+	}
+
 }
@@ -0,0 +1,57 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+
+import javax.obex.ClientSession;
+
+import com.intel.bluetooth.obex.OBEXAuthenticationConnectTest.PasswordAuthenticator;
+
+/**
+ * Prints latency of CONNECT with authentication challenge over TCP-OBEX loopback.
+ */
+public class OBEXAuthenticationConnectBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int BENCHMARK_CONNECTS = 500;
+
+	public void testConnectLatency() throws IOException {
+		startServer(new PasswordAuthenticator("secret"));
+		ClientSession clientSession = openClientSession();
+		try {
+			clientSession.setAuthenticator(new PasswordAuthenticator("secret"));
+			long start = System.currentTimeMillis();
+			for (int i = 0; i < BENCHMARK_CONNECTS; i++) {
+				OBEXAuthenticationConnectTest.connectWithChallenge(clientSession);
+				clientSession.disconnect(null);
+			}
+			long time = System.currentTimeMillis() - start;
+			System.out.println("OBEX CONNECT with authentication x" + BENCHMARK_CONNECTS + ": " + time + " msec, "
+					+ ((time * 1000) / BENCHMARK_CONNECTS) + " usec per CONNECT/DISCONNECT");
+		} finally {
+			clientSession.close();
+		}
+	}
+}
@@ -0,0 +1,113 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+
+import javax.obex.Authenticator;
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.PasswordAuthentication;
+import javax.obex.ResponseCodes;
+
+/**
+ * CONNECT with authentication challenge over TCP-OBEX loopback.
+ */
+public class OBEXAuthenticationConnectTest extends OBEXLoopbackTestCase {
+
+	private volatile int serverChallenges;
+
+	static class PasswordAuthenticator implements Authenticator {
+
+		private byte[] password;
+
+		PasswordAuthenticator(String password) {
+			this.password = password.getBytes();
+		}
+
+		public PasswordAuthentication onAuthenticationChallenge(String description, boolean isUserIdRequired,
+				boolean isFullAccess) {
+			return new PasswordAuthentication(null, password);
+		}
+
+		public byte[] onAuthenticationResponse(byte[] userName) {
+			return password;
+		}
+	}
+
+	private class ServerAuthenticator extends PasswordAuthenticator {
+
+		ServerAuthenticator(String password) {
+			super(password);
+		}
+
+		public PasswordAuthentication onAuthenticationChallenge(String description, boolean isUserIdRequired,
+				boolean isFullAccess) {
+			serverChallenges++;
+			return super.onAuthenticationChallenge(description, isUserIdRequired, isFullAccess);
+		}
+	}
+
+	private ClientSession open(String password) throws IOException {
+		ClientSession clientSession = openClientSession();
+		clientSession.setAuthenticator(new PasswordAuthenticator(password));
+		return clientSession;
+	}
+
+	static void connectWithChallenge(ClientSession clientSession) throws IOException {
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.createAuthenticationChallenge("BenchTest", false, true);
+		HeaderSet hsConnectReply = clientSession.connect(hs);
+		assertEquals("connect", ResponseCodes.OBEX_HTTP_OK, hsConnectReply.getResponseCode());
+	}
+
+	public void testConnectAuthentication() throws IOException {
+		startServer(new ServerAuthenticator("secret"));
+		ClientSession clientSession = open("secret");
+		try {
+			connectWithChallenge(clientSession);
+			assertEquals("challenges", 1, serverChallenges);
+			clientSession.disconnect(null);
+			connectWithChallenge(clientSession);
+			assertEquals("challenges", 2, serverChallenges);
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+
+	public void testConnectWrongPassword() throws IOException {
+		startServer(new ServerAuthenticator("secret"));
+		ClientSession clientSession = open("other");
+		try {
+			connectWithChallenge(clientSession);
+			fail("Authentication should fail");
+		} catch (IOException e) {
+			assertEquals("Authentication failure", e.getMessage());
+		} finally {
+			clientSession.close();
+		}
+	}
+}
@@ -74,6 +74,18 @@ public class OBEXAuthenticationTest extends TestCase {
 		assertEquals("md5 digest", digestExpected, digest);
 	}
 
+	public void testRequestDigestReused() {
+		MD5DigestWrapper md5 = new MD5DigestWrapper();
+		byte[] nonce = md5digest("0cc175b9c0f1b6a831c399e269772661");
+		byte[] password = new byte[] { 'p', 'w' };
+		byte[] digest1 = OBEXAuthentication.requestDigest(md5, nonce, password);
+		byte[] digest2 = OBEXAuthentication.requestDigest(md5, nonce, password);
+		assertEquals("reused digest", digest1, digest2);
+		assertEquals("new digest", digest1, OBEXAuthentication.requestDigest(new MD5DigestWrapper(), nonce, password));
+		byte[] digest3 = OBEXAuthentication.requestDigest(md5, nonce, new byte[] { 'p', 'x' });
+		assertFalse("other password", OBEXAuthentication.equals(digest1, digest3));
+	}
+
 	static public void assertEquals(String message, OBEXAuthentication.Challenge expected,
 			OBEXAuthentication.Challenge actual) {
 		assertEquals(message + " realm", expected.getRealm(), actual.getRealm());
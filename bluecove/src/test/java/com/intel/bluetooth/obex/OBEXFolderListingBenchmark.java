@@ -0,0 +1,56 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+
+import javax.obex.ClientSession;
+import javax.obex.ServerRequestHandler;
+
+/**
+ * Prints time of streaming GET of large folder listing over TCP-OBEX loopback.
+ */
+public class OBEXFolderListingBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int LARGE_LISTING_ENTRIES = 100000;
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new OBEXFolderListingTest.ListingRequestHandler(LARGE_LISTING_ENTRIES);
+	}
+
+	public void testLargeListing() throws IOException {
+		ClientSession clientSession = connect();
+		try {
+			long start = System.currentTimeMillis();
+			int count = OBEXFolderListingTest.getListing(clientSession);
+			long time = System.currentTimeMillis() - start;
+			assertEquals("entries", LARGE_LISTING_ENTRIES, count);
+			System.out.println("OBEX folder-listing " + count + " entries: " + time + " msec");
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+}
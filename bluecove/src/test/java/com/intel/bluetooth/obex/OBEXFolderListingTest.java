@@ -0,0 +1,188 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.ByteArrayInputStream;
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+/**
+ * Folder-listing parser and writer, streaming GET of large listing over TCP-OBEX loopback.
+ */
+public class OBEXFolderListingTest extends OBEXLoopbackTestCase {
+
+	private static final int LARGE_LISTING_ENTRIES = 10000;
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new ListingRequestHandler(LARGE_LISTING_ENTRIES);
+	}
+
+	private OBEXFolderListingParser parser(String xml) throws IOException {
+		return new OBEXFolderListingParser(new ByteArrayInputStream(xml.getBytes("UTF-8")));
+	}
+
+	public void testParse() throws IOException {
+		OBEXFolderListingParser p = parser("<?xml version=\"1.0\"?>\n"
+				+ "<!DOCTYPE folder-listing SYSTEM \"obex-folder-listing.dtd\" [ <!ENTITY x \"y\"> ]>\n"
+				+ "<!-- comment <file name=\"no\"/> --->\n" + "<folder-listing version=\"1.0\">\n" + "  <parent-folder />\n"
+				+ "  <folder name='Pictures' modified=\"20090101T120000Z\"/>\n"
+				+ "  <file name=\"a &amp; b &lt;&#x4E2D;&#65;&gt;.txt\" size=\"1024\" type=\"text/plain\">desc</file>\n"
+				+ "  <unknown x=\"1\"/>\n" + "  <file name=\"\u00E4\"/>\n" + "</folder-listing>\n");
+		OBEXFolderListingEntry e = p.next();
+		assertTrue("parent", e.isParentFolder());
+		assertEquals("parent attributes", 0, e.getAttributeCount());
+		e = p.next();
+		assertTrue("folder", e.isFolder());
+		assertEquals("folder name", "Pictures", e.getName());
+		assertEquals("folder modified", "20090101T120000Z", e.getModified());
+		assertEquals("folder size", -1, e.getSize());
+		e = p.next();
+		assertTrue("file", e.isFile());
+		assertEquals("file name", "a & b <\u4E2DA>.txt", e.getName());
+		assertEquals("file size", 1024, e.getSize());
+		assertEquals("file type", "text/plain", e.getAttribute("type"));
+		e = p.next();
+		assertEquals("file name 2", "\u00E4", e.getName());
+		assertNull("end", p.next());
+		assertNull("after end", p.next());
+	}
+
+	public void testParseTruncated() throws IOException {
+		OBEXFolderListingParser p = parser("<folder-listing version=\"1.0\"><file name=\"a\"/><file name=\"b");
+		assertEquals("a", p.next().getName());
+		try {
+			p.next();
+			fail("truncated listing");
+		} catch (IOException e) {
+		}
+	}
+
+	public void testWriteParse() throws IOException {
+		ByteArrayOutputStream out = new ByteArrayOutputStream();
+		OBEXFolderListingWriter w = new OBEXFolderListingWriter(out);
+		w.writeParentFolder();
+		w.write(OBEXFolderListingEntry.createFolder("Dir \"1\""));
+		OBEXFolderListingEntry file = OBEXFolderListingEntry.createFile("x<&>\u4E2D\uD834\uDD1E", 77);
+		file.setAttribute("modified", "20090101T120000Z");
+		w.write(file);
+		w.close();
+
+		OBEXFolderListingParser p = new OBEXFolderListingParser(new ByteArrayInputStream(out.toByteArray()));
+		assertTrue("parent", p.next().isParentFolder());
+		assertEquals("folder", "Dir \"1\"", p.next().getName());
+		OBEXFolderListingEntry e = p.next();
+		assertEquals("file name", file.getName(), e.getName());
+		assertEquals("file size", 77, e.getSize());
+		assertEquals("file modified", "20090101T120000Z", e.getModified());
+		assertNull("end", p.next());
+	}
+
+	public void testEntryAttributes() {
+		OBEXFolderListingEntry e = OBEXFolderListingEntry.createFile("f", 1);
+		for (int i = 0; i < 10; i++) {
+			e.setAttribute("a" + i, String.valueOf(i));
+		}
+		assertEquals(12, e.getAttributeCount());
+		e.setAttribute("size", null);
+		assertEquals(11, e.getAttributeCount());
+		assertEquals(-1, e.getSize());
+		assertEquals("9", e.getAttribute("a9"));
+		e.setAttribute("name", "g");
+		assertEquals("g", e.getName());
+		assertEquals(11, e.getAttributeCount());
+	}
+
+	/**
+	 * Responds to GET with listing of given number of files, file size is its index.
+	 */
+	static class ListingRequestHandler extends ServerRequestHandler {
+
+		private int entries;
+
+		ListingRequestHandler(int entries) {
+			this.entries = entries;
+		}
+
+		public int onGet(Operation op) {
+			try {
+				HeaderSet hs = createHeaderSet();
+				hs.setHeader(HeaderSet.TYPE, "x-obex/folder-listing");
+				op.sendHeaders(hs);
+				OBEXFolderListingWriter w = new OBEXFolderListingWriter(op.openOutputStream());
+				w.writeParentFolder();
+				for (int i = 0; i < entries; i++) {
+					w.write(OBEXFolderListingEntry.createFile("file" + i + ".bin", i));
+				}
+				w.close();
+				op.close();
+				return ResponseCodes.OBEX_HTTP_OK;
+			} catch (IOException e) {
+				e.printStackTrace();
+				return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+			}
+		}
+	}
+
+	/**
+	 * GET folder listing and verify entries sent by ListingRequestHandler.
+	 * 
+	 * @return number of file entries
+	 */
+	static int getListing(ClientSession clientSession) throws IOException {
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.setHeader(HeaderSet.TYPE, "x-obex/folder-listing");
+		Operation getOperation = clientSession.get(hs);
+		InputStream is = getOperation.openInputStream();
+		OBEXFolderListingParser p = new OBEXFolderListingParser(is);
+		assertTrue("parent", p.next().isParentFolder());
+		int count = 0;
+		OBEXFolderListingEntry e;
+		while ((e = p.next()) != null) {
+			assertEquals("size", count, e.getSize());
+			count++;
+		}
+		is.close();
+		assertEquals("GET", ResponseCodes.OBEX_HTTP_OK, getOperation.getResponseCode());
+		getOperation.close();
+		return count;
+	}
+
+	public void testLargeListing() throws IOException {
+		ClientSession clientSession = connect();
+		try {
+			assertEquals("entries", LARGE_LISTING_ENTRIES, getListing(clientSession));
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+}
@@ -0,0 +1,179 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.Vector;
+
+import javax.microedition.io.Connection;
+import javax.microedition.io.Connector;
+import javax.obex.Authenticator;
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+import javax.obex.SessionNotifier;
+
+import junit.framework.TestCase;
+
+/**
+ * OBEX client and server connected over TCP-OBEX loopback. Server accepts sessions until stopServer() or tearDown(),
+ * by default PUT body is received by PutRequestHandler.
+ */
+public abstract class OBEXLoopbackTestCase extends TestCase {
+
+	protected static final int TEST_PORT = 18650;
+
+	private SessionNotifier serverNotifier;
+
+	private Thread acceptThread;
+
+	private Vector serverConnections = new Vector();
+
+	/**
+	 * Keep PUT body in serverReceivedData, only length is saved when false.
+	 */
+	protected volatile boolean serverKeepData = true;
+
+	protected volatile byte[] serverReceivedData;
+
+	protected volatile int serverReceivedLength;
+
+	protected void tearDown() throws Exception {
+		stopServer();
+		super.tearDown();
+	}
+
+	/**
+	 * Reads PUT body to serverReceivedData and serverReceivedLength.
+	 */
+	protected class PutRequestHandler extends ServerRequestHandler {
+
+		public int onPut(Operation op) {
+			try {
+				InputStream is = op.openInputStream();
+				ByteArrayOutputStream buf = new ByteArrayOutputStream();
+				byte[] b = new byte[0x1000];
+				int received = 0;
+				int len;
+				while ((len = is.read(b)) != -1) {
+					if (serverKeepData) {
+						buf.write(b, 0, len);
+					}
+					received += len;
+				}
+				is.close();
+				serverReceivedLength = received;
+				serverReceivedData = buf.toByteArray();
+				op.close();
+				return ResponseCodes.OBEX_HTTP_OK;
+			} catch (IOException e) {
+				e.printStackTrace();
+				return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+			}
+		}
+	}
+
+	/**
+	 * Called for each accepted session.
+	 */
+	protected ServerRequestHandler createRequestHandler() {
+		return new PutRequestHandler();
+	}
+
+	protected SessionNotifier getServerNotifier() {
+		return serverNotifier;
+	}
+
+	protected void startServer() throws IOException {
+		startServer(null);
+	}
+
+	protected void startServer(final Authenticator authenticator) throws IOException {
+		final SessionNotifier notifier = (SessionNotifier) Connector.open("tcpobex://:" + TEST_PORT);
+		serverNotifier = notifier;
+		acceptThread = new Thread() {
+			public void run() {
+				try {
+					while (true) {
+						serverConnections.addElement(notifier.acceptAndOpen(createRequestHandler(), authenticator));
+					}
+				} catch (IOException notifierClosed) {
+				}
+			}
+		};
+		acceptThread.start();
+	}
+
+	protected void stopServer() throws Exception {
+		if (serverNotifier != null) {
+			serverNotifier.close();
+			serverNotifier = null;
+		}
+		if (acceptThread != null) {
+			acceptThread.join(5000);
+			acceptThread = null;
+		}
+		for (int i = 0; i < serverConnections.size(); i++) {
+			((Connection) serverConnections.elementAt(i)).close();
+		}
+		serverConnections.removeAllElements();
+	}
+
+	protected ClientSession openClientSession() throws IOException {
+		return (ClientSession) Connector.open("tcpobex://localhost:" + TEST_PORT);
+	}
+
+	/**
+	 * Open client session and send CONNECT to running server.
+	 */
+	protected ClientSession connectClientSession() throws IOException {
+		ClientSession clientSession = openClientSession();
+		HeaderSet hsConnectReply = clientSession.connect(null);
+		assertEquals("connect", ResponseCodes.OBEX_HTTP_OK, hsConnectReply.getResponseCode());
+		return clientSession;
+	}
+
+	/**
+	 * Start server and connect client session to it.
+	 */
+	protected ClientSession connect() throws IOException {
+		startServer();
+		return connectClientSession();
+	}
+
+	protected void assertData(String message, byte[] expected, byte[] actual) {
+		assertNotNull(message + " data", actual);
+		assertEquals(message + " length", expected.length, actual.length);
+		for (int i = 0; i < expected.length; i++) {
+			if (expected[i] != actual[i]) {
+				fail(message + " byte " + i);
+			}
+		}
+	}
+}
@@ -0,0 +1,84 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.OutputStream;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Prints PUT throughput over TCP-OBEX loopback for different MTU values.
+ */
+public class OBEXMTUBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int BENCHMARK_SIZE = 4 * 1024 * 1024;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		serverKeepData = false;
+	}
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_MTU, null);
+		super.tearDown();
+	}
+
+	public void testTransferSpeed() throws Exception {
+		int[] mtus = new int[] { 0x400, 0x1000, 0x4000, OBEXOperationCodes.OBEX_MAX_PACKET_LEN };
+		byte[] data = new byte[0x4000];
+		for (int i = 0; i < mtus.length; i++) {
+			BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_MTU, String.valueOf(mtus[i]));
+			ClientSession clientSession = connect();
+			try {
+				assertEquals("mtu", mtus[i], BlueCoveOBEX.getPacketSize(clientSession));
+				long start = System.currentTimeMillis();
+				HeaderSet hs = clientSession.createHeaderSet();
+				hs.setHeader(HeaderSet.NAME, "test.bin");
+				Operation putOperation = clientSession.put(hs);
+				OutputStream os = putOperation.openOutputStream();
+				for (int k = 0; k < BENCHMARK_SIZE; k += data.length) {
+					os.write(data);
+				}
+				os.close();
+				assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+				putOperation.close();
+				long time = System.currentTimeMillis() - start;
+				assertEquals("received", BENCHMARK_SIZE, serverReceivedLength);
+				System.out.println("OBEX PUT " + (BENCHMARK_SIZE / 1024) + " KB, mtu " + mtus[i] + ": " + time
+						+ " msec, " + ((time == 0) ? "-" : String.valueOf(BENCHMARK_SIZE / time)) + " KB/s");
+				clientSession.disconnect(null);
+			} finally {
+				clientSession.close();
+				stopServer();
+			}
+		}
+	}
+}
@@ -0,0 +1,90 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+import java.io.OutputStream;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * MTU selected by transport over TCP-OBEX loopback.
+ */
+public class OBEXMTUTest extends OBEXLoopbackTestCase {
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		serverKeepData = false;
+	}
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_MTU, null);
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_MTU_AUTO, null);
+		super.tearDown();
+	}
+
+	private void put(ClientSession clientSession, int size) throws IOException {
+		byte[] data = new byte[0x4000];
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.setHeader(HeaderSet.NAME, "test.bin");
+		Operation putOperation = clientSession.put(hs);
+		OutputStream os = putOperation.openOutputStream();
+		for (int i = 0; i < size; i += data.length) {
+			os.write(data);
+		}
+		os.close();
+		assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+		putOperation.close();
+		assertEquals("received", size, serverReceivedLength);
+	}
+
+	public void testTransportMTU() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_MTU_AUTO, "true");
+		ClientSession clientSession = connect();
+		try {
+			assertEquals("mtu", OBEXOperationCodes.OBEX_MAX_PACKET_LEN, BlueCoveOBEX.getPacketSize(clientSession));
+			put(clientSession, 1024 * 1024);
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+
+	public void testConfiguredMTUNotChanged() throws Exception {
+		ClientSession clientSession = connect();
+		try {
+			assertEquals("mtu", OBEXConnectionParams.OBEX_DEFAULT_MTU, BlueCoveOBEX.getPacketSize(clientSession));
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+}
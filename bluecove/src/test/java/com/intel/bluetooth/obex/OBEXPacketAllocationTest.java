@@ -0,0 +1,156 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+import java.lang.reflect.Method;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+/**
+ * Counts bytes allocated by client thread per OBEX packet during PUT and GET over TCP-OBEX loopback. Body transfer
+ * should not allocate memory proportional to the packet size.
+ */
+public class OBEXPacketAllocationTest extends OBEXLoopbackTestCase {
+
+	private static final int TRANSFER_SIZE = 1024 * 1024;
+
+	private Object threadMXBean;
+
+	private Method getThreadAllocatedBytes;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		serverKeepData = false;
+		// Not available on all JVMs, use reflection
+		try {
+			Class factory = Class.forName("java.lang.management.ManagementFactory");
+			threadMXBean = factory.getMethod("getThreadMXBean", new Class[0]).invoke(null, new Object[0]);
+			Class beanClass = Class.forName("com.sun.management.ThreadMXBean");
+			if (beanClass.isInstance(threadMXBean)) {
+				getThreadAllocatedBytes = beanClass.getMethod("getThreadAllocatedBytes", new Class[] { Long.TYPE });
+			}
+		} catch (Throwable e) {
+			getThreadAllocatedBytes = null;
+		}
+	}
+
+	private long allocatedBytes() throws Exception {
+		Long id = new Long(Thread.currentThread().getId());
+		return ((Long) getThreadAllocatedBytes.invoke(threadMXBean, new Object[] { id })).longValue();
+	}
+
+	private class RequestHandler extends PutRequestHandler {
+
+		public int onGet(Operation op) {
+			try {
+				OutputStream os = op.openOutputStream();
+				byte[] b = new byte[0x1000];
+				for (int i = 0; i < TRANSFER_SIZE; i += b.length) {
+					os.write(b);
+				}
+				os.close();
+				op.close();
+				return ResponseCodes.OBEX_HTTP_OK;
+			} catch (IOException e) {
+				e.printStackTrace();
+				return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+			}
+		}
+	}
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new RequestHandler();
+	}
+
+	private void put(ClientSession clientSession, byte[] data) throws IOException {
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.setHeader(HeaderSet.NAME, "test.bin");
+		Operation putOperation = clientSession.put(hs);
+		OutputStream os = putOperation.openOutputStream();
+		for (int i = 0; i < TRANSFER_SIZE; i += data.length) {
+			os.write(data);
+		}
+		os.close();
+		assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+		putOperation.close();
+	}
+
+	private void get(ClientSession clientSession, byte[] data) throws IOException {
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.setHeader(HeaderSet.NAME, "test.bin");
+		Operation getOperation = clientSession.get(hs);
+		InputStream is = getOperation.openInputStream();
+		int received = 0;
+		int len;
+		while ((len = is.read(data)) != -1) {
+			received += len;
+		}
+		is.close();
+		assertEquals("GET", ResponseCodes.OBEX_HTTP_OK, getOperation.getResponseCode());
+		getOperation.close();
+		assertEquals("GET length", TRANSFER_SIZE, received);
+	}
+
+	public void testAllocationPerPacket() throws Exception {
+		if (getThreadAllocatedBytes == null) {
+			// Thread allocation counter not available
+			return;
+		}
+		ClientSession clientSession = connect();
+		try {
+			OBEXSessionBase session = (OBEXSessionBase) clientSession;
+			byte[] data = new byte[0x1000];
+			// Warm up, buffers are allocated for the first packets
+			put(clientSession, data);
+			get(clientSession, data);
+
+			int packets = session.getPacketsCountWrite() + session.getPacketsCountRead();
+			long allocated = allocatedBytes();
+			put(clientSession, data);
+			long putAllocated = allocatedBytes() - allocated;
+			int putPackets = session.getPacketsCountWrite() + session.getPacketsCountRead() - packets;
+
+			packets = session.getPacketsCountWrite() + session.getPacketsCountRead();
+			allocated = allocatedBytes();
+			get(clientSession, data);
+			long getAllocated = allocatedBytes() - allocated;
+			int getPackets = session.getPacketsCountWrite() + session.getPacketsCountRead() - packets;
+
+			int mtu = session.getPacketSize();
+			assertTrue("PUT allocation " + (putAllocated / putPackets), putAllocated / putPackets < mtu / 4);
+			assertTrue("GET allocation " + (getAllocated / getPackets), getAllocated / getPackets < mtu / 4);
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+}
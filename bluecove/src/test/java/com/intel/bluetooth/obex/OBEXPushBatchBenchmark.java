@@ -0,0 +1,103 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+import java.io.OutputStream;
+import java.util.Vector;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+/**
+ * Prints the time to push 1000 vCards over TCP-OBEX loopback with session per object, PUT operations in one session
+ * and BlueCoveOBEX.putObjects.
+ */
+public class OBEXPushBatchBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int BENCHMARK_OBJECTS = 1000;
+
+	private Vector serverReceived = new Vector();
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new OBEXPushBatchTest.PushRequestHandler(serverReceived);
+	}
+
+	private void put(ClientSession clientSession, HeaderSet hs, byte[] data) throws IOException {
+		Operation putOperation = clientSession.put(hs);
+		OutputStream os = putOperation.openOutputStream();
+		os.write(data);
+		os.close();
+		assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+		putOperation.close();
+	}
+
+	public void testTransferSpeed() throws Exception {
+		startServer();
+		byte[][] objects = new byte[BENCHMARK_OBJECTS][];
+		for (int i = 0; i < BENCHMARK_OBJECTS; i++) {
+			objects[i] = OBEXPushBatchTest.vCard(i);
+		}
+
+		long start = System.currentTimeMillis();
+		for (int i = 0; i < BENCHMARK_OBJECTS; i++) {
+			ClientSession clientSession = connectClientSession();
+			try {
+				put(clientSession, OBEXPushBatchTest.createHeaders(clientSession, 1, null)[0], objects[i]);
+				clientSession.disconnect(null);
+			} finally {
+				clientSession.close();
+			}
+		}
+		long sessionPerObject = System.currentTimeMillis() - start;
+
+		start = System.currentTimeMillis();
+		ClientSession clientSession = connectClientSession();
+		try {
+			HeaderSet[] headers = OBEXPushBatchTest.createHeaders(clientSession, BENCHMARK_OBJECTS, "card1.vcf");
+			for (int i = 0; i < BENCHMARK_OBJECTS; i++) {
+				put(clientSession, headers[i], objects[i]);
+			}
+			long oneSession = System.currentTimeMillis() - start;
+
+			headers = OBEXPushBatchTest.createHeaders(clientSession, BENCHMARK_OBJECTS, "card1.vcf");
+			start = System.currentTimeMillis();
+			int[] rc = BlueCoveOBEX.putObjects(clientSession, headers, objects);
+			long batch = System.currentTimeMillis() - start;
+			for (int i = 0; i < BENCHMARK_OBJECTS; i++) {
+				assertEquals("rc " + i, ResponseCodes.OBEX_HTTP_OK, rc[i]);
+			}
+			clientSession.disconnect(null);
+			System.out.println("OBEX push " + BENCHMARK_OBJECTS + " vCards: session per object " + sessionPerObject
+					+ " msec, one session " + oneSession + " msec, putObjects " + batch + " msec");
+		} finally {
+			clientSession.close();
+		}
+		assertEquals("received", 3 * BENCHMARK_OBJECTS, serverReceived.size());
+	}
+}
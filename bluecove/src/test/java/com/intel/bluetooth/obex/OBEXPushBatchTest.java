@@ -0,0 +1,129 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.util.Vector;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+/**
+ * BlueCoveOBEX.putObjects over TCP-OBEX loopback.
+ */
+public class OBEXPushBatchTest extends OBEXLoopbackTestCase {
+
+	private Vector serverReceived = new Vector();
+
+	/**
+	 * Saves name and body of each PUT, object named "reject.vcf" is refused.
+	 */
+	static class PushRequestHandler extends ServerRequestHandler {
+
+		private Vector received;
+
+		PushRequestHandler(Vector received) {
+			this.received = received;
+		}
+
+		public int onPut(Operation op) {
+			try {
+				String name = (String) op.getReceivedHeaders().getHeader(HeaderSet.NAME);
+				InputStream is = op.openInputStream();
+				ByteArrayOutputStream buf = new ByteArrayOutputStream();
+				byte[] b = new byte[0x400];
+				int len;
+				while ((len = is.read(b)) != -1) {
+					buf.write(b, 0, len);
+				}
+				is.close();
+				op.close();
+				received.addElement(new Object[] { name, buf.toByteArray() });
+				if ("reject.vcf".equals(name)) {
+					return ResponseCodes.OBEX_HTTP_FORBIDDEN;
+				}
+				return ResponseCodes.OBEX_HTTP_OK;
+			} catch (IOException e) {
+				e.printStackTrace();
+				return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+			}
+		}
+	}
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new PushRequestHandler(serverReceived);
+	}
+
+	static byte[] vCard(int i) {
+		return ("BEGIN:VCARD\r\nVERSION:2.1\r\nN:Contact;" + i + "\r\nTEL;CELL:+1555" + (1000000 + i)
+				+ "\r\nEND:VCARD\r\n").getBytes();
+	}
+
+	static HeaderSet[] createHeaders(ClientSession clientSession, int count, String rejectName) {
+		HeaderSet[] headers = new HeaderSet[count];
+		for (int i = 0; i < count; i++) {
+			headers[i] = clientSession.createHeaderSet();
+			headers[i].setHeader(HeaderSet.NAME, (i == 1) ? rejectName : ("card" + i + ".vcf"));
+			headers[i].setHeader(HeaderSet.TYPE, "text/x-vcard");
+		}
+		return headers;
+	}
+
+	public void testPutObjects() throws IOException {
+		ClientSession clientSession = connect();
+		try {
+			byte[][] objects = new byte[][] { vCard(0), vCard(1), new byte[0], new byte[5000] };
+			for (int i = 0; i < objects[3].length; i++) {
+				objects[3][i] = (byte) i;
+			}
+			HeaderSet[] headers = createHeaders(clientSession, objects.length, "reject.vcf");
+			OBEXSessionBase session = (OBEXSessionBase) clientSession;
+			int write = session.getPacketsCountWrite();
+			int[] rc = BlueCoveOBEX.putObjects(clientSession, headers, objects);
+			assertEquals("rc 0", ResponseCodes.OBEX_HTTP_OK, rc[0]);
+			assertEquals("rc 1", ResponseCodes.OBEX_HTTP_FORBIDDEN, rc[1]);
+			assertEquals("rc 2", ResponseCodes.OBEX_HTTP_OK, rc[2]);
+			assertEquals("rc 3", ResponseCodes.OBEX_HTTP_OK, rc[3]);
+			int mtu = session.getPacketSize() - OBEXOperationCodes.OBEX_MTU_HEADER_RESERVE;
+			// One packet for each small object, headers and body packets for the large one
+			assertTrue("packets", session.getPacketsCountWrite() - write >= 3 + 1 + (objects[3].length + mtu - 1) / mtu);
+			assertTrue("packets max", session.getPacketsCountWrite() - write <= 3 + 2 + (objects[3].length + mtu - 1) / mtu);
+			assertEquals("received", objects.length, serverReceived.size());
+			for (int i = 0; i < objects.length; i++) {
+				Object[] r = (Object[]) serverReceived.elementAt(i);
+				assertEquals("name " + i, headers[i].getHeader(HeaderSet.NAME), r[0]);
+				assertData("object " + i, objects[i], (byte[]) r[1]);
+			}
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+}
@@ -0,0 +1,105 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.FileOutputStream;
+import java.io.InputStream;
+import java.io.OutputStream;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+
+/**
+ * Prints BlueCoveOBEX.putFile transfer speed over TCP-OBEX loopback compared to copying the file to Operation output
+ * stream.
+ */
+public class OBEXPutFileBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int BENCHMARK_SIZE = 16 * 1024 * 1024;
+
+	private File testFile;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		serverKeepData = false;
+		testFile = File.createTempFile("obex", ".bin");
+		FileOutputStream os = new FileOutputStream(testFile);
+		try {
+			os.write(new byte[BENCHMARK_SIZE]);
+		} finally {
+			os.close();
+		}
+	}
+
+	protected void tearDown() throws Exception {
+		super.tearDown();
+		testFile.delete();
+	}
+
+	private long benchmarkPut(boolean putFile) throws Exception {
+		ClientSession clientSession = connect();
+		try {
+			HeaderSet hs = clientSession.createHeaderSet();
+			hs.setHeader(HeaderSet.NAME, "test.bin");
+			long start = System.currentTimeMillis();
+			if (putFile) {
+				HeaderSet reply = BlueCoveOBEX.putFile(clientSession, hs, testFile);
+				assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, reply.getResponseCode());
+			} else {
+				hs.setHeader(HeaderSet.LENGTH, new Long(testFile.length()));
+				Operation putOperation = clientSession.put(hs);
+				OutputStream os = putOperation.openOutputStream();
+				InputStream is = new FileInputStream(testFile);
+				byte[] b = new byte[0x4000];
+				int len;
+				while ((len = is.read(b)) != -1) {
+					os.write(b, 0, len);
+				}
+				is.close();
+				os.close();
+				assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+				putOperation.close();
+			}
+			long time = System.currentTimeMillis() - start;
+			assertEquals("received", BENCHMARK_SIZE, serverReceivedLength);
+			clientSession.disconnect(null);
+			return time;
+		} finally {
+			clientSession.close();
+			stopServer();
+		}
+	}
+
+	public void testTransferSpeed() throws Exception {
+		long stream = benchmarkPut(false);
+		long putFile = benchmarkPut(true);
+		System.out.println("OBEX PUT file " + (BENCHMARK_SIZE / 1024) + " KB, mtu "
+				+ OBEXConnectionParams.OBEX_DEFAULT_MTU + ": stream " + stream + " msec, putFile " + putFile + " msec");
+	}
+}
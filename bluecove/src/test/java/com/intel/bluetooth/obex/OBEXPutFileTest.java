@@ -0,0 +1,111 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.File;
+import java.io.FileOutputStream;
+import java.io.IOException;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+/**
+ * BlueCoveOBEX.putFile over TCP-OBEX loopback.
+ */
+public class OBEXPutFileTest extends OBEXLoopbackTestCase {
+
+	private volatile Long serverReceivedLengthHeader;
+
+	private File testFile;
+
+	protected void tearDown() throws Exception {
+		super.tearDown();
+		if (testFile != null) {
+			testFile.delete();
+			testFile = null;
+		}
+	}
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new PutRequestHandler() {
+			public int onPut(Operation op) {
+				try {
+					serverReceivedLengthHeader = (Long) op.getReceivedHeaders().getHeader(HeaderSet.LENGTH);
+				} catch (IOException e) {
+					e.printStackTrace();
+					return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+				}
+				return super.onPut(op);
+			}
+		};
+	}
+
+	private byte[] createTestFile(int length) throws IOException {
+		byte data[] = new byte[length];
+		for (int i = 0; i < length; i++) {
+			data[i] = (byte) ((i * 7) & 0xFF);
+		}
+		testFile = File.createTempFile("obex", ".bin");
+		FileOutputStream os = new FileOutputStream(testFile);
+		try {
+			os.write(data);
+		} finally {
+			os.close();
+		}
+		return data;
+	}
+
+	private void runPutFile(int length) throws IOException {
+		byte[] data = createTestFile(length);
+		ClientSession clientSession = connect();
+		try {
+			HeaderSet hs = clientSession.createHeaderSet();
+			hs.setHeader(HeaderSet.NAME, "test.bin");
+			HeaderSet reply = BlueCoveOBEX.putFile(clientSession, hs, testFile);
+			assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, reply.getResponseCode());
+			assertData("PUT", data, serverReceivedData);
+			assertEquals("Length header", new Long(length), serverReceivedLengthHeader);
+			assertNull("application HeaderSet changed", hs.getHeader(HeaderSet.LENGTH));
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+
+	public void testPutFile() throws IOException {
+		runPutFile(100 * 1024 + 7);
+	}
+
+	public void testPutEmptyFile() throws IOException {
+		runPutFile(0);
+	}
+
+	public void testPutFileSinglePacket() throws IOException {
+		runPutFile(10);
+	}
+}
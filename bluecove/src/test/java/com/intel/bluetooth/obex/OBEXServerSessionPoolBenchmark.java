@@ -0,0 +1,66 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Load test for OBEX server sessions over TCP-OBEX loopback. Many short push sessions are served by thread per session
+ * and by the session pool, sessions per second are printed.
+ */
+public class OBEXServerSessionPoolBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int POOL_SIZE = 4;
+
+	private static final int CLIENTS = 16;
+
+	private static final int SESSIONS_PER_CLIENT = 25;
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SERVER_POOL, null);
+		super.tearDown();
+	}
+
+	private long runLoad(int poolSize) throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SERVER_POOL, String.valueOf(poolSize));
+		startServer();
+		long start = System.currentTimeMillis();
+		int clientErrors = OBEXServerSessionPoolTest.runClients(CLIENTS, SESSIONS_PER_CLIENT);
+		long time = System.currentTimeMillis() - start;
+		stopServer();
+		assertEquals("client errors", 0, clientErrors);
+		return time;
+	}
+
+	public void testSessionsPerSecond() throws Exception {
+		int sessions = CLIENTS * SESSIONS_PER_CLIENT;
+		long threadPerSession = runLoad(0);
+		long pool = runLoad(POOL_SIZE);
+		System.out.println("OBEX " + sessions + " sessions from " + CLIENTS + " clients: thread per session "
+				+ (sessions * 1000 / Math.max(threadPerSession, 1)) + " sessions/s, pool of " + POOL_SIZE + " "
+				+ (sessions * 1000 / Math.max(pool, 1)) + " sessions/s");
+	}
+}
@@ -0,0 +1,171 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+
+import javax.microedition.io.Connector;
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * OBEX server sessions served by the session pool over TCP-OBEX loopback.
+ */
+public class OBEXServerSessionPoolTest extends OBEXLoopbackTestCase {
+
+	private static final int POOL_SIZE = 4;
+
+	private static final int CLIENTS = 8;
+
+	private static final int SESSIONS_PER_CLIENT = 5;
+
+	private int serverPutCount;
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SERVER_POOL, null);
+		super.tearDown();
+	}
+
+	private class RequestHandler extends ServerRequestHandler {
+
+		public int onPut(Operation op) {
+			try {
+				InputStream is = op.openInputStream();
+				byte[] b = new byte[0x100];
+				while (is.read(b) != -1) {
+				}
+				is.close();
+				op.close();
+				synchronized (OBEXServerSessionPoolTest.this) {
+					serverPutCount++;
+				}
+				return ResponseCodes.OBEX_HTTP_OK;
+			} catch (IOException e) {
+				e.printStackTrace();
+				return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+			}
+		}
+	}
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new RequestHandler();
+	}
+
+	private void startServer(int poolSize) throws IOException {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SERVER_POOL, String.valueOf(poolSize));
+		serverPutCount = 0;
+		startServer();
+	}
+
+	static void pushObject(byte[] data) throws IOException {
+		ClientSession clientSession = (ClientSession) Connector.open("tcpobex://localhost:" + TEST_PORT);
+		try {
+			HeaderSet hsConnectReply = clientSession.connect(null);
+			assertEquals("connect", ResponseCodes.OBEX_HTTP_OK, hsConnectReply.getResponseCode());
+			HeaderSet hs = clientSession.createHeaderSet();
+			hs.setHeader(HeaderSet.NAME, "card.vcf");
+			Operation putOperation = clientSession.put(hs);
+			OutputStream os = putOperation.openOutputStream();
+			os.write(data);
+			os.close();
+			assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+			putOperation.close();
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+
+	/**
+	 * Each client pushes sessionsPerClient objects, one session per object, all clients run at the same time.
+	 * 
+	 * @return number of failed clients
+	 */
+	static int runClients(int clients, final int sessionsPerClient) throws InterruptedException {
+		final byte[] data = new byte[300];
+		final int[] errors = new int[1];
+		Thread[] threads = new Thread[clients];
+		for (int i = 0; i < clients; i++) {
+			threads[i] = new Thread() {
+				public void run() {
+					try {
+						for (int s = 0; s < sessionsPerClient; s++) {
+							pushObject(data);
+						}
+					} catch (Throwable e) {
+						e.printStackTrace();
+						synchronized (errors) {
+							errors[0]++;
+						}
+					}
+				}
+			};
+			threads[i].start();
+		}
+		for (int i = 0; i < clients; i++) {
+			threads[i].join();
+		}
+		return errors[0];
+	}
+
+	public void testIdleSessionReleasesThread() throws Exception {
+		startServer(1);
+		ClientSession idleSession = openClientSession();
+		try {
+			assertEquals("connect", ResponseCodes.OBEX_HTTP_OK, idleSession.connect(null).getResponseCode());
+			// The only pool thread waits for the next request of idle session
+			pushObject(new byte[10]);
+			assertEquals("sessions", 1, serverPutCount);
+			idleSession.disconnect(null);
+		} finally {
+			idleSession.close();
+		}
+	}
+
+	public void testConcurrentSessions() throws Exception {
+		startServer(POOL_SIZE);
+		OBEXServerSessionPool pool = ((OBEXSessionNotifierImpl) getServerNotifier()).getSessionPool();
+		int clientErrors = runClients(CLIENTS, SESSIONS_PER_CLIENT);
+		assertTrue("pool threads", pool.getThreadCount() <= POOL_SIZE);
+		assertTrue("pool threads started", pool.getThreadCount() > 0);
+		stopServer();
+		assertEquals("client errors", 0, clientErrors);
+		assertEquals("sessions", CLIENTS * SESSIONS_PER_CLIENT, serverPutCount);
+		// Idle threads end when notifier is closed
+		long end = System.currentTimeMillis() + 5000;
+		while ((pool.getThreadCount() > 0) && (System.currentTimeMillis() < end)) {
+			Thread.sleep(50);
+		}
+		assertEquals("pool threads after close", 0, pool.getThreadCount());
+	}
+}
@@ -0,0 +1,72 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import javax.obex.ClientSession;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Prints PUT transfer speed over TCP-OBEX loopback with and without Single Response Mode.
+ */
+public class OBEXSingleResponseModeBenchmark extends OBEXLoopbackTestCase {
+
+	private static final int BENCHMARK_SIZE = 4 * 1024 * 1024;
+
+	protected void setUp() throws Exception {
+		super.setUp();
+		serverKeepData = false;
+	}
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SRM, null);
+		super.tearDown();
+	}
+
+	private long benchmarkPut(boolean srm) throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SRM, String.valueOf(srm));
+		ClientSession clientSession = connect();
+		try {
+			byte[] data = OBEXSingleResponseModeTest.makeTestData(BENCHMARK_SIZE);
+			long start = System.currentTimeMillis();
+			OBEXSingleResponseModeTest.put(clientSession, data);
+			long time = System.currentTimeMillis() - start;
+			assertEquals("received", BENCHMARK_SIZE, serverReceivedLength);
+			clientSession.disconnect(null);
+			return time;
+		} finally {
+			clientSession.close();
+			stopServer();
+		}
+	}
+
+	public void testTransferSpeed() throws Exception {
+		long lockStep = benchmarkPut(false);
+		long srm = benchmarkPut(true);
+		System.out.println("OBEX PUT " + (BENCHMARK_SIZE / 1024) + " KB, mtu " + OBEXConnectionParams.OBEX_DEFAULT_MTU
+				+ ": " + lockStep + " msec, SRM " + srm + " msec");
+	}
+}
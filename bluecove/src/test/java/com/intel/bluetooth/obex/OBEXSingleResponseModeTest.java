@@ -0,0 +1,178 @@
+/**
+ *  BlueCove - Java library for Bluetooth
+ *  Copyright (C) 2006-2009 Vlad Skarzhevskyy
+ *
+ *  Licensed to the Apache Software Foundation (ASF) under one
+ *  or more contributor license agreements.  See the NOTICE file
+ *  distributed with this work for additional information
+ *  regarding copyright ownership.  The ASF licenses this file
+ *  to you under the Apache License, Version 2.0 (the
+ *  "License"); you may not use this file except in compliance
+ *  with the License.  You may obtain a copy of the License at
+ *
+ *    http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing,
+ *  software distributed under the License is distributed on an
+ *  "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ *  KIND, either express or implied.  See the License for the
+ *  specific language governing permissions and limitations
+ *  under the License.
+ *
+ *  @author vlads
+ *  @version $Id$
+ */
+package com.intel.bluetooth.obex;
+
+import java.io.ByteArrayOutputStream;
+import java.io.IOException;
+import java.io.InputStream;
+import java.io.OutputStream;
+
+import javax.obex.ClientSession;
+import javax.obex.HeaderSet;
+import javax.obex.Operation;
+import javax.obex.ResponseCodes;
+import javax.obex.ServerRequestHandler;
+
+import com.intel.bluetooth.BlueCoveConfigProperties;
+import com.intel.bluetooth.BlueCoveImpl;
+
+/**
+ * Single Response Mode PUT and GET over TCP-OBEX loopback.
+ */
+public class OBEXSingleResponseModeTest extends OBEXLoopbackTestCase {
+
+	private volatile byte[] serverGetData;
+
+	protected void tearDown() throws Exception {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SRM, null);
+		super.tearDown();
+	}
+
+	private class RequestHandler extends PutRequestHandler {
+
+		public int onGet(Operation op) {
+			try {
+				OutputStream os = op.openOutputStream();
+				os.write(serverGetData);
+				os.close();
+				op.close();
+				return ResponseCodes.OBEX_HTTP_OK;
+			} catch (IOException e) {
+				e.printStackTrace();
+				return ResponseCodes.OBEX_HTTP_UNAVAILABLE;
+			}
+		}
+	}
+
+	protected ServerRequestHandler createRequestHandler() {
+		return new RequestHandler();
+	}
+
+	private void startServer(boolean srm) throws IOException {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SRM, String.valueOf(srm));
+		startServer();
+	}
+
+	private ClientSession connect(boolean srm) throws IOException {
+		BlueCoveImpl.setConfigProperty(BlueCoveConfigProperties.PROPERTY_OBEX_SRM, String.valueOf(srm));
+		return connectClientSession();
+	}
+
+	static byte[] makeTestData(int length) {
+		byte data[] = new byte[length];
+		for (int i = 0; i < length; i++) {
+			data[i] = (byte) (i & 0xFF);
+		}
+		return data;
+	}
+
+	static void put(ClientSession clientSession, byte[] data) throws IOException {
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.setHeader(HeaderSet.NAME, "test.bin");
+		hs.setHeader(HeaderSet.LENGTH, new Long(data.length));
+		Operation putOperation = clientSession.put(hs);
+		OutputStream os = putOperation.openOutputStream();
+		os.write(data);
+		os.close();
+		assertEquals("PUT", ResponseCodes.OBEX_HTTP_OK, putOperation.getResponseCode());
+		putOperation.close();
+	}
+
+	private byte[] get(ClientSession clientSession) throws IOException {
+		HeaderSet hs = clientSession.createHeaderSet();
+		hs.setHeader(HeaderSet.NAME, "test.bin");
+		Operation getOperation = clientSession.get(hs);
+		InputStream is = getOperation.openInputStream();
+		ByteArrayOutputStream buf = new ByteArrayOutputStream();
+		byte[] b = new byte[0x1000];
+		int len;
+		while ((len = is.read(b)) != -1) {
+			buf.write(b, 0, len);
+		}
+		is.close();
+		assertEquals("GET", ResponseCodes.OBEX_HTTP_OK, getOperation.getResponseCode());
+		getOperation.close();
+		return buf.toByteArray();
+	}
+
+	private void runTransfer(boolean serverSRM, boolean clientSRM, int size, boolean expectSRM) throws IOException {
+		startServer(serverSRM);
+		ClientSession clientSession = connect(clientSRM);
+		try {
+			OBEXSessionBase session = (OBEXSessionBase) clientSession;
+			byte[] data = makeTestData(size);
+			int mtu = session.getPacketSize() - OBEXOperationCodes.OBEX_MTU_HEADER_RESERVE;
+			int bodyPackets = (size + mtu - 1) / mtu;
+
+			int write = session.getPacketsCountWrite();
+			int read = session.getPacketsCountRead();
+			put(clientSession, data);
+			assertData("PUT", data, serverReceivedData);
+			int putWrite = session.getPacketsCountWrite() - write;
+			int putRead = session.getPacketsCountRead() - read;
+			if (expectSRM) {
+				// Response to the first packet that enabled SRM and to the final one
+				assertEquals("PUT responses", 2, putRead);
+			} else {
+				assertEquals("PUT responses", putWrite, putRead);
+			}
+			assertTrue("PUT packets", putWrite >= bodyPackets);
+
+			serverGetData = data;
+			write = session.getPacketsCountWrite();
+			read = session.getPacketsCountRead();
+			assertData("GET", data, get(clientSession));
+			int getWrite = session.getPacketsCountWrite() - write;
+			int getRead = session.getPacketsCountRead() - read;
+			if (expectSRM) {
+				assertEquals("GET requests", 1, getWrite);
+			} else {
+				assertEquals("GET requests", getRead, getWrite);
+			}
+			assertTrue("GET packets", getRead >= bodyPackets);
+			assertFalse("SRM", session.isSingleResponseModeActive());
+
+			clientSession.disconnect(null);
+		} finally {
+			clientSession.close();
+		}
+	}
+
+	public void testSingleResponseMode() throws IOException {
+		runTransfer(true, true, 100 * 1024, true);
+	}
+
+	public void testSingleResponseModeSmallObject() throws IOException {
+		runTransfer(true, true, 10, true);
+	}
+
+	public void testServerNotSupportingSingleResponseMode() throws IOException {
+		runTransfer(false, true, 100 * 1024, false);
+	}
+
+	public void testClientNotRequestingSingleResponseMode() throws IOException {
+		runTransfer(true, false, 100 * 1024, false);
+	}
+}
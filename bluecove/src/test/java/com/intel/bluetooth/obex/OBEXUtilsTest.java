@@ -24,10 +24,14 @@
  */
 package com.intel.bluetooth.obex;
 
+import java.io.ByteArrayInputStream;
 import java.io.IOException;
+import java.io.InterruptedIOException;
 
 import junit.framework.TestCase;
 
+import com.intel.bluetooth.ReadTimeoutInputStream;
+
 public class OBEXUtilsTest extends TestCase {
 	
 	public void testBytesLoHi() {
@@ -64,6 +68,91 @@ public class OBEXUtilsTest extends TestCase {
 		value = "\u0413\u043E\u043B\u0443\u0431\u043E\u0439\u0417\u0443\u0431";
 		assertEquals("UTF16 Rus String", value, new String(OBEXUtils.getUTF16BytesSimple(value), "UTF-16BE"));
 		assertEquals("UTF16 Rus String", value, OBEXUtils.newStringUTF16Simple(OBEXUtils.getUTF16Bytes(value)));
+
+		value = "G\uD834\uDD1E\u00E9";
+		byte[] b = value.getBytes("UTF-16BE");
+		assertEquals("UTF16 surrogate pair", value, new String(OBEXUtils.getUTF16Bytes(value), "UTF-16BE"));
+		byte[] padded = new byte[b.length + 3];
+		System.arraycopy(b, 0, padded, 1, b.length);
+		assertEquals("UTF16 offset", value, OBEXUtils.newStringUTF16(padded, 1, b.length));
+	}
+
+	public void testASCII() throws IOException {
+		String value = "x-obex/folder-listing";
+		assertEquals("ASCII bytes", value, new String(OBEXUtils.getASCIIBytes(value), "iso-8859-1"));
+		byte[] b = value.getBytes("iso-8859-1");
+		assertEquals("ASCII String", value, OBEXUtils.newStringASCII(b, 0, b.length));
+		assertEquals("ISO-8859-1", "\u00E9", OBEXUtils.newStringASCII(new byte[] { (byte) 0xE9 }, 0, 1));
+	}
+
+	/**
+	 * Returns one byte per timed read and then waits for data that never arrives.
+	 */
+	private static class TimeoutStream extends ByteArrayInputStream implements ReadTimeoutInputStream {
+
+		int timedReads;
+
+		int lastTimeout;
+
+		/**
+		 * Time to wait before each byte.
+		 */
+		int delay;
+
+		TimeoutStream(byte[] buf) {
+			super(buf);
+		}
+
+		public synchronized int read(byte[] b, int off, int len, int timeout) throws IOException {
+			timedReads++;
+			lastTimeout = timeout;
+			if (available() == 0) {
+				throw new InterruptedIOException();
+			}
+			if (delay > 0) {
+				try {
+					Thread.sleep(delay);
+				} catch (InterruptedException e) {
+					throw new InterruptedIOException();
+				}
+			}
+			return read(b, off, 1);
+		}
+	}
+
+	public void testReadFullyTimeout() throws IOException {
+		OBEXConnectionParams params = new OBEXConnectionParams();
+		params.timeouts = true;
+		params.timeout = 1000;
+
+		TimeoutStream is = new TimeoutStream(new byte[] { 1, 2, 3 });
+		byte[] b = new byte[3];
+		OBEXUtils.readFully(is, params, b);
+		assertEquals("timed reads", 3, is.timedReads);
+		assertEquals("data", 3, b[2]);
+
+		is = new TimeoutStream(new byte[] { 1, 2 });
+		try {
+			OBEXUtils.readFully(is, params, b);
+			fail("timeout expected");
+		} catch (InterruptedIOException e) {
+			assertTrue("message " + e.getMessage(), e.getMessage().indexOf("received 2") != -1);
+		}
+	}
+
+	public void testReadFullyTimeoutPerChunk() throws IOException {
+		OBEXConnectionParams params = new OBEXConnectionParams();
+		params.timeouts = true;
+		params.timeout = 150;
+
+		// Whole read takes longer than timeout, each chunk arrives in time
+		TimeoutStream is = new TimeoutStream(new byte[] { 1, 2, 3, 4, 5 });
+		is.delay = 50;
+		byte[] b = new byte[5];
+		OBEXUtils.readFully(is, params, b);
+		assertEquals("timed reads", 5, is.timedReads);
+		assertEquals("timeout", 150, is.lastTimeout);
+		assertEquals("data", 5, b[4]);
 	}
 
 }